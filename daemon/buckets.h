@@ -134,7 +134,7 @@ public:
      */
     Hdr1sfMicroSecHistogram subjson_operation_times;
 
-    /// JSON_checker validate() execution time histogram.
+    /// JSON validation (cb::json::Validator) execution time histogram.
     Hdr1sfMicroSecHistogram jsonValidateTimes;
 
     /// Snappy decompression time histogram.
@@ -1447,12 +1447,12 @@ size_t Connection::getSendQueueSize() const {
     return evbuffer_get_length(bufferevent_get_output(bev.get()));
 }
 
-void Connection::sendResponseHeaders(Cookie& cookie,
-                                     cb::mcbp::Status status,
-                                     std::string_view extras,
-                                     std::string_view key,
-                                     std::size_t value_len,
-                                     uint8_t datatype) {
+cb::char_buffer Connection::formatResponseHeaders(Cookie& cookie,
+                                                 cb::mcbp::Status status,
+                                                 std::string_view extras,
+                                                 std::string_view key,
+                                                 std::size_t value_len,
+                                                 uint8_t datatype) {
     static_assert(sizeof(FrontEndThread::scratch_buffer) >
                           (sizeof(cb::mcbp::Response) + 3),
                   "scratch buffer too small");
@@ -1520,6 +1520,18 @@ void Connection::sendResponseHeaders(Cookie& cookie,
         }
     }
 
+    return wbuf;
+}
+
+void Connection::sendResponseHeaders(Cookie& cookie,
+                                     cb::mcbp::Status status,
+                                     std::string_view extras,
+                                     std::string_view key,
+                                     std::size_t value_len,
+                                     uint8_t datatype) {
+    auto wbuf = formatResponseHeaders(
+            cookie, status, extras, key, value_len, datatype);
+
     // if we can fit the key and extras in the scratch buffer lets copy them
     // in to avoid the extra mutex lock
     if ((wbuf.size() + extras.size() + key.size()) <
@@ -1545,19 +1557,85 @@ void Connection::sendResponse(Cookie& cookie,
                               std::string_view value,
                               uint8_t datatype,
                               std::unique_ptr<SendBuffer> sendbuffer) {
+    if (sendbuffer && sendbuffer->getPayload().size() != value.size()) {
+        throw std::runtime_error(
+                "Connection::sendResponse: The sendbuffers payload must "
+                "match the value encoded in the response");
+    }
+
+    // The payload of a send buffer is large (see
+    // SendBuffer::MinimumDataSize). If there isn't anything queued up
+    // in front of the response we may write the headers and the payload
+    // straight to the socket instead of going through libevent.
+    if (sendbuffer && !isSslEnabled() && getSendQueueSize() == 0) {
+        auto wbuf = formatResponseHeaders(
+                cookie, status, extras, key, value.size(), datatype);
+        if ((wbuf.size() + extras.size() + key.size()) <
+            thread.scratch_buffer.size()) {
+            std::copy(extras.begin(), extras.end(), wbuf.end());
+            wbuf = {wbuf.data(), wbuf.size() + extras.size()};
+            std::copy(key.begin(), key.end(), wbuf.end());
+            wbuf = {wbuf.data(), wbuf.size() + key.size()};
+            sendToSocket({wbuf.data(), wbuf.size()}, std::move(sendbuffer));
+            ++getBucket().responseCounters[uint16_t(status)];
+            return;
+        }
+    }
+
     sendResponseHeaders(cookie, status, extras, key, value.size(), datatype);
     if (sendbuffer) {
-        if (sendbuffer->getPayload().size() != value.size()) {
-            throw std::runtime_error(
-                    "Connection::sendResponse: The sendbuffers payload must "
-                    "match the value encoded in the response");
-        }
         chainDataToOutputStream(std::move(sendbuffer));
     } else {
         cookie.getConnection().copyToOutputStream(value);
     }
 }
 
+void Connection::sendToSocket(std::string_view header,
+                              std::unique_ptr<SendBuffer> sendbuffer) {
+    const auto payload = sendbuffer->getPayload();
+    std::array<iovec, 2> iov;
+    iov[0].iov_base = const_cast<char*>(header.data());
+    iov[0].iov_len = header.size();
+    iov[1].iov_base = const_cast<char*>(payload.data());
+    iov[1].iov_len = payload.size();
+
+    msghdr msg{};
+    msg.msg_iov = iov.data();
+    msg.msg_iovlen = iov.size();
+
+    // Ignore errors; libevent reports them (unless the socket is just
+    // full) as part of writing the data we queue up below.
+    const auto nw = cb::net::sendmsg(socketDescriptor, &msg, 0);
+    const auto sent = nw > 0 ? size_t(nw) : 0;
+
+    const auto total = header.size() + payload.size();
+    totalSend += total;
+    auto* stats = get_thread_stats(this);
+    stats->bytes_written += total;
+    stats->direct_sends++;
+
+    // Queue whatever the socket didn't accept
+    if (sent < header.size()) {
+        if (bufferevent_write(bev.get(),
+                              header.data() + sent,
+                              header.size() - sent) == -1) {
+            throw std::bad_alloc();
+        }
+    }
+    if (sent < total) {
+        const auto offset = sent > header.size() ? sent - header.size() : 0;
+        if (evbuffer_add_reference(bufferevent_get_output(bev.get()),
+                                   payload.data() + offset,
+                                   payload.size() - offset,
+                                   sendbuffer_cleanup_cb,
+                                   sendbuffer.get()) == -1) {
+            throw std::bad_alloc();
+        }
+        // The callback (sendbuffer_cleanup_cb) frees the buffer
+        (void)sendbuffer.release();
+    }
+}
+
 cb::engine_errc Connection::add_packet_to_send_pipe(
         cb::const_byte_buffer packet) {
     try {
@@ -797,6 +797,34 @@ protected:
      */
     cb::engine_errc add_packet_to_send_pipe(cb::const_byte_buffer packet);
 
+    /**
+     * Format the response header (including the framing extras) for a
+     * response into the threads scratch buffer
+     *
+     * @return the header in the scratch buffer
+     */
+    cb::char_buffer formatResponseHeaders(Cookie& cookie,
+                                          cb::mcbp::Status status,
+                                          std::string_view extras,
+                                          std::string_view key,
+                                          std::size_t value_length,
+                                          uint8_t datatype);
+
+    /**
+     * Write the header and the payload of the send buffer directly to the
+     * socket with a single sendmsg call (avoiding libevent copying the
+     * header and allocating a chain for the payload). Whatever the socket
+     * can't accept right away is queued up in the output stream.
+     *
+     * Must only be used for plain sockets with an empty output stream.
+     *
+     * @param header the response header, extras and key
+     * @param sendbuffer the send buffer containing the value
+     * @throws std::bad_alloc if we failed to queue the remaining data
+     */
+    void sendToSocket(std::string_view header,
+                      std::unique_ptr<SendBuffer> sendbuffer);
+
     /**
      * Disable read event for this connection (we won't get notified if
      * more data arrives on the socket).
@@ -215,6 +215,44 @@ void Cookie::setAiostat(cb::engine_errc value) {
     aiostat = value;
 }
 
+void Cookie::beginNotificationBatch() {
+    notificationBatchStatus = cb::engine_errc::success;
+    pendingNotifications = NotificationBatchOpen;
+}
+
+void Cookie::addPendingNotification() {
+    pendingNotifications++;
+}
+
+cb::engine_errc Cookie::endNotificationBatch() {
+    if (pendingNotifications.fetch_sub(NotificationBatchOpen) !=
+        NotificationBatchOpen) {
+        return cb::engine_errc::would_block;
+    }
+    return notificationBatchStatus;
+}
+
+bool Cookie::completeNotification(cb::engine_errc& status) {
+    auto current = pendingNotifications.load();
+    do {
+        if (current == 0) {
+            // Not part of a batch
+            return true;
+        }
+    } while (!pendingNotifications.compare_exchange_weak(current,
+                                                         current - 1));
+
+    if (status != cb::engine_errc::success) {
+        auto expected = cb::engine_errc::success;
+        notificationBatchStatus.compare_exchange_strong(expected, status);
+    }
+    if (current - 1 != 0) {
+        return false;
+    }
+    status = notificationBatchStatus;
+    return true;
+}
+
 void Cookie::setEwouldblock(bool value) {
     if (value && !connection.isDCP()) {
         setAiostat(cb::engine_errc::would_block);
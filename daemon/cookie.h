@@ -24,6 +24,7 @@
 #include <memcached/tracer.h>
 #include <nlohmann/json.hpp>
 #include <platform/compression/buffer.h>
+#include <atomic>
 #include <chrono>
 
 // Forward decls
@@ -311,6 +312,42 @@ public:
      */
     void setEwouldblock(bool ewouldblock);
 
+    /**
+     * Commands which issue multiple engine operations before blocking
+     * (e.g. GetMulti) may have more than one of them return would_block,
+     * each of which results in a call to notify_io_complete. To only
+     * resume the command once all of them completed the command must:
+     *
+     *  1. call beginNotificationBatch() before issuing the operations
+     *  2. call addPendingNotification() for every operation which
+     *     returned would_block
+     *  3. call endNotificationBatch() once all operations are issued
+     *
+     * Only the last notification of the batch is delivered to the front
+     * end thread.
+     */
+    void beginNotificationBatch();
+    void addPendingNotification();
+
+    /**
+     * @return cb::engine_errc::would_block if there are notifications
+     *         outstanding (the command should block), otherwise the
+     *         status of the first failed notification in the batch (or
+     *         success if none failed)
+     */
+    cb::engine_errc endNotificationBatch();
+
+    /**
+     * Account for a notify_io_complete call for this cookie.
+     *
+     * @param status the status of the notification; updated to the status
+     *               of the first failed notification if this completes a
+     *               batch
+     * @return true if the notification should be delivered, false if it
+     *         is part of a notification batch which isn't complete yet
+     */
+    bool completeNotification(cb::engine_errc& status);
+
     /**
      *
      * @return
@@ -689,6 +726,16 @@ protected:
 
     bool ewouldblock = false;
 
+    /// Outstanding notifications of a notification batch (see
+    /// beginNotificationBatch()), plus NotificationBatchOpen while the
+    /// command is still issuing operations. Zero if there is no batch.
+    std::atomic<uint64_t> pendingNotifications{0};
+    static constexpr uint64_t NotificationBatchOpen = uint64_t(1) << 32;
+
+    /// The first failure reported by a notification in the current batch
+    std::atomic<cb::engine_errc> notificationBatchStatus{
+            cb::engine_errc::success};
+
     /// The number of times someone tried to reserve the cookie (to avoid
     /// releasing it while other parties think they reserved the object.
     /// Previously reserve would lock the connection, but with OOO we
@@ -18,7 +18,7 @@
 #pragma once
 
 #include "ssl_utils.h"
-#include <JSON_checker.h>
+#include "subdoc_lookup_cache.h"
 #include <event.h>
 #include <folly/Synchronized.h>
 #include <memcached/engine_error.h>
@@ -26,11 +26,14 @@
 #include <platform/sized_buffer.h>
 #include <platform/socket.h>
 #include <subdoc/operations.h>
+#include <utilities/json_validator.h>
 #include <array>
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -88,6 +91,9 @@ struct FrontEndThread {
                          in_port_t port,
                          uniqueSslPtr ssl);
 
+    /// Iterate over all of the front end threads
+    static void forEach(std::function<void(FrontEndThread&)> callback);
+
     /// Mutex to lock protect access to this object.
     std::mutex mutex;
 
@@ -118,11 +124,22 @@ struct FrontEndThread {
      */
     Subdoc::Operation subdoc_op;
 
+    /**
+     * Spare buffer for the sub-document operations of connections serviced
+     * by this thread to build the next version of a document in (see
+     * operate_single_doc()). Never expect anything about its content.
+     */
+    std::string subdoc_buffer;
+
+    /// Cached results of sub-document lookups by connections serviced by
+    /// this thread (if enabled by subdoc_lookup_cache_size)
+    SubdocLookupCache subdoc_lookup_cache;
+
     /**
      * Shared validator used by all connections serviced by this thread
      * when they need to validate a JSON document
      */
-    JSON_checker::Validator validator;
+    cb::json::Validator validator;
 
     /// Is the thread running or not
     std::atomic_bool running{false};
@@ -30,10 +30,12 @@
 #include <memcached/audit_interface.h>
 #include <memcached/isotime.h>
 #include <platform/string_hex.h>
+#include <utilities/logtags.h>
 
 #include <folly/Synchronized.h>
 #include <nlohmann/json.hpp>
 
+#include <cctype>
 #include <sstream>
 
 /// @returns the singleton audit handle.
@@ -305,6 +307,10 @@ void addSessionTerminated(const Connection& c) {
 namespace document {
 
 void add(const Cookie& cookie, Operation operation) {
+    add(cookie, operation, cookie.getRequestKey());
+}
+
+void add(const Cookie& cookie, Operation operation, const DocKey& key) {
     uint32_t id = 0;
     switch (operation) {
     case Operation::Read:
@@ -334,8 +340,15 @@ void add(const Cookie& cookie, Operation operation) {
     auto root = create_memcached_audit_object(connection,
                                               cookie.getEffectiveUser());
     root["bucket"] = connection.getBucket().name;
-    root["collection_id"] = cookie.getPrintableRequestCollectionID();
-    root["key"] = cookie.getPrintableRequestKey();
+    root["collection_id"] = key.getCollectionID().to_string();
+    std::string printableKey{reinterpret_cast<const char*>(key.data()),
+                             key.size()};
+    for (auto& ii : printableKey) {
+        if (!std::isgraph(ii)) {
+            ii = '.';
+        }
+    }
+    root["key"] = cb::tagUserData(printableKey);
 
     switch (operation) {
     case Operation::Read:
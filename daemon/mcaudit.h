@@ -24,6 +24,7 @@
 
 class Cookie;
 class Connection;
+struct DocKey;
 class StatCollector;
 
 /**
@@ -114,6 +115,10 @@ namespace document {
 enum class Operation;
 
 void add(const Cookie& c, Operation operation);
+
+/// Add an audit event for an operation on the given document (for commands
+/// operating on documents other than the request key)
+void add(const Cookie& c, Operation operation, const DocKey& key);
 } // namespace document
 } // namespace cb::audit
 
@@ -78,6 +78,9 @@ McbpPrivilegeChains::McbpPrivilegeChains() {
     setup(cb::mcbp::ClientOpcode::Getq, require<Privilege::Read>);
     setup(cb::mcbp::ClientOpcode::Getk, require<Privilege::Read>);
     setup(cb::mcbp::ClientOpcode::Getkq, require<Privilege::Read>);
+    // The keys may be in different collections; the privilege is checked
+    // for each of them by the command
+    setup(cb::mcbp::ClientOpcode::GetMulti, empty);
     setup(cb::mcbp::ClientOpcode::GetFailoverLog, require<Privilege::Read>);
     setup(cb::mcbp::ClientOpcode::Set, require<Privilege::Upsert>);
     setup(cb::mcbp::ClientOpcode::Setq, require<Privilege::Upsert>);
@@ -43,8 +43,10 @@ static bool is_valid_xattr_blob(Cookie& cookie,
 }
 
 bool is_document_key_valid(Cookie& cookie) {
-    const auto& req = cookie.getRequest();
-    const auto& key = req.getKey();
+    return is_document_key_valid(cookie, cookie.getRequest().getKey());
+}
+
+bool is_document_key_valid(Cookie& cookie, cb::const_byte_buffer key) {
     if (!cookie.getConnection().isCollectionsSupported()) {
         return true;
     }
@@ -1279,6 +1281,49 @@ static Status get_validator(Cookie& cookie) {
     return Status::Success;
 }
 
+static Status get_multi_validator(Cookie& cookie) {
+    auto status = McbpValidator::verify_header(cookie,
+                                               0,
+                                               ExpectedKeyLen::Zero,
+                                               ExpectedValueLen::NonZero,
+                                               ExpectedCas::NotSet,
+                                               PROTOCOL_BINARY_RAW_BYTES);
+    if (status != Status::Success) {
+        return status;
+    }
+
+    using cb::mcbp::request::GetMultiKeySpec;
+    const auto maxKeyLen = cookie.getConnection().isCollectionsSupported()
+                                   ? MaxCollectionsKeyLen
+                                   : KEY_MAX_LENGTH;
+    auto value = cookie.getRequest().getValue();
+    while (!value.empty()) {
+        if (value.size() < sizeof(GetMultiKeySpec)) {
+            cookie.setErrorContext("Truncated key specification");
+            return Status::Einval;
+        }
+        const auto& spec =
+                *reinterpret_cast<const GetMultiKeySpec*>(value.data());
+        value = {value.data() + sizeof(spec), value.size() - sizeof(spec)};
+        const auto keylen = spec.getKeylen();
+        if (keylen == 0 || keylen > maxKeyLen) {
+            cookie.setErrorContext("Invalid key length: " +
+                                   std::to_string(keylen));
+            return Status::Einval;
+        }
+        if (keylen > value.size()) {
+            cookie.setErrorContext("Key exceeds the value");
+            return Status::Einval;
+        }
+        if (!is_document_key_valid(cookie, {value.data(), keylen})) {
+            return Status::Einval;
+        }
+        value = {value.data() + keylen, value.size() - keylen};
+    }
+
+    return Status::Success;
+}
+
 static Status gat_validator(Cookie& cookie) {
     auto status =
             McbpValidator::verify_header(cookie,
@@ -2358,6 +2403,7 @@ McbpValidator::McbpValidator() {
           collections_get_id_validator);
     setup(cb::mcbp::ClientOpcode::CollectionsGetScopeID,
           collections_get_id_validator); // same rules as GetID
+    setup(cb::mcbp::ClientOpcode::GetMulti, get_multi_validator);
     setup(cb::mcbp::ClientOpcode::AdjustTimeofday, adjust_timeofday_validator);
     setup(cb::mcbp::ClientOpcode::EwouldblockCtl, ewb_validator);
     setup(cb::mcbp::ClientOpcode::GetRandomKey, get_random_key_validator);
@@ -23,6 +23,7 @@
 #include <mcbp/protocol/datatype.h>
 #include <mcbp/protocol/opcode.h>
 #include <mcbp/protocol/status.h>
+#include <platform/sized_buffer.h>
 #include <array>
 #include <functional>
 
@@ -75,3 +76,12 @@ protected:
  * @return true if the keylen represents a valid key for the connection
  */
 bool is_document_key_valid(Cookie& cookie);
+
+/**
+ * Validate a key (other than the request key) for operations which will
+ * create a DocKey
+ * @param cookie non const reference as failure will update the error context
+ * @param key the key to validate
+ * @return true if the key is a valid key for the connection
+ */
+bool is_document_key_valid(Cookie& cookie, cb::const_byte_buffer key);
@@ -1501,15 +1501,18 @@ int memcached_main(int argc, char** argv) {
     }
 #endif
 
-    networkInterfaceManager =
-            std::make_unique<NetworkInterfaceManager>(main_base);
-
     /* start up worker threads if MT mode */
     worker_threads_init();
 
     executorPool = std::make_unique<cb::ExecutorPool>(
             Settings::instance().getNumWorkerThreads());
 
+    // The worker threads (and the executor they use) must be running before
+    // we create the listening sockets as they may accept clients from their
+    // own sockets (see reuseport_listeners)
+    networkInterfaceManager =
+            std::make_unique<NetworkInterfaceManager>(main_base);
+
     LOG_INFO(R"(Starting Phosphor tracing with config: "{}")",
              Settings::instance().getPhosphorConfig());
     initializeTracing(Settings::instance().getPhosphorConfig(),
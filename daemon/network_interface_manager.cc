@@ -27,6 +27,7 @@
 #include <nlohmann/json.hpp>
 #include <platform/dirutils.h>
 #include <platform/strerror.h>
+#include <cstring>
 
 namespace cb::prometheus {
 // forward declaration
@@ -382,6 +383,69 @@ static SOCKET new_server_socket(struct addrinfo* ai) {
     return sfd;
 }
 
+bool NetworkInterfaceManager::useReuseportListeners() const {
+#ifdef __linux__
+    // Linux distributes the incoming connections across all of the sockets
+    // bound to the same address with SO_REUSEPORT
+    return Settings::instance().isReuseportListenersEnabled();
+#else
+    return false;
+#endif
+}
+
+std::unique_ptr<ServerSocket> NetworkInterfaceManager::createReuseportListeners(
+        SOCKET sfd,
+        addrinfo* ai,
+        in_port_t port,
+        std::shared_ptr<ListeningPort> descr) {
+    std::vector<FrontEndThread*> workers;
+    FrontEndThread::forEach(
+            [&workers](FrontEndThread& thr) { workers.push_back(&thr); });
+    if (workers.empty()) {
+        throw std::logic_error(
+                "NetworkInterfaceManager::createReuseportListeners: the "
+                "front end threads must be created first");
+    }
+
+    // The first socket is already bound (and holds the port number if an
+    // ephemeral port was requested). Bind one more socket to the same
+    // address for each of the other threads.
+    auto ret = std::make_unique<ServerSocket>(
+            sfd, workers.front()->base, descr, workers.front());
+
+    sockaddr_storage addr{};
+    std::memcpy(&addr, ai->ai_addr, ai->ai_addrlen);
+    if (ai->ai_family == AF_INET) {
+        reinterpret_cast<sockaddr_in*>(&addr)->sin_port = htons(port);
+    } else {
+        reinterpret_cast<sockaddr_in6*>(&addr)->sin6_port = htons(port);
+    }
+
+    for (auto iter = workers.begin() + 1; iter != workers.end(); ++iter) {
+        auto shard = new_server_socket(ai);
+        if (shard == INVALID_SOCKET) {
+            LOG_WARNING("Failed to create listen socket for worker {}",
+                        (*iter)->index);
+            continue;
+        }
+        if (bind(shard,
+                 reinterpret_cast<sockaddr*>(&addr),
+                 socklen_t(ai->ai_addrlen)) == SOCKET_ERROR) {
+            LOG_WARNING("Failed to bind listen socket for worker {} to {}: {}",
+                        (*iter)->index,
+                        cb::net::to_string(&addr, socklen_t(ai->ai_addrlen)),
+                        cb_strerror(cb::net::get_socket_error()));
+            safe_close(shard);
+            continue;
+        }
+        ret->addShard(std::make_unique<ServerSocket>(
+                shard, (*iter)->base, descr, *iter));
+        stats.curr_conns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return ret;
+}
+
 bool NetworkInterfaceManager::createInterface(const std::string& tag,
                                               const std::string& host,
                                               in_port_t port,
@@ -511,8 +575,13 @@ bool NetworkInterfaceManager::createInterface(const std::string& tag,
                                                      system_port,
                                                      sslkey,
                                                      sslcert);
-        listen_conn.emplace_back(std::make_unique<ServerSocket>(
-                sfd, event_get_base(event.get()), inter));
+        if (useReuseportListeners()) {
+            listen_conn.emplace_back(
+                    createReuseportListeners(sfd, next, listenport, inter));
+        } else {
+            listen_conn.emplace_back(std::make_unique<ServerSocket>(
+                    sfd, event_get_base(event.get()), inter));
+        }
         stats.curr_conns.fetch_add(1, std::memory_order_relaxed);
     }
 
@@ -72,6 +72,30 @@ protected:
                          NetworkInterface::Protocol iv4,
                          NetworkInterface::Protocol iv6);
 
+    /**
+     * Should each front end thread have its own listening socket for the
+     * interfaces (see Settings::isReuseportListenersEnabled())
+     */
+    bool useReuseportListeners() const;
+
+    /**
+     * Create a listening socket for each of the front end threads, all
+     * bound to the same address with SO_REUSEPORT so that the kernel
+     * distributes the new connections across the threads.
+     *
+     * @param sfd The socket already bound to the address (used by the
+     *            first front end thread)
+     * @param ai The address the socket is bound to
+     * @param port The port the socket is bound to
+     * @param descr The description of the interface
+     * @return The server socket owning all of the listening sockets
+     */
+    std::unique_ptr<ServerSocket> createReuseportListeners(
+            SOCKET sfd,
+            addrinfo* ai,
+            in_port_t port,
+            std::shared_ptr<ListeningPort> descr);
+
     /// The event handler called from libevent
     void event_handler();
 
@@ -64,7 +64,7 @@ static std::pair<cb::engine_errc, Hdr1sfMicroSecHistogram> get_timings(
         }
     }
 
-    auto* histo = bucket.timings.get_timing_histogram(opcode);
+    auto histo = bucket.timings.get_timing_histogram(opcode);
     if (histo) {
         return {cb::engine_errc::success, *histo};
     } else {
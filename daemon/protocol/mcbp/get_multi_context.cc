@@ -0,0 +1,284 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#include "get_multi_context.h"
+
+#include "engine_wrapper.h"
+
+#include <daemon/buckets.h>
+#include <daemon/mcaudit.h>
+#include <daemon/memcached.h>
+#include <daemon/sendbuffer.h>
+#include <daemon/stats.h>
+#include <logger/logger.h>
+#include <memcached/protocol_binary.h>
+#include <utilities/engine_errc_2_mcbp.h>
+#include <xattr/utils.h>
+#include <gsl/gsl>
+
+GetMultiCommandContext::GetMultiCommandContext(Cookie& cookie)
+    : SteppableCommandContext(cookie) {
+    using cb::mcbp::request::GetMultiKeySpec;
+    // The value is verified by get_multi_validator
+    const auto value = cookie.getRequest().getValue();
+    size_t offset = 0;
+    while (offset < value.size()) {
+        const auto& spec = *reinterpret_cast<const GetMultiKeySpec*>(
+                value.data() + offset);
+        offset += sizeof(spec);
+        entries.push_back({spec.getVBucket(),
+                           gsl::narrow_cast<uint32_t>(offset),
+                           spec.getKeylen()});
+        offset += spec.getKeylen();
+    }
+    remaining = entries.size();
+}
+
+std::string_view GetMultiCommandContext::getKey(const Entry& entry) const {
+    // Look up the value every time as the request may be copied if the
+    // command blocks
+    const auto value = cookie.getRequest().getValue();
+    return {reinterpret_cast<const char*>(value.data()) + entry.offset,
+            entry.keylen};
+}
+
+cb::engine_errc GetMultiCommandContext::checkPrivileges() {
+    const bool scopePrivileges =
+            cookie.getPrivilegeContext().hasScopePrivileges();
+    for (auto& entry : entries) {
+        const auto key = connection.makeDocKey(
+                {reinterpret_cast<const uint8_t*>(getKey(entry).data()),
+                 entry.keylen});
+
+        auto access = cb::rbac::PrivilegeAccessOk;
+        if (!scopePrivileges) {
+            access = cookie.testPrivilege(cb::rbac::Privilege::Read, {}, {});
+        } else if (key.getCollectionID().isDefaultCollection()) {
+            access = cookie.testPrivilege(cb::rbac::Privilege::Read,
+                                          ScopeID{ScopeID::Default},
+                                          key.getCollectionID());
+        } else {
+            // Same as the validator does for single key commands; we need
+            // the scope of the collection to check the privilege
+            auto res = connection.getBucket().getEngine().get_scope_id(
+                    &cookie, key, entry.vbucket);
+            if (res.result != cb::engine_errc::success) {
+                auto ret = sendError(entry, res.result);
+                if (ret != cb::engine_errc::success) {
+                    return ret;
+                }
+                continue;
+            }
+            access = cookie.testPrivilege(cb::rbac::Privilege::Read,
+                                          res.getScopeId(),
+                                          key.getCollectionID());
+        }
+
+        auto status = cb::engine_errc::success;
+        switch (access.getStatus()) {
+        case cb::rbac::PrivilegeAccess::Status::Ok:
+            break;
+        case cb::rbac::PrivilegeAccess::Status::Fail:
+            status = cb::engine_errc::no_access;
+            break;
+        case cb::rbac::PrivilegeAccess::Status::FailNoPrivileges:
+            status = cb::engine_errc::unknown_collection;
+            break;
+        }
+        if (status != cb::engine_errc::success) {
+            auto ret = sendError(entry, status);
+            if (ret != cb::engine_errc::success) {
+                return ret;
+            }
+        }
+    }
+
+    state = State::GetItems;
+    return cb::engine_errc::success;
+}
+
+cb::engine_errc GetMultiCommandContext::getItems() {
+    // Issue all of the gets before blocking; the engine notifies once for
+    // every get returning would_block and we want to resume when the last
+    // of them completes.
+    auto failure = cb::engine_errc::success;
+    cookie.beginNotificationBatch();
+    try {
+        for (auto& entry : entries) {
+            if (entry.done) {
+                continue;
+            }
+
+            const auto key = getKey(entry);
+            auto ret = bucket_get(
+                    cookie,
+                    connection.makeDocKey(
+                            {reinterpret_cast<const uint8_t*>(key.data()),
+                             key.size()}),
+                    entry.vbucket);
+            auto status = cb::engine_errc::success;
+            switch (ret.first) {
+            case cb::engine_errc::would_block:
+                cookie.addPendingNotification();
+                break;
+            case cb::engine_errc::success:
+                status = sendDocument(entry, std::move(ret.second));
+                break;
+            default:
+                status = sendError(entry, ret.first);
+            }
+
+            if (status != cb::engine_errc::success) {
+                failure = status;
+                break;
+            }
+        }
+    } catch (...) {
+        cookie.endNotificationBatch();
+        throw;
+    }
+
+    const auto status = cookie.endNotificationBatch();
+    if (failure != cb::engine_errc::success) {
+        if (status == cb::engine_errc::would_block) {
+            // The engine will notify the cookie for the gets it blocked on,
+            // so we can't fail the command (and move on to the next, or
+            // close the connection) until all of them completed.
+            error = failure;
+            state = State::Failed;
+        }
+        return status == cb::engine_errc::would_block ? status : failure;
+    }
+    if (status != cb::engine_errc::success) {
+        // would_block, or one of the background fetches failed
+        return status;
+    }
+
+    if (remaining == 0) {
+        cookie.sendResponse(cb::mcbp::Status::Success);
+        state = State::Done;
+    }
+    return cb::engine_errc::success;
+}
+
+cb::engine_errc GetMultiCommandContext::sendDocument(Entry& entry,
+                                                     cb::unique_item_ptr it) {
+    item_info info;
+    if (!bucket_get_item_info(connection, it.get(), &info)) {
+        LOG_WARNING("{}: Failed to get item info", connection.getId());
+        return cb::engine_errc::failed;
+    }
+
+    std::string_view payload{static_cast<const char*>(info.value[0].iov_base),
+                             info.value[0].iov_len};
+    cb::compression::Buffer buffer;
+    if (mcbp::datatype::is_snappy(info.datatype) &&
+        (mcbp::datatype::is_xattr(info.datatype) ||
+         !connection.isSnappyEnabled())) {
+        try {
+            if (!cookie.inflateSnappy(payload, buffer)) {
+                LOG_WARNING("{}: Failed to inflate item", connection.getId());
+                return cb::engine_errc::failed;
+            }
+        } catch (const std::bad_alloc&) {
+            return cb::engine_errc::no_memory;
+        }
+        payload = buffer;
+        info.datatype &= ~PROTOCOL_BINARY_DATATYPE_SNAPPY;
+    }
+
+    if (mcbp::datatype::is_xattr(info.datatype)) {
+        payload = cb::xattr::get_body(payload);
+        info.datatype &= ~PROTOCOL_BINARY_DATATYPE_XATTR;
+    }
+    info.datatype = connection.getEnabledDatatypes(info.datatype);
+
+    std::unique_ptr<SendBuffer> sendbuffer;
+    if (payload.size() > SendBuffer::MinimumDataSize) {
+        // Chain the document into the output stream instead of copying it,
+        // so that all of the responses of the batch go out in one write
+        if (buffer.empty()) {
+            sendbuffer = std::make_unique<ItemSendBuffer>(
+                    std::move(it), payload, connection.getBucket());
+        } else {
+            sendbuffer =
+                    std::make_unique<CompressionSendBuffer>(buffer, payload);
+        }
+    }
+
+    cookie.setCas(info.cas);
+    connection.sendResponse(
+            cookie,
+            cb::mcbp::Status::Success,
+            {reinterpret_cast<const char*>(&info.flags), sizeof(info.flags)},
+            getKey(entry),
+            payload,
+            info.datatype,
+            std::move(sendbuffer));
+
+    cb::audit::document::add(
+            cookie, cb::audit::document::Operation::Read, info.key);
+    STATS_HIT(&connection, get);
+
+    entry.done = true;
+    --remaining;
+    return cb::engine_errc::success;
+}
+
+cb::engine_errc GetMultiCommandContext::sendError(Entry& entry,
+                                                  cb::engine_errc error) {
+    if (error == cb::engine_errc::no_such_key) {
+        STATS_MISS(&connection, get);
+    }
+
+    error = connection.remapErrorCode(error);
+    if (error == cb::engine_errc::disconnect) {
+        return error;
+    }
+
+    cookie.setCas(0);
+    connection.sendResponse(cookie,
+                            cb::mcbp::to_status(error),
+                            {},
+                            getKey(entry),
+                            {},
+                            PROTOCOL_BINARY_RAW_BYTES,
+                            {});
+
+    entry.done = true;
+    --remaining;
+    return cb::engine_errc::success;
+}
+
+cb::engine_errc GetMultiCommandContext::step() {
+    auto ret = cb::engine_errc::success;
+    do {
+        switch (state) {
+        case State::CheckPrivileges:
+            ret = checkPrivileges();
+            break;
+        case State::GetItems:
+            ret = getItems();
+            break;
+        case State::Failed:
+            return error;
+        case State::Done:
+            return cb::engine_errc::success;
+        }
+    } while (ret == cb::engine_errc::success);
+
+    return ret;
+}
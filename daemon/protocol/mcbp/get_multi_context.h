@@ -0,0 +1,103 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#pragma once
+
+#include "steppable_command_context.h"
+
+#include <daemon/cookie.h>
+#include <memcached/engine.h>
+#include <vector>
+
+/**
+ * The GetMultiCommandContext is a state machine used by the memcached
+ * core to implement the GetMulti operation: fetch a number of documents
+ * (each in its own vbucket, and possibly collection) with a single request.
+ *
+ * All of the (remaining) documents are requested from the engine before
+ * the command blocks, so the engine may fetch all of the non-resident ones
+ * from disk as one batch rather than one after another. The response for
+ * each document is sent as soon as it is available, and once all of them
+ * are sent the command completes with a response without a key.
+ */
+class GetMultiCommandContext : public SteppableCommandContext {
+public:
+    // The internal states. Look at the function headers below to
+    // for the functions with the same name to figure out what each
+    // state does
+    enum class State : uint8_t { CheckPrivileges, GetItems, Failed, Done };
+
+    explicit GetMultiCommandContext(Cookie& cookie);
+
+protected:
+    cb::engine_errc step() override;
+
+    /**
+     * Check that the connection may read each of the requested documents,
+     * and send an error response for those it may not.
+     *
+     * @return cb::engine_errc::success to progress to State::GetItems
+     */
+    cb::engine_errc checkPrivileges();
+
+    /**
+     * Request all of the documents which isn't sent yet from the engine,
+     * and send the response for those which the engine returned (or failed
+     * to return). The state stays in State::GetItems until all documents
+     * are sent.
+     *
+     * If the command fails while the engine is still to notify the
+     * completion of gets which blocked, the error is kept and the state
+     * moves to State::Failed to return it once all of them completed.
+     *
+     * @return cb::engine_errc::would_block if the engine blocked for any of
+     *         the documents, cb::engine_errc::success to continue running
+     *         the state machine, or the error for the command
+     */
+    cb::engine_errc getItems();
+
+private:
+    /// A document requested by the client
+    struct Entry {
+        Vbid vbucket;
+        /// The offset of the key in the request value
+        uint32_t offset;
+        uint16_t keylen;
+        /// Set once the response for the document is sent
+        bool done = false;
+    };
+
+    /// @return the key of the entry as sent by the client
+    std::string_view getKey(const Entry& entry) const;
+
+    /**
+     * Send the response for a document returned by the engine (inflating
+     * and stripping off xattrs as needed).
+     */
+    cb::engine_errc sendDocument(Entry& entry, cb::unique_item_ptr it);
+
+    /**
+     * Send the response for a document the engine failed to return.
+     */
+    cb::engine_errc sendError(Entry& entry, cb::engine_errc error);
+
+    std::vector<Entry> entries;
+    /// The number of entries which isn't done yet
+    size_t remaining = 0;
+    /// The error to fail the command with in State::Failed
+    cb::engine_errc error = cb::engine_errc::success;
+    State state = State::CheckPrivileges;
+};
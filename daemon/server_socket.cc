@@ -17,6 +17,7 @@
 
 #include "server_socket.h"
 
+#include "connections.h"
 #include "front_end_thread.h"
 #include "listening_port.h"
 #include "memcached.h"
@@ -43,6 +44,12 @@ void ServerSocket::listen_event_handler(evutil_socket_t, short, void* arg) {
     auto& c = *reinterpret_cast<ServerSocket*>(arg);
 
     if (is_memcached_shutting_down()) {
+        if (c.owner) {
+            // The event base belongs to a front end thread which stops
+            // by itself; just stop accepting new connections
+            event_del(c.ev.get());
+            return;
+        }
         // Someone requested memcached to shut down. The listen thread should
         // be stopped immediately to avoid new connections
         LOG_INFO("Stopping listen thread");
@@ -61,11 +68,13 @@ void ServerSocket::listen_event_handler(evutil_socket_t, short, void* arg) {
 
 ServerSocket::ServerSocket(SOCKET fd,
                            event_base* b,
-                           std::shared_ptr<ListeningPort> interf)
+                           std::shared_ptr<ListeningPort> interf,
+                           FrontEndThread* owner)
     : sfd(fd),
       uuid(to_string(cb::uuid::random())),
       interface(std::move(interf)),
       sockname(cb::net::getsockname(fd)),
+      owner(owner),
       ev(event_new(b,
                    sfd,
                    EV_READ | EV_PERSIST,
@@ -79,11 +88,16 @@ ServerSocket::ServerSocket(SOCKET fd,
     if (!interface->tag.empty()) {
         tagstr = " \"" + interface->tag + "\"";
     }
-    LOG_INFO("{} Listen on IPv{}{}: {}",
+    std::string threadstr;
+    if (owner) {
+        threadstr = " (worker " + std::to_string(owner->index) + ")";
+    }
+    LOG_INFO("{} Listen on IPv{}{}: {}{}",
              sfd,
              interface->family == AF_INET ? "4" : "6",
              tagstr,
-             sockname);
+             sockname,
+             threadstr);
     if (cb::net::listen(sfd, backlog) == SOCKET_ERROR) {
         LOG_WARNING("{}: Failed to listen on {}: {}",
                     sfd,
@@ -99,6 +113,8 @@ ServerSocket::ServerSocket(SOCKET fd,
 }
 
 ServerSocket::~ServerSocket() {
+    shards.clear();
+
     std::string tagstr;
     if (!interface->tag.empty()) {
         tagstr = " \"" + interface->tag + "\"";
@@ -118,7 +134,16 @@ ServerSocket::~ServerSocket() {
     numInstances--;
 }
 
+void ServerSocket::addShard(std::unique_ptr<ServerSocket> shard) {
+    shards.emplace_back(std::move(shard));
+}
+
 void ServerSocket::acceptNewClient() {
+    // The interface description may be replaced by updateSSL (which
+    // runs in the dispatcher thread) while a front end thread accepts
+    // clients
+    const auto interface = std::atomic_load(&this->interface);
+
     sockaddr_storage addr{};
     socklen_t addrlen = sizeof(addr);
     auto client = cb::net::accept(
@@ -194,6 +219,22 @@ void ServerSocket::acceptNewClient() {
         return;
     }
 
+    if (owner) {
+        // We're running in the front end thread which should serve the
+        // client; no need to go through the dispatcher
+        if (conn_new(client,
+                     *owner,
+                     interface->system,
+                     interface->port,
+                     std::move(ssl)) == nullptr) {
+            if (interface->system) {
+                --stats.system_conns;
+            }
+            safe_close(client);
+        }
+        return;
+    }
+
     FrontEndThread::dispatch(
             client, interface->system, interface->port, std::move(ssl));
 }
@@ -236,11 +277,15 @@ void ServerSocket::updateSSL(const std::string& key, const std::string& cert) {
         ss << " (" << interface->tag << ")";
     }
     LOG_INFO(ss.str());
-    interface = std::make_shared<ListeningPort>(interface->tag,
-                                                interface->host,
-                                                interface->port,
-                                                interface->family,
-                                                interface->system,
-                                                key,
-                                                cert);
+    std::atomic_store(&interface,
+                      std::make_shared<ListeningPort>(interface->tag,
+                                                      interface->host,
+                                                      interface->port,
+                                                      interface->family,
+                                                      interface->system,
+                                                      key,
+                                                      cert));
+    for (auto& shard : shards) {
+        std::atomic_store(&shard->interface, interface);
+    }
 }
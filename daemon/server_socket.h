@@ -21,9 +21,11 @@
 #include <platform/socket.h>
 #include <atomic>
 #include <memory>
+#include <vector>
 
 class ListeningPort;
 class NetworkInterface;
+struct FrontEndThread;
 
 /**
  * The ServerSocket represents the socket used to accept new clients.
@@ -39,10 +41,14 @@ public:
      * @param sfd The socket to operate on
      * @param b The event base to use (the caller owns the event base)
      * @param interf The interface object containing properties to use
+     * @param owner The front end thread running the event base, which
+     *              should serve the accepted clients. If not set the
+     *              clients are dispatched to the front end threads.
      */
     ServerSocket(SOCKET sfd,
                  event_base* b,
-                 std::shared_ptr<ListeningPort> interf);
+                 std::shared_ptr<ListeningPort> interf,
+                 FrontEndThread* owner = nullptr);
 
     ~ServerSocket();
 
@@ -59,6 +65,14 @@ public:
         return *interface;
     }
 
+    /**
+     * Add another listening socket bound to the same address (with
+     * SO_REUSEPORT), owned by a different front end thread. The shards
+     * share the interface description with this object and are closed
+     * when this object is destroyed.
+     */
+    void addShard(std::unique_ptr<ServerSocket> shard);
+
     /// Update the interface description to use the provided SSL info
     void updateSSL(const std::string& key, const std::string& cert);
 
@@ -92,9 +106,15 @@ protected:
     /// The backlog to specify to bind
     const int backlog = 1024;
 
+    /// The front end thread accepting the clients (if not dispatched)
+    FrontEndThread* const owner;
+
     /// The libevent object we're using
     cb::libevent::unique_event_ptr ev;
 
+    /// The other sockets bound to the same address (see addShard())
+    std::vector<std::unique_ptr<ServerSocket>> shards;
+
     /// The notification handler registered in libevent
     static void listen_event_handler(evutil_socket_t, short, void* arg);
 
@@ -239,6 +239,19 @@ static void handle_stdin_listener(Settings& s, const nlohmann::json& obj) {
     s.setStdinListenerEnabled(obj.get<bool>());
 }
 
+/**
+ * Handle the "reuseport_listeners" tag in the settings
+ *
+ *  The value must be a boolean value
+ *
+ * @param s the settings object to update
+ * @param obj the object in the configuration
+ */
+static void handle_reuseport_listeners(Settings& s,
+                                       const nlohmann::json& obj) {
+    s.setReuseportListenersEnabled(obj.get<bool>());
+}
+
 /**
  * Handle "default_reqs_per_event", "reqs_per_event_high_priority",
  * "reqs_per_event_med_priority" and "reqs_per_event_low_priority" tag in
@@ -455,6 +468,15 @@ static void handle_max_send_queue_size(Settings& s, const nlohmann::json& obj) {
     s.setMaxSendQueueSize(obj.get<size_t>() * 1024 * 1024);
 }
 
+static void handle_subdoc_lookup_cache_size(Settings& s,
+                                            const nlohmann::json& obj) {
+    if (!obj.is_number_unsigned()) {
+        cb::throwJsonTypeError(
+                R"("subdoc_lookup_cache_size" must be an unsigned number)");
+    }
+    s.setSubdocLookupCacheSize(obj.get<size_t>());
+}
+
 static void handle_max_connections(Settings& s, const nlohmann::json& obj) {
     if (!obj.is_number_unsigned()) {
         cb::throwJsonTypeError(
@@ -757,11 +779,13 @@ void Settings::reconfigure(const nlohmann::json& json) {
             {"breakpad", handle_breakpad},
             {"max_packet_size", handle_max_packet_size},
             {"max_send_queue_size", handle_max_send_queue_size},
+            {"subdoc_lookup_cache_size", handle_subdoc_lookup_cache_size},
             {"max_connections", handle_max_connections},
             {"system_connections", handle_system_connections},
             {"sasl_mechanisms", handle_sasl_mechanisms},
             {"ssl_sasl_mechanisms", handle_ssl_sasl_mechanisms},
             {"stdin_listener", handle_stdin_listener},
+            {"reuseport_listeners", handle_reuseport_listeners},
             {"dedupe_nmvb_maps", handle_dedupe_nmvb_maps},
             {"xattr_enabled", handle_xattr_enabled},
             {"client_cert_auth", handle_client_cert_auth},
@@ -852,6 +876,13 @@ void Settings::updateSettings(const Settings& other, bool apply) {
         }
     }
 
+    if (other.has.reuseport_listeners) {
+        if (other.reuseport_listeners.load() != reuseport_listeners.load()) {
+            throw std::invalid_argument(
+                    "reuseport_listeners can't be changed dynamically");
+        }
+    }
+
     if (other.has.logger) {
         if (other.logger_settings != logger_settings)
             throw std::invalid_argument(
@@ -981,6 +1012,14 @@ void Settings::updateSettings(const Settings& other, bool apply) {
             setMaxSendQueueSize(other.max_send_queue_size);
         }
     }
+    if (other.has.subdoc_lookup_cache_size) {
+        if (other.subdoc_lookup_cache_size != subdoc_lookup_cache_size) {
+            LOG_INFO("Change subdoc lookup cache size from {} to {}",
+                     subdoc_lookup_cache_size.load(),
+                     other.subdoc_lookup_cache_size.load());
+            setSubdocLookupCacheSize(other.subdoc_lookup_cache_size);
+        }
+    }
 
     if (other.has.ssl_cipher_list) {
         std::string his = *other.ssl_cipher_list.rlock();
@@ -190,6 +190,28 @@ public:
         notify_changed("stdin_listener");
     }
 
+    /**
+     * Should each front end thread have its own listening socket (bound
+     * with SO_REUSEPORT to the same address) for every interface, and
+     * accept the clients connecting to it?
+     *
+     * @return true if enabled, false otherwise
+     */
+    bool isReuseportListenersEnabled() const {
+        return reuseport_listeners.load();
+    }
+
+    /**
+     * Set if each front end thread should have its own listening sockets
+     *
+     * @param enabled the new value
+     */
+    void setReuseportListenersEnabled(bool enabled) {
+        reuseport_listeners.store(enabled);
+        has.reuseport_listeners = true;
+        notify_changed("reuseport_listeners");
+    }
+
     cb::logger::Config getLoggerConfig() const {
         auto config = logger_settings;
         // log_level is synthesised from settings.verbose.
@@ -482,6 +504,26 @@ public:
         notify_changed("max_send_queue_size");
     }
 
+    /**
+     * Get the number of documents each front end thread caches the results
+     * of sub-document lookups for (0 means disabled)
+     */
+    size_t getSubdocLookupCacheSize() const {
+        return subdoc_lookup_cache_size.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Set the number of documents each front end thread caches the results
+     * of sub-document lookups for
+     *
+     * @param size the new number of documents (0 disables the cache)
+     */
+    void setSubdocLookupCacheSize(size_t size) {
+        subdoc_lookup_cache_size.store(size, std::memory_order_release);
+        has.subdoc_lookup_cache_size = true;
+        notify_changed("subdoc_lookup_cache_size");
+    }
+
     /**
      * Get the list of SSL ciphers to use for TLS < 1.3
      *
@@ -932,6 +974,11 @@ protected:
     /// limit is set to 40MB (2x the max document size)
     std::atomic<size_t> max_send_queue_size{40 * 1024 * 1024};
 
+    /// The number of documents each front end thread caches the results of
+    /// sub-document lookups for (see SubdocLookupCache). Disabled (0) by
+    /// default.
+    std::atomic<size_t> subdoc_lookup_cache_size{0};
+
     /// The SSL cipher list to use for TLS < 1.3
     folly::Synchronized<std::string> ssl_cipher_list;
 
@@ -1001,6 +1048,12 @@ protected:
      */
     std::atomic_bool stdin_listener{true};
 
+    /**
+     * Let each front end thread accept clients from its own listening
+     * socket (instead of a single socket served by the dispatcher)
+     */
+    std::atomic_bool reuseport_listeners{false};
+
     /**
      * Should we allow for using the external authentication service or not
      */
@@ -1078,6 +1131,7 @@ public:
         bool breakpad = false;
         bool max_packet_size = false;
         bool max_send_queue_size = false;
+        bool subdoc_lookup_cache_size = false;
         bool ssl_cipher_list = false;
         bool ssl_cipher_order = false;
         bool ssl_cipher_suites = false;
@@ -1094,6 +1148,7 @@ public:
         bool topkeys_enabled = false;
         bool tracing_enabled = false;
         bool stdin_listener = false;
+        bool reuseport_listeners = false;
         bool scramsha_fallback_salt = false;
         bool external_auth_service = false;
         bool active_external_users_push_interval = false;
@@ -567,6 +567,29 @@ TEST_F(SettingsTest, ParseLoggerSettings) {
     EXPECT_EQ(true, config.unit_test);
 }
 
+TEST_F(SettingsTest, ReuseportListeners) {
+    nonBooleanValuesShouldFail("reuseport_listeners");
+
+    nlohmann::json obj;
+    obj["reuseport_listeners"] = true;
+    try {
+        Settings settings(obj);
+        EXPECT_TRUE(settings.isReuseportListenersEnabled());
+        EXPECT_TRUE(settings.has.reuseport_listeners);
+    } catch (std::exception& exception) {
+        FAIL() << exception.what();
+    }
+
+    obj["reuseport_listeners"] = false;
+    try {
+        Settings settings(obj);
+        EXPECT_FALSE(settings.isReuseportListenersEnabled());
+        EXPECT_TRUE(settings.has.reuseport_listeners);
+    } catch (std::exception& exception) {
+        FAIL() << exception.what();
+    }
+}
+
 TEST_F(SettingsTest, StdinListener) {
     nonBooleanValuesShouldFail("stdin_listener");
 
@@ -916,6 +939,20 @@ TEST_F(SettingsTest, max_packet_size) {
     }
 }
 
+TEST_F(SettingsTest, SubdocLookupCacheSize) {
+    nonNumericValuesShouldFail("subdoc_lookup_cache_size");
+
+    nlohmann::json obj;
+    obj["subdoc_lookup_cache_size"] = 1000;
+    try {
+        Settings settings(obj);
+        EXPECT_EQ(1000, settings.getSubdocLookupCacheSize());
+        EXPECT_TRUE(settings.has.subdoc_lookup_cache_size);
+    } catch (std::exception& exception) {
+        FAIL() << exception.what();
+    }
+}
+
 TEST_F(SettingsTest, max_connections) {
     nonNumericValuesShouldFail("max_connections");
 
@@ -1530,6 +1567,16 @@ TEST(SettingsUpdateTest, MaxPacketSizeIsDynamic) {
     EXPECT_EQ(updated.getMaxPacketSize(), settings.getMaxPacketSize());
 }
 
+TEST(SettingsUpdateTest, SubdocLookupCacheSizeIsDynamic) {
+    Settings settings;
+    Settings updated;
+    updated.setSubdocLookupCacheSize(100);
+    EXPECT_NO_THROW(settings.updateSettings(updated, false));
+    EXPECT_EQ(0, settings.getSubdocLookupCacheSize());
+    EXPECT_NO_THROW(settings.updateSettings(updated));
+    EXPECT_EQ(100, settings.getSubdocLookupCacheSize());
+}
+
 TEST(SettingsUpdateTest, SaslMechanismsIsDynamic) {
     Settings settings;
     Settings updated;
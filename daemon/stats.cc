@@ -99,6 +99,10 @@ static void server_bucket_stats(const BucketStatCollector& collector,
                       thread_stats.bytes_subdoc_mutation_total);
     collector.addStat(Key::bytes_subdoc_mutation_inserted,
                       thread_stats.bytes_subdoc_mutation_inserted);
+    collector.addStat(Key::subdoc_lookup_cache_hits,
+                      thread_stats.subdoc_lookup_cache_hits);
+    collector.addStat(Key::subdoc_lookup_cache_misses,
+                      thread_stats.subdoc_lookup_cache_misses);
 
     // bucket specific totals
     auto& current_bucket_timings = bucket.timings;
@@ -122,6 +126,7 @@ static void server_bucket_stats(const BucketStatCollector& collector,
     collector.addStat(Key::cas_badval, thread_stats.cas_badval);
     collector.addStat(Key::bytes_read, thread_stats.bytes_read);
     collector.addStat(Key::bytes_written, thread_stats.bytes_written);
+    collector.addStat(Key::direct_sends, thread_stats.direct_sends);
     collector.addStat(Key::conn_yields, thread_stats.conn_yields);
     collector.addStat(Key::iovused_high_watermark,
                       thread_stats.iovused_high_watermark);
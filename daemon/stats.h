@@ -53,6 +53,7 @@ struct thread_stats {
         cas_misses = 0;
         bytes_written = 0;
         bytes_read = 0;
+        direct_sends = 0;
         cmd_flush = 0;
         conn_yields = 0;
         auth_cmds = 0;
@@ -66,6 +67,8 @@ struct thread_stats {
         bytes_subdoc_lookup_extracted = 0;
         bytes_subdoc_mutation_total = 0;
         bytes_subdoc_mutation_inserted = 0;
+        subdoc_lookup_cache_hits = 0;
+        subdoc_lookup_cache_misses = 0;
 
         iovused_high_watermark = 0;
         msgused_high_watermark = 0;
@@ -87,6 +90,7 @@ struct thread_stats {
         cas_misses += other.cas_misses;
         bytes_read += other.bytes_read;
         bytes_written += other.bytes_written;
+        direct_sends += other.direct_sends;
         cmd_flush += other.cmd_flush;
         conn_yields += other.conn_yields;
         auth_cmds += other.auth_cmds;
@@ -101,6 +105,8 @@ struct thread_stats {
         bytes_subdoc_lookup_extracted += other.bytes_subdoc_lookup_extracted;
         bytes_subdoc_mutation_total += other.bytes_subdoc_mutation_total;
         bytes_subdoc_mutation_inserted += other.bytes_subdoc_mutation_inserted;
+        subdoc_lookup_cache_hits += other.subdoc_lookup_cache_hits;
+        subdoc_lookup_cache_misses += other.subdoc_lookup_cache_misses;
 
         iovused_high_watermark.setIfGreater(other.iovused_high_watermark);
         msgused_high_watermark.setIfGreater(other.msgused_high_watermark);
@@ -129,6 +135,9 @@ struct thread_stats {
     cb::RelaxedAtomic<uint64_t> cas_misses;
     cb::RelaxedAtomic<uint64_t> bytes_read;
     cb::RelaxedAtomic<uint64_t> bytes_written;
+    /* # of responses written straight to the socket with a single sendmsg
+       (bypassing the libevent output buffer) */
+    cb::RelaxedAtomic<uint64_t> direct_sends;
     cb::RelaxedAtomic<uint64_t> cmd_flush;
     cb::RelaxedAtomic<uint64_t>
             conn_yields; /* # of yields for connections (-R option)*/
@@ -159,6 +168,11 @@ struct thread_stats {
        received from the client). */
     cb::RelaxedAtomic<uint64_t> bytes_subdoc_mutation_inserted;
 
+    /* # of subdoc lookups answered from (or not found in) the thread's
+       SubdocLookupCache. Lookups which bypass the cache count as neither. */
+    cb::RelaxedAtomic<uint64_t> subdoc_lookup_cache_hits;
+    cb::RelaxedAtomic<uint64_t> subdoc_lookup_cache_misses;
+
     /* Highest value iovsize has got to */
     cb::RelaxedAtomic<int> iovused_high_watermark;
     /* High value Connection->msgused has got to */
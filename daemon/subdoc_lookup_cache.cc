@@ -0,0 +1,84 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "subdoc_lookup_cache.h"
+
+SubdocLookupCache::SubdocLookupCache(size_t maxDocuments)
+    : maxDocuments(maxDocuments), documents(maxDocuments) {
+}
+
+void SubdocLookupCache::setMaxDocuments(size_t maxDocuments) {
+    this->maxDocuments = maxDocuments;
+    if (maxDocuments == 0) {
+        documents.clear();
+    }
+    documents.setMaxSize(maxDocuments);
+}
+
+std::optional<SubdocLookupCache::Result> SubdocLookupCache::find(
+        const DocumentId& document,
+        cb::mcbp::ClientOpcode opcode,
+        std::string_view path) {
+    auto it = documents.find(makeKey(document));
+    if (it == documents.end() || it->second.cas != document.cas ||
+        it->second.size != document.size) {
+        return {};
+    }
+    for (const auto& cached : it->second.paths) {
+        if (cached.opcode == opcode && cached.path == path) {
+            return cached.result;
+        }
+    }
+    return {};
+}
+
+void SubdocLookupCache::insert(const DocumentId& document,
+                               cb::mcbp::ClientOpcode opcode,
+                               std::string_view path,
+                               Result result) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    const auto& key = makeKey(document);
+    auto it = documents.find(key);
+    if (it == documents.end() || it->second.cas != document.cas ||
+        it->second.size != document.size) {
+        // First lookup in this version of the document
+        documents.set(key, Document{document.cas, document.size, {}});
+        it = documents.find(key);
+    }
+
+    auto& paths = it->second.paths;
+    if (paths.size() < MaxPathsPerDocument) {
+        paths.push_back({opcode, std::string(path), result});
+    }
+}
+
+const std::string& SubdocLookupCache::makeKey(const DocumentId& document) {
+    keyBuffer.clear();
+    keyBuffer.append(reinterpret_cast<const char*>(&document.bucket),
+                     sizeof(document.bucket));
+    const auto vbucket = document.vbucket.get();
+    keyBuffer.append(reinterpret_cast<const char*>(&vbucket),
+                     sizeof(vbucket));
+    // The same bytes are a different key with and without a collection-ID
+    keyBuffer.push_back(char(document.key.getEncoding()));
+    keyBuffer.append(reinterpret_cast<const char*>(document.key.data()),
+                     document.key.size());
+    return keyBuffer;
+}
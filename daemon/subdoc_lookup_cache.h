@@ -0,0 +1,122 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/EvictingCacheMap.h>
+#include <mcbp/protocol/opcode.h>
+#include <mcbp/protocol/status.h>
+#include <memcached/dockey.h>
+#include <memcached/vbucket.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * A cache of the results of sub-document lookups, for workloads which look
+ * up the same few paths in the same (hot) documents over and over.
+ *
+ * Results are cached per version of a document - identified by its bucket,
+ * vBucket, key and CAS (which changes on every mutation) - as the status of
+ * the lookup and the location of the match in the document body. A
+ * repeated lookup then costs a hash table lookup instead of parsing the
+ * document up to the path. A lookup in a new version of a document
+ * replaces the cached results of the old one.
+ *
+ * Holds at most the configured number of documents (evicting the least
+ * recently used) and MaxPathsPerDocument paths of each. Not thread-safe;
+ * each front end thread has its own (see subdoc_lookup_cache_size).
+ */
+class SubdocLookupCache {
+public:
+    /// Identifies one version of a document
+    struct DocumentId {
+        int bucket;
+        Vbid vbucket;
+        DocKey key;
+        uint64_t cas;
+        /// The size of the document body; checked as a safety net
+        size_t size;
+    };
+
+    /// The result of a lookup of one path
+    struct Result {
+        cb::mcbp::Status status;
+        /// The offset of the match in the document body (if successful)
+        size_t offset;
+        /// The length of the match (if successful)
+        size_t length;
+    };
+
+    explicit SubdocLookupCache(size_t maxDocuments = 0);
+
+    bool isEnabled() const {
+        return maxDocuments != 0;
+    }
+
+    size_t getMaxDocuments() const {
+        return maxDocuments;
+    }
+
+    /**
+     * Set the maximum number of documents to cache the results of; zero
+     * disables (and empties) the cache.
+     */
+    void setMaxDocuments(size_t maxDocuments);
+
+    /// @return the cached result of the lookup, if any
+    std::optional<Result> find(const DocumentId& document,
+                               cb::mcbp::ClientOpcode opcode,
+                               std::string_view path);
+
+    /// Cache the result of a lookup (if enabled)
+    void insert(const DocumentId& document,
+                cb::mcbp::ClientOpcode opcode,
+                std::string_view path,
+                Result result);
+
+    /// @return the number of documents with cached results
+    size_t size() const {
+        return documents.size();
+    }
+
+    /// The most paths cached for one document
+    static constexpr size_t MaxPathsPerDocument = 16;
+
+private:
+    struct Path {
+        cb::mcbp::ClientOpcode opcode;
+        std::string path;
+        Result result;
+    };
+
+    struct Document {
+        uint64_t cas;
+        size_t size;
+        std::vector<Path> paths;
+    };
+
+    /// @return the key of the document in the map (built in keyBuffer)
+    const std::string& makeKey(const DocumentId& document);
+
+    size_t maxDocuments;
+    folly::EvictingCacheMap<std::string, Document> documents;
+    /// Reused to build keys, to avoid an allocation per lookup
+    std::string keyBuffer;
+};
@@ -0,0 +1,130 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "subdoc_lookup_cache.h"
+#include <folly/portability/GTest.h>
+
+using Status = cb::mcbp::Status;
+using Opcode = cb::mcbp::ClientOpcode;
+
+class SubdocLookupCacheTest : public ::testing::Test {
+protected:
+    SubdocLookupCache::DocumentId makeId(const char* key, uint64_t cas) {
+        return {0,
+                Vbid(0),
+                DocKey(key, DocKeyEncodesCollectionId::No),
+                cas,
+                100};
+    }
+
+    SubdocLookupCache cache{2};
+};
+
+TEST_F(SubdocLookupCacheTest, Disabled) {
+    cache.setMaxDocuments(0);
+    EXPECT_FALSE(cache.isEnabled());
+    cache.insert(makeId("key", 1),
+                 Opcode::SubdocGet,
+                 "a",
+                 {Status::Success, 10, 2});
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.find(makeId("key", 1), Opcode::SubdocGet, "a"));
+}
+
+TEST_F(SubdocLookupCacheTest, FindInserted) {
+    const auto id = makeId("key", 1);
+    EXPECT_FALSE(cache.find(id, Opcode::SubdocGet, "a"));
+
+    cache.insert(id, Opcode::SubdocGet, "a", {Status::Success, 10, 2});
+    cache.insert(id, Opcode::SubdocGet, "b", {Status::SubdocPathEnoent, 0, 0});
+    EXPECT_EQ(1, cache.size());
+
+    auto result = cache.find(id, Opcode::SubdocGet, "a");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(Status::Success, result->status);
+    EXPECT_EQ(10, result->offset);
+    EXPECT_EQ(2, result->length);
+
+    result = cache.find(id, Opcode::SubdocGet, "b");
+    ASSERT_TRUE(result);
+    EXPECT_EQ(Status::SubdocPathEnoent, result->status);
+
+    // Another opcode, path or document isn't found
+    EXPECT_FALSE(cache.find(id, Opcode::SubdocExists, "a"));
+    EXPECT_FALSE(cache.find(id, Opcode::SubdocGet, "c"));
+    EXPECT_FALSE(cache.find(makeId("key2", 1), Opcode::SubdocGet, "a"));
+    auto otherVbucket = id;
+    otherVbucket.vbucket = Vbid(1);
+    EXPECT_FALSE(cache.find(otherVbucket, Opcode::SubdocGet, "a"));
+    auto otherBucket = id;
+    otherBucket.bucket = 1;
+    EXPECT_FALSE(cache.find(otherBucket, Opcode::SubdocGet, "a"));
+}
+
+// A new version (CAS) of the document invalidates the cached results
+TEST_F(SubdocLookupCacheTest, CasChangeInvalidates) {
+    cache.insert(makeId("key", 1),
+                 Opcode::SubdocGet,
+                 "a",
+                 {Status::Success, 10, 2});
+    EXPECT_FALSE(cache.find(makeId("key", 2), Opcode::SubdocGet, "a"));
+
+    cache.insert(makeId("key", 2),
+                 Opcode::SubdocGet,
+                 "b",
+                 {Status::Success, 20, 3});
+    EXPECT_EQ(1, cache.size());
+    EXPECT_FALSE(cache.find(makeId("key", 1), Opcode::SubdocGet, "a"));
+    EXPECT_FALSE(cache.find(makeId("key", 2), Opcode::SubdocGet, "a"));
+    EXPECT_TRUE(cache.find(makeId("key", 2), Opcode::SubdocGet, "b"));
+}
+
+TEST_F(SubdocLookupCacheTest, Bounded) {
+    cache.insert(makeId("key1", 1),
+                 Opcode::SubdocGet,
+                 "a",
+                 {Status::Success, 0, 1});
+    cache.insert(makeId("key2", 1),
+                 Opcode::SubdocGet,
+                 "a",
+                 {Status::Success, 0, 1});
+    // Use key1 so key2 is the least recently used
+    EXPECT_TRUE(cache.find(makeId("key1", 1), Opcode::SubdocGet, "a"));
+    cache.insert(makeId("key3", 1),
+                 Opcode::SubdocGet,
+                 "a",
+                 {Status::Success, 0, 1});
+    EXPECT_EQ(2, cache.size());
+    EXPECT_TRUE(cache.find(makeId("key1", 1), Opcode::SubdocGet, "a"));
+    EXPECT_FALSE(cache.find(makeId("key2", 1), Opcode::SubdocGet, "a"));
+    EXPECT_TRUE(cache.find(makeId("key3", 1), Opcode::SubdocGet, "a"));
+
+    // Only so many paths of a document are cached
+    const auto id = makeId("key1", 1);
+    for (size_t ii = 0; ii < SubdocLookupCache::MaxPathsPerDocument; ++ii) {
+        cache.insert(id,
+                     Opcode::SubdocGet,
+                     "path" + std::to_string(ii),
+                     {Status::Success, ii, 1});
+    }
+    EXPECT_TRUE(cache.find(id, Opcode::SubdocGet, "path0"));
+    EXPECT_FALSE(cache.find(
+            id,
+            Opcode::SubdocGet,
+            "path" + std::to_string(SubdocLookupCache::MaxPathsPerDocument -
+                                    1)));
+}
@@ -22,6 +22,7 @@
 #include "front_end_thread.h"
 #include "mcaudit.h"
 #include "protocol/mcbp/engine_wrapper.h"
+#include "settings.h"
 #include "subdoc/util.h"
 #include "subdocument_context.h"
 #include "subdocument_parser.h"
@@ -40,10 +41,16 @@
 #include <utilities/engine_errc_2_mcbp.h>
 #include <xattr/blob.h>
 #include <gsl/gsl>
+#include <algorithm>
+#include <vector>
 
 static const std::array<SubdocCmdContext::Phase, 2> phases{{SubdocCmdContext::Phase::XATTR,
                                                             SubdocCmdContext::Phase::Body}};
 
+/// The largest spare buffer (see FrontEndThread::subdoc_buffer) a thread
+/// keeps once it operates on smaller documents.
+static constexpr size_t SubdocBufferMaxRetained = 1024 * 1024;
+
 using namespace mcbp::subdoc;
 
 /******************************************************************************
@@ -459,6 +466,71 @@ static cb::mcbp::Status subdoc_operate_one_path(
     }
 }
 
+/**
+ * Perform the subjson operation specified by {spec} to one path in the
+ * document, using the thread's SubdocLookupCache for lookups in the
+ * document body if it is enabled.
+ */
+static cb::mcbp::Status subdoc_operate_one_path_cached(
+        SubdocCmdContext& context,
+        SubdocCmdContext::OperationSpec& spec,
+        std::string_view in_doc) {
+    auto& cache = context.connection.getThread().subdoc_lookup_cache;
+    const auto cacheSize = Settings::instance().getSubdocLookupCacheSize();
+    if (cacheSize != cache.getMaxDocuments()) {
+        cache.setMaxDocuments(cacheSize);
+    }
+
+    if (!cache.isEnabled() || context.traits.is_mutator ||
+        context.getCurrentPhase() != SubdocCmdContext::Phase::Body ||
+        context.getInputItemInfo().cas == LOCKED_CAS) {
+        return subdoc_operate_one_path(context, spec, in_doc);
+    }
+
+    const SubdocLookupCache::DocumentId document{
+            context.connection.getBucketIndex(),
+            context.vbucket,
+            context.cookie.getRequestKey(),
+            context.getInputItemInfo().cas,
+            in_doc.size()};
+    const auto opcode = spec.traits.mcbpCommand;
+    auto* thread_stats = get_thread_stats(&context.connection);
+    if (auto cached = cache.find(document, opcode, spec.path)) {
+        thread_stats->subdoc_lookup_cache_hits++;
+        if (cached->status == cb::mcbp::Status::Success) {
+            spec.result.set_matchloc(
+                    {in_doc.data() + cached->offset, cached->length});
+        }
+        return cached->status;
+    }
+    thread_stats->subdoc_lookup_cache_misses++;
+
+    const auto status = subdoc_operate_one_path(context, spec, in_doc);
+    switch (status) {
+    case cb::mcbp::Status::Success: {
+        // Only a match within the document can be cached (not e.g. the
+        // count returned by GetCount)
+        const auto match = spec.result.matchloc();
+        const auto* begin = in_doc.data();
+        if (match.at >= begin &&
+            match.at + match.length <= begin + in_doc.size()) {
+            cache.insert(document,
+                         opcode,
+                         spec.path,
+                         {status, size_t(match.at - begin), match.length});
+        }
+        break;
+    }
+    case cb::mcbp::Status::SubdocPathEnoent:
+    case cb::mcbp::Status::SubdocPathMismatch:
+        cache.insert(document, opcode, spec.path, {status, 0, 0});
+        break;
+    default:
+        break;
+    }
+    return status;
+}
+
 /**
  * Perform the wholedoc (mcbp) operation defined by spec
  */
@@ -522,6 +594,144 @@ static cb::mcbp::Status subdoc_operate_attributes_and_body(
     return st;
 }
 
+/**
+ * Get the thread's spare buffer (see FrontEndThread::subdoc_buffer), empty
+ * and with room for a document of the given size.
+ */
+static std::string& get_subdoc_buffer(SubdocCmdContext& context,
+                                      size_t doc_len) {
+    auto& buffer = context.connection.getThread().subdoc_buffer;
+    if (buffer.capacity() > SubdocBufferMaxRetained &&
+        buffer.capacity() > doc_len * 2) {
+        // Don't hold on to the memory of a (much) larger document than the
+        // ones currently operated on.
+        std::string().swap(buffer);
+    }
+    buffer.clear();
+    buffer.reserve(doc_len);
+    return buffer;
+}
+
+/**
+ * Try to apply all of the body mutations of a multi-mutation with a single
+ * copy of the document, instead of building a new document after each of
+ * them.
+ *
+ * Each spec is executed against the original document, and the new
+ * document it returns (prefix of the document, new fragments, suffix of
+ * the document) is turned into a splice replacing a range of the original
+ * document. If the ranges are disjoint (with at least one byte between
+ * them, as e.g. the comma handling of adjacent edits depends on each
+ * other), applying the splices in document order gives the same result as
+ * applying the specs one after the other. That is not the case for specs
+ * whose outcome depends on an earlier spec (e.g. adding two keys to the
+ * same object, or array indexes which shift after an earlier edit), so
+ * those (and any spec which fails) are left to the sequential path.
+ *
+ * @param context The context object for this operation
+ * @param current The document body; replaced by the new document upon
+ *                success
+ * @return true if all of the mutations were applied, false if they must be
+ *         applied one at a time (the document is left untouched)
+ */
+static bool subdoc_operate_disjoint_mutations(SubdocCmdContext& context,
+                                              MemoryBackedBuffer& current) {
+    auto& operations = context.getOperations();
+    if (!context.traits.is_mutator ||
+        context.traits.path != SubdocPath::MULTI ||
+        context.getCurrentPhase() != SubdocCmdContext::Phase::Body ||
+        operations.size() < 2) {
+        return false;
+    }
+
+    for (const auto& op : operations) {
+        if (op.traits.scope != CommandScope::SubJSON ||
+            (op.flags & SUBDOC_FLAG_EXPAND_MACROS) ||
+            op.path.find('[') != std::string::npos) {
+            return false;
+        }
+    }
+
+    struct Splice {
+        size_t begin;
+        size_t end;
+        const Subdoc::Result* result;
+    };
+    std::vector<Splice> splices;
+    splices.reserve(operations.size());
+
+    const auto doc = current.view;
+    const auto* const docBegin = doc.data();
+    const auto* const docEnd = docBegin + doc.size();
+    auto abandon = [&operations]() {
+        for (auto& op : operations) {
+            op.result.clear();
+        }
+        return false;
+    };
+
+    for (auto& op : operations) {
+        // The newdoc fragments only refer to the input document, the spec's
+        // value or the spec's own result, so they stay valid while the
+        // following specs are executed.
+        if (subdoc_operate_one_path(context, op, doc) !=
+            cb::mcbp::Status::Success) {
+            return abandon();
+        }
+
+        const auto& newdoc = op.result.newdoc();
+        if (newdoc.size() < 2) {
+            return abandon();
+        }
+        const auto& prefix = newdoc.front();
+        const auto& suffix = newdoc.back();
+        if (prefix.at != docBegin || suffix.at < docBegin + prefix.length ||
+            suffix.at + suffix.length != docEnd) {
+            return abandon();
+        }
+        splices.push_back({prefix.length,
+                           size_t(suffix.at - docBegin),
+                           &op.result});
+    }
+
+    std::sort(splices.begin(),
+              splices.end(),
+              [](const Splice& a, const Splice& b) {
+                  return a.begin < b.begin;
+              });
+
+    size_t new_doc_len = doc.size();
+    for (size_t ii = 0; ii < splices.size(); ++ii) {
+        const auto& splice = splices[ii];
+        if (ii > 0 && splices[ii - 1].end >= splice.begin) {
+            return abandon();
+        }
+        new_doc_len -= splice.end - splice.begin;
+        const auto& newdoc = splice.result->newdoc();
+        for (auto it = newdoc.begin() + 1; it != newdoc.end() - 1; ++it) {
+            new_doc_len += it->length;
+        }
+    }
+
+    auto& next = get_subdoc_buffer(context, new_doc_len);
+    size_t offset = 0;
+    for (const auto& splice : splices) {
+        next.append(docBegin + offset, splice.begin - offset);
+        const auto& newdoc = splice.result->newdoc();
+        for (auto it = newdoc.begin() + 1; it != newdoc.end() - 1; ++it) {
+            next.append(it->at, it->length);
+        }
+        offset = splice.end;
+    }
+    next.append(docBegin + offset, doc.size() - offset);
+    current.reset(std::move(next));
+
+    for (auto& op : operations) {
+        op.status = cb::mcbp::Status::Success;
+    }
+    return true;
+}
+
 /**
  * Run through all of the subdoc operations for the current phase on
  * the documents content (either the xattr section or the document body,
@@ -562,13 +772,20 @@ static bool operate_single_doc(SubdocCmdContext& context,
                             ? *xattr
                             : body;
 
+    if (mcbp::datatype::is_json(doc_datatype) &&
+        subdoc_operate_disjoint_mutations(context, current)) {
+        modified = true;
+        return true;
+    }
+
     // 2. Perform each of the operations on document.
     for (auto& op : operations) {
         switch (op.traits.scope) {
         case CommandScope::SubJSON:
             if (mcbp::datatype::is_json(doc_datatype)) {
                 // Got JSON, perform the operation.
-                op.status = subdoc_operate_one_path(context, op, current.view);
+                op.status = subdoc_operate_one_path_cached(
+                        context, op, current.view);
             } else {
                 // No good; need to have JSON.
                 op.status = cb::mcbp::Status::SubdocDocNotJson;
@@ -596,30 +813,30 @@ static bool operate_single_doc(SubdocCmdContext& context,
                         new_doc_len += loc.length;
                     }
 
-                    std::string next;
-                    next.reserve(new_doc_len);
-                    // TODO-PERF: We need to create a contiguous input
-                    // region for the next subjson call, from the set of
-                    // iovecs in the result. We can't simply write into
-                    // the dynamic_buffer, as that may be the underlying
-                    // storage for iovecs from the result. Ideally we'd
-                    // either permit subjson to take an iovec as input, or
-                    // permit subjson to take all the multipaths at once.
-                    // For now we make a contiguous region in a temporary
-                    // char[], and point in_doc at that.
+                    // We need to create a contiguous input region for the
+                    // next subjson call from the set of iovecs in the
+                    // result. It can't be built in place, as the iovecs
+                    // may refer to the current document, so it is built
+                    // in the thread's spare buffer which is then swapped
+                    // with the current document - whose storage becomes
+                    // the spare buffer for the next operation. This way a
+                    // multi-mutation doesn't allocate (or free) a new
+                    // document for each of its specs.
+                    auto& next = get_subdoc_buffer(context, new_doc_len);
                     for (auto& loc : op.result.newdoc()) {
                         next.insert(next.end(), loc.at, loc.at + loc.length);
                     }
 
-                    // Copying complete - safe to delete the old temp_doc
+                    // Copying complete - safe to reuse the old document
                     // (even if it was the source of some of the newdoc
-                    // iovecs).
+                    // iovecs) once it is the spare buffer.
                     current.reset(std::move(next));
 
                     if (op.traits.scope == CommandScope::WholeDoc) {
                         // the entire document has been replaced as part of a
                         // wholedoc op update the datatype to match
-                        JSON_checker::Validator validator;
+                        auto& validator =
+                                context.connection.getThread().validator;
                         bool isValidJson = validator.validate(current.view);
 
                         // don't alter context.in_datatype directly here in case
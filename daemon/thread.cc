@@ -330,6 +330,11 @@ void FrontEndThread::libevent_callback() {
 }
 
 void notifyIoComplete(Cookie& cookie, cb::engine_errc status) {
+    if (!cookie.completeNotification(status)) {
+        // Part of a notification batch which is still outstanding
+        return;
+    }
+
     auto& thr = cookie.getConnection().getThread();
     LOG_DEBUG("notifyIoComplete: Got notify from {}, status {}",
               cookie.getConnection().getId(),
@@ -392,6 +397,12 @@ void FrontEndThread::dispatch(SOCKET sfd,
     }
 }
 
+void FrontEndThread::forEach(std::function<void(FrontEndThread&)> callback) {
+    for (auto& thread : threads) {
+        callback(thread);
+    }
+}
+
 /******************************* GLOBAL STATS ******************************/
 
 void threadlocal_stats_reset(std::vector<thread_stats>& thread_stats) {
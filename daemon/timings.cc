@@ -17,22 +17,31 @@
 #include "timings.h"
 
 Timings::Timings() {
+    for (auto& shard : timings) {
+        for (auto& t : shard) {
+            t = nullptr;
+        }
+    }
     reset();
 }
 
 Timings::~Timings() {
     std::lock_guard<std::mutex> lg(histogram_mutex);
-    for (auto& t : timings) {
-        delete t;
+    for (auto& shard : timings) {
+        for (auto& t : shard) {
+            delete t;
+        }
     }
 }
 
 void Timings::reset() {
     {
         std::lock_guard<std::mutex> lg(histogram_mutex);
-        for (auto& t : timings) {
-            if (t) {
-                t.load()->reset();
+        for (auto& shard : timings) {
+            for (auto& t : shard) {
+                if (t) {
+                    t.load()->reset();
+                }
             }
         }
     }
@@ -59,11 +68,10 @@ void Timings::collect(cb::mcbp::ClientOpcode opcode,
 }
 
 std::string Timings::generate(cb::mcbp::ClientOpcode opcode) {
-    auto* histoPtr =
-            timings[std::underlying_type<cb::mcbp::ClientOpcode>::type(opcode)]
-                    .load();
-    if (histoPtr) {
-        return histoPtr->to_string();
+    const auto histo = get_timing_histogram(
+            std::underlying_type<cb::mcbp::ClientOpcode>::type(opcode));
+    if (histo) {
+        return histo->to_string();
     }
     return std::string("{}");
 }
@@ -108,6 +116,7 @@ static const cb::mcbp::ClientOpcode timings_retrievals[] = {
         cb::mcbp::ClientOpcode::Getkq,
         cb::mcbp::ClientOpcode::Getq,
         cb::mcbp::ClientOpcode::GetLocked,
+        cb::mcbp::ClientOpcode::GetMulti,
         cb::mcbp::ClientOpcode::GetRandomKey,
         cb::mcbp::ClientOpcode::GetReplica,
         cb::mcbp::ClientOpcode::SubdocMultiLookup,
@@ -117,11 +126,12 @@ static const cb::mcbp::ClientOpcode timings_retrievals[] = {
 uint64_t Timings::get_aggregated_mutation_stats() const {
     uint64_t ret = 0;
     for (auto cmd : timings_mutations) {
-        auto* histoPtr =
-                timings[std::underlying_type<cb::mcbp::ClientOpcode>::type(cmd)]
-                        .load();
-        if (histoPtr) {
-            ret += histoPtr->getValueCount();
+        const auto op = std::underlying_type<cb::mcbp::ClientOpcode>::type(cmd);
+        for (const auto& shard : timings) {
+            auto* histoPtr = shard[op].load();
+            if (histoPtr) {
+                ret += histoPtr->getValueCount();
+            }
         }
     }
     return ret;
@@ -130,11 +140,12 @@ uint64_t Timings::get_aggregated_mutation_stats() const {
 uint64_t Timings::get_aggregated_retrieval_stats() const {
     uint64_t ret = 0;
     for (auto cmd : timings_retrievals) {
-        auto* histoPtr =
-                timings[std::underlying_type<cb::mcbp::ClientOpcode>::type(cmd)]
-                        .load();
-        if (histoPtr) {
-            ret += histoPtr->getValueCount();
+        const auto op = std::underlying_type<cb::mcbp::ClientOpcode>::type(cmd);
+        for (const auto& shard : timings) {
+            auto* histoPtr = shard[op].load();
+            if (histoPtr) {
+                ret += histoPtr->getValueCount();
+            }
         }
     }
     return ret;
@@ -152,17 +163,29 @@ cb::sampling::Interval Timings::get_interval_lookup_latency() {
 
 Hdr1sfMicroSecHistogram& Timings::get_or_create_timing_histogram(
         uint8_t opcode) {
-    if (!timings[opcode]) {
+    auto& histo = timings.get()[opcode];
+    if (!histo) {
         std::lock_guard<std::mutex> allocLock(histogram_mutex);
-        if (!timings[opcode]) {
-            timings[opcode] = new Hdr1sfMicroSecHistogram();
+        if (!histo) {
+            histo = new Hdr1sfMicroSecHistogram();
         }
     }
-    return *(timings[opcode].load());
+    return *(histo.load());
 }
 
-Hdr1sfMicroSecHistogram* Timings::get_timing_histogram(uint8_t opcode) const {
-    return timings[opcode].load();
+std::optional<Hdr1sfMicroSecHistogram> Timings::get_timing_histogram(
+        uint8_t opcode) const {
+    std::optional<Hdr1sfMicroSecHistogram> ret;
+    for (const auto& shard : timings) {
+        auto* histoPtr = shard[opcode].load();
+        if (histoPtr) {
+            if (!ret) {
+                ret.emplace();
+            }
+            *ret += *histoPtr;
+        }
+    }
+    return ret;
 }
 
 void Timings::sample(std::chrono::seconds sample_interval) {
@@ -23,7 +23,9 @@
 #include <platform/corestore.h>
 #include <utilities/hdrhistogram.h>
 #include <array>
+#include <atomic>
 #include <mutex>
+#include <optional>
 #include <string>
 
 #define MAX_NUM_OPCODES 0x100
@@ -48,11 +50,13 @@ public:
     cb::sampling::Interval get_interval_lookup_latency();
 
     /**
-     * Get a pointer to the underlying histogram for the specified opcode
-     * @return a pointer to the underling HdrMicroSecHistogram for this opcode
-     * if there isn't one allocated already a nullptr will be returned.
+     * Get the histogram for the specified opcode (merged over all of the
+     * per-core shards it is recorded in)
+     * @return the HdrMicroSecHistogram for this opcode, or std::nullopt if
+     * there isn't one allocated already
      */
-    Hdr1sfMicroSecHistogram* get_timing_histogram(uint8_t opcode) const;
+    std::optional<Hdr1sfMicroSecHistogram> get_timing_histogram(
+            uint8_t opcode) const;
 
 private:
     /**
@@ -68,10 +72,14 @@ private:
 
     cb::sampling::IntervalSeries interval_latency_lookups;
     cb::sampling::IntervalSeries interval_latency_mutations;
-    // create an array of unique_ptrs as we want to create HdrHistograms
+    // create an array of pointers as we want to create HdrHistograms
     // in a lazy manner as their foot print is larger than our old
-    // histogram class
-    std::array<std::atomic<Hdr1sfMicroSecHistogram*>, MAX_NUM_OPCODES> timings;
+    // histogram class. Sharded by core (like interval_counters) so the
+    // front-end threads don't contend on the same histograms when recording;
+    // the shards are merged when the timings are read.
+    CoreStore<std::array<std::atomic<Hdr1sfMicroSecHistogram*>,
+                         MAX_NUM_OPCODES>>
+            timings;
     std::mutex histogram_mutex;
 
     // Sharded by core as cache contention was observed due to the number of
@@ -0,0 +1,73 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "timings.h"
+
+#include <folly/portability/GTest.h>
+
+#include <thread>
+#include <vector>
+
+using cb::mcbp::ClientOpcode;
+
+TEST(TimingsTest, NoHistogramUntilCollected) {
+    Timings timings;
+    EXPECT_FALSE(timings.get_timing_histogram(uint8_t(ClientOpcode::Get)));
+    EXPECT_EQ("{}", timings.generate(ClientOpcode::Get));
+    EXPECT_EQ(0, timings.get_aggregated_retrieval_stats());
+}
+
+// Timings recorded by many threads (and so into different shards) are all
+// accounted for when read
+TEST(TimingsTest, CollectFromManyThreads) {
+    Timings timings;
+    constexpr size_t numThreads = 8;
+    constexpr size_t numOps = 1000;
+
+    std::vector<std::thread> threads;
+    for (size_t ii = 0; ii < numThreads; ++ii) {
+        threads.emplace_back([&timings]() {
+            for (size_t op = 0; op < numOps; ++op) {
+                timings.collect(ClientOpcode::Get,
+                                std::chrono::microseconds(10));
+                timings.collect(ClientOpcode::Set,
+                                std::chrono::microseconds(20));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    const auto get = timings.get_timing_histogram(uint8_t(ClientOpcode::Get));
+    ASSERT_TRUE(get);
+    EXPECT_EQ(numThreads * numOps, get->getValueCount());
+    EXPECT_EQ(10, get->getMaxValue());
+
+    const auto set = timings.get_timing_histogram(uint8_t(ClientOpcode::Set));
+    ASSERT_TRUE(set);
+    EXPECT_EQ(numThreads * numOps, set->getValueCount());
+    EXPECT_EQ(20, set->getMinValue());
+
+    EXPECT_EQ(numThreads * numOps, timings.get_aggregated_retrieval_stats());
+    EXPECT_EQ(numThreads * numOps, timings.get_aggregated_mutation_stats());
+    EXPECT_EQ(get->to_string(), timings.generate(ClientOpcode::Get));
+
+    timings.reset();
+    EXPECT_EQ(0, timings.get_aggregated_retrieval_stats());
+    EXPECT_EQ(0, timings.get_aggregated_mutation_stats());
+}
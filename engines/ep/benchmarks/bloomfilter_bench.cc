@@ -0,0 +1,63 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2020 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/*
+ * Benchmarks relating to the BloomFilter class.
+ */
+
+#include "bloomfilter.h"
+#include "module_tests/test_helpers.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+/**
+ * Benchmark the cost of looking up keys which are *not* in the filter - the
+ * common case for a full-eviction get of a non-existent key. The filter
+ * holds state.range(0) keys; the larger size does not fit in L2 cache.
+ */
+static void benchmarkMiss(benchmark::State& state, BloomFilter::Type type) {
+    const size_t numKeys = state.range(0);
+    BloomFilter bf(numKeys, 0.01, BFILTER_ENABLED, type);
+    for (size_t i = 0; i < numKeys; i++) {
+        bf.addKey(makeStoredDocKey("key_" + std::to_string(i)));
+    }
+
+    std::vector<StoredDocKey> missing;
+    for (size_t i = 0; i < 1024; i++) {
+        missing.push_back(makeStoredDocKey("miss_" + std::to_string(i)));
+    }
+
+    size_t i = 0;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(
+                bf.maybeKeyExists(missing[i++ % missing.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_BloomFilterMissClassic(benchmark::State& state) {
+    benchmarkMiss(state, BloomFilter::Type::Classic);
+}
+
+static void BM_BloomFilterMissBlocked(benchmark::State& state) {
+    benchmarkMiss(state, BloomFilter::Type::Blocked);
+}
+
+BENCHMARK(BM_BloomFilterMissClassic)->Arg(10000)->Arg(1000000);
+BENCHMARK(BM_BloomFilterMissBlocked)->Arg(10000)->Arg(1000000);
@@ -27,14 +27,22 @@
 #include <folly/portability/GTest.h>
 #include <spdlog/fmt/fmt.h>
 
+#include <thread>
+
 // Benchmarks inserting items into a HashTable
 class HashTableBench : public benchmark::Fixture {
 public:
-    HashTableBench()
+    explicit HashTableBench(
+            HashTable::ReadMode readMode = HashTable::ReadMode::Locked,
+            HashTable::IndexType indexType = HashTable::IndexType::Chained,
+            HashTable::ResizeMode resizeMode = HashTable::ResizeMode::Blocking)
         : ht(stats,
              std::make_unique<StoredValueFactory>(stats),
              Configuration().getHtSize(),
-             Configuration().getHtLocks()) {
+             Configuration().getHtLocks(),
+             readMode,
+             indexType,
+             resizeMode) {
     }
 
     void SetUp(benchmark::State& state) override {
@@ -118,6 +126,68 @@ public:
         }
     }
 
+    /**
+     * Benchmark finding items which are either all present or all absent,
+     * with the HashTable sized such that the average chain length is
+     * state.range(0).
+     */
+    void benchmarkFind(benchmark::State& state, bool present) {
+        sharedItems = createUniqueItems("key::");
+        for (auto& item : sharedItems) {
+            ASSERT_EQ(MutationStatus::WasClean, ht.set(item));
+        }
+        ht.resize(numItems / state.range(0));
+        const auto missing = createUniqueItems("missing::");
+        const auto& items = present ? sharedItems : missing;
+
+        while (state.KeepRunning()) {
+            // Stride through the items so successive lookups don't hit the
+            // same cache lines.
+            const auto index = (state.iterations() * 7919) % numItems;
+            auto& key = items[index].getKey();
+            benchmark::DoNotOptimize(ht.findForRead(key).storedValue);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /**
+     * Benchmark finding items while a background thread continually resizes
+     * the HashTable between two sizes.
+     */
+    void benchmarkFindDuringResize(benchmark::State& state) {
+        std::thread resizer;
+        std::atomic<bool> stopResizing{false};
+        if (state.thread_index == 0) {
+            sharedItems = createUniqueItems("key::");
+            for (auto& item : sharedItems) {
+                ASSERT_EQ(MutationStatus::WasClean, ht.set(item));
+            }
+            resizer = std::thread([this, &stopResizing]() {
+                size_t newSize = numItems / 4;
+                while (!stopResizing) {
+                    ht.resize(newSize);
+                    // No-op unless resizing incrementally.
+                    const auto budget = std::chrono::milliseconds(1);
+                    while (!stopResizing && ht.continueResize(budget)) {
+                    }
+                    newSize = (newSize == numItems) ? numItems / 4 : numItems;
+                }
+            });
+        }
+
+        while (state.KeepRunning()) {
+            auto& key = sharedItems[state.iterations() % numItems].getKey();
+            benchmark::DoNotOptimize(ht.findForRead(key).storedValue);
+        }
+
+        if (state.thread_index == 0) {
+            stopResizing = true;
+            resizer.join();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
     auto& getValFact() {
         return ht.valFact;
     }
@@ -162,6 +232,119 @@ BENCHMARK_DEFINE_F(HashTableBench, FindForRead)(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations());
 }
 
+// As HashTableBench, but with the HashTable configured for optimistic reads.
+class OptimisticHashTableBench : public HashTableBench {
+public:
+    OptimisticHashTableBench()
+        : HashTableBench(HashTable::ReadMode::Optimistic) {
+    }
+
+    /**
+     * Index of the item to read on the given iteration, skewed such that 90%
+     * of reads are for 1% of the keys - modelling a set of hot keys all
+     * reader threads contend on.
+     */
+    static size_t hotKeyIndex(size_t iteration) {
+        if (iteration % 10 != 0) {
+            return (iteration * 7919) % (numItems / 100);
+        }
+        return iteration % numItems;
+    }
+};
+
+// Benchmark finding a skewed (hot) set of keys via the locked read path.
+// Baseline for FindForReadOptimisticHotKeys.
+BENCHMARK_DEFINE_F(OptimisticHashTableBench, FindForReadLockedHotKeys)
+(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        sharedItems = createUniqueItems("key::");
+        for (auto& item : sharedItems) {
+            ASSERT_EQ(MutationStatus::WasClean, ht.set(item));
+        }
+    }
+
+    while (state.KeepRunning()) {
+        auto& key = sharedItems[hotKeyIndex(state.iterations())].getKey();
+        auto result = ht.findForRead(key);
+        benchmark::DoNotOptimize(result.storedValue->toItem(Vbid(0)));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Benchmark finding a skewed (hot) set of keys via the optimistic read path,
+// which doesn't acquire the hash bucket lock.
+BENCHMARK_DEFINE_F(OptimisticHashTableBench, FindForReadOptimisticHotKeys)
+(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        sharedItems = createUniqueItems("key::");
+        for (auto& item : sharedItems) {
+            ASSERT_EQ(MutationStatus::WasClean, ht.set(item));
+        }
+    }
+
+    while (state.KeepRunning()) {
+        auto& key = sharedItems[hotKeyIndex(state.iterations())].getKey();
+        auto result = ht.findForReadOptimistic(key, Vbid(0));
+        if (result.status != HashTable::OptimisticReadResult::Status::Found) {
+            // Fallback - perform the read under the lock as VBucket does.
+            auto locked = ht.findForRead(key);
+            benchmark::DoNotOptimize(locked.storedValue->toItem(Vbid(0)));
+        }
+        benchmark::DoNotOptimize(result.item);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// As HashTableBench, but with the HashTable using a Tagged index.
+class TaggedHashTableBench : public HashTableBench {
+public:
+    TaggedHashTableBench()
+        : HashTableBench(HashTable::ReadMode::Locked,
+                         HashTable::IndexType::Tagged) {
+    }
+};
+
+// Benchmark finding keys which exist, for the Chained and Tagged indexes.
+BENCHMARK_DEFINE_F(HashTableBench, FindHit)(benchmark::State& state) {
+    benchmarkFind(state, true);
+}
+BENCHMARK_DEFINE_F(TaggedHashTableBench, FindHit)(benchmark::State& state) {
+    benchmarkFind(state, true);
+}
+
+// Benchmark finding keys which do not exist, for the Chained and Tagged
+// indexes.
+BENCHMARK_DEFINE_F(HashTableBench, FindMiss)(benchmark::State& state) {
+    benchmarkFind(state, false);
+}
+BENCHMARK_DEFINE_F(TaggedHashTableBench, FindMiss)(benchmark::State& state) {
+    benchmarkFind(state, false);
+}
+
+// As HashTableBench, but with the HashTable resized incrementally.
+class IncrementalResizeHashTableBench : public HashTableBench {
+public:
+    IncrementalResizeHashTableBench()
+        : HashTableBench(HashTable::ReadMode::Locked,
+                         HashTable::IndexType::Chained,
+                         HashTable::ResizeMode::Incremental) {
+    }
+};
+
+// Benchmark finding items while the HashTable is being resized, for both
+// blocking and incremental resizing. With blocking resize readers stall for
+// the duration of each resize; with incremental only for each slice.
+BENCHMARK_DEFINE_F(HashTableBench, FindDuringResize)
+(benchmark::State& state) {
+    benchmarkFindDuringResize(state);
+}
+BENCHMARK_DEFINE_F(IncrementalResizeHashTableBench, FindDuringResize)
+(benchmark::State& state) {
+    benchmarkFindDuringResize(state);
+}
+
 // Benchmark finding items (for write) in the HashTable.
 // Includes extra  50% of Items are prepared SyncWrites -  an unrealistically
 // high percentage in a real-world, but want to measure any performance impact
@@ -370,6 +553,22 @@ BENCHMARK_DEFINE_F(HashTableBench, HTStatsEpilogue)(benchmark::State& state) {
 BENCHMARK_REGISTER_F(HashTableBench, FindForRead)
         ->ThreadPerCpu()
         ->Iterations(HashTableBench::numItems);
+BENCHMARK_REGISTER_F(OptimisticHashTableBench, FindForReadLockedHotKeys)
+        ->ThreadPerCpu()
+        ->Iterations(HashTableBench::numItems);
+BENCHMARK_REGISTER_F(OptimisticHashTableBench, FindForReadOptimisticHotKeys)
+        ->ThreadPerCpu()
+        ->Iterations(HashTableBench::numItems);
+BENCHMARK_REGISTER_F(HashTableBench, FindHit)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_REGISTER_F(TaggedHashTableBench, FindHit)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_REGISTER_F(HashTableBench, FindMiss)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_REGISTER_F(TaggedHashTableBench, FindMiss)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK_REGISTER_F(HashTableBench, FindDuringResize)
+        ->ThreadPerCpu()
+        ->Iterations(HashTableBench::numItems);
+BENCHMARK_REGISTER_F(IncrementalResizeHashTableBench, FindDuringResize)
+        ->ThreadPerCpu()
+        ->Iterations(HashTableBench::numItems);
 BENCHMARK_REGISTER_F(HashTableBench, FindForWrite)
         ->ThreadPerCpu()
         ->Iterations(HashTableBench::numItems);
@@ -0,0 +1,81 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/*
+ * Benchmarks relating to the ItemEviction class.
+ */
+
+#include "item_eviction.h"
+
+#include <benchmark/benchmark.h>
+#include <folly/Random.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ * The frequency counters and ages of the items visited by a paging pass,
+ * skewed towards low counters (as the counters are probabilistic).
+ */
+struct PagingPassItems {
+    explicit PagingPassItems(size_t numItems) {
+        folly::Random::DefaultGenerator gen(numItems);
+        freqs.reserve(numItems);
+        ages.reserve(numItems);
+        for (size_t ii = 0; ii < numItems; ++ii) {
+            freqs.push_back(uint8_t(folly::Random::rand32(
+                    folly::Random::rand32(1, 256, gen), gen)));
+            ages.push_back(folly::Random::rand64(uint64_t(1) << 40, gen));
+        }
+    }
+
+    std::vector<uint8_t> freqs;
+    std::vector<uint64_t> ages;
+};
+
+/**
+ * Benchmark the eviction statistics of one paging pass over a vBucket of
+ * state.range(0) items: each item visited is added to the histograms and
+ * the thresholds are recomputed as PagingVisitor does (every item while
+ * learning, then every 0.1% of the items).
+ */
+static void BM_ItemEvictionPagingPass(benchmark::State& state) {
+    const size_t numItems = state.range(0);
+    const PagingPassItems items(numItems);
+    const uint64_t interval =
+            std::max(uint64_t(std::ceil(numItems * 0.001)),
+                     ItemEviction::learningPopulation);
+
+    ItemEviction itemEviction;
+    while (state.KeepRunning()) {
+        itemEviction.reset();
+        itemEviction.setUpdateInterval(interval);
+        for (size_t ii = 0; ii < numItems; ++ii) {
+            itemEviction.addFreqAndAgeToHistograms(items.freqs[ii],
+                                                   items.ages[ii]);
+            if (itemEviction.isLearning() ||
+                itemEviction.isRequiredToUpdate()) {
+                benchmark::DoNotOptimize(
+                        itemEviction.getThresholds(10.0, 30.0));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+
+BENCHMARK(BM_ItemEvictionPagingPass)->Arg(10000)->Arg(1000000);
@@ -19,10 +19,12 @@
 #include "collections/manager.h"
 #include "collections/vbucket_manifest.h"
 #include "configuration.h"
+#include "couch-kvstore/couch-kvstore-config.h"
 #include "item.h"
 #include "kvstore.h"
 #include "kvstore_config.h"
 #include "vb_commit.h"
+#include "vbucket_bgfetch_item.h"
 #ifdef EP_USE_ROCKSDB
 #include "rocksdb-kvstore/rocksdb-kvstore_config.h"
 #endif
@@ -35,6 +37,8 @@
 #include <platform/dirutils.h>
 #include <programs/engine_testapp/mock_server.h>
 
+#include <random>
+
 using namespace std::string_literals;
 
 enum Storage {
@@ -104,7 +108,7 @@ protected:
                                       get_mock_server_api());
             WorkLoadPolicy workload(config.getMaxNumWorkers(),
                                     config.getMaxNumShards());
-            kvstoreConfig = std::make_unique<KVStoreConfig>(
+            kvstoreConfig = std::make_unique<CouchKVStoreConfig>(
                     config, workload.getNumShards(), shardId);
             break;
         }
@@ -206,3 +210,56 @@ BENCHMARK_REGISTER_F(KVStoreBench, Scan)
         ->Args({NUM_ITEMS, ROCKSDB})
 #endif
         ;
+
+/*
+ * Benchmark for KVStore::getMulti() - i.e. the disk reads of a BgFetch
+ * batch - with the reads of each batch issued one at a time (queue depth 1)
+ * or up to 64 at once via io_uring.
+ *
+ * Note the data file will likely be in the page cache, so this mostly
+ * measures the overhead of the batched read path; the benefit of deeper
+ * queues is seen when the reads have to go to the device.
+ */
+BENCHMARK_DEFINE_F(KVStoreBench, GetMulti)(benchmark::State& state) {
+    const auto queueDepth = state.range(2);
+    const auto coalesceGap = state.range(3);
+    auto& couchConfig = dynamic_cast<CouchKVStoreConfig&>(*kvstoreConfig);
+    couchConfig.setIoUringQueueDepth(queueDepth);
+    couchConfig.setBgFetchCoalesceGap(coalesceGap);
+    state.SetLabel("Couchstore queue_depth:" + std::to_string(queueDepth) +
+                   " coalesce_gap:" + std::to_string(coalesceGap));
+
+    const size_t batchSize = 64;
+    std::mt19937 gen;
+    std::uniform_int_distribution<int> dist(1, numItems);
+    size_t itemCountTotal = 0;
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        vb_bgfetch_queue_t itms;
+        while (itms.size() < batchSize) {
+            vb_bgfetch_item_ctx_t ctx;
+            ctx.addBgFetch(std::make_unique<FrontEndBGFetchItem>(
+                    nullptr, ValueFilter::VALUES_DECOMPRESSED));
+            auto key = makeStoredDocKey("key" + std::to_string(dist(gen)));
+            itms.emplace(DiskDocKey{key}, std::move(ctx));
+        }
+        state.ResumeTiming();
+
+        kvstore->getMulti(vbid, itms);
+
+        for (const auto& fetched : itms) {
+            ASSERT_EQ(cb::engine_errc::success,
+                      fetched.second.value.getStatus());
+        }
+        itemCountTotal += itms.size();
+    }
+
+    state.SetItemsProcessed(itemCountTotal);
+}
+
+BENCHMARK_REGISTER_F(KVStoreBench, GetMulti)
+        ->Args({NUM_ITEMS, COUCHSTORE, 0, 0})
+        ->Args({NUM_ITEMS, COUCHSTORE, 64, 0})
+        ->Args({NUM_ITEMS, COUCHSTORE, 0, 4096})
+        ->Args({NUM_ITEMS, COUCHSTORE, 64, 4096});
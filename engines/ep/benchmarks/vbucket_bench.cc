@@ -21,6 +21,7 @@
 
 #include "benchmark_memory_tracker.h"
 #include "checkpoint_manager.h"
+#include "collections/manifest.h"
 #include "engine_fixture.h"
 #include "ep_bucket.h"
 #include "fakes/fake_executorpool.h"
@@ -157,6 +158,63 @@ protected:
     }
 };
 
+/*
+ * Fixture for benchmarks of a CheckpointManager read by DCP cursors, with the
+ * default checkpoint configuration.
+ */
+class CheckpointCursorBench : public EngineFixture {
+protected:
+    void SetUp(const benchmark::State& state) override {
+        varConfig = "max_size=1000000000";
+
+        EngineFixture::SetUp(state);
+        if (state.thread_index == 0) {
+            engine->getKVBucket()->setVBucketState(Vbid(0),
+                                                   vbucket_state_active);
+        }
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        if (state.thread_index == 0) {
+            engine->getKVBucket()->deleteVBucket(vbid, this);
+        }
+        EngineFixture::TearDown(state);
+    }
+};
+
+/*
+ * Fixture for benchmarks of front-end operations against one vBucket from
+ * many threads, with the documents in either the default collection or a
+ * (non-default) collection.
+ */
+class CollectionsVBucketBench : public EngineFixture {
+protected:
+    void SetUp(const benchmark::State& state) override {
+        varConfig = "max_size=1000000000";
+
+        EngineFixture::SetUp(state);
+        if (state.thread_index == 0) {
+            engine->getKVBucket()->setVBucketState(Vbid(0),
+                                                   vbucket_state_active);
+            if (state.range(0)) {
+                auto vb = engine->getKVBucket()->getVBucket(vbid);
+                vb->updateFromManifest(Collections::Manifest{
+                        R"({"uid":"1",
+                            "scopes":[{"name":"_default","uid":"0",
+                            "collections":[{"name":"_default","uid":"0"},
+                                           {"name":"bench","uid":"8"}]}]})"});
+            }
+        }
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        if (state.thread_index == 0) {
+            engine->getKVBucket()->deleteVBucket(vbid, this);
+        }
+        EngineFixture::TearDown(state);
+    }
+};
+
 /**
  * Benchmark queueing items into a vBucket.
  * Items have a 10% chance of being a duplicate key of a previous item (to
@@ -448,6 +506,133 @@ BENCHMARK_DEFINE_F(CheckpointBench, QueueDirtyWithManyClosedUnrefCheckpoints)
     bgThread.join();
 }
 
+/**
+ * Benchmark the throughput of a front-end thread queueing items into a
+ * CheckpointManager while the given number of DCP cursors (each on its own
+ * thread, as the streams of replicas and indexers) keep up with it.
+ * Like ActiveStream, each reader checks for items, reads them and reads the
+ * high seqno, contending with the writer for the CM::queueLock.
+ */
+BENCHMARK_DEFINE_F(CheckpointCursorBench, QueueDirtyWithActiveCursors)
+(benchmark::State& state) {
+    const size_t numCursors = state.range(0);
+    // The keys cycle through a fixed set so that the open checkpoint stays a
+    // bounded size (by de-duplication).
+    const size_t numKeys = 10000;
+    const size_t batchSize = 1000;
+
+    auto* vb = engine->getKVBucket()->getVBucket(vbid).get();
+    auto* ckptMgr = vb->checkpointManager.get();
+
+    std::atomic<bool> done{false};
+    ThreadGate tg(numCursors + 1);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < numCursors; ++i) {
+        auto cursor = ckptMgr->registerCursorBySeqno(
+                                     "bench_cursor_" + std::to_string(i), 0)
+                              .cursor;
+        readers.emplace_back([&tg, &done, ckptMgr, vb, cursor]() {
+            tg.threadUp();
+            std::vector<queued_item> items;
+            while (!done) {
+                auto c = cursor.lock();
+                if (ckptMgr->hasItemsForCursor(c.get())) {
+                    ckptMgr->getNextItemsForCursor(c.get(), items);
+                    items.clear();
+                }
+                benchmark::DoNotOptimize(vb->getHighSeqno());
+            }
+        });
+    }
+
+    tg.threadUp();
+
+    size_t nextKey = 0;
+    size_t itemsQueuedTotal = 0;
+    std::vector<queued_item> batch;
+    while (state.KeepRunning()) {
+        // Note we don't include the time taken to make the items.
+        state.PauseTiming();
+        batch.clear();
+        for (size_t i = 0; i < batchSize; ++i) {
+            batch.emplace_back(new Item(
+                    StoredDocKey("key" + std::to_string(nextKey++ % numKeys),
+                                 CollectionID::Default),
+                    vbid,
+                    queue_op::mutation,
+                    /*revSeq*/ 0,
+                    /*bySeq*/ 0));
+        }
+        state.ResumeTiming();
+
+        for (auto& qi : batch) {
+            ckptMgr->queueDirty(*vb,
+                                qi,
+                                GenerateBySeqno::Yes,
+                                GenerateCas::Yes,
+                                /*preLinkDocCtx*/ nullptr);
+        }
+        itemsQueuedTotal += batch.size();
+    }
+
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    state.SetItemsProcessed(itemsQueuedTotal);
+}
+
+/**
+ * Benchmark the throughput of a set followed by a get of the same document,
+ * from each of a number of front-end threads. Every operation obtains the
+ * vBucket's collections manifest (via a CachingReadHandle), so this shows how
+ * reading the manifest scales with the number of threads; for documents in
+ * the default collection and in a non-default collection.
+ */
+BENCHMARK_DEFINE_F(CollectionsVBucketBench, SetGet)
+(benchmark::State& state) {
+    const CollectionID collection =
+            state.range(0) ? CollectionID(8) : CollectionID::Default;
+    // Each thread cycles through its own set of keys
+    const size_t numKeys = 1000;
+    std::vector<StoredDocKey> keys;
+    for (size_t i = 0; i < numKeys; ++i) {
+        keys.emplace_back("key_" + std::to_string(state.thread_index) + "_" +
+                                  std::to_string(i),
+                          collection);
+    }
+
+    auto* kvBucket = engine->getKVBucket();
+    const std::string value(100, 'x');
+    const auto options = static_cast<get_options_t>(
+            QUEUE_BG_FETCH | HONOR_STATES | TRACK_REFERENCE | DELETE_TEMP |
+            HIDE_LOCKED_CAS | TRACK_STATISTICS);
+    size_t nextKey = 0;
+    while (state.KeepRunning()) {
+        const auto& key = keys[nextKey++ % numKeys];
+        Item item(key,
+                  /*flags*/ 0,
+                  /*exp*/ 0,
+                  value.data(),
+                  value.size(),
+                  PROTOCOL_BINARY_DATATYPE_JSON);
+        item.setVBucketId(vbid);
+        if (kvBucket->set(item, cookie) != cb::engine_errc::success) {
+            state.SkipWithError("Failed to set document");
+            break;
+        }
+        auto gv = kvBucket->get(key, vbid, cookie, options);
+        if (gv.getStatus() != cb::engine_errc::success) {
+            state.SkipWithError("Failed to get document");
+            break;
+        }
+    }
+    // A set and a get per iteration
+    state.SetItemsProcessed(state.iterations() * 2);
+    state.SetLabel(state.range(0) ? "collection" : "default collection");
+}
+
 // Run with couchstore backend(0); item counts from 1..10,000,000
 BENCHMARK_REGISTER_F(MemTrackingVBucketBench, QueueDirty)
         ->Args({0, 1})
@@ -485,3 +670,17 @@ BENCHMARK_REGISTER_F(MemTrackingVBucketBench, FlushVBucket)
 BENCHMARK_REGISTER_F(CheckpointBench, QueueDirtyWithManyClosedUnrefCheckpoints)
         ->Args({1000000, 1000})
         ->Iterations(1);
+
+// Arguments: numCursors
+BENCHMARK_REGISTER_F(CheckpointCursorBench, QueueDirtyWithActiveCursors)
+        ->Arg(0)
+        ->Arg(4)
+        ->Arg(16)
+        ->UseRealTime();
+
+// Arguments: documents in the default collection (0) or another collection (1)
+BENCHMARK_REGISTER_F(CollectionsVBucketBench, SetGet)
+        ->Arg(0)
+        ->Arg(1)
+        ->ThreadRange(1, 64)
+        ->UseRealTime();
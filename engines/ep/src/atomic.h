@@ -242,6 +242,31 @@ public:
         return value == other.value;
     }
 
+    /**
+     * Attempt to take a new reference on the object pointed to by `p`,
+     * when the caller does *not* hold the lock guarding the owning
+     * SingleThreadedRCPtr(s). Fails (returning an empty pointer) if the
+     * object's reference count has already dropped to zero - i.e. it is in
+     * the process of being freed; a count of zero is never resurrected.
+     *
+     * The caller must ensure the memory pointed to by `p` remains valid for
+     * the duration of the call - for example via DeferredReclamation.
+     */
+    static SingleThreadedRCPtr tryAcquire(Pointer p) {
+        SingleThreadedRCPtr result;
+        if (p == nullptr) {
+            return result;
+        }
+        auto count = p->_rc_refcount.load();
+        while (count > 0) {
+            if (p->_rc_refcount.compare_exchange_weak(count, count + 1)) {
+                result.value = p;
+                break;
+            }
+        }
+        return result;
+    }
+
 private:
     template <typename Y, typename P, typename D>
     friend class SingleThreadedRCPtr;
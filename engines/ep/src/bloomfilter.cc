@@ -21,7 +21,12 @@
 
 #include "murmurhash3.h"
 
+#include <folly/hash/Hash.h>
+#include <folly/lang/Bits.h>
+
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #if __x86_64__ || __ppc64__
 #define MURMURHASH_3 MurmurHash3_x64_128
@@ -29,19 +34,90 @@
 #define MURMURHASH_3 MurmurHash3_x86_128
 #endif
 
-BloomFilter::BloomFilter(size_t key_count, double false_positive_prob,
-                         bfilter_status_t new_status) {
+/// Number of bits in each block of a Blocked filter.
+static constexpr size_t bitsPerBlock = 64 * 8;
+
+/// Odd multipliers used to derive each lane's bit from a key's hash.
+static constexpr std::array<uint32_t, 8> blockSalts = {{0x47b6137bU,
+                                                        0x44974d91U,
+                                                        0x8824ad5bU,
+                                                        0xa2b7289dU,
+                                                        0x705495c7U,
+                                                        0x2df1424bU,
+                                                        0x9efc4947U,
+                                                        0x5c6bfb31U}};
 
+BloomFilter::BloomFilter(size_t key_count,
+                         double false_positive_prob,
+                         bfilter_status_t new_status,
+                         Type type)
+    : type(type) {
     status = new_status;
-    filterSize = estimateFilterSize(key_count, false_positive_prob);
-    noOfHashes = estimateNoOfHashes(key_count);
     keyCounter = 0;
-    bitArray.assign(filterSize, false);
+    if (type == Type::Blocked) {
+        stages.emplace_back(std::max(key_count, size_t(1)),
+                            false_positive_prob);
+        filterSize = stages.front().blocks.size() * bitsPerBlock;
+        noOfHashes = Block::Lanes;
+    } else {
+        filterSize = estimateFilterSize(key_count, false_positive_prob);
+        noOfHashes = estimateNoOfHashes(key_count);
+        bitArray.assign(filterSize, false);
+    }
+}
+
+BloomFilter::BloomFilter(Type type, bfilter_status_t new_status)
+    : type(type),
+      filterSize(0),
+      noOfHashes(0),
+      keyCounter(0),
+      status(new_status) {
 }
 
 BloomFilter::~BloomFilter() {
     status = BFILTER_DISABLED;
-    bitArray.clear();
+    clearBits();
+}
+
+std::array<uint64_t, BloomFilter::Block::Lanes> BloomFilter::Block::masks(
+        uint32_t hash) {
+    static_assert(blockSalts.size() == Lanes, "Need one salt per lane");
+    std::array<uint64_t, Lanes> result;
+    for (size_t i = 0; i < Lanes; i++) {
+        result[i] = uint64_t(1) << ((hash * blockSalts[i]) >> 26);
+    }
+    return result;
+}
+
+void BloomFilter::Block::insert(uint32_t hash) {
+    const auto bits = masks(hash);
+    for (size_t i = 0; i < Lanes; i++) {
+        lanes[i] |= bits[i];
+    }
+}
+
+bool BloomFilter::Block::contains(uint32_t hash) const {
+    // Accumulate any missing bits across all lanes rather than returning at
+    // the first miss, keeping the loop branch-free so it vectorises into a
+    // handful of SIMD ops over the whole cache line.
+    const auto bits = masks(hash);
+    uint64_t missing = 0;
+    for (size_t i = 0; i < Lanes; i++) {
+        missing |= bits[i] & ~lanes[i];
+    }
+    return missing == 0;
+}
+
+BloomFilter::Stage::Stage(size_t capacity, double false_positive_prob)
+    : blocks(estimateNoOfBlocks(capacity, false_positive_prob)),
+      capacity(capacity),
+      falsePositiveProb(false_positive_prob) {
+}
+
+size_t BloomFilter::Stage::blockIndex(uint64_t hash) const {
+    // Map the upper 32 bits of the hash onto [0, blocks) by multiply-shift,
+    // leaving the lower 32 bits to select the bits within the block.
+    return ((hash >> 32) * blocks.size()) >> 32;
 }
 
 size_t BloomFilter::estimateFilterSize(size_t key_count,
@@ -54,6 +130,49 @@ size_t BloomFilter::estimateNoOfHashes(size_t key_count) {
     return round(((double) filterSize / key_count) * (log(2.0)));
 }
 
+size_t BloomFilter::estimateNoOfBlocks(size_t key_count,
+                                       double false_positive_prob) {
+    // Start from the size of a Classic filter with the same parameters.
+    // Confining each key to one block makes a Blocked filter somewhat less
+    // accurate for a given size (keys are not evenly spread over blocks), so
+    // grow from there until the expected false positive rate is met.
+    const double bits = std::max(
+            0.0,
+            -((double)(key_count)*log(false_positive_prob)) /
+                    pow(log(2.0), 2));
+    auto blocks = std::max(size_t(1), size_t(ceil(bits / bitsPerBlock)));
+    const auto limit = blocks * 64;
+    while (blocks < limit &&
+           estimateBlockedFalsePositiveRate(key_count, blocks) >
+                   false_positive_prob) {
+        blocks += blocks / 16 + 1;
+    }
+    return blocks;
+}
+
+double BloomFilter::estimateBlockedFalsePositiveRate(size_t key_count,
+                                                     size_t blocks) {
+    // The number of keys in a block is ~Poisson(key_count / blocks). A block
+    // holding n keys gives a false positive if all Lanes bits probed are
+    // set; each is set with probability 1 - (1 - 1/64)^n. Sum over the
+    // range of n carrying any meaningful probability mass.
+    if (key_count == 0) {
+        return 0;
+    }
+    const double lambda = (double)(key_count) / blocks;
+    const double spread = 10 * sqrt(lambda) + 10;
+    const auto first = size_t(std::max(0.0, lambda - spread));
+    const auto last = size_t(lambda + spread);
+    double rate = 0;
+    for (size_t n = first; n <= last; n++) {
+        const double probOfN =
+                exp(n * log(lambda) - lambda - lgamma(n + 1.0));
+        const double bitSet = 1 - pow(1 - 1.0 / 64, n);
+        rate += probOfN * pow(bitSet, Block::Lanes);
+    }
+    return rate;
+}
+
 uint64_t BloomFilter::hashDocKey(const DocKey& key, uint32_t iteration) {
     uint64_t result = 0;
     auto hashable = key.getIdAndKey();
@@ -62,6 +181,17 @@ uint64_t BloomFilter::hashDocKey(const DocKey& key, uint32_t iteration) {
     return result;
 }
 
+uint64_t BloomFilter::stageHash(uint64_t hash, size_t stage) {
+    // Later stages re-mix the key's hash so a key colliding with another in
+    // one stage is unlikely to collide with it in the next.
+    return stage == 0 ? hash : folly::hash::twang_mix64(hash + stage);
+}
+
+void BloomFilter::clearBits() {
+    bitArray.clear();
+    stages.clear();
+}
+
 void BloomFilter::setStatus(bfilter_status_t to) {
     switch (status) {
         case BFILTER_DISABLED:
@@ -72,7 +202,7 @@ void BloomFilter::setStatus(bfilter_status_t to) {
         case BFILTER_PENDING:
             if (to == BFILTER_DISABLED) {
                 status = to;
-                bitArray.clear();
+                clearBits();
             } else if (to == BFILTER_COMPACTING) {
                 status = to;
             }
@@ -80,7 +210,7 @@ void BloomFilter::setStatus(bfilter_status_t to) {
         case BFILTER_COMPACTING:
             if (to == BFILTER_DISABLED) {
                 status = to;
-                bitArray.clear();
+                clearBits();
             } else if (to == BFILTER_ENABLED) {
                 status = to;
             }
@@ -88,7 +218,7 @@ void BloomFilter::setStatus(bfilter_status_t to) {
         case BFILTER_ENABLED:
             if (to == BFILTER_DISABLED) {
                 status = to;
-                bitArray.clear();
+                clearBits();
             } else if (to == BFILTER_COMPACTING) {
                 status = to;
             }
@@ -116,6 +246,10 @@ std::string BloomFilter::getStatusString() {
 
 void BloomFilter::addKey(const DocKey& key) {
     if (status == BFILTER_COMPACTING || status == BFILTER_ENABLED) {
+        if (type == Type::Blocked) {
+            addKeyBlocked(hashDocKey(key, 0));
+            return;
+        }
         bool overlap = true;
         for (uint32_t i = 0; i < noOfHashes; i++) {
             uint64_t result = hashDocKey(key, i);
@@ -130,8 +264,56 @@ void BloomFilter::addKey(const DocKey& key) {
     }
 }
 
+void BloomFilter::addKeyBlocked(uint64_t keyHash) {
+    if (stages.empty()) {
+        return;
+    }
+    if (maybeKeyExistsBlocked(keyHash)) {
+        // As for a Classic filter whose bits were all already set, the key
+        // (or one indistinguishable from it) is already accounted for.
+        return;
+    }
+
+    if (stages.back().keys >= stages.back().capacity) {
+        // The current stage has outgrown the key count it was sized for;
+        // rather than let its false positive rate climb, add new keys to a
+        // larger stage with half the false positive probability, bounding
+        // the overall rate to twice that of the first stage.
+        const auto capacity = stages.back().capacity * 2;
+        const auto prob = stages.back().falsePositiveProb / 2;
+        stages.emplace_back(capacity, prob);
+        filterSize += stages.back().blocks.size() * bitsPerBlock;
+    }
+
+    auto& stage = stages.back();
+    const auto hash = stageHash(keyHash, stages.size() - 1);
+    stage.blocks[stage.blockIndex(hash)].insert(uint32_t(hash));
+    stage.keys++;
+    keyCounter++;
+}
+
+bool BloomFilter::maybeKeyExistsBlocked(uint64_t keyHash) {
+    if (stages.empty()) {
+        // The key may exist.
+        return true;
+    }
+    for (size_t i = 0; i < stages.size(); i++) {
+        const auto& stage = stages[i];
+        const auto hash = stageHash(keyHash, i);
+        if (stage.blocks[stage.blockIndex(hash)].contains(uint32_t(hash))) {
+            // The key may exist.
+            return true;
+        }
+    }
+    // The key does NOT exist.
+    return false;
+}
+
 bool BloomFilter::maybeKeyExists(const DocKey& key) {
     if (status == BFILTER_COMPACTING || status == BFILTER_ENABLED) {
+        if (type == Type::Blocked) {
+            return maybeKeyExistsBlocked(hashDocKey(key, 0));
+        }
         for (uint32_t i = 0; i < noOfHashes; i++) {
             uint64_t result = hashDocKey(key, i);
             if (bitArray[result % filterSize] == 0) {
@@ -167,3 +349,135 @@ size_t BloomFilter::getNoOfHashes() const {
         return 0;
     }
 }
+
+size_t BloomFilter::getNumOfStages() const {
+    return type == Type::Blocked ? stages.size() : 1;
+}
+
+/// Version of the format produced by BloomFilter::serialise().
+static constexpr uint8_t serialisedVersion = 1;
+
+static void appendUint64(std::string& out, uint64_t value) {
+    value = folly::Endian::little(value);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static bool readUint64(std::string_view& in, uint64_t& value) {
+    if (in.size() < sizeof(value)) {
+        return false;
+    }
+    std::memcpy(&value, in.data(), sizeof(value));
+    value = folly::Endian::little(value);
+    in.remove_prefix(sizeof(value));
+    return true;
+}
+
+std::string BloomFilter::serialise() const {
+    std::string out;
+    out.push_back(char(serialisedVersion));
+    out.push_back(char(type));
+    appendUint64(out, filterSize);
+    appendUint64(out, noOfHashes);
+    appendUint64(out, keyCounter);
+
+    if (type == Type::Blocked) {
+        appendUint64(out, stages.size());
+        for (const auto& stage : stages) {
+            uint64_t prob;
+            std::memcpy(&prob, &stage.falsePositiveProb, sizeof(prob));
+            appendUint64(out, stage.capacity);
+            appendUint64(out, prob);
+            appendUint64(out, stage.keys);
+            appendUint64(out, stage.blocks.size());
+            for (const auto& block : stage.blocks) {
+                for (auto lane : block.lanes) {
+                    appendUint64(out, lane);
+                }
+            }
+        }
+    } else {
+        // Pack the bits, 8 per byte.
+        std::string bytes((bitArray.size() + 7) / 8, '\0');
+        for (size_t i = 0; i < bitArray.size(); i++) {
+            if (bitArray[i]) {
+                bytes[i / 8] |= char(1 << (i % 8));
+            }
+        }
+        appendUint64(out, bitArray.size());
+        out.append(bytes);
+    }
+    return out;
+}
+
+std::unique_ptr<BloomFilter> BloomFilter::deserialise(
+        std::string_view data, bfilter_status_t newStatus) {
+    if (data.size() < 2 || uint8_t(data[0]) != serialisedVersion ||
+        uint8_t(data[1]) > uint8_t(Type::Blocked)) {
+        return {};
+    }
+    const auto type = Type(uint8_t(data[1]));
+    data.remove_prefix(2);
+
+    std::unique_ptr<BloomFilter> bf(new BloomFilter(type, newStatus));
+    uint64_t filterSize;
+    uint64_t noOfHashes;
+    uint64_t keyCounter;
+    if (!readUint64(data, filterSize) || !readUint64(data, noOfHashes) ||
+        !readUint64(data, keyCounter)) {
+        return {};
+    }
+    bf->filterSize = filterSize;
+    bf->noOfHashes = noOfHashes;
+    bf->keyCounter = keyCounter;
+
+    if (type == Type::Blocked) {
+        uint64_t numStages;
+        if (!readUint64(data, numStages) || numStages == 0) {
+            return {};
+        }
+        uint64_t totalBits = 0;
+        for (uint64_t i = 0; i < numStages; i++) {
+            uint64_t capacity;
+            uint64_t prob;
+            uint64_t keys;
+            uint64_t numBlocks;
+            if (!readUint64(data, capacity) || !readUint64(data, prob) ||
+                !readUint64(data, keys) || !readUint64(data, numBlocks) ||
+                numBlocks == 0 || data.size() / sizeof(Block) < numBlocks) {
+                return {};
+            }
+            // Construct an empty stage, then fill it from the data.
+            bf->stages.emplace_back(0, 1.0);
+            auto& stage = bf->stages.back();
+            stage.capacity = capacity;
+            std::memcpy(&stage.falsePositiveProb, &prob, sizeof(prob));
+            stage.keys = keys;
+            stage.blocks.resize(numBlocks);
+            for (auto& block : stage.blocks) {
+                for (auto& lane : block.lanes) {
+                    readUint64(data, lane);
+                }
+            }
+            totalBits += numBlocks * bitsPerBlock;
+        }
+        if (totalBits != filterSize || noOfHashes != Block::Lanes) {
+            return {};
+        }
+    } else {
+        uint64_t numBits;
+        if (!readUint64(data, numBits) || numBits != filterSize ||
+            data.size() != (numBits + 7) / 8) {
+            return {};
+        }
+        bf->bitArray.assign(numBits, false);
+        for (size_t i = 0; i < numBits; i++) {
+            bf->bitArray[i] = (uint8_t(data[i / 8]) >> (i % 8)) & 1;
+        }
+        data.remove_prefix(data.size());
+    }
+
+    if (!data.empty()) {
+        return {};
+    }
+    return bf;
+}
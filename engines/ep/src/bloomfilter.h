@@ -16,7 +16,11 @@
  */
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct DocKey;
@@ -33,11 +37,32 @@ enum bfilter_status_t {
  * We are to maintain the vbucket-number of these instances.
  *
  * Each vbucket will hold one such object.
+ *
+ * Two layouts are supported (see Type). A Classic filter is a single bit
+ * array probed by noOfHashes independent hashes - i.e. noOfHashes random
+ * memory accesses per key. A Blocked filter is an array of cache-line sized
+ * blocks: one hash per key selects a block, and one bit is set / tested in
+ * each 64-bit lane of that block, so a probe touches a single cache line and
+ * the per-lane test is a branch-free loop the compiler can vectorise.
+ *
+ * A Blocked filter also grows online: once the keys added exceed the count
+ * it was sized for, a further (twice as large, tighter false positive)
+ * stage is appended and new keys are added to that, keeping the overall
+ * false positive rate bounded when the key count estimate was too low.
  */
 class BloomFilter {
 public:
+    /// Layout of the filter's bits.
+    enum class Type : uint8_t {
+        /// Single bit array, noOfHashes independent hashes per key.
+        Classic,
+        /// Cache-line sized blocks, one block per key; grows as needed.
+        Blocked
+    };
+
     BloomFilter(size_t key_count, double false_positive_prob,
-                bfilter_status_t newStatus = BFILTER_DISABLED);
+                bfilter_status_t newStatus = BFILTER_DISABLED,
+                Type type = Type::Classic);
     ~BloomFilter();
 
     void setStatus(bfilter_status_t to);
@@ -51,12 +76,99 @@ public:
     size_t getFilterSize();
     size_t getNoOfHashes() const;
 
+    Type getType() const {
+        return type;
+    }
+
+    /// @returns the number of stages of a Blocked filter (1 until it has
+    /// grown beyond its initial key count); 1 for a Classic filter.
+    size_t getNumOfStages() const;
+
+    /**
+     * @returns the filter's contents (layout, sizing and bits, but not its
+     * status) in a form which can be persisted and later restored with
+     * deserialise().
+     */
+    std::string serialise() const;
+
+    /**
+     * Recreate a filter from the output of serialise().
+     *
+     * @param data serialised filter
+     * @param newStatus status of the recreated filter
+     * @returns the filter, or nullptr if data is not a valid serialised filter
+     */
+    static std::unique_ptr<BloomFilter> deserialise(
+            std::string_view data, bfilter_status_t newStatus);
+
 protected:
+    /// Construct an empty filter of the given type, for deserialise().
+    BloomFilter(Type type, bfilter_status_t newStatus);
+
+    /**
+     * One cache line of a Blocked filter. A key sets one bit in each lane,
+     * the bit for lane i chosen by multiplying the key's (32-bit) hash by
+     * the lane's odd salt and taking the top 6 bits.
+     */
+    struct alignas(64) Block {
+        static constexpr size_t Lanes = 8;
+
+        /// @returns the bit to set / test in each lane for the given hash.
+        static std::array<uint64_t, Lanes> masks(uint32_t hash);
+
+        void insert(uint32_t hash);
+        bool contains(uint32_t hash) const;
+
+        std::array<uint64_t, Lanes> lanes{};
+    };
+    static_assert(sizeof(Block) == 64, "Block should be one cache line");
+
+    /**
+     * A Blocked filter's blocks, sized for `capacity` keys at the false
+     * positive probability the stage was created with.
+     */
+    struct Stage {
+        Stage(size_t capacity, double false_positive_prob);
+
+        /// @returns the block for the given 64-bit key hash.
+        size_t blockIndex(uint64_t hash) const;
+
+        std::vector<Block> blocks;
+        size_t capacity;
+        double falsePositiveProb;
+        size_t keys = 0;
+    };
+
     size_t estimateFilterSize(size_t key_count, double false_positive_prob);
     size_t estimateNoOfHashes(size_t key_count);
 
+    /**
+     * @returns the number of Blocks a Blocked filter needs for key_count
+     * keys at the given false positive probability.
+     */
+    static size_t estimateNoOfBlocks(size_t key_count,
+                                     double false_positive_prob);
+
+    /**
+     * @returns the expected false positive rate of a Blocked filter with
+     * the given number of blocks holding key_count keys.
+     */
+    static double estimateBlockedFalsePositiveRate(size_t key_count,
+                                                   size_t blocks);
+
     uint64_t hashDocKey(const DocKey& key, uint32_t iteration);
 
+    /// @returns the hash used to address the given Blocked stage.
+    static uint64_t stageHash(uint64_t hash, size_t stage);
+
+    void addKeyBlocked(uint64_t keyHash);
+    bool maybeKeyExistsBlocked(uint64_t keyHash);
+
+    /// Free the filter's bits (on transition to BFILTER_DISABLED).
+    void clearBits();
+
+    const Type type;
+
     size_t filterSize;
     size_t noOfHashes;
 
@@ -64,4 +176,7 @@ protected:
 
     bfilter_status_t status;
     std::vector<bool> bitArray;
+
+    /// Stages of a Blocked filter, oldest (smallest) first.
+    std::vector<Stage> stages;
 };
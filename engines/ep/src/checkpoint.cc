@@ -128,6 +128,21 @@ size_t CheckpointCursor::getRemainingItemsCount() const {
     return remaining;
 }
 
+bool CheckpointCursor::hasRemainingItems() const {
+    ChkptQueueIterator itr = currentPos;
+    // Start looking from the next item
+    if (itr != (*currentCheckpoint)->end()) {
+        ++itr;
+    }
+    while (itr != (*currentCheckpoint)->end()) {
+        if (!(*itr)->isCheckPointMetaItem()) {
+            return true;
+        }
+        ++itr;
+    }
+    return false;
+}
+
 CheckpointType CheckpointCursor::getCheckpointType() const {
     return (*currentCheckpoint)->getCheckpointType();
 }
@@ -332,6 +347,8 @@ QueueDirtyStatus Checkpoint::queueDirty(const queued_item& qi,
                 // Reduce the size of the checkpoint by the size of the
                 // item being removed.
                 queuedItemsMemUsage -= ((*currPos)->size());
+                checkpointManager->removeItemFromSharedCursorBatch_UNLOCKED(
+                        *this, *currPos);
                 // Remove the existing item for the same key from the list.
                 toWrite.erase(
                         ChkptQueueIterator::const_underlying_iterator{currPos});
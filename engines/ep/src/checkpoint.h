@@ -203,6 +203,15 @@ private:
      */
     size_t getRemainingItemsCount() const;
 
+    /*
+     * Check if there is any item (excluding meta-items) remaining to be
+     * processed in the checkpoint the cursor is currently in. Unlike
+     * getRemainingItemsCount() this stops at the first such item.
+     *
+     * @return true if there is an item remaining to be processed.
+     */
+    bool hasRemainingItems() const;
+
     std::string                      name;
     CheckpointList::iterator currentCheckpoint;
 
@@ -45,6 +45,8 @@ public:
             config.allowItemNumBasedNewCheckpoint(value);
         } else if (key.compare("keep_closed_chks") == 0) {
             config.allowKeepClosedCheckpoints(value);
+        } else if (key.compare("dcp_shared_checkpoint_reads") == 0) {
+            config.setDcpSharedCheckpointReads(value);
         }
     }
 
@@ -66,13 +68,15 @@ CheckpointConfig::CheckpointConfig(rel_time_t period,
                                    size_t max_ckpts,
                                    bool item_based_new_ckpt,
                                    bool keep_closed_ckpts,
-                                   bool persistence_enabled)
+                                   bool persistence_enabled,
+                                   bool dcp_shared_checkpoint_reads)
     : checkpointPeriod(period),
       checkpointMaxItems(max_items),
       maxCheckpoints(max_ckpts),
       itemNumBasedNewCheckpoint(item_based_new_ckpt),
       keepClosedCheckpoints(keep_closed_ckpts),
-      persistenceEnabled(persistence_enabled) {
+      persistenceEnabled(persistence_enabled),
+      dcpSharedCheckpointReads(dcp_shared_checkpoint_reads) {
 }
 
 CheckpointConfig::CheckpointConfig(EventuallyPersistentEngine& e) {
@@ -83,6 +87,7 @@ CheckpointConfig::CheckpointConfig(EventuallyPersistentEngine& e) {
     itemNumBasedNewCheckpoint = config.isItemNumBasedNewChk();
     keepClosedCheckpoints = config.isKeepClosedChks();
     persistenceEnabled = config.getBucketType() == "persistent";
+    dcpSharedCheckpointReads = config.isDcpSharedCheckpointReads();
 }
 
 void CheckpointConfig::addConfigChangeListener(
@@ -103,6 +108,9 @@ void CheckpointConfig::addConfigChangeListener(
     configuration.addValueChangedListener(
             "keep_closed_chks",
             std::make_unique<ChangeListener>(engine.getCheckpointConfig()));
+    configuration.addValueChangedListener(
+            "dcp_shared_checkpoint_reads",
+            std::make_unique<ChangeListener>(engine.getCheckpointConfig()));
 }
 
 bool CheckpointConfig::validateCheckpointMaxItemsParam(
@@ -34,7 +34,8 @@ public:
                      size_t max_ckpts,
                      bool item_based_new_ckpt,
                      bool keep_closed_ckpts,
-                     bool persistence_enabled);
+                     bool persistence_enabled,
+                     bool dcp_shared_checkpoint_reads = false);
 
     explicit CheckpointConfig(EventuallyPersistentEngine& e);
 
@@ -62,6 +63,10 @@ public:
         return persistenceEnabled;
     }
 
+    bool isDcpSharedCheckpointReads() const {
+        return dcpSharedCheckpointReads;
+    }
+
 protected:
     friend class CheckpointConfigChangeListener;
     friend class EventuallyPersistentEngine;
@@ -82,6 +87,10 @@ protected:
         keepClosedCheckpoints = value;
     }
 
+    void setDcpSharedCheckpointReads(bool value) {
+        dcpSharedCheckpointReads = value;
+    }
+
     static void addConfigChangeListener(EventuallyPersistentEngine& engine);
 
 private:
@@ -104,4 +113,8 @@ private:
 
     // Flag indicating if persistence is enabled.
     bool persistenceEnabled;
+
+    // Flag indicating if DCP cursors at the same position may share the items
+    // read from the checkpoints by the first of them.
+    bool dcpSharedCheckpointReads = false;
 };
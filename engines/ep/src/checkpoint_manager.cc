@@ -26,6 +26,7 @@
 #include "vbucket.h"
 #include "vbucket_state.h"
 
+#include <algorithm>
 #include <utility>
 
 #include <gsl/gsl-lite.hpp>
@@ -35,6 +36,44 @@
 constexpr const char* CheckpointManager::pCursorName;
 constexpr const char* CheckpointManager::backupPCursorName;
 
+struct CheckpointManager::SharedCursorBatch {
+    SharedCursorBatch(CheckpointList::iterator startCheckpoint,
+                      ChkptQueueIterator startPos,
+                      CheckpointList::iterator endCheckpoint,
+                      ChkptQueueIterator endPos,
+                      std::vector<queued_item> items,
+                      const ItemsForCursor& result)
+        : startCheckpoint(startCheckpoint),
+          startPos(startPos),
+          endCheckpoint(endCheckpoint),
+          endPos(endPos),
+          items(std::move(items)),
+          checkpointType(result.checkpointType),
+          ranges(result.ranges),
+          moreAvailable(result.moreAvailable),
+          maxDeletedRevSeqno(result.maxDeletedRevSeqno),
+          highCompletedSeqno(result.highCompletedSeqno),
+          visibleSeqno(result.visibleSeqno) {
+    }
+
+    // The position the items were read from
+    CheckpointList::iterator startCheckpoint;
+    ChkptQueueIterator startPos;
+    // The position the cursor reading the items moved to
+    CheckpointList::iterator endCheckpoint;
+    ChkptQueueIterator endPos;
+
+    const std::vector<queued_item> items;
+
+    // The ItemsForCursor returned with the items
+    const CheckpointType checkpointType;
+    const std::vector<CheckpointSnapshotRange> ranges;
+    const bool moreAvailable;
+    const std::optional<uint64_t> maxDeletedRevSeqno;
+    const std::optional<uint64_t> highCompletedSeqno;
+    const uint64_t visibleSeqno;
+};
+
 CheckpointManager::CheckpointManager(EPStats& st,
                                      Vbid vbucket,
                                      CheckpointConfig& config,
@@ -75,6 +114,8 @@ CheckpointManager::CheckpointManager(EPStats& st,
     }
 }
 
+CheckpointManager::~CheckpointManager() = default;
+
 uint64_t CheckpointManager::getOpenCheckpointId_UNLOCKED(const LockHolder& lh) {
     return getOpenCheckpoint_UNLOCKED(lh).getId();
 }
@@ -95,6 +136,19 @@ uint64_t CheckpointManager::getLastClosedCheckpointId() {
     return getLastClosedCheckpointId_UNLOCKED(lh);
 }
 
+std::optional<uint64_t> CheckpointManager::getHighPreparedSeqno() const {
+    LockHolder lh(queueLock);
+    // Seqnos increase along the list, so the last checkpoint with a prepare
+    // has the highest.
+    for (auto it = checkpointList.rbegin(); it != checkpointList.rend();
+         ++it) {
+        if (const auto hps = (*it)->getHighPreparedSeqno()) {
+            return hps;
+        }
+    }
+    return {};
+}
+
 void CheckpointManager::setOpenCheckpointId(uint64_t id) {
     LockHolder lh(queueLock);
     setOpenCheckpointId_UNLOCKED(lh, id);
@@ -129,7 +183,7 @@ void CheckpointManager::setOpenCheckpointId_UNLOCKED(const LockHolder& lh,
             id,
             vbucketId,
             (*ckpt_start)->getBySeqno(),
-            lastBySeqno);
+            lastBySeqno.load());
 }
 
 Checkpoint& CheckpointManager::getOpenCheckpoint_UNLOCKED(
@@ -555,6 +609,10 @@ size_t CheckpointManager::removeClosedUnrefCheckpoints(
         }
         size_t total_items = numUnrefItems + numMetaItems;
         numItems.fetch_sub(total_items);
+        if (it != checkpointList.begin()) {
+            // The shared batch may have been read from a removed checkpoint
+            sharedCursorBatch.reset();
+        }
         unrefCheckpointList.splice(unrefCheckpointList.begin(),
                                    checkpointList,
                                    checkpointList.begin(),
@@ -671,6 +729,7 @@ CheckpointManager::expelUnreferencedCheckpointItems() {
          * queue thereby ensuring they still have a reference whilst
          * the queuelock is being held.
          */
+        sharedCursorBatch.reset();
         expelledItems = oldestCheckpoint->expelItems(expelUpToAndIncluding);
     }
 
@@ -1007,6 +1066,25 @@ CheckpointManager::ItemsForCursor CheckpointManager::getItemsForCursor(
 
     auto& cursor = *cursorPtr;
 
+    // DCP cursors reading everything available may be given the items another
+    // cursor read from the same position (and share what they read
+    // themselves). The persistence cursor never shares, as it may read less
+    // than everything, and must register its backup cursor.
+    bool shareRead = false;
+    if (!checkpointConfig.isDcpSharedCheckpointReads()) {
+        sharedCursorBatch.reset();
+    } else if (cursorPtr != persistenceCursor &&
+               approxLimit == std::numeric_limits<size_t>::max()) {
+        auto shared = getSharedItemsForCursor(lh, cursor, items);
+        if (shared) {
+            return std::move(*shared);
+        }
+        shareRead = true;
+    }
+    const auto startCheckpoint = cursor.currentCheckpoint;
+    const auto startPos = cursor.currentPos;
+    const auto firstItem = items.size();
+
     // Fetch whole checkpoints; as long as we don't exceed the approx item
     // limit.
     ItemsForCursor result(
@@ -1127,11 +1205,73 @@ CheckpointManager::ItemsForCursor CheckpointManager::getItemsForCursor(
                 result.moreAvailable ? "true" : "false");
     }
 
+    if (shareRead && itemCount > 0) {
+        sharedCursorBatch = std::make_unique<SharedCursorBatch>(
+                startCheckpoint,
+                startPos,
+                cursor.currentCheckpoint,
+                cursor.currentPos,
+                std::vector<queued_item>(items.begin() + firstItem,
+                                         items.end()),
+                result);
+    }
+
     cursor.numVisits++;
 
     return result;
 }
 
+std::optional<CheckpointManager::ItemsForCursor>
+CheckpointManager::getSharedItemsForCursor(const LockHolder& lh,
+                                           CheckpointCursor& cursor,
+                                           std::vector<queued_item>& items) {
+    if (!sharedCursorBatch || !cursor.valid()) {
+        return {};
+    }
+
+    auto& batch = *sharedCursorBatch;
+    if (cursor.currentCheckpoint != batch.startCheckpoint ||
+        cursor.currentPos != batch.startPos) {
+        return {};
+    }
+
+    // Move the cursor straight to where the cursor which read the items
+    // ended up, keeping the cursor counts of the checkpoints up to date
+    if (cursor.currentCheckpoint != batch.endCheckpoint) {
+        (*cursor.currentCheckpoint)->decNumOfCursorsInCheckpoint();
+        cursor.currentCheckpoint = batch.endCheckpoint;
+        (*cursor.currentCheckpoint)->incNumOfCursorsInCheckpoint();
+    }
+    cursor.currentPos = batch.endPos;
+    cursor.numVisits++;
+
+    items.insert(items.end(), batch.items.begin(), batch.items.end());
+    ++stats.dcpCursorBatchesShared;
+
+    ItemsForCursor result(batch.checkpointType,
+                          batch.maxDeletedRevSeqno,
+                          batch.highCompletedSeqno,
+                          batch.visibleSeqno);
+    result.ranges = batch.ranges;
+    result.moreAvailable = batch.moreAvailable;
+    return result;
+}
+
+void CheckpointManager::removeItemFromSharedCursorBatch_UNLOCKED(
+        const Checkpoint& checkpoint, const queued_item& qi) {
+    if (!sharedCursorBatch) {
+        return;
+    }
+
+    auto& batch = *sharedCursorBatch;
+    if ((batch.startCheckpoint->get() == &checkpoint &&
+         (*batch.startPos).get() == qi.get()) ||
+        (batch.endCheckpoint->get() == &checkpoint &&
+         (*batch.endPos).get() == qi.get())) {
+        sharedCursorBatch.reset();
+    }
+}
+
 bool CheckpointManager::incrCursor(CheckpointCursor &cursor) {
     if (!cursor.valid()) {
         return false;
@@ -1155,12 +1295,10 @@ void CheckpointManager::notifyFlusher() {
 }
 
 int64_t CheckpointManager::getHighSeqno() const {
-    LockHolder lh(queueLock);
     return lastBySeqno;
 }
 
 uint64_t CheckpointManager::getMaxVisibleSeqno() const {
-    LockHolder lh(queueLock);
     return maxVisibleSeqno;
 }
 
@@ -1189,6 +1327,8 @@ void CheckpointManager::clear(VBucket& vb, uint64_t seqno) {
 }
 
 void CheckpointManager::clear_UNLOCKED(vbucket_state_t vbState, uint64_t seqno) {
+    sharedCursorBatch.reset();
+
     // Swap our checkpoint list for a new one so that we can clear everything
     // and addOpenCheckpoint will create the new checkpoint in our new list.
     // This also keeps our cursors pointing to valid checkpoints which is
@@ -1317,6 +1457,28 @@ size_t CheckpointManager::getNumItemsForCursor_UNLOCKED(
     return 0;
 }
 
+bool CheckpointManager::hasItemsForCursor(
+        const CheckpointCursor* cursor) const {
+    LockHolder lh(queueLock);
+    if (!cursor || !cursor->valid()) {
+        return false;
+    }
+    if (cursor->hasRemainingItems()) {
+        return true;
+    }
+
+    // Check the item counts of all the subsequent checkpoints
+    CheckpointList::const_iterator chkptIterator(cursor->currentCheckpoint);
+    if (chkptIterator != checkpointList.end()) {
+        ++chkptIterator;
+    }
+    return std::any_of(chkptIterator,
+                       checkpointList.end(),
+                       [](const std::unique_ptr<Checkpoint>& ckpt) {
+                           return ckpt->getNumItems() > 0;
+                       });
+}
+
 void CheckpointManager::clear(vbucket_state_t vbState) {
     LockHolder lh(queueLock);
     clear_UNLOCKED(vbState, lastBySeqno);
@@ -150,10 +150,18 @@ public:
                       uint64_t maxVisibleSeqno,
                       FlusherCallback cb);
 
+    ~CheckpointManager();
+
     uint64_t getOpenCheckpointId();
 
     uint64_t getLastClosedCheckpointId();
 
+    /**
+     * @return the seqno of the last prepare queued in any of the
+     *         checkpoints, or none if they contain no prepares.
+     */
+    std::optional<uint64_t> getHighPreparedSeqno() const;
+
     void setOpenCheckpointId(uint64_t id);
 
     /**
@@ -360,6 +368,20 @@ public:
         return getNumItemsForCursor(persistenceCursor);
     }
 
+    /**
+     * Check if the given cursor has any Item (excluding meta items) yet to
+     * process; equivalent to getNumItemsForCursor(cursor) > 0.
+     * The queueLock is held only until the first such item is found, instead
+     * of for counting all of them, so callers which only need to know if
+     * there is something to do don't block the front-end threads queueing
+     * items for longer than necessary.
+     */
+    bool hasItemsForCursor(const CheckpointCursor* cursor) const;
+
+    bool hasItemsForPersistence() const {
+        return hasItemsForCursor(persistenceCursor);
+    }
+
     void clear(vbucket_state_t vbState);
 
     /**
@@ -589,6 +611,28 @@ protected:
 
     void clear_UNLOCKED(vbucket_state_t vbState, uint64_t seqno);
 
+    /**
+     * Give the cursor the items of the sharedCursorBatch (and move it to the
+     * end of the batch) if the batch was read from the cursor's position.
+     *
+     * @param lh Lock to CM::queueLock
+     * @return the result for getItemsForCursor, or an empty optional if the
+     *         cursor must read the checkpoints itself
+     */
+    std::optional<ItemsForCursor> getSharedItemsForCursor(
+            const LockHolder& lh,
+            CheckpointCursor& cursor,
+            std::vector<queued_item>& items);
+
+    /**
+     * Called (with the queueLock held) when an item is about to be removed
+     * from the given checkpoint by de-duplication. Drops the
+     * sharedCursorBatch if it starts or ends at the item, as it would
+     * reference a removed position.
+     */
+    void removeItemFromSharedCursorBatch_UNLOCKED(const Checkpoint& checkpoint,
+                                                  const queued_item& qi);
+
     /*
      * @return a reference to the open checkpoint
      */
@@ -673,6 +717,19 @@ protected:
                                      queue_op checkpoint_op);
 
     CheckpointList checkpointList;
+
+    /**
+     * The items most recently read by a DCP cursor, along with the positions
+     * they were read between. With dcp_shared_checkpoint_reads enabled any
+     * other DCP cursor at the start position (e.g. the streams of all of the
+     * replicas and indexers keeping up with the vbucket) is given the same
+     * items, instead of walking the checkpoints again.
+     * Guarded by queueLock, and dropped whenever items or checkpoints are
+     * removed from the checkpointList.
+     */
+    struct SharedCursorBatch;
+    std::unique_ptr<SharedCursorBatch> sharedCursorBatch;
+
     EPStats                 &stats;
     CheckpointConfig        &checkpointConfig;
     mutable std::mutex       queueLock;
@@ -681,15 +738,21 @@ protected:
     // Total number of items (including meta items) in /all/ checkpoints managed
     // by this object.
     std::atomic<size_t>      numItems;
-    Monotonic<int64_t>       lastBySeqno;
+    /**
+     * Only modified with the queueLock held, but atomic so getHighSeqno()
+     * (called for every DCP stream step, stat and flush) can read it without
+     * contending with the front-end threads queueing items.
+     */
+    AtomicMonotonic<int64_t> lastBySeqno;
     /**
      * The highest seqno of all items that are visible, i.e. normal mutations or
      * mutations which have been prepared->committed. The main use of this value
      * is to give clients that don't support sync-replication a view of the
      * vbucket which they can receive (via dcp), i.e this value would not change
      * to the seqno of a prepare.
+     * Atomic for the same reason as lastBySeqno.
      */
-    Monotonic<int64_t> maxVisibleSeqno;
+    AtomicMonotonic<int64_t> maxVisibleSeqno;
     uint64_t                 pCursorPreCheckpointId;
 
     /**
@@ -118,6 +118,30 @@ std::string to_string(const DropScopeEventData& event) {
                        event.sid.to_string());
 }
 
+std::string to_string(EvictionPriority priority) {
+    switch (priority) {
+    case EvictionPriority::Low:
+        return "low";
+    case EvictionPriority::Normal:
+        return "normal";
+    case EvictionPriority::High:
+        return "high";
+    }
+    return "unknown " + std::to_string(int(priority));
+}
+
+EvictionPriority makeEvictionPriority(std::string_view name) {
+    if (name == "low") {
+        return EvictionPriority::Low;
+    } else if (name == "normal") {
+        return EvictionPriority::Normal;
+    } else if (name == "high") {
+        return EvictionPriority::High;
+    }
+    throw std::invalid_argument("makeEvictionPriority: invalid priority:" +
+                                std::string(name));
+}
+
 namespace VB {
 std::string to_string(ManifestUpdateStatus status) {
     switch (status) {
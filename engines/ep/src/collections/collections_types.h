@@ -23,6 +23,7 @@
 #include <memcached/types.h>
 #include <gsl/gsl>
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
 
@@ -65,6 +66,42 @@ struct AccumulatedStats {
 };
 using Summary = std::unordered_map<CollectionID, AccumulatedStats>;
 
+/**
+ * The order in which the ItemPager evicts the items of collections; the items
+ * of Low priority collections are considered colder than they are (and
+ * evicted first), those of High priority collections hotter (and evicted
+ * last). The values are persisted with the manifest.
+ */
+enum class EvictionPriority : uint8_t { Low = 0, Normal = 1, High = 2 };
+
+std::string to_string(EvictionPriority priority);
+
+/**
+ * @return the EvictionPriority of the given name ("low", "normal" or "high")
+ * @throws std::invalid_argument for any other name
+ */
+EvictionPriority makeEvictionPriority(std::string_view name);
+
+/**
+ * How the ItemPager treats the items of a collection, as set by the
+ * "memoryShare" and "evictionPriority" of the collection in the manifest.
+ */
+struct EvictionSettings {
+    bool operator==(const EvictionSettings& other) const {
+        return memoryShare == other.memoryShare && priority == other.priority;
+    }
+    bool operator!=(const EvictionSettings& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * Percentage of the bucket quota the collection's items may use before
+     * the ItemPager evicts any of them; 0 for no share.
+     */
+    uint8_t memoryShare{0};
+    EvictionPriority priority{EvictionPriority::Normal};
+};
+
 struct ManifestUidNetworkOrder {
     explicit ManifestUidNetworkOrder(ManifestUid uid) : uid(htonll(uid)) {
     }
@@ -393,9 +430,29 @@ public:
         return !(*this == meta);
     }
 
+    /**
+     * The eviction settings are not part of the collection's identity - they
+     * are neither compared nor replicated and can change with any manifest
+     * update - they are set by the Manager from the bucket manifest.
+     */
+    void setEvictionSettings(EvictionSettings settings) const {
+        memoryShare.store(settings.memoryShare, std::memory_order_relaxed);
+        evictionPriority.store(settings.priority, std::memory_order_relaxed);
+    }
+
+    EvictionSettings getEvictionSettings() const {
+        return {memoryShare.load(std::memory_order_relaxed),
+                evictionPriority.load(std::memory_order_relaxed)};
+    }
+
     const std::string name;
     const ScopeID scope;
     const cb::ExpiryLimit maxTtl;
+
+private:
+    mutable std::atomic<uint8_t> memoryShare{0};
+    mutable std::atomic<EvictionPriority> evictionPriority{
+            EvictionPriority::Normal};
 };
 std::ostream& operator<<(std::ostream& os,
                          const CollectionSharedMetaData& meta);
@@ -143,6 +143,8 @@ cb::engine_error Collections::Manager::applyNewManifest(
                         updated->to_string() + ", cannot apply to vbuckets");
     }
 
+    updateEvictionSettings(*newManifest);
+
     // Now switch to write locking and change the manifest. The lock is
     // released after this statement.
     *current.moveFromUpgradeToWrite() = std::move(*newManifest);
@@ -187,6 +189,27 @@ std::optional<Vbid> Collections::Manager::updateAllVBuckets(
     return {};
 }
 
+void Collections::Manager::updateEvictionSettings(const Manifest& manifest) {
+    std::unordered_map<CollectionID, EvictionSettings> newSettings;
+    for (const auto& [cid, entry] : manifest) {
+        if (entry.eviction != EvictionSettings{}) {
+            newSettings.emplace(cid, entry.eviction);
+        }
+    }
+
+    auto lockedSMT = collectionSMT.wlock();
+    auto lockedSettings = evictionSettings.wlock();
+    *lockedSettings = std::move(newSettings);
+    lockedSMT->forEach([&lockedSettings](CollectionID cid,
+                                         const VB::CollectionSharedMetaData&
+                                                 meta) {
+        auto itr = lockedSettings->find(cid);
+        meta.setEvictionSettings(itr == lockedSettings->end()
+                                         ? EvictionSettings{}
+                                         : itr->second);
+    });
+}
+
 void Collections::Manager::updatePersistManifestTaskDone(
         EventuallyPersistentEngine& engine,
         const void* cookie,
@@ -315,6 +338,7 @@ bool Collections::Manager::warmupLoadManifest(const std::string& dbpath) {
                 "uid:{:#x} force:{}",
                 rv.value().getUid(),
                 rv.value().isForcedUpdate());
+        updateEvictionSettings(rv.value());
         *currentManifest.wlock() = std::move(rv.value());
         return true;
     }
@@ -364,7 +388,14 @@ SingleThreadedRCPtr<const Collections::VB::CollectionSharedMetaData>
 Collections::Manager::createOrReferenceMeta(
         CollectionID cid,
         const Collections::VB::CollectionSharedMetaDataView& view) {
-    return collectionSMT.wlock()->createOrReference(cid, view);
+    auto lockedSMT = collectionSMT.wlock();
+    auto meta = lockedSMT->createOrReference(cid, view);
+    auto lockedSettings = evictionSettings.rlock();
+    auto itr = lockedSettings->find(cid);
+    if (itr != lockedSettings->end()) {
+        meta->setEvictionSettings(itr->second);
+    }
+    return meta;
 }
 
 void Collections::Manager::dereferenceMeta(CollectionID cid) {
@@ -804,12 +835,13 @@ std::ostream& Collections::operator<<(std::ostream& os,
 
 Collections::CachedStats Collections::Manager::getPerCollectionStats(
         KVBucket& bucket) {
-    auto memUsed = bucket.getEPEngine().getEpStats().getAllCollectionsMemUsed();
+    auto memStats =
+            bucket.getEPEngine().getEpStats().getAllCollectionsMemStats();
 
     AllCollectionsGetStatsVBucketVisitor visitor;
     bucket.visit(visitor);
 
-    return {std::move(memUsed),
+    return {std::move(memStats),
             std::move(visitor.summary) /* accumulated collection stats */};
 }
 
@@ -820,21 +852,22 @@ Collections::CachedStats Collections::Manager::getPerCollectionStats(
     CollectionsGetStatsVBucketVisitor visitor{collections};
     bucket.visit(visitor);
 
-    // And the mem_used which is stored in EpStats
-    std::unordered_map<CollectionID, size_t> memUsed;
+    // And the mem_used (and residency) which is stored in EpStats
+    std::unordered_map<CollectionID, CollectionMemStats> memStats;
     for (const auto& entry : collections) {
-        memUsed.emplace(entry.cid,
-                        bucket.getEPEngine().getEpStats().getCollectionMemUsed(
-                                entry.cid));
+        memStats.emplace(
+                entry.cid,
+                bucket.getEPEngine().getEpStats().getCollectionMemStats(
+                        entry.cid));
     }
-    return {std::move(memUsed),
+    return {std::move(memStats),
             std::move(visitor.summary) /* accumulated collection stats */};
 }
 
 Collections::CachedStats::CachedStats(
-        std::unordered_map<CollectionID, size_t>&& colMemUsed,
+        std::unordered_map<CollectionID, CollectionMemStats>&& colMemStats,
         std::unordered_map<CollectionID, AccumulatedStats>&& accumulatedStats)
-    : colMemUsed(std::move(colMemUsed)),
+    : colMemStats(std::move(colMemStats)),
       accumulatedStats(std::move(accumulatedStats)) {
 }
 
@@ -856,6 +889,16 @@ void Collections::CachedStats::addStatsForCollection(
         collectionC.addStat(Key::collection_maxTTL,
                             collection.maxTtl.value().count());
     }
+
+    // add eviction settings if not the defaults
+    if (collection.eviction.memoryShare) {
+        collectionC.addStat(Key::collection_memory_share,
+                            collection.eviction.memoryShare);
+    }
+    if (collection.eviction.priority != EvictionPriority::Normal) {
+        collectionC.addStat(Key::collection_eviction_priority,
+                            to_string(collection.eviction.priority));
+    }
 }
 
 void Collections::CachedStats::addStatsForScope(
@@ -882,19 +925,21 @@ void Collections::CachedStats::addStatsForScope(
 
 void Collections::CachedStats::addAggregatedCollectionStats(
         const std::vector<CollectionID>& cids, const StatCollector& collector) {
-    size_t memUsed = 0;
+    CollectionMemStats memStats;
     AccumulatedStats stats;
 
     for (const auto& cid : cids) {
-        memUsed += colMemUsed[cid];
+        memStats += colMemStats[cid];
         stats += accumulatedStats[cid];
     }
 
     using namespace cb::stats;
 
-    collector.addStat(Key::collection_mem_used, memUsed);
+    collector.addStat(Key::collection_mem_used, memStats.memUsed);
     collector.addStat(Key::collection_item_count, stats.itemCount);
     collector.addStat(Key::collection_disk_size, stats.diskSize);
+    collector.addStat(Key::collection_resident_ratio,
+                      memStats.getResidentRatio());
 
     collector.addStat(Key::collection_ops_store, stats.opsStore);
     collector.addStat(Key::collection_ops_delete, stats.opsDelete);
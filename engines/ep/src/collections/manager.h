@@ -19,6 +19,7 @@
 
 #include "collections/manifest.h"
 #include "collections/shared_metadata_table.h"
+#include "stats.h"
 
 #include <memcached/engine.h>
 #include <memcached/engine_error.h>
@@ -44,11 +45,13 @@ namespace Collections {
 class CachedStats {
 public:
     /**
-     * @param colMemUsed a map of collection to mem_used, object takes ownership
+     * @param colMemStats a map of collection to mem_used (and residency),
+     * object takes ownership
      * @param accumulatedStats a map of collection to AccumulatedStats, object
      * takes ownership
      */
-    CachedStats(std::unordered_map<CollectionID, size_t>&& colMemUsed,
+    CachedStats(std::unordered_map<CollectionID, CollectionMemStats>&&
+                        colMemStats,
                 std::unordered_map<CollectionID, AccumulatedStats>&&
                         accumulatedStats);
     /**
@@ -85,7 +88,7 @@ private:
      */
     void addAggregatedCollectionStats(const std::vector<CollectionID>& cids,
                                       const StatCollector& collector);
-    std::unordered_map<CollectionID, size_t> colMemUsed;
+    std::unordered_map<CollectionID, CollectionMemStats> colMemStats;
     std::unordered_map<CollectionID, AccumulatedStats> accumulatedStats;
 };
 
@@ -294,6 +297,13 @@ private:
     std::optional<Vbid> updateAllVBuckets(KVBucket& bucket,
                                           const Manifest& newManifest);
 
+    /**
+     * Take the eviction settings of all collections from the manifest and
+     * apply them to the collections known by the vbuckets (active and
+     * replica alike).
+     */
+    void updateEvictionSettings(const Manifest& manifest);
+
     /**
      * This method handles the IO complete path and allows ::update to
      * correctly call applyNewManifest
@@ -412,6 +422,15 @@ private:
                                 const VB::CollectionSharedMetaData>;
     folly::Synchronized<CollectionsSharedMetaDataTable> collectionSMT;
 
+    /**
+     * The eviction settings of the collections of the current manifest, for
+     * those without the default settings. Given to every
+     * CollectionSharedMetaData when it is created (or referenced).
+     * Lock ordering: collectionSMT must be locked first.
+     */
+    folly::Synchronized<std::unordered_map<CollectionID, EvictionSettings>>
+            evictionSettings;
+
     /**
      * All of the currently known collection names for a ScopeID, which
      * vbuckets refer back to.
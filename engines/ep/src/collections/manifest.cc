@@ -52,6 +52,12 @@ static constexpr char const* UidKey = "uid";
 static constexpr char const* MaxTtlKey = "maxTTL";
 static constexpr nlohmann::json::value_t MaxTtlType =
         nlohmann::json::value_t::number_unsigned;
+static constexpr char const* MemoryShareKey = "memoryShare";
+static constexpr nlohmann::json::value_t MemoryShareType =
+        nlohmann::json::value_t::number_unsigned;
+static constexpr char const* EvictionPriorityKey = "evictionPriority";
+static constexpr nlohmann::json::value_t EvictionPriorityType =
+        nlohmann::json::value_t::string;
 static constexpr char const* ForceUpdateKey = "force";
 
 /**
@@ -160,6 +166,10 @@ Manifest::Manifest(std::string_view json)
             auto cuid = getJsonObject(collection, UidKey, UidType);
             auto cmaxttl = cb::getOptionalJsonObject(
                     collection, MaxTtlKey, MaxTtlType);
+            auto cmemoryshare = cb::getOptionalJsonObject(
+                    collection, MemoryShareKey, MemoryShareType);
+            auto cevictionpriority = cb::getOptionalJsonObject(
+                    collection, EvictionPriorityKey, EvictionPriorityType);
 
             auto cnameValue = cname.get<std::string>();
             if (!validName(cnameValue)) {
@@ -209,9 +219,27 @@ Manifest::Manifest(std::string_view json)
                 maxTtl = std::chrono::seconds(value);
             }
 
+            EvictionSettings eviction;
+            if (cmemoryshare) {
+                // A percentage of the bucket quota
+                auto value = cmemoryshare.value().get<uint64_t>();
+                if (value > 100) {
+                    throwInvalid("memoryShare:" + std::to_string(value));
+                }
+                eviction.memoryShare = gsl::narrow_cast<uint8_t>(value);
+            }
+            if (cevictionpriority) {
+                try {
+                    eviction.priority = makeEvictionPriority(
+                            cevictionpriority.value().get<std::string>());
+                } catch (const std::invalid_argument& e) {
+                    throwInvalid(e.what());
+                }
+            }
+
             enableDefaultCollection(cidValue);
-            scopeCollections.push_back(
-                    CollectionEntry{cidValue, cnameValue, maxTtl, sidValue});
+            scopeCollections.push_back(CollectionEntry{
+                    cidValue, cnameValue, maxTtl, sidValue, eviction});
         }
 
         this->scopes.emplace(sidValue,
@@ -222,6 +250,15 @@ Manifest::Manifest(std::string_view json)
     buildCollectionIdToEntryMap();
 
     // Final checks...
+    // The memory shares are of the same quota, so can't exceed it in total
+    size_t memoryShare = 0;
+    for (const auto& [cid, collection] : collections) {
+        memoryShare += collection.eviction.memoryShare;
+    }
+    if (memoryShare > 100) {
+        throwInvalid("total memoryShare:" + std::to_string(memoryShare));
+    }
+
     // uid of 0 -> this must be the 'epoch' state
     // else no scopes is invalid and we must always have default scope
     if (uid == 0 && !isEpoch()) {
@@ -340,6 +377,13 @@ nlohmann::json Manifest::toJson(
                 if (c.maxTtl) {
                     collection["maxTTL"] = c.maxTtl.value().count();
                 }
+                if (c.eviction.memoryShare) {
+                    collection["memoryShare"] = c.eviction.memoryShare;
+                }
+                if (c.eviction.priority != EvictionPriority::Normal) {
+                    collection["evictionPriority"] =
+                            to_string(c.eviction.priority);
+                }
                 scope["collections"].push_back(collection);
             }
         }
@@ -366,7 +410,9 @@ flatbuffers::DetachedBuffer Manifest::toFlatbuffer() const {
                     uint32_t(c.cid),
                     c.maxTtl.has_value(),
                     c.maxTtl.value_or(std::chrono::seconds(0)).count(),
-                    builder.CreateString(c.name));
+                    builder.CreateString(c.name),
+                    c.eviction.memoryShare,
+                    static_cast<uint8_t>(c.eviction.priority));
             fbCollections.push_back(newEntry);
         }
         auto collectionVector = builder.CreateVector(fbCollections);
@@ -419,9 +465,19 @@ Manifest::Manifest(std::string_view flatbufferData, Manifest::FlatBuffers tag)
                 maxTtl = std::chrono::seconds(collection->maxTtl());
             }
 
+            // Absent from manifests persisted before eviction settings
+            // existed, which then read as the defaults.
+            EvictionSettings eviction;
+            eviction.memoryShare = collection->memoryShare();
+            eviction.priority =
+                    static_cast<EvictionPriority>(collection->evictionPriority());
+
             enableDefaultCollection(cid);
-            scopeCollections.push_back(CollectionEntry{
-                    cid, collection->name()->str(), maxTtl, scope->scopeId()});
+            scopeCollections.push_back(CollectionEntry{cid,
+                                                       collection->name()->str(),
+                                                       maxTtl,
+                                                       scope->scopeId(),
+                                                       eviction});
         }
 
         this->scopes.emplace(
@@ -458,6 +514,14 @@ void Manifest::addCollectionStats(KVBucket& bucket,
                 if (entry.maxTtl) {
                     collectionC.addStat(Key::collection_maxTTL, entry.maxTtl->count());
                 }
+                if (entry.eviction.memoryShare) {
+                    collectionC.addStat(Key::collection_memory_share,
+                                        entry.eviction.memoryShare);
+                }
+                if (entry.eviction.priority != EvictionPriority::Normal) {
+                    collectionC.addStat(Key::collection_eviction_priority,
+                                        to_string(entry.eviction.priority));
+                }
             }
         }
     } catch (const std::exception& e) {
@@ -589,7 +653,7 @@ void Manifest::dump() const {
 
 bool CollectionEntry::operator==(const CollectionEntry& other) const {
     return cid == other.cid && name == other.name && sid == other.sid &&
-           maxTtl == other.maxTtl;
+           maxTtl == other.maxTtl && eviction == other.eviction;
 }
 
 bool Scope::operator==(const Scope& other) const {
@@ -655,8 +719,11 @@ cb::engine_error Manifest::isSuccessor(const Manifest& successor) const {
         for (const auto& [cid, collection] : collections) {
             auto itr = successor.findCollection(cid);
             if (itr != successor.end()) {
-                // CollectionEntry must be equal (no maxTTL changes either)
-                if (collection != itr->second) {
+                // CollectionEntry must be equal (no maxTTL changes either),
+                // only the eviction settings may change
+                auto successorCollection = itr->second;
+                successorCollection.eviction = collection.eviction;
+                if (collection != successorCollection) {
                     return cb::engine_error(
                             cb::engine_errc::cannot_apply_collections_manifest,
                             "invalid collection change detected "
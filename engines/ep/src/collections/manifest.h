@@ -44,6 +44,8 @@ struct CollectionEntry {
     std::string name;
     cb::ExpiryLimit maxTtl;
     ScopeID sid;
+    // Unlike the above the eviction settings may change between manifests
+    EvictionSettings eviction{};
     bool operator==(const CollectionEntry& other) const;
     bool operator!=(const CollectionEntry& other) const {
         return !(*this == other);
@@ -78,6 +78,18 @@ public:
         return smt.count(id);
     }
 
+    /**
+     * Call the given function for every id and Value in the container.
+     *
+     * @param func invoked as func(Key, const Value&)
+     */
+    template <class Function>
+    void forEach(Function&& func) const {
+        for (const auto& [key, value] : smt) {
+            func(key, *value);
+        }
+    }
+
 private:
     template <class K, class V>
     friend std::ostream& operator<<(std::ostream& os,
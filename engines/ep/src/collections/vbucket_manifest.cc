@@ -927,6 +927,14 @@ uint64_t Manifest::getItemCount(CollectionID collection) const {
     return itr->second.getItemCount();
 }
 
+EvictionSettings Manifest::getEvictionSettings(CollectionID collection) const {
+    auto itr = map.find(collection);
+    if (itr == map.end()) {
+        return {};
+    }
+    return itr->second.getEvictionSettings();
+}
+
 uint64_t Manifest::getHighSeqno(CollectionID collection) const {
     auto itr = map.find(collection);
     if (itr == map.end()) {
@@ -1317,6 +1325,32 @@ WriteHandle Manifest::wlock() {
     return {*this, rwlock};
 }
 
+void Manifest::excludeLockFreeReaders() {
+    if (readMode != ReadMode::LockFree) {
+        return;
+    }
+    // Any CachingReadHandle created after this increment obtains rwlock (and
+    // so waits for the WriteHandle); once a grace period has elapsed every
+    // CachingReadHandle created before it has been destroyed. The wait must
+    // happen before rwlock is exclusively locked - a CachingReadHandle may
+    // itself be waiting for rwlock, e.g. to obtain a nested ReadHandle.
+    pendingWriters.fetch_add(1);
+    getRcuDomain().synchronize();
+}
+
+void Manifest::allowLockFreeReaders() {
+    if (readMode != ReadMode::LockFree) {
+        return;
+    }
+    pendingWriters.fetch_sub(1);
+}
+
+Manifest::RcuDomain& Manifest::getRcuDomain() {
+    // folly permits a single domain per tag
+    static RcuDomain domain;
+    return domain;
+}
+
 std::ostream& operator<<(std::ostream& os, const ReadHandle& readHandle) {
     os << "VB::Manifest::ReadHandle: manifest:" << *readHandle.manifest;
     return os;
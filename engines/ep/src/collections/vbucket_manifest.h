@@ -26,7 +26,9 @@
 #include <folly/SharedMutex.h>
 #include <folly/Synchronized.h>
 #include <folly/container/F14Map.h>
+#include <folly/synchronization/Rcu.h>
 
+#include <atomic>
 #include <optional>
 #include <unordered_set>
 
@@ -80,6 +82,14 @@ class WriteHandle;
  * for the entire scope of the set path to ensure no other thread can interleave
  * collection create/delete and cause an inconsistency in the checkpoint
  * ordering.
+ *
+ * With ReadMode::LockFree the CachingReadHandle (obtained by every key-based
+ * operation) normally does not obtain the shared lock; writes to the lock's
+ * shared state from many cores would bounce its cache-line between them.
+ * Instead it enters a read-side critical section of the manifests' own RCU
+ * domain (a thread-local write) and checks pendingWriters; a WriteHandle
+ * increments pendingWriters and waits for a grace period of that domain
+ * before locking, see CachingReadHandle.
  */
 class Manifest {
 public:
@@ -92,6 +102,21 @@ public:
 #endif
     struct AllowSystemKeys {};
 
+    /**
+     * How the CachingReadHandle synchronises with the WriteHandle.
+     */
+    enum class ReadMode : uint8_t {
+        /// CachingReadHandle always obtains rwlock (shared).
+        Locked,
+        /// CachingReadHandle only obtains rwlock while a WriteHandle is
+        /// pending, see CachingReadHandle.
+        LockFree,
+    };
+
+    /// Tag of the RCU domain used by ReadMode::LockFree
+    struct RcuTag {};
+    using RcuDomain = folly::rcu_domain<RcuTag>;
+
     friend Collections::VB::ReadHandle;
     friend Collections::VB::CachingReadHandle;
     friend Collections::VB::StatsReadHandle;
@@ -134,6 +159,18 @@ public:
      */
     ~Manifest();
 
+    /**
+     * Set how CachingReadHandles synchronise with WriteHandles. Must be
+     * called before the Manifest is accessed by more than one thread.
+     */
+    void setReadMode(ReadMode mode) {
+        readMode = mode;
+    }
+
+    ReadMode getReadMode() const {
+        return readMode;
+    }
+
     /**
      * @return ReadHandle, no iterator is held on the collection container
      */
@@ -442,6 +479,26 @@ protected:
                    OptionalSeqno optionalSeqno,
                    bool isForcedDrop);
 
+    /**
+     * Called by a WriteHandle before it exclusively locks rwlock. With
+     * ReadMode::LockFree increments pendingWriters and waits for any
+     * CachingReadHandle which did not obtain rwlock to be destroyed.
+     */
+    void excludeLockFreeReaders();
+
+    /**
+     * Called by a WriteHandle before it unlocks rwlock; once no WriteHandle
+     * is pending CachingReadHandles can again read without obtaining rwlock.
+     */
+    void allowLockFreeReaders();
+
+    /**
+     * @return the RCU domain shared by all Manifests for ReadMode::LockFree.
+     *         A dedicated domain means a WriteHandle only waits for
+     *         CachingReadHandles and not for every RCU reader in the process.
+     */
+    static RcuDomain& getRcuDomain();
+
     /**
      * Update the manifestUid
      * @param uid new value
@@ -623,6 +680,12 @@ protected:
      */
     uint64_t getHighSeqno(CollectionID collection) const;
 
+    /**
+     * @return the eviction settings of the collection, the defaults if the
+     *         collection does not exist (e.g. it is being dropped)
+     */
+    EvictionSettings getEvictionSettings(CollectionID collection) const;
+
     /**
      * Set the high seqno of the given collection to the given value. Allowed
      * to be const as the only constness we care about here is the state of
@@ -936,6 +999,16 @@ protected:
      */
     mutable mutex_type rwlock;
 
+    /// How CachingReadHandles synchronise with WriteHandles
+    ReadMode readMode{ReadMode::Locked};
+
+    /**
+     * Number of WriteHandles which exist or are waiting to exclusively lock
+     * rwlock. Read by the CachingReadHandle (ReadMode::LockFree) to decide
+     * if it must obtain rwlock.
+     */
+    std::atomic<int> pendingWriters{0};
+
     /// The manifest UID which updated this vb::manifest
     ManifestUid manifestUid{0};
 
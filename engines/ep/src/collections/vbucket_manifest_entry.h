@@ -88,6 +88,11 @@ public:
         return meta->name;
     }
 
+    /// @return the eviction settings from the bucket manifest
+    EvictionSettings getEvictionSettings() const {
+        return meta->getEvictionSettings();
+    }
+
     /// increment how many items are stored for this collection
     void incrementItemCount() const {
         itemCount++;
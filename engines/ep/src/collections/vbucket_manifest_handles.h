@@ -19,6 +19,9 @@
 
 #include "collections/vbucket_manifest.h"
 
+#include <optional>
+#include <utility>
+
 class StatCollector;
 
 namespace Collections::VB {
@@ -45,11 +48,14 @@ public:
     }
 
     ReadHandle(ReadHandle&& rhs)
-        : readLock(std::move(rhs.readLock)), manifest(rhs.manifest) {
+        : readLock(std::move(rhs.readLock)),
+          rcuReader(std::exchange(rhs.rcuReader, std::nullopt)),
+          manifest(rhs.manifest) {
     }
 
     ReadHandle& operator=(ReadHandle&& other) {
         readLock = std::move(other.readLock);
+        rcuReader = std::exchange(other.rcuReader, std::nullopt);
         manifest = std::move(other.manifest);
 
         return *this;
@@ -132,6 +138,10 @@ public:
         return manifest->getHighSeqno(collection);
     }
 
+    EvictionSettings getEvictionSettings(CollectionID collection) const {
+        return manifest->getEvictionSettings(collection);
+    }
+
     uint64_t getPersistedHighSeqno(CollectionID collection) const {
         return manifest->getPersistedHighSeqno(collection);
     }
@@ -216,6 +226,7 @@ public:
      */
     void unlock() {
         readLock.unlock();
+        rcuReader.reset();
         manifest = nullptr;
     }
 
@@ -227,9 +238,31 @@ public:
     }
 
 protected:
+    struct LockFreeTag {};
+
+    /**
+     * Read access to the manifest which, with ReadMode::LockFree, only
+     * obtains lock if a WriteHandle exists (or is pending), see
+     * CachingReadHandle.
+     */
+    ReadHandle(const Manifest* m, Manifest::mutex_type& lock, LockFreeTag)
+        : manifest(m) {
+        if (m->readMode == Manifest::ReadMode::LockFree) {
+            rcuReader.emplace(&Manifest::getRcuDomain());
+            if (m->pendingWriters.load() == 0) {
+                return;
+            }
+            // Leave the critical section, the writer may be waiting for it
+            rcuReader.reset();
+        }
+        readLock = Manifest::mutex_type::ReadHolder(lock);
+    }
+
     friend std::ostream& operator<<(std::ostream& os,
                                     const ReadHandle& readHandle);
     Manifest::mutex_type::ReadHolder readLock{nullptr};
+    // Engaged instead of readLock when read without obtaining the lock
+    std::optional<folly::rcu_reader_domain<Manifest::RcuTag>> rcuReader;
     const Manifest* manifest{nullptr};
 };
 
@@ -252,6 +285,18 @@ protected:
  * Privately inherited from ReadHandle so we have a readlock/manifest
  * without exposing the ReadHandle public methods that don't quite fit in
  * this class.
+ *
+ * As one is created for every key-based operation, with
+ * Manifest::ReadMode::LockFree the CachingReadHandle avoids obtaining the
+ * manifest's lock; it instead holds a read-side critical section of
+ * Manifest::getRcuDomain() for its lifetime, which only writes to
+ * thread-local state. A WriteHandle increments Manifest::pendingWriters and
+ * waits for a grace period of that domain before obtaining the lock, so the
+ * manifest cannot change while a CachingReadHandle exists - the same
+ * guarantee the lock gives. A CachingReadHandle created while pendingWriters
+ * is non-zero obtains the lock as before. Because of the wait a
+ * CachingReadHandle should be short-lived and never be held while obtaining
+ * a WriteHandle.
  */
 class CachingReadHandle : private ReadHandle {
 public:
@@ -266,11 +311,15 @@ public:
                       Manifest::mutex_type& lock,
                       DocKey key,
                       Manifest::AllowSystemKeys tag)
-        : ReadHandle(m, lock), itr(m->getManifestEntry(key, tag)), key(key) {
+        : ReadHandle(m, lock, LockFreeTag{}),
+          itr(m->getManifestEntry(key, tag)),
+          key(key) {
     }
 
     CachingReadHandle(const Manifest* m, Manifest::mutex_type& lock, DocKey key)
-        : ReadHandle(m, lock), itr(m->getManifestEntry(key)), key(key) {
+        : ReadHandle(m, lock, LockFreeTag{}),
+          itr(m->getManifestEntry(key)),
+          key(key) {
     }
 
     /**
@@ -547,17 +596,32 @@ protected:
  */
 class WriteHandle {
 public:
-    WriteHandle(Manifest& m, Manifest::mutex_type& lock)
-        : writeLock(lock), manifest(m) {
+    WriteHandle(Manifest& m, Manifest::mutex_type& lock) : manifest(m) {
+        manifest.excludeLockFreeReaders();
+        writeLock = Manifest::mutex_type::WriteHolder(lock);
     }
 
     WriteHandle(WriteHandle&& rhs)
-        : writeLock(std::move(rhs.writeLock)), manifest(rhs.manifest) {
+        : writeLock(std::move(rhs.writeLock)),
+          manifest(rhs.manifest),
+          excludingLockFreeReaders(
+                  std::exchange(rhs.excludingLockFreeReaders, false)) {
     }
 
     WriteHandle(Manifest& m,
                 Manifest::mutex_type::UpgradeHolder&& upgradeHolder)
-        : writeLock(std::move(upgradeHolder)), manifest(m) {
+        : manifest(m) {
+        // Upgrade holders do not exclude readers, so waiting whilst holding
+        // one cannot block a CachingReadHandle which obtains the lock
+        manifest.excludeLockFreeReaders();
+        writeLock = Manifest::mutex_type::WriteHolder(std::move(upgradeHolder));
+    }
+
+    ~WriteHandle() {
+        // Before writeLock is released
+        if (excludingLockFreeReaders) {
+            manifest.allowLockFreeReaders();
+        }
     }
 
     /**
@@ -682,8 +746,10 @@ public:
     void dump();
 
 private:
-    Manifest::mutex_type::WriteHolder writeLock;
+    Manifest::mutex_type::WriteHolder writeLock{nullptr};
     Manifest& manifest;
+    // false once moved from
+    bool excludingLockFreeReaders{true};
 };
 
 } // namespace Collections::VB
@@ -150,8 +150,13 @@ cs_off_t StatsOps::goto_eof(couchstore_error_info_t* errinfo,
 couchstore_error_t StatsOps::sync(couchstore_error_info_t* errinfo,
                                   couch_file_handle h) {
     auto* sf = reinterpret_cast<StatFile*>(h);
+    // Syncs of different files overlap when commits are synced outside of
+    // the KVStore transaction (couchstore_group_commit).
+    stats.syncConcurrencyHisto.addValue(++stats.syncsInProgress);
     HdrMicroSecBlockTimer bt(&stats.syncTimeHisto);
-    return sf->orig_ops->sync(errinfo, sf->orig_handle);
+    auto result = sf->orig_ops->sync(errinfo, sf->orig_handle);
+    --stats.syncsInProgress;
+    return result;
 }
 
 couchstore_error_t StatsOps::advise(couchstore_error_info_t* errinfo,
@@ -0,0 +1,417 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "couch-kvstore/couch-fs-uring.h"
+
+#ifdef EP_USE_LIBURING
+#include <fcntl.h>
+#include <liburing.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+/**
+ * Prefetched ranges are expanded to multiples of this, so that the reads
+ * couchstore's read buffer makes (of this size, at offsets aligned to it)
+ * are served from the prefetched data.
+ */
+static constexpr cs_off_t prefetchAlignment = 4096;
+
+/// Ranges are not coalesced into reads larger than this.
+static constexpr size_t maxCoalescedRead = 1024 * 1024;
+
+#ifdef EP_USE_LIBURING
+/// Upper bound on the size of a thread's io_uring submission queue.
+static constexpr size_t maxQueueDepth = 4096;
+
+namespace {
+/**
+ * A thread's io_uring instance. Created on first use, and re-created if a
+ * deeper queue is later requested.
+ */
+class Ring {
+public:
+    ~Ring() {
+        reset();
+    }
+
+    /// @returns the ring, or nullptr if io_uring is unavailable.
+    io_uring* get(unsigned depth) {
+        if (entries >= depth) {
+            return &ring;
+        }
+        reset();
+        if (unavailable || io_uring_queue_init(depth, &ring, 0) < 0) {
+            // Most likely the kernel does not support (or permit) io_uring;
+            // don't keep trying.
+            unavailable = true;
+            return nullptr;
+        }
+        entries = depth;
+        return &ring;
+    }
+
+    void reset() {
+        if (entries) {
+            io_uring_queue_exit(&ring);
+            entries = 0;
+        }
+    }
+
+private:
+    io_uring ring;
+    unsigned entries = 0;
+    bool unavailable = false;
+};
+
+thread_local Ring threadRing;
+} // namespace
+#endif
+
+IoUringReadOps::File::File(FileOpsInterface* _orig_ops,
+                           couch_file_handle _orig_handle)
+    : orig_ops(_orig_ops), orig_handle(_orig_handle) {
+}
+
+size_t IoUringReadOps::File::prefetch(std::vector<Range> ranges,
+                                      size_t maxGap,
+                                      size_t queueDepth) {
+    extents.clear();
+    if (ranges.empty()) {
+        return 0;
+    }
+
+    // Align and sort the ranges, then coalesce them into the extents to read.
+    for (auto& range : ranges) {
+        const auto start = range.offset - (range.offset % prefetchAlignment);
+        auto end = cs_off_t(range.offset + range.size);
+        end += (prefetchAlignment - (end % prefetchAlignment)) %
+               prefetchAlignment;
+        range = {start, size_t(end - start)};
+    }
+    std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+        return a.offset < b.offset;
+    });
+    size_t coalesced = 0;
+    for (const auto& range : ranges) {
+        const auto end = cs_off_t(range.offset + range.size);
+        if (!extents.empty()) {
+            auto& last = extents.back();
+            const auto lastEnd = cs_off_t(last.offset + last.data.size());
+            if (range.offset <= lastEnd + cs_off_t(maxGap) &&
+                size_t(end - last.offset) <= maxCoalescedRead) {
+                if (end > lastEnd) {
+                    last.data.resize(end - last.offset);
+                }
+                ++coalesced;
+                continue;
+            }
+        }
+        extents.push_back({range.offset, std::vector<char>(range.size)});
+    }
+
+    if (queueDepth == 0 || !readExtentsIoUring(queueDepth)) {
+        readExtents();
+    }
+
+    extents.erase(std::remove_if(extents.begin(),
+                                 extents.end(),
+                                 [](const auto& e) { return !e.complete; }),
+                  extents.end());
+    return coalesced;
+}
+
+void IoUringReadOps::File::readExtents() {
+    for (auto& extent : extents) {
+        couchstore_error_info_t errinfo{};
+        size_t done = 0;
+        bool failed = false;
+        while (done < extent.data.size()) {
+            const auto got = orig_ops->pread(&errinfo,
+                                             orig_handle,
+                                             extent.data.data() + done,
+                                             extent.data.size() - done,
+                                             extent.offset + done);
+            if (got < 0) {
+                failed = true;
+                break;
+            }
+            if (got == 0) {
+                break;
+            }
+            done += got;
+        }
+        if (failed || done == 0) {
+            continue;
+        }
+        if (done < extent.data.size()) {
+            extent.data.resize(done);
+            extent.eof = true;
+        }
+        extent.complete = true;
+    }
+}
+
+#ifdef EP_USE_LIBURING
+bool IoUringReadOps::File::readExtentsIoUring(size_t queueDepth) {
+    if (fd < 0) {
+        return false;
+    }
+    auto* ring = threadRing.get(std::min(queueDepth, maxQueueDepth));
+    if (!ring) {
+        return false;
+    }
+
+    size_t next = 0;
+    // Reads prepared but not yet accepted by the kernel, and those accepted
+    // but not yet completed.
+    size_t queued = 0;
+    size_t inflight = 0;
+    bool failed = false;
+    while ((!failed && next < extents.size()) || inflight > 0) {
+        while (!failed && next < extents.size() &&
+               queued + inflight < queueDepth) {
+            auto* sqe = io_uring_get_sqe(ring);
+            if (!sqe) {
+                break;
+            }
+            auto& extent = extents[next++];
+            io_uring_prep_read(sqe,
+                               fd,
+                               extent.data.data(),
+                               extent.data.size(),
+                               extent.offset);
+            io_uring_sqe_set_data(sqe, &extent);
+            ++queued;
+        }
+
+        if (!failed && queued > 0) {
+            const int ret = io_uring_submit(ring);
+            if (ret >= 0) {
+                queued -= ret;
+                inflight += ret;
+            } else if (ret != -EINTR && ret != -EAGAIN && ret != -EBUSY) {
+                // Give up on the remainder; those already in flight must
+                // still be waited for as they reference our buffers.
+                failed = true;
+            }
+        }
+        if (inflight == 0) {
+            continue;
+        }
+
+        io_uring_cqe* cqe;
+        const int ret = io_uring_wait_cqe(ring, &cqe);
+        if (ret < 0 && ret != -EINTR) {
+            // Cannot safely free the buffers of reads we failed to wait for;
+            // this is not expected to happen with a valid ring.
+            throw std::system_error(-ret,
+                                    std::system_category(),
+                                    "IoUringReadOps::File::"
+                                    "readExtentsIoUring: "
+                                    "io_uring_wait_cqe failed");
+        }
+
+        unsigned head;
+        unsigned reaped = 0;
+        io_uring_for_each_cqe(ring, head, cqe) {
+            auto* extent = static_cast<Extent*>(io_uring_cqe_get_data(cqe));
+            if (cqe->res >= 0) {
+                if (size_t(cqe->res) < extent->data.size()) {
+                    // Short reads of regular files only occur at EOF.
+                    extent->data.resize(cqe->res);
+                    extent->eof = true;
+                }
+                extent->complete = true;
+                ++batched_read_count;
+            }
+            ++reaped;
+        }
+        io_uring_cq_advance(ring, reaped);
+        inflight -= reaped;
+    }
+
+    if (failed) {
+        // Discard any reads left queued in the ring.
+        threadRing.reset();
+    }
+    return true;
+}
+#else
+bool IoUringReadOps::File::readExtentsIoUring(size_t) {
+    return false;
+}
+#endif
+
+ssize_t IoUringReadOps::File::readPrefetched(void* buf,
+                                             size_t nbytes,
+                                             cs_off_t offset) {
+    // Find the last extent starting at or before offset.
+    auto it = std::upper_bound(
+            extents.begin(),
+            extents.end(),
+            offset,
+            [](cs_off_t off, const Extent& e) { return off < e.offset; });
+    if (it == extents.begin()) {
+        return -1;
+    }
+    --it;
+    const auto available = cs_off_t(it->offset + it->data.size()) - offset;
+    if (available < 0 || (size_t(available) < nbytes && !it->eof)) {
+        return -1;
+    }
+    const auto toCopy = std::min(nbytes, size_t(available));
+    std::memcpy(buf, it->data.data() + (offset - it->offset), toCopy);
+    return toCopy;
+}
+
+size_t IoUringReadOps::File::getReadCount() {
+    auto* stats = orig_ops->get_stats(orig_handle);
+    return (stats ? stats->getReadCount() : 0) + batched_read_count;
+}
+
+size_t IoUringReadOps::File::getWriteCount() {
+    auto* stats = orig_ops->get_stats(orig_handle);
+    return stats ? stats->getWriteCount() : 0;
+}
+
+size_t IoUringReadOps::File::getWriteBytes() {
+    auto* stats = orig_ops->get_stats(orig_handle);
+    return stats ? stats->getWriteBytes() : 0;
+}
+
+IoUringReadOps::File* IoUringReadOps::getFile(Db& db) {
+    return dynamic_cast<File*>(couchstore_get_db_filestats(&db));
+}
+
+couch_file_handle IoUringReadOps::constructor(
+        couchstore_error_info_t* errinfo) {
+    FileOpsInterface* orig_ops = &wrapped_ops;
+    auto* file = new File(orig_ops, orig_ops->constructor(errinfo));
+    return reinterpret_cast<couch_file_handle>(file);
+}
+
+couchstore_error_t IoUringReadOps::open(couchstore_error_info_t* errinfo,
+                                        couch_file_handle* h,
+                                        const char* path,
+                                        int flags) {
+    auto* file = reinterpret_cast<File*>(*h);
+    file->batched_read_count = 0;
+    const auto ret =
+            file->orig_ops->open(errinfo, &file->orig_handle, path, flags);
+#ifdef EP_USE_LIBURING
+    if (ret == COUCHSTORE_SUCCESS && (flags & O_ACCMODE) == O_RDONLY) {
+        // Failure to open is not an error; the wrapped FileOps are used
+        // instead.
+        file->fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    }
+#endif
+    return ret;
+}
+
+couchstore_error_t IoUringReadOps::close(couchstore_error_info_t* errinfo,
+                                         couch_file_handle h) {
+    auto* file = reinterpret_cast<File*>(h);
+    file->extents.clear();
+#ifdef EP_USE_LIBURING
+    if (file->fd >= 0) {
+        ::close(file->fd);
+        file->fd = -1;
+    }
+#endif
+    return file->orig_ops->close(errinfo, file->orig_handle);
+}
+
+couchstore_error_t IoUringReadOps::set_periodic_sync(couch_file_handle h,
+                                                     uint64_t period_bytes) {
+    auto* file = reinterpret_cast<File*>(h);
+    return file->orig_ops->set_periodic_sync(file->orig_handle, period_bytes);
+}
+
+couchstore_error_t IoUringReadOps::set_tracing_enabled(couch_file_handle h) {
+    auto* file = reinterpret_cast<File*>(h);
+    return file->orig_ops->set_tracing_enabled(file->orig_handle);
+}
+
+couchstore_error_t IoUringReadOps::set_write_validation_enabled(
+        couch_file_handle h) {
+    auto* file = reinterpret_cast<File*>(h);
+    return file->orig_ops->set_write_validation_enabled(file->orig_handle);
+}
+
+couchstore_error_t IoUringReadOps::set_mprotect_enabled(couch_file_handle h) {
+    auto* file = reinterpret_cast<File*>(h);
+    return file->orig_ops->set_mprotect_enabled(file->orig_handle);
+}
+
+ssize_t IoUringReadOps::pread(couchstore_error_info_t* errinfo,
+                              couch_file_handle h,
+                              void* buf,
+                              size_t sz,
+                              cs_off_t off) {
+    auto* file = reinterpret_cast<File*>(h);
+    const auto copied = file->readPrefetched(buf, sz, off);
+    if (copied >= 0) {
+        return copied;
+    }
+    return file->orig_ops->pread(errinfo, file->orig_handle, buf, sz, off);
+}
+
+ssize_t IoUringReadOps::pwrite(couchstore_error_info_t* errinfo,
+                               couch_file_handle h,
+                               const void* buf,
+                               size_t sz,
+                               cs_off_t off) {
+    auto* file = reinterpret_cast<File*>(h);
+    return file->orig_ops->pwrite(errinfo, file->orig_handle, buf, sz, off);
+}
+
+cs_off_t IoUringReadOps::goto_eof(couchstore_error_info_t* errinfo,
+                                  couch_file_handle h) {
+    auto* file = reinterpret_cast<File*>(h);
+    return file->orig_ops->goto_eof(errinfo, file->orig_handle);
+}
+
+couchstore_error_t IoUringReadOps::sync(couchstore_error_info_t* errinfo,
+                                        couch_file_handle h) {
+    auto* file = reinterpret_cast<File*>(h);
+    return file->orig_ops->sync(errinfo, file->orig_handle);
+}
+
+couchstore_error_t IoUringReadOps::advise(couchstore_error_info_t* errinfo,
+                                          couch_file_handle h,
+                                          cs_off_t offs,
+                                          cs_off_t len,
+                                          couchstore_file_advice_t adv) {
+    auto* file = reinterpret_cast<File*>(h);
+    return file->orig_ops->advise(errinfo, file->orig_handle, offs, len, adv);
+}
+
+FileOpsInterface::FHStats* IoUringReadOps::get_stats(couch_file_handle h) {
+    // File implements FHStats interface directly.
+    return reinterpret_cast<File*>(h);
+}
+
+void IoUringReadOps::destructor(couch_file_handle h) {
+    auto* file = reinterpret_cast<File*>(h);
+    file->orig_ops->destructor(file->orig_handle);
+    delete file;
+}
@@ -0,0 +1,165 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <libcouchstore/couch_db.h>
+
+#include <vector>
+
+/**
+ * FileOpsInterface implementation which allows a batch of reads against a
+ * file (e.g. of all the documents of a BgFetch batch) to be issued together,
+ * instead of couchstore issuing a pread() for each in turn.
+ *
+ * All operations are forwarded to the wrapped FileOps. In addition,
+ * File::prefetch() reads the given ranges of a file and caches the data;
+ * subsequent pread()s which fall within a prefetched range are served from
+ * that cache. The cache lives until the next prefetch(), or until the file
+ * is closed.
+ *
+ * Ranges are read in file offset order, with ranges close to each other
+ * coalesced into a single read. Where liburing is available
+ * (EP_USE_LIBURING) the reads of read-only files are issued via io_uring
+ * with many in flight at once; otherwise via the wrapped FileOps' pread().
+ */
+class IoUringReadOps : public FileOpsInterface {
+public:
+    /// A range of a file to be prefetched.
+    struct Range {
+        cs_off_t offset;
+        size_t size;
+    };
+
+    /**
+     * The per-file state of IoUringReadOps; also exposed as the file's
+     * FHStats (forwarding to those of the wrapped FileOps), which allows it
+     * to be obtained from a Db via getFile().
+     */
+    class File : public FileOpsInterface::FHStats {
+    public:
+        File(FileOpsInterface* _orig_ops, couch_file_handle _orig_handle);
+
+        /**
+         * Read the given ranges (which may overlap) of the file, caching the
+         * data read for subsequent pread()s. Replaces any previously
+         * prefetched data.
+         *
+         * Ranges separated by no more than maxGap bytes are read with a
+         * single read (including the gap). Ranges which fail to be read are
+         * not cached - pread() will then read them via the wrapped FileOps
+         * as normal.
+         *
+         * @param queueDepth Maximum number of reads in flight at once when
+         *        using io_uring; if zero the wrapped FileOps are used.
+         * @returns the number of ranges which were coalesced into the read
+         *          of another range (i.e. the number of reads saved).
+         */
+        size_t prefetch(std::vector<Range> ranges,
+                        size_t maxGap,
+                        size_t queueDepth);
+
+        size_t getReadCount() override;
+        size_t getWriteCount() override;
+        size_t getWriteBytes() override;
+
+    private:
+        friend class IoUringReadOps;
+
+        /// A contiguous prefetched part of the file.
+        struct Extent {
+            cs_off_t offset;
+            std::vector<char> data;
+            /// Read reached the end of the file (data may be short).
+            bool eof = false;
+            bool complete = false;
+        };
+
+        /// Read the extents via io_uring. @returns false if unavailable.
+        bool readExtentsIoUring(size_t queueDepth);
+
+        /// Read the extents via the wrapped FileOps.
+        void readExtents();
+
+        /**
+         * Copy the given range of the file from the prefetched data.
+         * @returns the number of bytes copied, or -1 if the range has not
+         *          been prefetched.
+         */
+        ssize_t readPrefetched(void* buf, size_t nbytes, cs_off_t offset);
+
+        FileOpsInterface* orig_ops;
+        couch_file_handle orig_handle;
+
+        /// Separate descriptor used for io_uring reads; -1 if not open.
+        int fd = -1;
+
+        /// Prefetched data, sorted by (and non-overlapping in) offset.
+        std::vector<Extent> extents;
+
+        /// Number of io_uring reads completed since the file was opened.
+        size_t batched_read_count = 0;
+    };
+
+    explicit IoUringReadOps(FileOpsInterface& ops) : wrapped_ops(ops) {
+    }
+
+    /**
+     * @returns the IoUringReadOps file state of the given Db, or nullptr if
+     *          it was not opened via IoUringReadOps.
+     */
+    static File* getFile(Db& db);
+
+    couch_file_handle constructor(couchstore_error_info_t* errinfo) override;
+    couchstore_error_t open(couchstore_error_info_t* errinfo,
+                            couch_file_handle* handle,
+                            const char* path,
+                            int oflag) override;
+    couchstore_error_t close(couchstore_error_info_t* errinfo,
+                             couch_file_handle handle) override;
+    couchstore_error_t set_periodic_sync(couch_file_handle handle,
+                                         uint64_t period_bytes) override;
+    couchstore_error_t set_tracing_enabled(couch_file_handle handle) override;
+    couchstore_error_t set_write_validation_enabled(
+            couch_file_handle handle) override;
+    couchstore_error_t set_mprotect_enabled(couch_file_handle handle) override;
+
+    ssize_t pread(couchstore_error_info_t* errinfo,
+                  couch_file_handle handle,
+                  void* buf,
+                  size_t nbytes,
+                  cs_off_t offset) override;
+    ssize_t pwrite(couchstore_error_info_t* errinfo,
+                   couch_file_handle handle,
+                   const void* buf,
+                   size_t nbytes,
+                   cs_off_t offset) override;
+    cs_off_t goto_eof(couchstore_error_info_t* errinfo,
+                      couch_file_handle handle) override;
+    couchstore_error_t sync(couchstore_error_info_t* errinfo,
+                            couch_file_handle handle) override;
+    couchstore_error_t advise(couchstore_error_info_t* errinfo,
+                              couch_file_handle handle,
+                              cs_off_t offset,
+                              cs_off_t len,
+                              couchstore_file_advice_t advice) override;
+    FHStats* get_stats(couch_file_handle handle) override;
+    void destructor(couch_file_handle handle) override;
+
+protected:
+    FileOpsInterface& wrapped_ops;
+};
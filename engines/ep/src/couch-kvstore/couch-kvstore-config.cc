@@ -36,12 +36,21 @@ public:
         if (key == "couchstore_mprotect") {
             config.setCouchstoreMprotectEnabled(value);
         }
+        if (key == "couchstore_group_commit") {
+            config.setGroupCommitEnabled(value);
+        }
     }
 
     void sizeValueChanged(const std::string& key, size_t value) override {
         if (key == "couchstore_file_cache_max_size") {
             config.setCouchstoreFileCacheMaxSize(value);
         }
+        if (key == "couchstore_io_uring_queue_depth") {
+            config.setIoUringQueueDepth(value);
+        }
+        if (key == "couchstore_bg_fetch_coalesce_gap") {
+            config.setBgFetchCoalesceGap(value);
+        }
     }
 
 private:
@@ -64,10 +73,22 @@ CouchKVStoreConfig::CouchKVStoreConfig(Configuration& config,
     config.addValueChangedListener(
             "couchstore_mprotect",
             std::make_unique<ConfigChangeListener>(*this));
+    setGroupCommitEnabled(config.isCouchstoreGroupCommit());
+    config.addValueChangedListener(
+            "couchstore_group_commit",
+            std::make_unique<ConfigChangeListener>(*this));
     setCouchstoreFileCacheMaxSize(config.getCouchstoreFileCacheMaxSize());
     config.addValueChangedListener(
             "couchstore_file_cache_max_size",
             std::make_unique<ConfigChangeListener>(*this));
+    setIoUringQueueDepth(config.getCouchstoreIoUringQueueDepth());
+    config.addValueChangedListener(
+            "couchstore_io_uring_queue_depth",
+            std::make_unique<ConfigChangeListener>(*this));
+    setBgFetchCoalesceGap(config.getCouchstoreBgFetchCoalesceGap());
+    config.addValueChangedListener(
+            "couchstore_bg_fetch_coalesce_gap",
+            std::make_unique<ConfigChangeListener>(*this));
 }
 
 CouchKVStoreConfig::CouchKVStoreConfig(uint16_t maxVBuckets,
@@ -79,7 +100,10 @@ CouchKVStoreConfig::CouchKVStoreConfig(uint16_t maxVBuckets,
       buffered(true),
       couchstoreTracingEnabled(false),
       couchstoreWriteValidationEnabled(false),
-      couchstoreMprotectEnabled(false) {
+      couchstoreMprotectEnabled(false),
+      groupCommitEnabled(false),
+      ioUringQueueDepth(0),
+      bgFetchCoalesceGap(0) {
 }
 
 void CouchKVStoreConfig::setCouchstoreFileCacheMaxSize(size_t value) {
@@ -83,8 +83,44 @@ public:
         return couchstoreMprotectEnabled;
     }
 
+    void setGroupCommitEnabled(bool value) {
+        groupCommitEnabled = value;
+    }
+
+    /**
+     * Whether a commit lets the next transaction begin (see
+     * VB::Commit::writeCompleteCallback) while it syncs the file.
+     */
+    bool getGroupCommitEnabled() const {
+        return groupCommitEnabled;
+    }
+
     void setCouchstoreFileCacheMaxSize(size_t value);
 
+    void setIoUringQueueDepth(size_t value) {
+        ioUringQueueDepth = value;
+    }
+
+    /**
+     * Maximum number of reads a BgFetch batch keeps in flight via io_uring;
+     * zero if batched reads are disabled.
+     */
+    size_t getIoUringQueueDepth() const {
+        return ioUringQueueDepth;
+    }
+
+    void setBgFetchCoalesceGap(size_t value) {
+        bgFetchCoalesceGap = value;
+    }
+
+    /**
+     * Maximum number of bytes between two documents of a BgFetch batch for
+     * them to be read with a single I/O; zero if coalescing is disabled.
+     */
+    size_t getBgFetchCoalesceGap() const {
+        return bgFetchCoalesceGap;
+    }
+
 private:
     class ConfigChangeListener;
 
@@ -100,4 +136,10 @@ private:
     std::atomic_bool couchstoreWriteValidationEnabled;
     /* enbale mprotect of couchstore internal io buffer */
     std::atomic_bool couchstoreMprotectEnabled;
+    /* sync commits outside of the KVStore transaction */
+    std::atomic_bool groupCommitEnabled;
+    /* reads in flight for io_uring batched BgFetches (0 = disabled) */
+    std::atomic<size_t> ioUringQueueDepth;
+    /* max gap (bytes) between coalesced BgFetch reads (0 = disabled) */
+    std::atomic<size_t> bgFetchCoalesceGap;
 };
\ No newline at end of file
@@ -21,6 +21,7 @@
 #include "collections/collection_persisted_stats.h"
 #include "couch-kvstore-config.h"
 #include "couch-kvstore-db-holder.h"
+#include "couch-kvstore/couch-fs-uring.h"
 #include "diskdockey.h"
 #include "ep_time.h"
 #include "getkeys.h"
@@ -42,6 +43,7 @@
 #include <platform/dirutils.h>
 #include <gsl/gsl>
 
+#include <algorithm>
 #include <memory>
 #include <shared_mutex>
 #include <utility>
@@ -331,6 +333,9 @@ static constexpr const char* droppedCollectionsName =
         "_local/collections/dropped";
 } // namespace Collections
 
+/// Local document holding the PersistedBloomFilter written by compaction.
+static constexpr const char* bloomFilterName = "_local/bloomfilter";
+
 CouchKVStore::CouchKVStore(CouchKVStoreConfig& config)
     : CouchKVStore(config, *couchstore_get_default_file_ops()) {
 }
@@ -354,6 +359,8 @@ CouchKVStore::CouchKVStore(CouchKVStoreConfig& config,
     statCollectingFileOps = getCouchstoreStatsOps(st.fsStats, base_ops);
     statCollectingFileOpsCompaction = getCouchstoreStatsOps(
         st.fsStatsCompaction, base_ops);
+    batchedReadFileOps =
+            std::make_unique<IoUringReadOps>(*statCollectingFileOps);
 
     // init db file map with default revision number, 1
     auto numDbFiles = configuration.getMaxVBuckets();
@@ -599,14 +606,103 @@ GetValue CouchKVStore::getWithHeader(DbHolder& db,
     return rv;
 }
 
+/**
+ * A copy of a DocInfo (and the buffers it references), which unlike the
+ * DocInfo passed to a couchstore callback outlives the callback.
+ */
+struct OwnedDocInfo {
+    explicit OwnedDocInfo(const DocInfo& docinfo)
+        : info(docinfo),
+          id(docinfo.id.buf, docinfo.id.size),
+          revMeta(docinfo.rev_meta.buf, docinfo.rev_meta.size) {
+    }
+
+    DocInfo* get() {
+        info.id = {id.data(), id.size()};
+        info.rev_meta = {revMeta.data(), revMeta.size()};
+        return &info;
+    }
+
+    DocInfo info;
+    std::string id;
+    std::string revMeta;
+};
+
+static int collectDocInfoCallback(Db*, DocInfo* docinfo, void* ctx) {
+    static_cast<std::vector<OwnedDocInfo>*>(ctx)->emplace_back(*docinfo);
+    return 0;
+}
+
+/**
+ * Alternative to couchstore_docinfos_by_id(..., getMultiCallback) which
+ * first looks up the DocInfos of all requested keys, then reads all the
+ * document bodies required as one batch - in file offset order, with
+ * nearby documents coalesced into a single read - before passing each
+ * DocInfo to getMultiCallback (whose reads are then served from memory).
+ */
+static couchstore_error_t getMultiBatched(Db& db,
+                                          std::vector<sized_buf>& ids,
+                                          GetMultiCbCtx& ctx,
+                                          size_t coalesceGap,
+                                          size_t queueDepth) {
+    std::vector<OwnedDocInfo> docinfos;
+    docinfos.reserve(ids.size());
+    auto errCode = couchstore_docinfos_by_id(
+            &db, ids.data(), ids.size(), 0, collectDocInfoCallback, &docinfos);
+    if (errCode != COUCHSTORE_SUCCESS) {
+        return errCode;
+    }
+
+    std::vector<IoUringReadOps::Range> ranges;
+    ranges.reserve(docinfos.size());
+    for (auto& owned : docinfos) {
+        const auto* docinfo = owned.get();
+        auto itr = ctx.fetches.find(makeDiskDocKey(docinfo->id));
+        if (docinfo->bp == 0 || itr == ctx.fetches.end() ||
+            itr->second.getValueFilter() == ValueFilter::KEYS_ONLY) {
+            continue;
+        }
+        // A document body is stored as a chunk: an 8-byte header followed
+        // by the (physical) body, with a one-byte marker at the start of
+        // every 4KiB block it spans.
+        size_t size = docinfo->size + 8;
+        size += size / 4095 + 1;
+        ranges.push_back({cs_off_t(docinfo->bp), size});
+    }
+    if (auto* file = IoUringReadOps::getFile(db)) {
+        ctx.cks.getKVStoreStat().io_bg_fetch_coalesced +=
+                file->prefetch(std::move(ranges), coalesceGap, queueDepth);
+    }
+
+    // Process in file order, so any reads not prefetched are also made in
+    // offset order.
+    std::sort(docinfos.begin(),
+              docinfos.end(),
+              [](const auto& a, const auto& b) {
+                  return a.info.bp < b.info.bp;
+              });
+    for (auto& owned : docinfos) {
+        getMultiCallback(&db, owned.get(), &ctx);
+    }
+    return COUCHSTORE_SUCCESS;
+}
+
 void CouchKVStore::getMulti(Vbid vb, vb_bgfetch_queue_t& itms) {
     if (itms.empty()) {
         return;
     }
     int numItems = itms.size();
 
+    const auto coalesceGap = configuration.getBgFetchCoalesceGap();
+    const auto queueDepth = configuration.getIoUringQueueDepth();
+    const bool batched = coalesceGap > 0 || queueDepth > 0;
+
     DbHolder db(*this);
-    couchstore_error_t errCode = openDB(vb, db, COUCHSTORE_OPEN_FLAG_RDONLY);
+    couchstore_error_t errCode =
+            openDB(vb,
+                   db,
+                   COUCHSTORE_OPEN_FLAG_RDONLY,
+                   batched ? batchedReadFileOps.get() : nullptr);
     if (errCode != COUCHSTORE_SUCCESS) {
         logger.warn(
                 "CouchKVStore::getMulti: openDB error:{}, "
@@ -630,8 +726,12 @@ void CouchKVStore::getMulti(Vbid vb, vb_bgfetch_queue_t& itms) {
 
     GetMultiCbCtx ctx(*this, vb, itms);
 
-    errCode = couchstore_docinfos_by_id(
-            db, ids.data(), itms.size(), 0, getMultiCallback, &ctx);
+    if (batched) {
+        errCode = getMultiBatched(*db, ids, ctx, coalesceGap, queueDepth);
+    } else {
+        errCode = couchstore_docinfos_by_id(
+                db, ids.data(), itms.size(), 0, getMultiCallback, &ctx);
+    }
     if (errCode != COUCHSTORE_SUCCESS) {
         st.numGetFailure += numItems;
         logger.warn(
@@ -982,6 +1082,10 @@ static int time_purge_hook(Db* d,
         }
     }
 
+    if (ctx->persistedFilter && !metadata->isPrepare()) {
+        ctx->addToPersistedFilter(docKey);
+    }
+
     return COUCHSTORE_COMPACT_KEEP_ITEM;
 }
 
@@ -1323,6 +1427,7 @@ CouchKVStore::CompactDBInternalStatus CouchKVStore::compactDBInternal(
         // @todo I'm not sure if updating the bloom filter as part of
         //       traversing historical data is what we want to do :S
         hook_ctx->bloomFilterCallback = {};
+        hook_ctx->persistedFilter.reset();
 
         CompactionReplayPrepareStats prepareStats;
         uint64_t purge_seqno = 0;
@@ -1409,6 +1514,10 @@ CouchKVStore::CompactDBInternalStatus CouchKVStore::compactDBInternal(
         hook_ctx->eraserContext =
                 std::make_unique<Collections::VB::EraserContext>(
                         droppedCollections);
+        // Compaction copies the source file as of now; mutations after this
+        // are replayed into the new file later so aren't in persistedFilter.
+        const auto filterSeqno =
+                cb::couchstore::getHeader(*sourceDb).updateSeqNum;
         errCode = cb::couchstore::compact(
                 *sourceDb,
                 compact_file.c_str(),
@@ -1418,7 +1527,7 @@ CouchKVStore::CompactDBInternalStatus CouchKVStore::compactDBInternal(
                 },
                 {},
                 def_iops,
-                [vbid, hook_ctx, this](Db& compacted) {
+                [vbid, hook_ctx, filterSeqno, this](Db& compacted) {
                     if (mb40415_regression_hook) {
                         return COUCHSTORE_ERROR_CANCEL;
                     }
@@ -1439,6 +1548,11 @@ CouchKVStore::CompactDBInternalStatus CouchKVStore::compactDBInternal(
                                 Collections::droppedCollectionsName,
                                 CouchLocalDocRequest::IsDeleted{});
                     }
+                    if (hook_ctx->persistedFilter) {
+                        localDocQueue.emplace_back(
+                                bloomFilterName,
+                                hook_ctx->takePersistedFilter(filterSeqno));
+                    }
                     auto ret = maybePatchOnDiskPrepares(
                             compacted, hook_ctx->stats, localDocQueue, vbid);
                     if (ret == COUCHSTORE_SUCCESS) {
@@ -1972,14 +2086,28 @@ bool CouchKVStore::commit(VB::Commit& commitData) {
                         "object.");
     }
 
-    if (inTransaction) {
-        if (commit2couchstore(commitData)) {
+    if (!inTransaction) {
+        return true;
+    }
+
+    if (!configuration.getGroupCommitEnabled()) {
+        if (commit2couchstore(
+                    commitData, pendingReqsQ, *transactionCtx, false)) {
             inTransaction = false;
             transactionCtx.reset();
         }
+        return !inTransaction;
     }
 
-    return !inTransaction;
+    // Take over the state of the transaction so that the next one may begin
+    // (see VB::Commit::writeCompleteCallback) while this one is synced; the
+    // requests don't move with the deque. A failed commit therefore doesn't
+    // leave the transaction open, the caller has to begin() again to retry.
+    auto committedReqs = std::move(pendingReqsQ);
+    pendingReqsQ.clear();
+    auto txCtx = std::move(transactionCtx);
+    inTransaction = false;
+    return commit2couchstore(commitData, committedReqs, *txCtx, true);
 }
 
 bool CouchKVStore::getStat(std::string_view name, size_t& value) const {
@@ -2012,6 +2140,9 @@ bool CouchKVStore::getStat(std::string_view name, size_t& value) const {
     } else if (name == "io_bg_fetch_read_count") {
         value = st.getMultiFsReadCount;
         return true;
+    } else if (name == "io_bg_fetch_coalesced") {
+        value = st.io_bg_fetch_coalesced;
+        return true;
     }
 
     return false;
@@ -2747,15 +2878,18 @@ static int byIdScanCallback(Db* db, DocInfo* docinfo, void* ctx) {
     return int(status);
 }
 
-bool CouchKVStore::commit2couchstore(VB::Commit& commitData) {
+bool CouchKVStore::commit2couchstore(VB::Commit& commitData,
+                                     PendingRequestQueue& committedReqs,
+                                     TransactionContext& txCtx,
+                                     bool syncOutsideTransaction) {
     bool success = true;
 
-    size_t pendingCommitCnt = pendingReqsQ.size();
+    size_t pendingCommitCnt = committedReqs.size();
     if (pendingCommitCnt == 0) {
         return success;
     }
 
-    const auto vbid = transactionCtx->vbid;
+    const auto vbid = txCtx.vbid;
 
     TRACE_EVENT2("CouchKVStore",
                  "commit2couchstore",
@@ -2769,7 +2903,7 @@ bool CouchKVStore::commit2couchstore(VB::Commit& commitData) {
     std::vector<void*> kvReqs(pendingCommitCnt);
 
     for (size_t i = 0; i < pendingCommitCnt; ++i) {
-        auto& req = pendingReqsQ[i];
+        auto& req = committedReqs[i];
         docs[i] = req.getDbDoc();
         docinfos[i] = req.getDbDocInfo();
         kvReqs[i] = &req;
@@ -2777,7 +2911,8 @@ bool CouchKVStore::commit2couchstore(VB::Commit& commitData) {
 
     kvstats_ctx kvctx(commitData);
     // flush all
-    const auto errCode = saveDocs(vbid, docs, docinfos, kvReqs, kvctx);
+    const auto errCode = saveDocs(
+            vbid, docs, docinfos, kvReqs, kvctx, syncOutsideTransaction);
 
     if (errCode) {
         success = false;
@@ -2798,9 +2933,9 @@ bool CouchKVStore::commit2couchstore(VB::Commit& commitData) {
         postFlushHook();
     }
 
-    commitCallback(pendingReqsQ, kvctx, errCode);
+    commitCallback(committedReqs, txCtx, kvctx, errCode);
 
-    pendingReqsQ.clear();
+    committedReqs.clear();
     return success;
 }
 
@@ -2898,7 +3033,9 @@ couchstore_error_t CouchKVStore::saveDocs(Vbid vbid,
                                           const std::vector<Doc*>& docs,
                                           const std::vector<DocInfo*>& docinfos,
                                           const std::vector<void*>& kvReqs,
-                                          kvstats_ctx& kvctx) {
+                                          kvstats_ctx& kvctx,
+                                          bool syncOutsideTransaction) {
+    const auto writeBegin = std::chrono::steady_clock::now();
     couchstore_error_t errCode;
     DbHolder db(*this);
     errCode = openDB(vbid, db, COUCHSTORE_OPEN_FLAG_CREATE);
@@ -3006,6 +3143,15 @@ couchstore_error_t CouchKVStore::saveDocs(Vbid vbid,
     pendingLocalReqsQ.clear();
 
     auto cs_begin = std::chrono::steady_clock::now();
+    st.commitWriteHisto.add(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                    cs_begin - writeBegin));
+
+    // All but the header is written. From here on only this vBucket's file
+    // and stats are touched, so other vBuckets may be flushed meanwhile.
+    if (syncOutsideTransaction && kvctx.commitData.writeCompleteCallback) {
+        kvctx.commitData.writeCompleteCallback();
+    }
 
     errCode = couchstore_commit(db, kvctx.commitData.sysErrorCallback);
     st.commitHisto.add(std::chrono::duration_cast<std::chrono::microseconds>(
@@ -3056,6 +3202,7 @@ couchstore_error_t CouchKVStore::saveDocs(Vbid vbid,
 }
 
 void CouchKVStore::commitCallback(PendingRequestQueue& committedReqs,
+                                  TransactionContext& txCtx,
                                   kvstats_ctx& kvctx,
                                   couchstore_error_t errCode) {
     const auto flushSuccess = (errCode == COUCHSTORE_SUCCESS);
@@ -3081,7 +3228,7 @@ void CouchKVStore::commitCallback(PendingRequestQueue& committedReqs,
                 ++st.numDelFailure;
             }
 
-            transactionCtx->deleteCallback(committed.getItem(), state);
+            txCtx.deleteCallback(committed.getItem(), state);
         } else {
             FlushStateMutation state;
             if (flushSuccess) {
@@ -3099,7 +3246,7 @@ void CouchKVStore::commitCallback(PendingRequestQueue& committedReqs,
                 ++st.numSetFailure;
             }
 
-            transactionCtx->setCallback(committed.getItem(), state);
+            txCtx.setCallback(committed.getItem(), state);
         }
     }
 }
@@ -4022,6 +4169,24 @@ vbucket_state CouchKVStore::getPersistedVBucketState(Vbid vbid) {
     return res.state;
 }
 
+std::optional<PersistedBloomFilter> CouchKVStore::getPersistedBloomFilter(
+        Vbid vbid) {
+    DbHolder db(*this);
+    auto errCode = openDB(vbid, db, COUCHSTORE_OPEN_FLAG_RDONLY);
+    if (errCode != COUCHSTORE_SUCCESS) {
+        // openDB would of logged any critical error
+        return {};
+    }
+
+    auto res = readLocalDoc(*db.getDb(), bloomFilterName);
+    if (res.status != COUCHSTORE_SUCCESS) {
+        return {};
+    }
+    auto buffer = res.doc.getBuffer();
+    return PersistedBloomFilter::decode(
+            {reinterpret_cast<const char*>(buffer.data()), buffer.size()});
+}
+
 couchstore_error_t CouchKVStore::updateLocalDocuments(
         Db& db, PendingLocalDocRequestQueue& queue) {
     if (queue.size() == 0) {
@@ -389,6 +389,9 @@ public:
      */
     vbucket_state getPersistedVBucketState(Vbid vbid) override;
 
+    std::optional<PersistedBloomFilter> getPersistedBloomFilter(
+            Vbid vbid) override;
+
     /// Get the logger used by this bucket
     BucketLogger& getLogger() {
         return logger;
@@ -468,7 +471,18 @@ protected:
     bool writeVBucketState(Vbid vbucketId, const vbucket_state& vbstate);
 
     void close();
-    bool commit2couchstore(VB::Commit& commitData);
+
+    /**
+     * Write and sync the given requests of a transaction.
+     *
+     * @param syncOutsideTransaction if true the transaction is already
+     *        taken over from the KVStore, and the commitData's
+     *        writeCompleteCallback is executed before syncing the file
+     */
+    bool commit2couchstore(VB::Commit& commitData,
+                           PendingRequestQueue& committedReqs,
+                           TransactionContext& txCtx,
+                           bool syncOutsideTransaction);
 
     /**
      * Populate CouchKVStore::dbFileRevMap and remove any couch files that are
@@ -547,6 +561,8 @@ protected:
      * @param kvReqs Vector of pointers to KV requests being passed to the
      *        storage. Same order as docs and docsinfo.
      * @param kvctx a stats context object to update
+     * @param syncOutsideTransaction execute the writeCompleteCallback of
+     *        kvctx's commitData before syncing the file
      *
      * @returns COUCHSTORE_SUCCESS or a failure code (failure paths log)
      */
@@ -554,9 +570,11 @@ protected:
                                 const std::vector<Doc*>& docs,
                                 const std::vector<DocInfo*>& docinfos,
                                 const std::vector<void*>& kvReqs,
-                                kvstats_ctx& kvctx);
+                                kvstats_ctx& kvctx,
+                                bool syncOutsideTransaction);
 
     void commitCallback(PendingRequestQueue& committedReqs,
+                        TransactionContext& txCtx,
                         kvstats_ctx& kvctx,
                         couchstore_error_t errCode);
 
@@ -907,6 +925,12 @@ protected:
      */
     std::unique_ptr<FileOpsInterface> statCollectingFileOpsCompaction;
 
+    /**
+     * FileOpsInterface implementation (wrapping statCollectingFileOps) used
+     * by getMulti to read all the documents of a batch together.
+     */
+    std::unique_ptr<FileOpsInterface> batchedReadFileOps;
+
     /* deleted docs in each file, indexed by vBucket. RelaxedAtomic
        to allow stats access witout lock */
     std::vector<cb::RelaxedAtomic<size_t>> cachedDeleteCount;
@@ -994,8 +994,8 @@ std::unique_ptr<DcpResponse> ActiveStream::nextQueuedItem() {
 
 bool ActiveStream::nextCheckpointItem() {
     VBucketPtr vbucket = engine->getVBucket(vb_);
-    if (vbucket && vbucket->checkpointManager->getNumItemsForCursor(
-                           cursor.lock().get()) > 0) {
+    if (vbucket && vbucket->checkpointManager->hasItemsForCursor(
+                           cursor.lock().get())) {
         // schedule this stream to build the next checkpoint
         auto producer = producerPtr.lock();
         if (!producer) {
@@ -0,0 +1,50 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2020 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "deferred_reclamation.h"
+
+#include "objectregistry.h"
+
+void DeferredReclamation::synchronize() {
+    folly::synchronize_rcu();
+}
+
+void DeferredReclamation::barrier() {
+    folly::rcu_barrier();
+}
+
+namespace {
+/// A retired object's free function, plus the engine it is accounted to.
+struct RetiredObject {
+    EventuallyPersistentEngine* engine;
+    std::function<void()> free;
+};
+} // namespace
+
+void DeferredReclamation::retireImpl(std::function<void()> free) {
+    // Record which engine the object is accounted against, so that when
+    // the callback is eventually run (possibly on another thread, or this
+    // thread while it is servicing a different bucket) the free is
+    // attributed to the correct bucket.
+    auto* retired = new RetiredObject{ObjectRegistry::getCurrentEngine(),
+                                      std::move(free)};
+    folly::rcu_retire(retired, [](RetiredObject* obj) {
+        BucketAllocationGuard guard(obj->engine);
+        obj->free();
+        delete obj;
+    });
+}
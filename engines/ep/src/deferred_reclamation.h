@@ -0,0 +1,78 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2020 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/synchronization/Rcu.h>
+
+#include <functional>
+
+/**
+ * Deferred (RCU-based) reclamation of objects which may be read without
+ * holding the lock which guards them.
+ *
+ * The optimistic HashTable read path (see HashTable::findForReadOptimistic)
+ * walks hash chains and reads StoredValue / Blob objects without acquiring
+ * the hash bucket mutex, validating what it read afterwards against the
+ * bucket's version counter. For that to be memory-safe, objects which a
+ * writer unlinks must not be freed until all such readers have finished -
+ * i.e. until an RCU grace period has elapsed.
+ *
+ * Only objects which may be read that way are retired via this class -
+ * StoredValues linked into a HashTable configured for optimistic reads
+ * (see StoredValue::isOptimisticallyRead), their values and such a
+ * HashTable's old table after a resize. All other objects are freed
+ * immediately as before, so buckets not using optimistic reads are
+ * unaffected.
+ *
+ * Objects are freed on whichever thread happens to run the RCU callbacks,
+ * so the engine which owned the object at the time it was retired is
+ * recorded and re-instated (via BucketAllocationGuard) for the free, keeping
+ * per-bucket memory accounting correct.
+ */
+class DeferredReclamation {
+public:
+    /// RAII guard marking an optimistic (lock-free) read-side critical
+    /// section; objects retired while it is held will not be freed until
+    /// it has been released.
+    using ReadGuard = folly::rcu_reader;
+
+    /**
+     * Free the given object via the specified function once an RCU grace
+     * period has elapsed.
+     */
+    template <typename T, typename Free>
+    static void retire(T* ptr, Free free) {
+        retireImpl([ptr, free]() { free(ptr); });
+    }
+
+    /**
+     * Block until an RCU grace period has elapsed - i.e. all read-side
+     * critical sections which were in progress when called have completed.
+     */
+    static void synchronize();
+
+    /**
+     * Block until all previously retired objects have been freed. Must be
+     * called before an engine is destroyed, as retired objects record the
+     * engine they are accounted against.
+     */
+    static void barrier();
+
+private:
+    static void retireImpl(std::function<void()> free);
+};
@@ -182,7 +182,11 @@ bool BloomFilterCallback::initTempFilter(Vbid vbucketId) {
         estimated_count = initial_estimation;
     }
 
-    vb->initTempFilter(estimated_count, config.getBfilterFpProb());
+    vb->initTempFilter(estimated_count,
+                       config.getBfilterFpProb(),
+                       config.getBfilterType() == "blocked"
+                               ? BloomFilter::Type::Blocked
+                               : BloomFilter::Type::Classic);
 
     return true;
 }
@@ -216,6 +220,9 @@ public:
     void sizeValueChanged(const std::string& key, size_t value) override {
         if (key == "flusher_total_batch_limit") {
             bucket.setFlusherBatchSplitTrigger(value);
+        } else if (key == "flusher_target_commit_latency") {
+            bucket.setFlusherTargetCommitLatency(
+                    std::chrono::milliseconds(value));
         } else if (key == "alog_sleep_time") {
             bucket.setAccessScannerSleeptime(value, false);
         } else if (key == "alog_task_time") {
@@ -234,6 +241,10 @@ public:
             }
         } else if (key == "retain_erroneous_tombstones") {
             bucket.setRetainErroneousTombstones(value);
+        } else if (key == "flusher_adaptive_batch_size") {
+            bucket.setAdaptiveFlushBatchSize(value);
+        } else if (key == "bgfetch_admission_control") {
+            bucket.setBgFetchAdmissionControl(value);
         } else  {
             EP_LOG_WARN("Failed to change value for unknown variable, {}", key);
         }
@@ -244,7 +255,19 @@ private:
 };
 
 EPBucket::EPBucket(EventuallyPersistentEngine& theEngine)
-    : KVBucket(theEngine) {
+    : KVBucket(theEngine),
+      adaptiveFlushBatchSize(
+              theEngine.getConfiguration().isFlusherAdaptiveBatchSize()),
+      flushBatchController(stats,
+                           theEngine.getConfiguration()
+                                   .getFlusherTotalBatchLimit(),
+                           std::chrono::milliseconds(
+                                   theEngine.getConfiguration()
+                                           .getFlusherTargetCommitLatency())),
+      bgFetchAdmissionControl(
+              theEngine.getConfiguration().isBgfetchAdmissionControl()),
+      bgFetchFrequencySketch(
+              theEngine.getConfiguration().getBgfetchAdmissionSketchSize()) {
     auto& config = engine.getConfiguration();
     const std::string& policy = config.getItemEvictionPolicy();
     if (policy.compare("value_only") == 0) {
@@ -273,6 +296,16 @@ EPBucket::EPBucket(EventuallyPersistentEngine& theEngine)
     config.addValueChangedListener(
             "flusher_total_batch_limit",
             std::make_unique<ValueChangedListener>(*this));
+    config.addValueChangedListener(
+            "flusher_adaptive_batch_size",
+            std::make_unique<ValueChangedListener>(*this));
+    config.addValueChangedListener(
+            "flusher_target_commit_latency",
+            std::make_unique<ValueChangedListener>(*this));
+
+    config.addValueChangedListener(
+            "bgfetch_admission_control",
+            std::make_unique<ValueChangedListener>(*this));
 
     retainErroneousTombstones = config.isRetainErroneousTombstones();
     config.addValueChangedListener(
@@ -369,7 +402,7 @@ EPBucket::FlushResult EPBucket::flushVBucket(Vbid vbid) {
 
     // Obtain the set of items to flush, up to the maximum allowed for
     // a single flush.
-    auto toFlush = vb->getItemsToPersist(flusherBatchSplitTrigger);
+    auto toFlush = vb->getItemsToPersist(getFlushBatchSize());
 
     // Callback must be initialized at persistence
     Expects(toFlush.flushHandle.get());
@@ -401,6 +434,17 @@ EPBucket::FlushResult EPBucket::flushVBucket(Vbid vbid) {
     std::optional<snapshot_range_t> range;
     KVStore* rwUnderlying = getRWUnderlying(vb->getId());
 
+    // Sorting the items doesn't touch the KVStore, do it before taking the
+    // transaction lock.
+    rwUnderlying->optimizeWrites(toFlush.items);
+
+    // Other vBuckets of this shard may be flushed concurrently (see
+    // flusher_concurrent_vbuckets), but the KVStore supports a single
+    // transaction at a time. Held until the flush-batch is committed (or
+    // only until it is written, see VB::Commit::writeCompleteCallback).
+    std::unique_lock<std::mutex> transactionLock(
+            vbMap.getShardByVbId(vbid)->getFlushTransactionLock());
+
     while (!rwUnderlying->begin(
             std::make_unique<EPTransactionContext>(stats, *vb))) {
         ++stats.beginFailed;
@@ -410,8 +454,6 @@ EPBucket::FlushResult EPBucket::flushVBucket(Vbid vbid) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
-    rwUnderlying->optimizeWrites(toFlush.items);
-
     Item* prev = nullptr;
 
     // Read the vbucket_state from disk as many values from the
@@ -446,6 +488,9 @@ EPBucket::FlushResult EPBucket::flushVBucket(Vbid vbid) {
     };
 
     VB::Commit commitData(vb->getManifest(), vbstate, callback);
+    commitData.writeCompleteCallback = [&transactionLock]() {
+        transactionLock.unlock();
+    };
 
     vbucket_state& proposedVBState = commitData.proposedVBState;
 
@@ -768,7 +813,14 @@ EPBucket::FlushResult EPBucket::flushVBucket(Vbid vbid) {
     }
 
     // Persist the flush-batch.
+    const auto commitStart = std::chrono::steady_clock::now();
     const auto flushSuccess = commit(vbid, *rwUnderlying, commitData);
+    const auto commitTime =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - commitStart);
+    if (transactionLock.owns_lock()) {
+        transactionLock.unlock();
+    }
 
     if (!flushSuccess) {
         // Flush failed, we need to reset the pcursor to the original
@@ -784,6 +836,14 @@ EPBucket::FlushResult EPBucket::flushVBucket(Vbid vbid) {
     Expects(range.has_value());
     vb->setPersistedSnapshot(*range);
 
+    if (adaptiveFlushBatchSize) {
+        flushBatchController.recordCommit(
+                moreAvailable == MoreAvailable::Yes,
+                hps.has_value(),
+                commitTime,
+                stats.diskQueueSize);
+    }
+
     uint64_t highSeqno = rwUnderlying->getLastPersistedSeqno(vbid);
     if (highSeqno > 0 && highSeqno != vb->getPersistenceSeqno()) {
         vb->setPersistenceSeqno(highSeqno);
@@ -889,12 +949,58 @@ void EPBucket::setFlusherBatchSplitTrigger(size_t limit) {
     // limit of 1 as a 0 limit could cause us to fail to flush anything.
     flusherBatchSplitTrigger =
             std::max(size_t(1), limit / ExecutorPool::get()->getNumWriters());
+    flushBatchController.setMaxBatchSize(flusherBatchSplitTrigger);
 }
 
 size_t EPBucket::getFlusherBatchSplitTrigger() {
     return flusherBatchSplitTrigger;
 }
 
+size_t EPBucket::getFlushBatchSize() const {
+    if (adaptiveFlushBatchSize) {
+        return flushBatchController.getBatchSize();
+    }
+    return flusherBatchSplitTrigger;
+}
+
+std::chrono::microseconds EPBucket::getFlusherPacingDelay() const {
+    if (adaptiveFlushBatchSize) {
+        return flushBatchController.getPacingDelay();
+    }
+    return std::chrono::microseconds{0};
+}
+
+void EPBucket::setAdaptiveFlushBatchSize(bool enabled) {
+    // Start over from the configured batch size either way, so the stats
+    // don't show decisions made while (previously) enabled.
+    flushBatchController.reset();
+    adaptiveFlushBatchSize = enabled;
+}
+
+bool EPBucket::admitBgFetchedValue(const DocKey& key) {
+    if (!bgFetchAdmissionControl) {
+        return true;
+    }
+
+    const auto frequency = bgFetchFrequencySketch.increment(key.hash());
+    if (frequency >= BgFetchAdmissionMinFrequency) {
+        return true;
+    }
+
+    // Below the low watermark caching the value displaces nothing.
+    if (stats.getEstimatedTotalMemoryUsed() < stats.mem_low_wat.load()) {
+        return true;
+    }
+
+    ++stats.bgFetchNotAdmitted;
+    return false;
+}
+
+void EPBucket::setFlusherTargetCommitLatency(
+        std::chrono::milliseconds latency) {
+    flushBatchController.setTargetCommitLatency(latency);
+}
+
 bool EPBucket::commit(Vbid vbid, KVStore& kvstore, VB::Commit& commitData) {
     HdrMicroSecBlockTimer timer(
             &stats.diskCommitHisto, "disk_commit", stats.timingLog);
@@ -1248,6 +1354,35 @@ void EPBucket::compactInternal(LockedVBucketPtr& vb, CompactionConfig& config) {
     auto ctx = makeCompactionContext(vb->getId(), config, vb->getPurgeSeqno());
     auto* shard = vbMap.getShardByVbId(vb->getId());
     auto* store = shard->getRWUnderlying();
+
+    auto& engineConfig = getEPEngine().getConfiguration();
+    if (engineConfig.isBfilterEnabled() && engineConfig.isBfilterPersist() &&
+        getItemEvictionPolicy() == EvictionPolicy::Full) {
+        // Build a filter of every key compaction keeps, for warmup to load.
+        // Size it as initTempFilter does with all items considered.
+        size_t numDeletes = 0;
+        try {
+            numDeletes = store->getNumPersistedDeletes(vb->getId());
+        } catch (std::runtime_error& re) {
+            EP_LOG_WARN(
+                    "EPBucket::compactInternal: runtime error while getting "
+                    "number of persisted deletes for {}, sizing persisted "
+                    "bloom filter for items only. Details: {}",
+                    vb->getId(),
+                    re.what());
+        }
+        const size_t estimatedCount =
+                std::max(size_t(round(1.25 * (vb->getNumTotalItems() +
+                                              numDeletes))),
+                         engineConfig.getBfilterKeyCount());
+        ctx->persistedFilter = std::make_unique<BloomFilter>(
+                estimatedCount,
+                engineConfig.getBfilterFpProb(),
+                BFILTER_ENABLED,
+                engineConfig.getBfilterType() == "blocked"
+                        ? BloomFilter::Type::Blocked
+                        : BloomFilter::Type::Classic);
+    }
     bool result = store->compactDB(vb.getLock(), ctx);
 
     if (getEPEngine().getConfiguration().isBfilterEnabled() && result) {
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include "flush_batch_controller.h"
+#include "frequency_sketch.h"
 #include "kv_bucket.h"
 #include "kvstore.h"
 
@@ -86,6 +88,44 @@ public:
 
     size_t getFlusherBatchSplitTrigger();
 
+    /**
+     * @return the (approximate) number of items to flush from a vBucket in a
+     *         single flusher commit; the flusherBatchSplitTrigger unless
+     *         flusher_adaptive_batch_size is enabled.
+     */
+    size_t getFlushBatchSize() const;
+
+    /**
+     * @return how long the Flusher should wait between flush-batches of low
+     *         priority vBuckets (non-zero only with
+     *         flusher_adaptive_batch_size)
+     */
+    std::chrono::microseconds getFlusherPacingDelay() const;
+
+    void setAdaptiveFlushBatchSize(bool enabled);
+
+    void setFlusherTargetCommitLatency(std::chrono::milliseconds latency);
+
+    /**
+     * Decide if a value fetched from disk for the given key should be cached
+     * normally, or only as the first candidate for eviction (see
+     * bgfetch_admission_control). Records the fetch of the key.
+     *
+     * @return true if the value should be cached normally
+     */
+    bool admitBgFetchedValue(const DocKey& key);
+
+    void setBgFetchAdmissionControl(bool enabled) {
+        bgFetchAdmissionControl = enabled;
+    }
+
+    /**
+     * A fetched value is cached normally (when bgfetch_admission_control is
+     * enabled) if its key has been fetched at least this many times recently
+     * (including this fetch).
+     */
+    static constexpr uint8_t BgFetchAdmissionMinFrequency = 2;
+
     /**
      * Persist whatever flush-batch previously queued into KVStore.
      *
@@ -375,6 +415,19 @@ protected:
      */
     std::atomic<size_t> flusherBatchSplitTrigger;
 
+    /// Whether flushVBucket() sizes flush-batches with flushBatchController
+    std::atomic_bool adaptiveFlushBatchSize;
+
+    /// Sizes flush-batches from the observed commit latency (see
+    /// flusher_adaptive_batch_size)
+    FlushBatchController flushBatchController;
+
+    /// Whether admitBgFetchedValue() may decline to cache values normally
+    std::atomic_bool bgFetchAdmissionControl;
+
+    /// How often keys have recently been fetched (see admitBgFetchedValue)
+    FrequencySketch bgFetchFrequencySketch;
+
     /**
      * Indicates whether erroneous tombstones need to retained or not during
      * compaction
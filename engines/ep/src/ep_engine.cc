@@ -31,6 +31,7 @@
 #include "dcp/flow-control-manager.h"
 #include "dcp/msg_producers_border_guard.h"
 #include "dcp/producer.h"
+#include "deferred_reclamation.h"
 #include "environment.h"
 #include "ep_bucket.h"
 #include "ep_engine_public.h"
@@ -52,7 +53,6 @@
 #include "vb_count_visitor.h"
 #include "warmup.h"
 
-#include <JSON_checker.h>
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
@@ -78,6 +78,7 @@
 #include <statistics/prometheus.h>
 #include <utilities/engine_errc_2_mcbp.h>
 #include <utilities/hdrhistogram.h>
+#include <utilities/json_validator.h>
 #include <utilities/logtags.h>
 #include <xattr/utils.h>
 
@@ -516,6 +517,8 @@ cb::engine_errc EventuallyPersistentEngine::setCheckpointParam(
             getConfiguration().setItemNumBasedNewChk(cb_stob(val));
         } else if (key == "keep_closed_chks") {
             getConfiguration().setKeepClosedChks(cb_stob(val));
+        } else if (key == "dcp_shared_checkpoint_reads") {
+            getConfiguration().setDcpSharedCheckpointReads(cb_stob(val));
         } else if (key == "cursor_dropping_checkpoint_mem_upper_mark") {
             getConfiguration().setCursorDroppingCheckpointMemUpperMark(
                     std::stoull(val));
@@ -610,6 +613,10 @@ cb::engine_errc EventuallyPersistentEngine::setFlushParam(
             getConfiguration().setExpPagerStime(std::stoull(val));
         } else if (key == "exp_pager_initial_run_time") {
             getConfiguration().setExpPagerInitialRunTime(std::stoll(val));
+        } else if (key == "flusher_adaptive_batch_size") {
+            getConfiguration().setFlusherAdaptiveBatchSize(cb_stob(val));
+        } else if (key == "flusher_target_commit_latency") {
+            getConfiguration().setFlusherTargetCommitLatency(std::stoull(val));
         } else if (key == "flusher_total_batch_limit") {
             getConfiguration().setFlusherTotalBatchLimit(std::stoll(val));
         } else if (key == "getl_default_timeout") {
@@ -639,6 +646,8 @@ cb::engine_errc EventuallyPersistentEngine::setFlushParam(
             getConfiguration().setBfilterFpProb(std::stof(val));
         } else if (key == "bfilter_key_count") {
             getConfiguration().setBfilterKeyCount(std::stoull(val));
+        } else if (key == "bfilter_type") {
+            getConfiguration().setBfilterType(val);
         } else if (key == "pager_active_vb_pcnt") {
             getConfiguration().setPagerActiveVbPcnt(std::stoull(val));
         } else if (key == "pager_sleep_time_ms") {
@@ -678,6 +687,8 @@ cb::engine_errc EventuallyPersistentEngine::setFlushParam(
             ExecutorPool::get()->setNumNonIO(value);
         } else if (key == "bfilter_enabled") {
             getConfiguration().setBfilterEnabled(cb_stob(val));
+        } else if (key == "bfilter_persist") {
+            getConfiguration().setBfilterPersist(cb_stob(val));
         } else if (key == "bfilter_residency_threshold") {
             getConfiguration().setBfilterResidencyThreshold(std::stof(val));
         } else if (key == "defragmenter_enabled") {
@@ -736,6 +747,8 @@ cb::engine_errc EventuallyPersistentEngine::setFlushParam(
             getConfiguration().setXattrEnabled(cb_stob(val));
         } else if (key == "compression_mode") {
             getConfiguration().setCompressionMode(val);
+        } else if (key == "compression_codec") {
+            getConfiguration().setCompressionCodec(val);
         } else if (key == "min_compression_ratio") {
             float min_comp_ratio;
             if (safe_strtof(val.c_str(), min_comp_ratio)) {
@@ -755,6 +768,8 @@ cb::engine_errc EventuallyPersistentEngine::setFlushParam(
             getConfiguration().setCouchstoreWriteValidation(cb_stob(val));
         } else if (key == "couchstore_mprotect") {
             getConfiguration().setCouchstoreMprotect(cb_stob(val));
+        } else if (key == "couchstore_group_commit") {
+            getConfiguration().setCouchstoreGroupCommit(cb_stob(val));
         } else if (key == "allow_sanitize_value_in_deletion") {
             getConfiguration().setAllowSanitizeValueInDeletion(cb_stob(val));
         } else if (key == "pitr_enabled") {
@@ -801,6 +816,20 @@ cb::engine_errc EventuallyPersistentEngine::setFlushParam(
             } else {
                 rv = cb::engine_errc::invalid_arguments;
             }
+        } else if (key == "couchstore_io_uring_queue_depth") {
+            uint32_t value;
+            if (safe_strtoul(val.c_str(), value)) {
+                getConfiguration().setCouchstoreIoUringQueueDepth(value);
+            } else {
+                rv = cb::engine_errc::invalid_arguments;
+            }
+        } else if (key == "couchstore_bg_fetch_coalesce_gap") {
+            uint32_t value;
+            if (safe_strtoul(val.c_str(), value)) {
+                getConfiguration().setCouchstoreBgFetchCoalesceGap(value);
+            } else {
+                rv = cb::engine_errc::invalid_arguments;
+            }
         } else {
             msg = "Unknown config param";
             rv = cb::engine_errc::invalid_arguments;
@@ -2696,6 +2725,12 @@ void EventuallyPersistentEngine::doEngineStatsCouchDB(const BucketStatCollector&
         double readAmp = fetched ? double(value) / double(fetched) : 0.0;
         collector.addStat(Key::ep_bg_fetch_avg_read_amplification, readAmp);
     }
+
+    if (kvBucket->getKVStoreStat("io_bg_fetch_coalesced",
+                                 value,
+                                 KVBucketIface::KVSOption::BOTH)) {
+        collector.addStat(Key::ep_bg_fetch_coalesced, value);
+    }
 }
 
 void EventuallyPersistentEngine::doEngineStatsMagma(
@@ -2899,6 +2934,14 @@ cb::engine_errc EventuallyPersistentEngine::doEngineStats(
         collector.addStat(Key::ep_commit_time, epstats.commit_time);
         collector.addStat(Key::ep_commit_time_total,
                           epstats.cumulativeCommitTime);
+        collector.addStat(Key::ep_flusher_batch_size,
+                          epstats.flusherBatchSize);
+        collector.addStat(Key::ep_flusher_pacing_delay,
+                          epstats.flusherPacingDelay);
+        collector.addStat(Key::ep_flusher_batch_size_increases,
+                          epstats.flusherBatchSizeIncreases);
+        collector.addStat(Key::ep_flusher_batch_size_decreases,
+                          epstats.flusherBatchSizeDecreases);
         collector.addStat(Key::ep_item_begin_failed, epstats.beginFailed);
         collector.addStat(Key::ep_item_commit_failed, epstats.commitFailed);
         collector.addStat(Key::ep_item_flush_expired, epstats.flushExpired);
@@ -2953,6 +2996,8 @@ cb::engine_errc EventuallyPersistentEngine::doEngineStats(
                       EPStats::isMemoryTrackingEnabled());
     collector.addStat(Key::ep_bg_fetched, epstats.bg_fetched);
     collector.addStat(Key::ep_bg_meta_fetched, epstats.bg_meta_fetched);
+    collector.addStat(Key::ep_bg_fetch_not_admitted,
+                      epstats.bgFetchNotAdmitted);
     collector.addStat(Key::ep_bg_remaining_items, epstats.numRemainingBgItems);
     collector.addStat(Key::ep_bg_remaining_jobs, epstats.numRemainingBgJobs);
     collector.addStat(Key::ep_num_pager_runs, epstats.pagerRuns);
@@ -2962,6 +3007,8 @@ cb::engine_errc EventuallyPersistentEngine::doEngineStats(
                       epstats.itemsExpelledFromCheckpoints);
     collector.addStat(Key::ep_items_rm_from_checkpoints,
                       epstats.itemsRemovedFromCheckpoints);
+    collector.addStat(Key::ep_dcp_cursor_batches_shared,
+                      epstats.dcpCursorBatchesShared);
     collector.addStat(Key::ep_num_value_ejects, epstats.numValueEjects);
     collector.addStat(Key::ep_num_eject_failures, epstats.numFailedEjects);
     collector.addStat(Key::ep_num_not_my_vbuckets, epstats.numNotMyVBuckets);
@@ -5362,8 +5409,11 @@ protocol_binary_datatype_t EventuallyPersistentEngine::checkForDatatypeJson(
             body = cb::xattr::get_body(body);
         }
 
-        if (checkUTF8JSON(reinterpret_cast<const uint8_t*>(body.data()),
-                          body.size())) {
+        // Reuse one validator (and its nesting stack) per thread. The stack
+        // outlives any one bucket, so don't account it to the current one.
+        thread_local cb::json::Validator validator;
+        NonBucketAllocationGuard guard;
+        if (validator.validate(body)) {
             datatype |= PROTOCOL_BINARY_DATATYPE_JSON;
         }
     }
@@ -6600,6 +6650,10 @@ EventuallyPersistentEngine::~EventuallyPersistentEngine() {
         waitForTasks(tasks);
     }
     EP_LOG_INFO("~EPEngine: Completed deinitialize.");
+    // Any objects whose free was deferred (see DeferredReclamation) record
+    // this engine for memory accounting; ensure they are freed while it is
+    // still valid.
+    DeferredReclamation::barrier();
     delete workload;
     delete checkpointConfig;
 
@@ -170,6 +170,13 @@ cb::engine_errc EPVBucket::completeBGFetchForSingleItem(
 
             if (restore) {
                 if (status == cb::engine_errc::success) {
+                    if (epBucket && !epBucket->admitBgFetchedValue(docKey)) {
+                        // Not (yet) worth displacing other values for; the
+                        // value is still needed by the waiting operation so
+                        // restore it, but as the first candidate for
+                        // eviction.
+                        fetchedValue->setFreqCounterValue(0);
+                    }
                     ht.unlocked_restoreValue(
                             res.lock.getHTLock(), *fetchedValue, *v);
                     if (!v->isResident()) {
@@ -291,7 +298,7 @@ void EPVBucket::completeCompactionExpiryBgFetch(
                 processExpiredItem(htRes, cHandle, ExpireBy::Compactor);
         // we unlock ht lock here because we want to avoid potential
         // lock inversions arising from notifyNewSeqno() call
-        htRes.getHBL().getHTLock().unlock();
+        htRes.getHBL().unlock();
         notifyNewSeqno(notifyCtx);
         doCollectionsStats(cHandle, notifyCtx);
     }
@@ -764,7 +771,7 @@ cb::engine_errc EPVBucket::addTempItemAndBGFetch(
     case TempAddStatus::NoMem:
         return cb::engine_errc::no_memory;
     case TempAddStatus::BgFetch:
-        hbl.getHTLock().unlock();
+        hbl.unlock();
         bgFetch(key, cookie, engine, metadataOnly);
         return cb::engine_errc::would_block;
     }
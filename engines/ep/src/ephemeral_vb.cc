@@ -1039,11 +1039,11 @@ uint64_t EphemeralVBucket::addSystemEventItem(
 
             // Track the system event against the collection it is associated
             // with
-            auto collectionMemUsed =
-                    stats.coreLocal.get()->collectionMemUsed.lock();
-            auto itr = collectionMemUsed->find(*cid);
-            if (itr != collectionMemUsed->end()) {
-                itr->second += v->size();
+            auto collectionMemStats =
+                    stats.coreLocal.get()->collectionMemStats.lock();
+            auto itr = collectionMemStats->find(*cid);
+            if (itr != collectionMemStats->end()) {
+                itr->second.memUsed += v->size();
             }
         }
     }
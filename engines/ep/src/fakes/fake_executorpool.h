@@ -185,6 +185,12 @@ public:
                 // These tasks all schedule one other task
                 this->oneExecutes(taskRescheduled, 1);
             };
+        } else if (getTaskName().find("Running a flusher loop") == 0) {
+            checker = [=](bool taskRescheduled) {
+                // The flusher _may_ hand off vBuckets to VBucketFlushTasks
+                // (flusher_concurrent_vbuckets - 1 at most).
+                this->oneExecutes(taskRescheduled, /*min*/ 0, /*max*/ 63);
+            };
         } else if (getTaskName() == "Paging out items.") {
             checker = [=](bool taskRescheduled) {
                 // This task _may_ schedule a single task.
@@ -0,0 +1,114 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "flush_batch_controller.h"
+
+#include "stats.h"
+
+#include <algorithm>
+
+FlushBatchController::FlushBatchController(
+        EPStats& stats,
+        size_t maxBatchSize,
+        std::chrono::microseconds targetCommitLatency)
+    : stats(stats),
+      maxBatchSize(std::max(size_t(1), maxBatchSize)),
+      batchSize(this->maxBatchSize),
+      targetCommitLatency(targetCommitLatency) {
+    stats.flusherBatchSize.store(batchSize);
+    stats.flusherPacingDelay.store(0);
+}
+
+void FlushBatchController::recordCommit(bool moreAvailable,
+                                        bool syncWrites,
+                                        std::chrono::microseconds commitTime,
+                                        size_t diskQueueSize) {
+    std::lock_guard<std::mutex> lh(mutex);
+    const bool queueGrowing = diskQueueSize > lastDiskQueueSize;
+    lastDiskQueueSize = diskQueueSize;
+
+    if (commitTime > targetCommitLatency) {
+        // The device is struggling; commit less at a time.
+        const auto newSize = std::max(getMinBatchSize(), batchSize / 2);
+        if (newSize < batchSize) {
+            setBatchSize(newSize);
+            ++stats.flusherBatchSizeDecreases;
+        }
+        setPacingDelay(std::chrono::microseconds{0});
+    } else if (moreAvailable && queueGrowing) {
+        // Within target but falling behind; commit more at a time.
+        const auto newSize = std::min(
+                maxBatchSize,
+                batchSize + std::max(size_t(1),
+                                     maxBatchSize / IncreaseDivisor));
+        if (newSize > batchSize) {
+            setBatchSize(newSize);
+            ++stats.flusherBatchSizeIncreases;
+        }
+        setPacingDelay(std::chrono::microseconds{0});
+    } else if (!moreAvailable && !queueGrowing && !syncWrites) {
+        // Light load; let the next batch accumulate for about as long as a
+        // commit takes.
+        setPacingDelay(std::min(commitTime, targetCommitLatency / 4));
+    } else {
+        setPacingDelay(std::chrono::microseconds{0});
+    }
+}
+
+size_t FlushBatchController::getBatchSize() const {
+    std::lock_guard<std::mutex> lh(mutex);
+    return batchSize;
+}
+
+std::chrono::microseconds FlushBatchController::getPacingDelay() const {
+    std::lock_guard<std::mutex> lh(mutex);
+    return pacingDelay;
+}
+
+void FlushBatchController::setMaxBatchSize(size_t size) {
+    std::lock_guard<std::mutex> lh(mutex);
+    maxBatchSize = std::max(size_t(1), size);
+    setBatchSize(std::clamp(batchSize, getMinBatchSize(), maxBatchSize));
+}
+
+void FlushBatchController::setTargetCommitLatency(
+        std::chrono::microseconds latency) {
+    std::lock_guard<std::mutex> lh(mutex);
+    targetCommitLatency = latency;
+    setPacingDelay(std::min(pacingDelay, targetCommitLatency / 4));
+}
+
+void FlushBatchController::reset() {
+    std::lock_guard<std::mutex> lh(mutex);
+    setBatchSize(maxBatchSize);
+    setPacingDelay(std::chrono::microseconds{0});
+    lastDiskQueueSize = 0;
+}
+
+size_t FlushBatchController::getMinBatchSize() const {
+    return std::max(size_t(1), maxBatchSize / MinBatchSizeDivisor);
+}
+
+void FlushBatchController::setBatchSize(size_t size) {
+    batchSize = size;
+    stats.flusherBatchSize.store(size);
+}
+
+void FlushBatchController::setPacingDelay(std::chrono::microseconds delay) {
+    pacingDelay = delay;
+    stats.flusherPacingDelay.store(delay.count());
+}
@@ -0,0 +1,112 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+class EPStats;
+
+/**
+ * Sizes the flush-batches of an EPBucket (and paces the flusher between
+ * them) from the latency the device shows for commits, instead of always
+ * using the fixed flusher_total_batch_limit
+ * (see flusher_adaptive_batch_size).
+ *
+ * After every successful commit the flusher reports how long the commit
+ * took and how the disk queue has moved:
+ *
+ * - A commit slower than the target latency halves the batch size (down to
+ *   1/64th of the maximum). Smaller batches commit quicker, which bounds
+ *   how long a persisted SyncWrite (majorityAndPersistOnMaster,
+ *   persistToMajority) waits for the flush-batch it is part of.
+ * - A full batch (more items left to flush) committed within the target
+ *   while the disk queue is growing grows the batch size by 1/16th of the
+ *   maximum (up to the maximum), as the flusher is falling behind.
+ * - A partial batch while the disk queue is not growing (i.e. light load)
+ *   paces the flusher by the commit time, capped at a quarter of the target
+ *   latency, so that more mutations are de-duplicated and written by the
+ *   next commit. Batches containing prepares are never paced, and the
+ *   Flusher doesn't pace while any of its vBuckets has an unpersisted
+ *   prepare queued.
+ *
+ * The decisions are published in EPStats (ep_flusher_batch_size,
+ * ep_flusher_pacing_delay, ep_flusher_batch_size_increases and
+ * ep_flusher_batch_size_decreases).
+ *
+ * Thread-safe; the flushers of all shards report to the same controller.
+ */
+class FlushBatchController {
+public:
+    FlushBatchController(EPStats& stats,
+                         size_t maxBatchSize,
+                         std::chrono::microseconds targetCommitLatency);
+
+    /**
+     * Record the outcome of a successful flush-batch commit.
+     *
+     * @param moreAvailable whether the vBucket had more items to flush than
+     *        fitted in the batch
+     * @param syncWrites whether the batch contained any prepares
+     * @param commitTime the time taken by the commit
+     * @param diskQueueSize the number of items waiting for persistence
+     *        after the commit
+     */
+    void recordCommit(bool moreAvailable,
+                      bool syncWrites,
+                      std::chrono::microseconds commitTime,
+                      size_t diskQueueSize);
+
+    /// @return the (approximate) number of items to flush in the next batch
+    size_t getBatchSize() const;
+
+    /// @return how long the flusher should wait before the next batch
+    std::chrono::microseconds getPacingDelay() const;
+
+    /**
+     * Set the largest batch size, which the batch size starts from (and is
+     * capped at).
+     */
+    void setMaxBatchSize(size_t size);
+
+    void setTargetCommitLatency(std::chrono::microseconds latency);
+
+    /// Forget the decisions made so far; start over from the max batch size
+    void reset();
+
+    /// The smallest batch size is the max batch size divided by this
+    static constexpr size_t MinBatchSizeDivisor = 64;
+
+    /// Batch size is increased by the max batch size divided by this
+    static constexpr size_t IncreaseDivisor = 16;
+
+private:
+    size_t getMinBatchSize() const;
+    void setBatchSize(size_t size);
+    void setPacingDelay(std::chrono::microseconds delay);
+
+    EPStats& stats;
+
+    mutable std::mutex mutex;
+    size_t maxBatchSize;
+    size_t batchSize;
+    std::chrono::microseconds targetCommitLatency;
+    std::chrono::microseconds pacingDelay{0};
+    size_t lastDiskQueueSize = 0;
+};
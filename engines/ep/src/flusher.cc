@@ -18,10 +18,13 @@
 #include "flusher.h"
 
 #include "bucket_logger.h"
+#include "checkpoint_manager.h"
 #include "ep_bucket.h"
+#include "ep_engine.h"
 #include "executorpool.h"
 #include "tasks.h"
 
+#include <gsl/gsl-lite.hpp>
 #include <platform/timeutils.h>
 
 #include <chrono>
@@ -35,6 +38,9 @@ Flusher::Flusher(EPBucket* st, KVShard* k)
       doHighPriority(false),
       numHighPriority(0),
       pendingMutation(false),
+      maxConcurrentVBuckets(st->getEPEngine()
+                                    .getConfiguration()
+                                    .getFlusherConcurrentVbuckets()),
       shard(k) {
 }
 
@@ -201,7 +207,23 @@ bool Flusher::step(GlobalTask *task) {
         // in the loop below) then that will cause the task to be re-awoken.
         task->snooze(INT_MAX);
 
+        // Under light load the adaptive flush batch sizing may ask us to
+        // wait a little between batches, so more mutations are written by a
+        // single commit. Persistence requests and prepares (which a
+        // SyncWrite may be waiting to be persisted) are never held back.
+        const auto pacingDelay = store->getFlusherPacingDelay();
+        if (pacingDelay.count() > 0 && hpVbs.empty() &&
+            shard->highPriorityCount.load() == 0 &&
+            !hasUnpersistedPrepares()) {
+            const auto nextFlush = lastFlushTime + pacingDelay;
+            if (std::chrono::steady_clock::now() < nextFlush) {
+                task->updateWaketime(nextFlush);
+                return true;
+            }
+        }
+
         auto more = flushVB();
+        lastFlushTime = std::chrono::steady_clock::now();
 
         if (_state == State::Running) {
             /// If there's still work to do for this shard, wake up the Flusher
@@ -225,6 +247,12 @@ bool Flusher::step(GlobalTask *task) {
         EP_LOG_DEBUG(
                 "Flusher::step: stopping flusher (write of all dirty items)");
         completeFlush();
+        if (hasConcurrentFlushes()) {
+            // The VBucketFlushTasks still running re-notify their vBucket
+            // if it has more to flush; run again once they complete.
+            task->snooze(0.001);
+            return true;
+        }
         EP_LOG_DEBUG("Flusher::step: stopped");
         transitionState(State::Stopped);
         return false;
@@ -300,9 +328,22 @@ bool Flusher::flushVB() {
         return false;
     }
 
+    const bool concurrent = maxConcurrentVBuckets > 1;
+    if (concurrent) {
+        if (!claimVBucket(vbid)) {
+            // Being flushed by a VBucketFlushTask, which re-notifies the
+            // vBucket once done.
+            return true;
+        }
+        if (_state == State::Running) {
+            scheduleConcurrentFlushes();
+        }
+    }
+
     const auto res = store->flushVBucket(vbid);
 
-    if (res.moreAvailable == EPBucket::MoreAvailable::Yes) {
+    const bool notified = concurrent && releaseVBucket(vbid);
+    if (res.moreAvailable == EPBucket::MoreAvailable::Yes || notified) {
         // More items still available, add vbid back to pending set.
         lpVbs.pushUnique(vbid);
     }
@@ -316,6 +357,84 @@ bool Flusher::flushVB() {
     return true;
 }
 
+void Flusher::flushVBConcurrently(Vbid vbid) {
+    // Flush unless paused; while stopping we want to flush everything.
+    const auto state = _state.load();
+    if (state == State::Running || state == State::Stopping) {
+        const auto res = store->flushVBucket(vbid);
+        if (res.wakeupCkptRemover == EPBucket::WakeCkptRemover::Yes) {
+            store->wakeUpCheckpointRemover();
+        }
+        if (res.moreAvailable == EPBucket::MoreAvailable::No) {
+            if (releaseVBucket(vbid)) {
+                notifyFlushEvent(vbid);
+            }
+            return;
+        }
+    }
+
+    // Not flushed, or more items still available; hand the vBucket back to
+    // the flusher task.
+    cancelConcurrentFlush(vbid);
+}
+
+void Flusher::cancelConcurrentFlush(Vbid vbid) {
+    releaseVBucket(vbid);
+    notifyFlushEvent(vbid);
+}
+
+bool Flusher::claimVBucket(Vbid vbid) {
+    auto inFlight = inFlightVBuckets.wlock();
+    auto it = inFlight->find(vbid);
+    if (it != inFlight->end()) {
+        it->second = true;
+        return false;
+    }
+    inFlight->emplace(vbid, false);
+    return true;
+}
+
+bool Flusher::releaseVBucket(Vbid vbid) {
+    auto inFlight = inFlightVBuckets.wlock();
+    auto it = inFlight->find(vbid);
+    Expects(it != inFlight->end());
+    const bool notified = it->second;
+    inFlight->erase(it);
+    return notified;
+}
+
+void Flusher::scheduleConcurrentFlushes() {
+    // Only this (the flusher) task claims vBuckets, so the number in flight
+    // cannot grow behind our back.
+    Vbid vbid;
+    while (inFlightVBuckets.rlock()->size() < maxConcurrentVBuckets &&
+           lpVbs.popFront(vbid)) {
+        if (!claimVBucket(vbid)) {
+            continue;
+        }
+        ExecutorPool::get()->schedule(std::make_shared<VBucketFlushTask>(
+                ObjectRegistry::getCurrentEngine(), weak_from_this(), vbid));
+    }
+}
+
+bool Flusher::hasConcurrentFlushes() const {
+    return !inFlightVBuckets.rlock()->empty();
+}
+
+bool Flusher::hasUnpersistedPrepares() const {
+    for (auto vbid : shard->getVBuckets()) {
+        auto vb = store->getVBucket(vbid);
+        if (!vb) {
+            continue;
+        }
+        const auto hps = vb->checkpointManager->getHighPreparedSeqno();
+        if (hps && *hps > vb->getPersistenceSeqno()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 size_t Flusher::getHPQueueSize() const {
     return hpVbs.size();
 }
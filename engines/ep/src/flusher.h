@@ -20,10 +20,14 @@
 #include "utility.h"
 #include "vb_ready_queue.h"
 
+#include <folly/Synchronized.h>
 #include <memcached/vbucket.h>
 
+#include <chrono>
 #include <functional>
+#include <memory>
 #include <queue>
+#include <unordered_map>
 
 #define NO_VBUCKETS_INSTANTIATED 0xFFFF
 #define RETRY_FLUSH_VBUCKET (-1)
@@ -33,8 +37,11 @@ class KVShard;
 
 /**
  * Manage persistence of data for an EPBucket.
+ *
+ * Owned by its KVShard via a shared_ptr, so that VBucketFlushTasks can refer
+ * to it weakly.
  */
-class Flusher {
+class Flusher : public std::enable_shared_from_this<Flusher> {
 public:
     Flusher(EPBucket* st, KVShard* k);
 
@@ -48,6 +55,18 @@ public:
     void wake();
     bool step(GlobalTask *task);
 
+    /**
+     * Flush a single vBucket which was handed off to a VBucketFlushTask
+     * by flushVB(); re-notifying the vBucket if it has more to flush.
+     */
+    void flushVBConcurrently(Vbid vbid);
+
+    /**
+     * A VBucketFlushTask was destroyed without running; release its
+     * vBucket and notify it so the flusher task flushes it instead.
+     */
+    void cancelConcurrentFlush(Vbid vbid);
+
     const char * stateName() const;
 
     void notifyFlushEvent(Vbid vbid) {
@@ -88,6 +107,34 @@ private:
      */
     bool flushVB();
     void completeFlush();
+
+    /**
+     * Record that the vBucket is being flushed.
+     * @return false if the vBucket is already being flushed by another task
+     *         (it is then re-notified once that flush completes)
+     */
+    bool claimVBucket(Vbid vbid);
+
+    /**
+     * Record that the vBucket is no longer being flushed.
+     * @return true if the vBucket was notified while being flushed
+     */
+    bool releaseVBucket(Vbid vbid);
+
+    /**
+     * Hand off ready low priority vBuckets to VBucketFlushTasks, while fewer
+     * than maxConcurrentVBuckets flushes are in flight.
+     */
+    void scheduleConcurrentFlushes();
+
+    bool hasConcurrentFlushes() const;
+
+    /**
+     * @return true if any of the shard's vBuckets has a prepare queued which
+     *         has not yet been persisted.
+     */
+    bool hasUnpersistedPrepares() const;
+
     void initialize();
     void schedule_UNLOCKED();
 
@@ -108,6 +155,18 @@ private:
     size_t numHighPriority;
     std::atomic<bool> pendingMutation;
 
+    // The maximum number of vBuckets of the shard to flush concurrently
+    // (flusher_concurrent_vbuckets)
+    const size_t maxConcurrentVBuckets;
+
+    // The vBuckets being flushed when flushing concurrently, mapped to
+    // whether they were notified while being flushed
+    folly::Synchronized<std::unordered_map<Vbid, bool>> inFlightVBuckets;
+
+    // When the Running step last flushed; used to pace the flusher (see
+    // EPBucket::getFlusherPacingDelay)
+    std::chrono::steady_clock::time_point lastFlushTime;
+
     KVShard *shard;
 
     DISALLOW_COPY_AND_ASSIGN(Flusher);
@@ -0,0 +1,94 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "frequency_sketch.h"
+
+#include <folly/lang/Bits.h>
+
+#include <algorithm>
+
+FrequencySketch::FrequencySketch(size_t width)
+    : width(folly::nextPowTwo(std::max(width, CountersPerWord))),
+      sampleSize(this->width * SampleFactor),
+      words(Depth * this->width / CountersPerWord) {
+}
+
+uint8_t FrequencySketch::increment(uint32_t hash) {
+    const auto frequency = estimate(hash);
+    if (frequency < MaxFrequency) {
+        // Conservative update; only increment the counters which are at the
+        // minimum, the others are already over-estimates.
+        for (size_t row = 0; row < Depth; ++row) {
+            const auto index = getCounterIndex(hash, row);
+            const auto shift = (index % CountersPerWord) * BitsPerCounter;
+            auto& word = words[index / CountersPerWord];
+            auto current = word.load(std::memory_order_relaxed);
+            while (((current >> shift) & CounterMask) == frequency &&
+                   !word.compare_exchange_weak(current,
+                                               current + (uint64_t(1) << shift),
+                                               std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    if (samples.fetch_add(1, std::memory_order_relaxed) + 1 == sampleSize) {
+        age();
+        // The halved counters account for (about) half of the samples
+        samples.fetch_sub(sampleSize / 2, std::memory_order_relaxed);
+    }
+
+    return std::min(uint8_t(frequency + 1), MaxFrequency);
+}
+
+uint8_t FrequencySketch::estimate(uint32_t hash) const {
+    uint8_t frequency = MaxFrequency;
+    for (size_t row = 0; row < Depth; ++row) {
+        frequency = std::min(frequency,
+                             getCounter(getCounterIndex(hash, row)));
+    }
+    return frequency;
+}
+
+size_t FrequencySketch::getCounterIndex(uint32_t hash, size_t row) const {
+    // Derive a distinct index for each row from the one hash (double
+    // hashing); the multiplication spreads keys with similar hashes.
+    const uint64_t mixed = uint64_t(hash) * 0x9e3779b97f4a7c15ULL;
+    const auto h1 = uint32_t(mixed >> 32);
+    const auto h2 = uint32_t(mixed) | 1;
+    return row * width + ((h1 + row * h2) & (width - 1));
+}
+
+uint8_t FrequencySketch::getCounter(size_t index) const {
+    const auto shift = (index % CountersPerWord) * BitsPerCounter;
+    return uint8_t(
+            (words[index / CountersPerWord].load(std::memory_order_relaxed) >>
+             shift) &
+            CounterMask);
+}
+
+void FrequencySketch::age() {
+    // Shift every counter right by one bit, dropping the bit shifted in from
+    // the neighbouring counter.
+    constexpr uint64_t mask = 0x7777777777777777ULL;
+    for (auto& word : words) {
+        auto current = word.load(std::memory_order_relaxed);
+        while (!word.compare_exchange_weak(current,
+                                           (current >> 1) & mask,
+                                           std::memory_order_relaxed)) {
+        }
+    }
+}
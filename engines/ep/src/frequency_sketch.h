@@ -0,0 +1,92 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A count-min sketch estimating how often each key has been seen recently,
+ * in the style of TinyLFU. Used to decide whether a value fetched from disk
+ * is worth caching (see bgfetch_admission_control); unlike the frequency
+ * counter of a StoredValue it also covers keys which are not in the
+ * HashTable.
+ *
+ * Each key (by its hash) maps to one 4-bit counter in each of Depth rows;
+ * the estimate is the smallest of those counters, so collisions can only
+ * over-estimate. Once width * SampleFactor occurrences have been recorded
+ * all the counters are halved, so the estimate reflects recent history.
+ *
+ * Thread-safe; counters are updated with relaxed atomics, so concurrent
+ * updates of the same key may be lost (which only makes the estimate more
+ * approximate).
+ */
+class FrequencySketch {
+public:
+    /**
+     * @param width the number of counters in each row; rounded up to a power
+     *        of two (of at least CountersPerWord)
+     */
+    explicit FrequencySketch(size_t width);
+
+    /**
+     * Record an occurrence of the key with the given hash.
+     *
+     * @return the estimated number of occurrences of the key, including this
+     *         one
+     */
+    uint8_t increment(uint32_t hash);
+
+    /// @return the estimated number of occurrences of the key
+    uint8_t estimate(uint32_t hash) const;
+
+    /// @return the number of counters in each row
+    size_t getWidth() const {
+        return width;
+    }
+
+    /// The number of rows (and so counters per key)
+    static constexpr size_t Depth = 4;
+
+    /// The largest estimate; counters saturate at this value
+    static constexpr uint8_t MaxFrequency = 15;
+
+    /// The counters are halved after width * SampleFactor occurrences
+    static constexpr size_t SampleFactor = 10;
+
+private:
+    static constexpr size_t BitsPerCounter = 4;
+    static constexpr size_t CountersPerWord = 64 / BitsPerCounter;
+    static constexpr uint64_t CounterMask = 0xf;
+
+    /// @return the index (over all rows) of the key's counter in the row
+    size_t getCounterIndex(uint32_t hash, size_t row) const;
+
+    /// @return the value of the counter with the given index
+    uint8_t getCounter(size_t index) const;
+
+    /// Halve all of the counters
+    void age();
+
+    const size_t width;
+    const size_t sampleSize;
+    std::vector<std::atomic<uint64_t>> words;
+    std::atomic<size_t> samples{0};
+};
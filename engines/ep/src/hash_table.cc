@@ -23,6 +23,7 @@
 #include "stored_value_factories.h"
 
 #include <folly/lang/Assume.h>
+#include <folly/lang/Bits.h>
 #include <phosphor/phosphor.h>
 #include <platform/compress.h>
 
@@ -156,10 +157,18 @@ StoredValue* HashTable::FindUpdateResult::selectSVForRead(
 HashTable::HashTable(EPStats& st,
                      std::unique_ptr<AbstractStoredValueFactory> svFactory,
                      size_t initialSize,
-                     size_t locks)
+                     size_t locks,
+                     ReadMode readMode,
+                     IndexType indexType,
+                     ResizeMode resizeMode)
     : initialSize(initialSize),
+      readMode(readMode),
+      indexType(indexType),
+      resizeMode(resizeMode),
       size(initialSize),
+      tagGroups(indexType == IndexType::Tagged ? initialSize : 0),
       mutexes(locks),
+      versions(readMode == ReadMode::Optimistic ? locks : 0),
       stats(st),
       valFact(std::move(svFactory)),
       visitors(0),
@@ -196,24 +205,49 @@ void HashTable::clear(bool deactivate) {
         }
     }
     MultiLockHolder mlh(mutexes);
+    AllBucketsWriteGuard writeGuard(*this);
     clear_UNLOCKED(deactivate);
 }
 
+HashTable::AllBucketsWriteGuard::AllBucketsWriteGuard(HashTable& ht) : ht(ht) {
+    for (auto& version : ht.versions) {
+        version->beginWrite();
+    }
+}
+
+HashTable::AllBucketsWriteGuard::~AllBucketsWriteGuard() {
+    for (auto& version : ht.versions) {
+        version->endWrite();
+    }
+}
+
 void HashTable::clear_UNLOCKED(bool deactivate) {
     if (deactivate) {
         setActiveState(false);
     }
     size_t clearedMemSize = 0;
     size_t clearedValSize = 0;
-    for (int i = 0; i < (int)size; i++) {
-        while (values[i]) {
+    auto clearChain = [&clearedMemSize,
+                       &clearedValSize](StoredValue::UniquePtr& chain) {
+        while (chain) {
             // Take ownership of the StoredValue from the vector, update
             // statistics and release it.
-            auto v = std::move(values[i]);
+            auto v = std::move(chain);
             clearedMemSize += v->size();
             clearedValSize += v->valuelen();
-            values[i] = std::move(v->getNext());
+            chain = std::move(v->getNext());
         }
+    };
+    for (int i = 0; i < (int)size; i++) {
+        clearChain(values[i]);
+    }
+    std::fill(tagGroups.begin(), tagGroups.end(), TagGroup{});
+    if (isResizeInProgress()) {
+        // Nothing left to migrate.
+        for (auto& chain : oldValues) {
+            clearChain(chain);
+        }
+        finishResize();
     }
 
     stats.coreLocal.get()->currentSize.fetch_sub(clearedMemSize -
@@ -283,46 +317,258 @@ void HashTable::resize(size_t newSize) {
         return;
     }
 
+    // Only one incremental resize may be in progress at once; it is
+    // completed by continueResize().
+    if (isResizeInProgress()) {
+        return;
+    }
+
     TRACE_EVENT2(
             "HashTable", "resize", "size", size.load(), "newSize", newSize);
 
+    // Get a place for the new items.
+    table_type newValues(newSize);
+    std::vector<TagGroup> newTagGroups(tagGroups.empty() ? 0 : newSize);
+
+    {
+        MultiLockHolder mlh(mutexes);
+        if (visitors.load() > 0 || isResizeInProgress()) {
+            // Do not allow a resize while any visitors are actually
+            // processing.  The next attempt will have to pick it up.  New
+            // visitors cannot start doing meaningful work (we own all
+            // locks at this point).
+            return;
+        }
+        AllBucketsWriteGuard writeGuard(*this);
+
+        stats.coreLocal.get()->memOverhead.fetch_sub(memorySize());
+        ++numResizes;
+
+        if (resizeMode == ResizeMode::Incremental) {
+            // Keep the current table as the old table, and start using the
+            // (empty) new one. Elements are migrated by continueResize().
+            oldValues.swap(values);
+            values.swap(newValues);
+            tagGroups.swap(newTagGroups);
+            bucketsMigrated.store(0);
+            oldSize.store(size);
+            size.store(newSize);
+
+            stats.coreLocal.get()->memOverhead.fetch_add(memorySize());
+            return;
+        }
+
+        // Set the new size so all the hashy stuff works.
+        size_t prevSize = size;
+        size.store(newSize);
+
+        // Move existing records into the new space.
+        for (size_t i = 0; i < prevSize; i++) {
+            while (values[i]) {
+                // unlink the front element from the hash chain at values[i].
+                auto v = std::move(values[i]);
+                values[i] = std::move(v->getNext());
+
+                // And re-link it into the correct place in newValues.
+                const int hash = v->getKey().hash();
+                int newBucket = getBucketForHash(hash);
+                if (!newTagGroups.empty()) {
+                    newTagGroups[newBucket].insert(getTag(hash),
+                                                   v.get().get());
+                }
+                v->setNext(std::move(newValues[newBucket]));
+                newValues[newBucket] = std::move(v);
+            }
+        }
+
+        // Finally swap the new table into values; newValues now holds the
+        // (empty) old table.
+        values.swap(newValues);
+        tagGroups.swap(newTagGroups);
+
+        stats.coreLocal.get()->memOverhead.fetch_add(memorySize());
+    }
+
+    if (readMode == ReadMode::Optimistic) {
+        // Optimistic readers may still be indexing into the old table; wait
+        // for them to finish before it is freed. Done after releasing the
+        // locks so front-end operations are not blocked meanwhile.
+        DeferredReclamation::synchronize();
+    }
+}
+
+bool HashTable::continueResize(std::chrono::steady_clock::duration budget) {
+    if (!isResizeInProgress()) {
+        return false;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    while (migrateResizeSlice()) {
+        if (std::chrono::steady_clock::now() - start >= budget) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HashTable::migrateResizeSlice() {
     MultiLockHolder mlh(mutexes);
-    if (visitors.load() > 0) {
-        // Do not allow a resize while any visitors are actually
-        // processing.  The next attempt will have to pick it up.  New
-        // visitors cannot start doing meaningful work (we own all
-        // locks at this point).
-        return;
+    if (!isActive() || !isResizeInProgress()) {
+        return false;
     }
 
-    // Get a place for the new items.
-    table_type newValues(newSize);
+    TRACE_EVENT2("HashTable",
+                 "migrateResizeSlice",
+                 "bucketsMigrated",
+                 bucketsMigrated.load(),
+                 "oldSize",
+                 oldSize.load());
+
+    const size_t end =
+            std::min(bucketsMigrated + resizeSliceSize, oldSize.load());
+    for (size_t i = bucketsMigrated; i < end; i++) {
+        while (oldValues[i]) {
+            // unlink the front element from the hash chain at oldValues[i].
+            auto v = std::move(oldValues[i]);
+            oldValues[i] = std::move(v->getNext());
+
+            // And re-link it into the correct place in values.
+            const int hash = v->getKey().hash();
+            const int newBucket = getBucketForHash(hash);
+            if (!tagGroups.empty()) {
+                tagGroups[newBucket].insert(getTag(hash), v.get().get());
+            }
+            v->setNext(std::move(values[newBucket]));
+            values[newBucket] = std::move(v);
+        }
+    }
+    bucketsMigrated.store(end);
+
+    if (end < oldSize) {
+        return true;
+    }
+    finishResize();
+    return false;
+}
 
+void HashTable::finishResize() {
     stats.coreLocal.get()->memOverhead.fetch_sub(memorySize());
-    ++numResizes;
-
-    // Set the new size so all the hashy stuff works.
-    size_t oldSize = size;
-    size.store(newSize);
-
-    // Move existing records into the new space.
-    for (size_t i = 0; i < oldSize; i++) {
-        while (values[i]) {
-            // unlink the front element from the hash chain at values[i].
-            auto v = std::move(values[i]);
-            values[i] = std::move(v->getNext());
-
-            // And re-link it into the correct place in newValues.
-            int newBucket = getBucketForHash(v->getKey().hash());
-            v->setNext(std::move(newValues[newBucket]));
-            newValues[newBucket] = std::move(v);
+
+    oldSize.store(0);
+    bucketsMigrated.store(0);
+    // Optimistic readers may still be indexing into the old table (if they
+    // started before the resize), so defer freeing it.
+    auto* old = new table_type();
+    old->swap(oldValues);
+    if (readMode == ReadMode::Optimistic) {
+        DeferredReclamation::retire(old,
+                                    [](table_type* table) { delete table; });
+    } else {
+        delete old;
+    }
+
+    stats.coreLocal.get()->memOverhead.fetch_add(memorySize());
+}
+
+HashTable::ResizeProgress HashTable::getResizeProgress() const {
+    ResizeProgress progress;
+    progress.bucketsTotal = oldSize;
+    if (progress.bucketsTotal != 0) {
+        progress.bucketsMigrated = bucketsMigrated;
+    }
+    return progress;
+}
+
+void HashTable::TagGroup::insert(uint8_t tag, StoredValue* v) {
+    if (isOverflowed()) {
+        return;
+    }
+    if (count == Slots) {
+        count = Overflow;
+        return;
+    }
+    tags[count] = tag;
+    storedValues[count] = v;
+    ++count;
+}
+
+bool HashTable::TagGroup::remove(const StoredValue* v) {
+    if (isOverflowed()) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        if (storedValues[i] == v) {
+            // Fill the hole with the last entry.
+            --count;
+            tags[i] = tags[count];
+            storedValues[i] = storedValues[count];
+            tags[count] = 0;
+            storedValues[count] = nullptr;
+            break;
+        }
+    }
+    return true;
+}
+
+void HashTable::TagGroup::replace(const StoredValue* oldValue,
+                                  StoredValue* newValue) {
+    if (isOverflowed()) {
+        return;
+    }
+    for (uint8_t i = 0; i < count; ++i) {
+        if (storedValues[i] == oldValue) {
+            storedValues[i] = newValue;
+            return;
         }
     }
+}
 
-    // Finally assign the new table to values.
-    values = std::move(newValues);
+uint32_t HashTable::TagGroup::match(uint8_t tag) const {
+    static_assert(offsetof(TagGroup, count) == Slots,
+                  "TagGroup::match expects tags and count to be the first 8 "
+                  "bytes");
+    uint64_t word;
+    std::memcpy(&word, this, sizeof(word));
+    word = folly::Endian::little(word);
 
-    stats.coreLocal.get()->memOverhead.fetch_add(memorySize());
+    // Bytes equal to tag become zero; then set the high bit of each zero
+    // byte (and only those - unlike the cheaper haszero() trick this has no
+    // false positives from borrows).
+    constexpr uint64_t lsbs = 0x0101010101010101ull;
+    constexpr uint64_t low7 = 0x7f7f7f7f7f7f7f7full;
+    const uint64_t x = word ^ (lsbs * tag);
+    const uint64_t zeros = ~(((x & low7) + low7) | x | low7);
+
+    // Gather the high bit of each byte into the low 8 bits (byte N -> bit
+    // N), then discard the unused slots and the count byte.
+    const auto mask = ((zeros >> 7) * 0x0102040810204080ull) >> 56;
+    return static_cast<uint32_t>(mask) & ((1u << count) - 1);
+}
+
+void HashTable::indexInsert(int bucket, StoredValue* v) {
+    if (readMode == ReadMode::Optimistic) {
+        v->setOptimisticallyRead();
+    }
+    if (!tagGroups.empty()) {
+        tagGroups[bucket].insert(getTag(v->getKey().hash()), v);
+    }
+}
+
+void HashTable::indexRemove(int bucket, const StoredValue* v) {
+    if (tagGroups.empty() || tagGroups[bucket].remove(v)) {
+        return;
+    }
+
+    // Group has overflowed; if the chain fits in a group once more then
+    // rebuild it so lookups can use it again.
+    TagGroup rebuilt;
+    for (StoredValue* sv = values[bucket].get().get(); sv;
+         sv = sv->getNext().get().get()) {
+        rebuilt.insert(getTag(sv->getKey().hash()), sv);
+        if (rebuilt.isOverflowed()) {
+            return;
+        }
+    }
+    tagGroups[bucket] = rebuilt;
 }
 
 HashTable::FindInnerResult HashTable::findInner(const DocKey& key) {
@@ -331,13 +577,13 @@ HashTable::FindInnerResult HashTable::findInner(const DocKey& key) {
                 "HashTable::find: Cannot call on a "
                 "non-active object");
     }
-    HashBucketLock hbl = getLockedBucket(key);
-    // Scan through all elements in the hash bucket chain looking for Committed
-    // and Pending items with the same key.
+    const int hash = key.hash();
+    HashBucketLock hbl = getLockedBucketForHash(hash);
+    // Scan through all elements in the hash bucket which may match looking
+    // for Committed and Pending items with the same key.
     StoredValue* foundCmt = nullptr;
     StoredValue* foundPend = nullptr;
-    for (StoredValue* v = values[hbl.getBucketNum()].get().get(); v;
-         v = v->getNext().get().get()) {
+    forEachCandidate(hbl, hash, [&](StoredValue* v) {
         if (v->hasKey(key)) {
             if (v->isPending() || v->isPrepareCompleted()) {
                 Expects(!foundPend);
@@ -347,20 +593,23 @@ HashTable::FindInnerResult HashTable::findInner(const DocKey& key) {
                 foundCmt = v;
             }
         }
-    }
+    });
 
     return {std::move(hbl), foundCmt, foundPend};
 }
 
 std::unique_ptr<Item> HashTable::getRandomKey(CollectionID cid, long rnd) {
     /* Try to locate a partition */
-    size_t start = rnd % size;
+    // During an incremental resize items may also be in the (possibly larger)
+    // old table.
+    const size_t slots = std::max(size.load(), oldSize.load());
+    size_t start = rnd % slots;
     size_t curr = start;
     std::unique_ptr<Item> ret;
 
     do {
         ret = getRandomKeyFromSlot(cid, curr++);
-        if (curr == size) {
+        if (curr == slots) {
             curr = 0;
         }
     } while (ret == nullptr && curr != start);
@@ -469,6 +718,7 @@ StoredValue* HashTable::unlocked_addNewStoredValue(const HashBucketLock& hbl,
     valueStats.epilogue(emptyProperties, v.get().get());
 
     values[hbl.getBucketNum()] = std::move(v);
+    indexInsert(hbl.getBucketNum(), values[hbl.getBucketNum()].get().get());
     return values[hbl.getBucketNum()].get().get();
 }
 
@@ -649,22 +899,37 @@ void HashTable::Statistics::epilogue(StoredValueProperties pre,
 
     auto& local = llcLocal.get();
 
+    // Determine if valid, non resident; and if valid, alive (neither deleted
+    // nor temporary).
+    bool preNonResident = pre.isValid && (!pre.isResident && !pre.isDeleted &&
+                                          !pre.isTempItem);
+    bool postNonResident =
+            post.isValid &&
+            (!post.isResident && !post.isDeleted && !post.isTempItem);
+    const bool preAlive = pre.isValid && !pre.isDeleted && !pre.isTempItem;
+    const bool postAlive = post.isValid && !post.isDeleted && !post.isTempItem;
+
+    // update per-collection stats
+    if ((pre.isValid || post.isValid) &&
+        (pre.size != post.size || preAlive != postAlive ||
+         preNonResident != postNonResident)) {
+        // either of pre or post may be invalid, but if either is
+        // valid use the collection id from that.
+        auto cid = pre.isValid ? pre.cid : post.cid;
+        auto collectionMemStats =
+                epStats.coreLocal.get()->collectionMemStats.lock();
+        auto itr = collectionMemStats->find(cid);
+        if (itr != collectionMemStats->end()) {
+            itr->second.memUsed += post.size - pre.size;
+            itr->second.numItems += int64_t(postAlive) - int64_t(preAlive);
+            itr->second.numNonResident +=
+                    int64_t(postNonResident) - int64_t(preNonResident);
+        }
+    }
+
     // Update size, metadataSize & uncompressed size if pre/post differ.
     if (pre.size != post.size) {
         auto sizeDelta = post.size - pre.size;
-        // update per-collection stats
-        if (pre.isValid || post.isValid) {
-            // either of pre or post may be invalid, but if either is
-            // valid use the collection id from that.
-            auto cid = pre.isValid ? pre.cid : post.cid;
-            auto collectionMemUsed =
-                    epStats.coreLocal.get()->collectionMemUsed.lock();
-            auto itr = collectionMemUsed->find(cid);
-            if (itr != collectionMemUsed->end()) {
-                itr->second += sizeDelta;
-            }
-        }
-
         local.cacheSize.fetch_add(sizeDelta);
         local.memSize.fetch_add(sizeDelta);
         memChangedCallback(sizeDelta);
@@ -679,13 +944,7 @@ void HashTable::Statistics::epilogue(StoredValueProperties pre,
                                             pre.uncompressedSize);
     }
 
-    // Determine if valid, non resident; and update numNonResidentItems if
-    // differ.
-    bool preNonResident = pre.isValid && (!pre.isResident && !pre.isDeleted &&
-                                          !pre.isTempItem);
-    bool postNonResident =
-            post.isValid &&
-            (!post.isResident && !post.isDeleted && !post.isTempItem);
+    // Update numNonResidentItems if differ.
     if (preNonResident != postNonResident) {
         local.numNonResidentItems.fetch_add(postNonResident - preNonResident);
     }
@@ -785,6 +1044,7 @@ HashTable::unlocked_replaceByCopy(const HashBucketLock& hbl,
     valueStats.epilogue(emptyProperties, newSv.get().get());
 
     values[hbl.getBucketNum()] = std::move(newSv);
+    indexInsert(hbl.getBucketNum(), values[hbl.getBucketNum()].get().get());
     return {values[hbl.getBucketNum()].get().get(), std::move(releasedSv)};
 }
 
@@ -898,6 +1158,164 @@ HashTable::FindROResult HashTable::findForRead(
     return {sv, std::move(result.lock)};
 }
 
+HashTable::OptimisticReadResult HashTable::findForReadOptimistic(
+        const DocKey& key,
+        Vbid vbid,
+        TrackReference trackReference,
+        StoredValue::HideLockedCas hideLockedCas,
+        StoredValue::IncludeValue includeValue) {
+    using Status = OptimisticReadResult::Status;
+    if (readMode != ReadMode::Optimistic || !isActive()) {
+        return {Status::Fallback, nullptr};
+    }
+
+    // Prevent any StoredValue / Blob / bucket array we might observe from
+    // being freed until we are done with it.
+    DeferredReclamation::ReadGuard guard;
+
+    const int hash = key.hash();
+    for (int attempt = 0; attempt < maxOptimisticReadAttempts; ++attempt) {
+        // Locate the bucket and its version. size and the bucket array are
+        // only modified by resize() with every version odd, so re-checking
+        // size (and validating the version) after reading the bucket array
+        // ensures we have a consistent pair.
+        const auto currSize = size.load();
+        const int bucket = abs(hash % static_cast<int>(currSize));
+        const auto& version = *versions[bucket % versions.size()];
+        const auto start = version.beginRead();
+        if ((start & 1) || size.load() != currSize) {
+            continue;
+        }
+        if (oldSize.load() != 0) {
+            // Incremental resize in progress; the key could be in either
+            // table so leave it to the locked path.
+            return {Status::Fallback, nullptr};
+        }
+        const auto* table = values.data();
+        if (!version.validateRead(start)) {
+            continue;
+        }
+
+        const StoredValue* committed = nullptr;
+        const StoredValue* pending = nullptr;
+        for (const auto* v = table[bucket].get().get(); v;
+             v = v->getNextUnchecked()) {
+            if (v->hasKey(key)) {
+                if (v->isPending() || v->isPrepareCompleted()) {
+                    pending = v;
+                } else {
+                    committed = v;
+                }
+            }
+        }
+
+        if (pending && pending->isPreparedMaybeVisible()) {
+            // Reads are blocked until re-committed; let the locked path
+            // report that.
+            return {Status::Fallback, nullptr};
+        }
+        if (!committed) {
+            if (!version.validateRead(start)) {
+                continue;
+            }
+            return {Status::NotFound, nullptr};
+        }
+        if (committed->isDeleted() || committed->isTempItem() ||
+            !committed->isResident() || committed->isZstdCompressed() ||
+            committed->isExpired(ep_real_time())) {
+            // Needs the lock to process (e.g. expiry, bgfetch, temp item
+            // cleanup, decompressing the value).
+            return {Status::Fallback, nullptr};
+        }
+
+        // Snapshot everything we need before validating.
+        const auto flags = committed->getFlags();
+        const auto exptime = committed->getExptime();
+        const auto datatype = committed->getDatatype();
+        const auto cas = (hideLockedCas == StoredValue::HideLockedCas::Yes &&
+                          committed->isLocked(ep_current_time()))
+                                 ? static_cast<uint64_t>(-1)
+                                 : committed->getCas();
+        const auto bySeqno = committed->getBySeqno();
+        const auto revSeqno = committed->getRevSeqno();
+        const auto freq = committed->getFreqCounterValue();
+        const auto committedState = committed->getCommitted();
+        const auto prepareSeqno =
+                committed->isOrdered()
+                        ? committed->toOrderedStoredValue()->getPrepareSeqno()
+                        : 0;
+        value_t value;
+        if (includeValue == StoredValue::IncludeValue::Yes) {
+            // Take a reference on the value - it may concurrently be
+            // replaced (dropping the StoredValue's reference), in which case
+            // the read will fail validation and our reference be released.
+            const auto* blob = committed->getValue().get().get();
+            if (blob) {
+                value = value_t::tryAcquire(TaggedPtr<Blob>(
+                        const_cast<Blob*>(blob), TaggedPtrBase::NoTagValue));
+                if (!value) {
+                    continue;
+                }
+            }
+        }
+
+        if (!version.validateRead(start)) {
+            continue;
+        }
+
+        // Read is consistent. The key is immutable, and the StoredValue
+        // cannot be freed while we hold the ReadGuard, so it is safe to read
+        // it now.
+        auto item = std::make_unique<Item>(committed->getKey(),
+                                           flags,
+                                           exptime,
+                                           value,
+                                           datatype,
+                                           cas,
+                                           bySeqno,
+                                           vbid,
+                                           revSeqno);
+        if (committedState == CommittedState::CommittedViaPrepare) {
+            item->setCommittedviaPrepareSyncWrite();
+        }
+        if (committed->isOrdered()) {
+            item->setPrepareSeqno(prepareSeqno);
+        }
+
+        auto newFreq = freq;
+        if (trackReference == TrackReference::Yes) {
+            newFreq = generateFreqValue(freq);
+        }
+        if (newFreq != freq) {
+            // The (probabilistic) frequency counter needs to be incremented.
+            // That is a write so requires the lock; this is infrequent as
+            // the likelihood of incrementing drops as the counter grows.
+            // During an incremental resize the StoredValue may still be in
+            // oldValues, so search every candidate as findInner() does. If
+            // it has since been removed the item reports the counter it had.
+            auto hbl = getLockedBucketForHash(hash);
+            bool updated = false;
+            forEachCandidate(hbl, hash, [&](StoredValue* v) {
+                if (v == committed) {
+                    v->setFreqCounterValue(newFreq);
+                    updated = true;
+                }
+            });
+            if (!updated) {
+                newFreq = freq;
+            } else if (newFreq == std::numeric_limits<uint8_t>::max()) {
+                frequencyCounterSaturated();
+            }
+        }
+        item->setFreqCounterValue(newFreq);
+
+        return {Status::Found, std::move(item)};
+    }
+
+    // Repeatedly raced with writers; give up and take the lock.
+    return {Status::Fallback, nullptr};
+}
+
 HashTable::FindResult HashTable::findForWrite(const DocKey& key,
                                               WantsDeleted wantsDeleted) {
     auto result = findInner(key);
@@ -1032,12 +1450,7 @@ StoredValue::UniquePtr HashTable::unlocked_release(
                 "HashTable::unlocked_release_base: Cannot call on a "
                 "non-active object");
     }
-    // Remove the first (should only be one) StoredValue matching the given
-    // pointer
-    auto released = hashChainRemoveFirst(
-            values[hbl.getBucketNum()], [valueToRelease](const StoredValue* v) {
-                return v == valueToRelease;
-            });
+    auto released = unlinkStoredValue(hbl, valueToRelease);
 
     if (!released) {
         /* We shouldn't reach here, we must delete the StoredValue in the
@@ -1054,6 +1467,21 @@ StoredValue::UniquePtr HashTable::unlocked_release(
     return released;
 }
 
+StoredValue::UniquePtr HashTable::unlinkStoredValue(const HashBucketLock& hbl,
+                                                  const StoredValue* v) {
+    // Remove the first (should only be one) StoredValue matching the given
+    // pointer
+    auto matches = [v](const StoredValue* candidate) { return candidate == v; };
+    auto unlinked = hashChainRemoveFirst(values[hbl.getBucketNum()], matches);
+    if (unlinked) {
+        indexRemove(hbl.getBucketNum(), unlinked.get().get());
+    } else if (hbl.getOldBucketNum() >= 0) {
+        unlinked = hashChainRemoveFirst(oldValues[hbl.getOldBucketNum()],
+                                        matches);
+    }
+    return unlinked;
+}
+
 MutationStatus HashTable::insertFromWarmup(const Item& itm,
                                            bool eject,
                                            bool keyMetaDataOnly,
@@ -1115,13 +1543,18 @@ MutationStatus HashTable::insertFromWarmup(const Item& itm,
 
 bool HashTable::reallocateStoredValue(StoredValue&& sv) {
     // Search the chain and reallocate
-    for (StoredValue::UniquePtr* curr =
-                 &values[getBucketForHash(sv.getKey().hash())];
-         curr->get().get();
+    const int bucket = getBucketForHash(sv.getKey().hash());
+    for (StoredValue::UniquePtr* curr = &values[bucket]; curr->get().get();
          curr = &curr->get()->getNext()) {
         if (&sv == curr->get().get()) {
             auto newSv = valFact->copyStoredValue(sv, std::move(sv.getNext()));
+            if (readMode == ReadMode::Optimistic) {
+                newSv->setOptimisticallyRead();
+            }
             curr->swap(newSv);
+            if (!tagGroups.empty()) {
+                tagGroups[bucket].replace(&sv, curr->get().get());
+            }
             return true;
         }
     }
@@ -1135,8 +1568,8 @@ void HashTable::dump() const {
 nlohmann::json HashTable::dumpStoredValuesAsJson() const {
     MultiLockHolder mlh(mutexes);
     auto obj = nlohmann::json::array();
-    for (const auto& chain : values) {
-        if (chain) {
+    for (const auto* table : {&values, &oldValues}) {
+        for (const auto& chain : *table) {
             for (StoredValue* sv = chain.get().get(); sv != nullptr;
                  sv = sv->getNext().get().get()) {
                 std::stringstream ss;
@@ -1157,6 +1590,15 @@ void HashTable::storeCompressedBuffer(std::string_view buf, StoredValue& v) {
     valueStats.epilogue(preProps, &v);
 }
 
+void HashTable::storeZstdCompressedBuffer(std::string_view buf,
+                                          StoredValue& v) {
+    const auto preProps = valueStats.prologue(&v);
+
+    v.storeZstdCompressedBuffer(buf);
+
+    valueStats.epilogue(preProps, &v);
+}
+
 void HashTable::visit(HashTableVisitor& visitor) {
     HashTable::Position ht_pos;
     while (ht_pos != endPosition()) {
@@ -1176,34 +1618,47 @@ void HashTable::visitDepth(HashTableDepthVisitor &visitor) {
     VisitorTracker vt(&visitors);
     lh.unlock();
 
-    for (int l = 0; l < static_cast<int>(mutexes.size()); l++) {
-        for (int i = l; i < static_cast<int>(size); i+= mutexes.size()) {
-            // (re)acquire mutex on each HashBucket, to minimise any impact
-            // on front-end threads.
-            LockHolder lh(mutexes[l]);
-
-            size_t depth = 0;
-            StoredValue* p = values[i].get().get();
-            if (p) {
-                // TODO: Perf: This check seems costly - do we think it's still
-                // worth keeping?
-                auto hashbucket = getBucketForHash(p->getKey().hash());
-                if (i != hashbucket) {
-                    throw std::logic_error("HashTable::visit: inconsistency "
-                            "between StoredValue's calculated hashbucket "
-                            "(which is " + std::to_string(hashbucket) +
-                            ") and bucket it is located in (which is " +
-                            std::to_string(i) + ")");
+    // Visit the buckets of both tables if an incremental resize is in
+    // progress (the lock of a bucket also guards the same bucket of the old
+    // table). The migration may continue meanwhile, so an item may be
+    // counted in both tables or neither - acceptable for depth statistics.
+    for (size_t l = 0; l < mutexes.size(); l++) {
+        for (const auto* table : {&values, &oldValues}) {
+            for (size_t i = l;; i += mutexes.size()) {
+                // (re)acquire mutex on each HashBucket, to minimise any
+                // impact on front-end threads.
+                LockHolder lh(mutexes[l]);
+                // Checked under the lock, as the old table is released once
+                // the migration completes.
+                if (i >= table->size()) {
+                    break;
                 }
+
+                size_t depth = 0;
+                StoredValue* p = (*table)[i].get().get();
+                if (p && table == &values) {
+                    // TODO: Perf: This check seems costly - do we think it's
+                    // still worth keeping?
+                    auto hashbucket = getBucketForHash(p->getKey().hash());
+                    if (i != size_t(hashbucket)) {
+                        throw std::logic_error(
+                                "HashTable::visit: inconsistency between "
+                                "StoredValue's calculated hashbucket (which "
+                                "is " +
+                                std::to_string(hashbucket) +
+                                ") and bucket it is located in (which is " +
+                                std::to_string(i) + ")");
+                    }
+                }
+                size_t mem(0);
+                while (p) {
+                    depth++;
+                    mem += p->size();
+                    p = p->getNext().get().get();
+                }
+                visitor.visit(int(i), depth, mem);
+                ++visited;
             }
-            size_t mem(0);
-            while (p) {
-                depth++;
-                mem += p->size();
-                p = p->getNext().get().get();
-            }
-            visitor.visit(i, depth, mem);
-            ++visited;
         }
     }
 }
@@ -1233,6 +1688,15 @@ HashTable::Position HashTable::pauseResumeVisit(HashTableVisitor& visitor,
     VisitorTracker vt(&visitors);
     lh.unlock();
 
+    // Visitors only handle a single table (and a new resize cannot start
+    // while we are registered as a visitor). Help an in-progress incremental
+    // resize along by a single slice, but don't complete it here - pause
+    // without visiting anything so the visitor's task yields, and resume
+    // once the migration (continued by the resizer) has finished.
+    if (continueResize(std::chrono::steady_clock::duration::zero())) {
+        return start_pos;
+    }
+
     // Start from the requested lock number if in range.
     size_t lock = (start_pos.lock < mutexes.size()) ? start_pos.lock : 0;
     size_t hash_bucket = 0;
@@ -1258,7 +1722,7 @@ HashTable::Position HashTable::pauseResumeVisit(HashTableVisitor& visitor,
             // around the HashBucket visit then we need to release it before
             // tearDownHashBucketVisit() is called.
             {
-                HashBucketLock lh(hash_bucket, mutexes[lock]);
+                HashBucketLock lh(hash_bucket, mutexes[lock], getVersion(lock));
 
                 StoredValue* v = values[hash_bucket].get().get();
                 while (!paused && v) {
@@ -1291,7 +1755,7 @@ HashTable::Position HashTable::endPosition() const  {
     return HashTable::Position(size, mutexes.size(), size);
 }
 
-bool HashTable::unlocked_ejectItem(const HashTable::HashBucketLock&,
+bool HashTable::unlocked_ejectItem(const HashTable::HashBucketLock& hbl,
                                    StoredValue*& vptr,
                                    EvictionPolicy policy) {
     if (vptr == nullptr) {
@@ -1315,10 +1779,7 @@ bool HashTable::unlocked_ejectItem(const HashTable::HashBucketLock&,
     }
     case EvictionPolicy::Full: {
         // Remove the item from the hash table.
-        int bucket_num = getBucketForHash(vptr->getKey().hash());
-        auto removed = hashChainRemoveFirst(
-                values[bucket_num],
-                [vptr](const StoredValue* v) { return v == vptr; });
+        auto removed = unlinkStoredValue(hbl, vptr);
 
         if (removed->isResident()) {
             ++stats.numValueEjects;
@@ -1336,12 +1797,19 @@ bool HashTable::unlocked_ejectItem(const HashTable::HashBucketLock&,
 
 std::unique_ptr<Item> HashTable::getRandomKeyFromSlot(CollectionID cid,
                                                       int slot) {
+    // Note: the lock for a given slot also guards the same slot of the old
+    // table if resizing.
     auto lh = getLockedBucket(slot);
-    for (StoredValue* v = values[slot].get().get(); v;
-            v = v->getNext().get().get()) {
-        if (!v->isTempItem() && !v->isDeleted() && v->isResident() &&
-            v->isCommitted() && v->getKey().getCollectionID() == cid) {
-            return v->toItem(Vbid(0));
+    for (auto* table : {&values, &oldValues}) {
+        if (static_cast<size_t>(slot) >= table->size()) {
+            continue;
+        }
+        for (StoredValue* v = (*table)[slot].get().get(); v;
+             v = v->getNext().get().get()) {
+            if (!v->isTempItem() && !v->isDeleted() && v->isResident() &&
+                v->isCommitted() && v->getKey().getCollectionID() == cid) {
+                return v->toItem(Vbid(0));
+            }
         }
     }
 
@@ -1416,8 +1884,8 @@ std::ostream& operator<<(std::ostream& os, const HashTable& ht) {
        << " numSystemItems:" << ht.getNumSystemItems()
        << " numPreparedSW:" << ht.getNumPreparedSyncWrites()
        << " values: " << std::endl;
-    for (const auto& chain : ht.values) {
-        if (chain) {
+    for (const auto* table : {&ht.values, &ht.oldValues}) {
+        for (const auto& chain : *table) {
             for (StoredValue* sv = chain.get().get(); sv != nullptr;
                  sv = sv->getNext().get().get()) {
                 os << "    " << *sv << std::endl;
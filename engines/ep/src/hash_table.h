@@ -17,15 +17,21 @@
 
 #pragma once
 
+#include "deferred_reclamation.h"
 #include "probabilistic_counter.h"
 #include "stored-value.h"
 #include "storeddockey.h"
 
+#include <folly/lang/Align.h>
+#include <folly/lang/Aligned.h>
+#include <folly/lang/Bits.h>
 #include <platform/corestore.h>
 #include <platform/non_negative_counter.h>
 
 #include <array>
+#include <chrono>
 #include <functional>
+#include <utility>
 
 class AbstractStoredValueFactory;
 class HashTableVisitor;
@@ -145,6 +151,52 @@ enum class DeletionDurability : uint8_t {};
  * re-hashing all elements into the new table. While resizing is occuring all
  * other access to the HashTable is blocked.
  *
+ * Incremental resize
+ * ------------------
+ *
+ * If constructed with ResizeMode::Incremental, resize() instead only swaps
+ * in the new (empty) vector of buckets, keeping the old one alongside it.
+ * Elements are then migrated from the old table a slice of buckets at a time
+ * by continueResize() - each slice holds all ht_locks only for as long as it
+ * takes to re-hash that slice. Until migration completes a key may be in
+ * either table, so lookups lock and search both the key's bucket in the new
+ * table and its bucket in the old table; new elements are always added to
+ * the new table. A new resize cannot start while visitors are running, and
+ * pauseResumeVisit() does not visit while a migration is in progress - it
+ * instead migrates a single slice and pauses - so visitors only ever see a
+ * single table. (visitDepth() is read-only and simply visits both tables.)
+ *
+ * Optimistic reads
+ * ----------------
+ *
+ * If constructed with ReadMode::Optimistic, each ht_lock additionally has a
+ * version counter (a seqlock) which is advanced by every HashBucketLock
+ * holder on acquire and release - the version is odd while the lock is held.
+ * findForReadOptimistic() then walks the hash chain *without* acquiring the
+ * lock, and accepts what it read only if the version was even and unchanged
+ * across the read; otherwise it retries, and ultimately the caller falls
+ * back to the locked findForRead(). This allows concurrent readers of the
+ * same (hot) hash bucket to proceed in parallel, without writing to any
+ * shared cache line.
+ * Memory safety for such readers is provided by DeferredReclamation - the
+ * StoredValues linked into such a HashTable (and their values) are freed
+ * only after an RCU grace period.
+ *
+ * Tagged index
+ * ------------
+ *
+ * If constructed with IndexType::Tagged, each bucket additionally has a
+ * cache line sized TagGroup - in the style of a Swiss table group - holding a
+ * 1-byte tag derived from the hash of each key in the chain, plus a pointer
+ * to its StoredValue. Lookups compare all tags in the group in one go and
+ * only dereference StoredValues whose tag matches; so a miss, or a hit on a
+ * longer chain, typically costs one cache miss for the group (plus one for
+ * the matching StoredValue) instead of one per chain element.
+ * The chain remains the owner of the StoredValues and is still what
+ * visitors walk; the TagGroup is purely an index. Buckets with more entries
+ * than a TagGroup can hold are marked as overflowed and searched by walking
+ * the chain, until they shrink back or the HashTable is resized.
+ *
  * Support for holding both Committed and Pending items requires that we
  * can represent having for each key, either:
  *  1. No item present
@@ -346,23 +398,140 @@ public:
         EPStats& epStats;
     };
 
+    /**
+     * How front-end reads synchronise with writers to the HashTable.
+     */
+    enum class ReadMode : uint8_t {
+        /// Readers always acquire the hash bucket lock.
+        Locked,
+        /// Readers may first attempt a lock-free read, validated against a
+        /// per-lock version counter (see findForReadOptimistic()).
+        Optimistic,
+    };
+
+    /**
+     * Index used to locate StoredValues within a hash bucket.
+     */
+    enum class IndexType : uint8_t {
+        /// Walk the bucket's StoredValue chain, comparing keys.
+        Chained,
+        /// Consult the bucket's TagGroup first, only comparing keys of
+        /// StoredValues whose hash tag matches.
+        Tagged,
+    };
+
+    /**
+     * How the HashTable is resized.
+     */
+    enum class ResizeMode : uint8_t {
+        /// All elements are re-hashed in one go, holding all ht_locks.
+        Blocking,
+        /// Elements are migrated to the new table a slice at a time (see
+        /// continueResize()).
+        Incremental,
+    };
+
+    /**
+     * Version counter (seqlock) for the hash buckets guarded by one ht_lock,
+     * used to validate optimistic reads. Only modified while the
+     * corresponding mutex is held; odd while a HashBucketLock is held and
+     * hence its buckets may be modified.
+     */
+    class BucketVersion {
+    public:
+        /// Mark the start of a (potential) modification. Mutex must be held.
+        void beginWrite() {
+            value.store(value.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        /// Mark the end of a modification. Mutex must be held.
+        void endWrite() {
+            value.store(value.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_release);
+        }
+
+        /// @returns the version to validate an optimistic read against.
+        uint64_t beginRead() const {
+            return value.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @returns true if no modification was in progress at, or started
+         * since, beginRead() returned `start` - i.e. everything read in
+         * between is consistent.
+         */
+        bool validateRead(uint64_t start) const {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return (start & 1) == 0 &&
+                   value.load(std::memory_order_relaxed) == start;
+        }
+
+    private:
+        std::atomic<uint64_t> value{0};
+    };
+
     /**
      * Represents a locked hash bucket that provides RAII semantics for the lock
      *
      * A simple container which holds a lock and the bucket_num of the
-     * hashtable bucket it has the lock for.
+     * hashtable bucket it has the lock for. If the HashTable supports
+     * optimistic reads then it also advances the BucketVersion of the lock
+     * on acquire and release.
      */
     class HashBucketLock {
     public:
         HashBucketLock()
             : bucketNum(-1) {}
 
-        HashBucketLock(int bucketNum, std::mutex& mutex)
-            : bucketNum(bucketNum), htLock(mutex) {
+        HashBucketLock(int bucketNum,
+                       std::mutex& mutex,
+                       BucketVersion* version = nullptr)
+            : bucketNum(bucketNum), htLock(mutex), version(version) {
+            if (version) {
+                version->beginWrite();
+            }
+        }
+
+        /**
+         * Lock a bucket in both the current and the old table during an
+         * incremental resize. Both mutexes are locked (in address order, as
+         * per MultiLockHolder) unless they are the same mutex.
+         */
+        HashBucketLock(int bucketNum,
+                       int oldBucketNum,
+                       std::mutex& mutex,
+                       std::mutex& oldMutex,
+                       BucketVersion* version = nullptr)
+            : bucketNum(bucketNum),
+              oldBucketNum(oldBucketNum),
+              htLock(mutex, std::defer_lock),
+              version(version) {
+            if (&oldMutex == &mutex) {
+                htLock.lock();
+            } else if (&oldMutex < &mutex) {
+                oldHtLock = std::unique_lock<std::mutex>(oldMutex);
+                htLock.lock();
+            } else {
+                htLock.lock();
+                oldHtLock = std::unique_lock<std::mutex>(oldMutex);
+            }
+            if (version) {
+                version->beginWrite();
+            }
         }
 
         HashBucketLock(HashBucketLock&& other)
-            : bucketNum(other.bucketNum), htLock(std::move(other.htLock)) {
+            : bucketNum(other.bucketNum),
+              oldBucketNum(other.oldBucketNum),
+              htLock(std::move(other.htLock)),
+              oldHtLock(std::move(other.oldHtLock)),
+              version(std::exchange(other.version, nullptr)) {
+        }
+
+        ~HashBucketLock() {
+            endWrite();
         }
 
         // Cannot copy HashBucketLock.
@@ -370,8 +539,12 @@ public:
         HashBucketLock& operator=(const HashBucketLock& other) = delete;
 
         HashBucketLock& operator=(HashBucketLock&& other) {
+            endWrite();
             bucketNum = other.bucketNum;
+            oldBucketNum = other.oldBucketNum;
             htLock = std::move(other.htLock);
+            oldHtLock = std::move(other.oldHtLock);
+            version = std::exchange(other.version, nullptr);
             return *this;
         }
 
@@ -379,17 +552,43 @@ public:
             return bucketNum;
         }
 
+        /**
+         * @returns the locked bucket in the old table if an incremental
+         * resize is in progress, else -1.
+         */
+        int getOldBucketNum() const {
+            return oldBucketNum;
+        }
+
+        // Note: no non-const accessor is provided; to release the lock early
+        // use unlock() so the BucketVersion is correctly updated.
         const std::unique_lock<std::mutex>& getHTLock() const {
             return htLock;
         }
 
-        std::unique_lock<std::mutex>& getHTLock() {
-            return htLock;
+        /// Release the lock before this HashBucketLock goes out of scope.
+        void unlock() {
+            endWrite();
+            htLock.unlock();
+            if (oldHtLock.owns_lock()) {
+                oldHtLock.unlock();
+            }
         }
 
     private:
+        void endWrite() {
+            if (version && htLock.owns_lock()) {
+                version->endWrite();
+            }
+            version = nullptr;
+        }
+
         int bucketNum;
+        int oldBucketNum = -1;
         std::unique_lock<std::mutex> htLock;
+        // Lock for oldBucketNum, if different to htLock.
+        std::unique_lock<std::mutex> oldHtLock;
+        BucketVersion* version = nullptr;
     };
 
     /**
@@ -399,17 +598,25 @@ public:
      * @param svFactory Factory to use for constructing stored values
      * @param initialSize the number of hash table buckets to initially create.
      * @param locks the number of locks in the hash table
+     * @param readMode how front-end reads synchronise with writers
+     * @param indexType index used to locate StoredValues within a bucket
+     * @param resizeMode how the HashTable is resized
      */
     HashTable(EPStats& st,
               std::unique_ptr<AbstractStoredValueFactory> svFactory,
               size_t initialSize,
-              size_t locks);
+              size_t locks,
+              ReadMode readMode = ReadMode::Locked,
+              IndexType indexType = IndexType::Chained,
+              ResizeMode resizeMode = ResizeMode::Blocking);
 
     ~HashTable();
 
     size_t memorySize() {
         return sizeof(HashTable)
             + (size * sizeof(StoredValue*))
+            + (oldSize * sizeof(StoredValue*))
+            + (tagGroups.size() * sizeof(TagGroup))
             + (mutexes.size() * sizeof(std::mutex));
     }
 
@@ -423,6 +630,21 @@ public:
      */
     size_t getNumLocks() { return mutexes.size(); }
 
+    /// @returns how front-end reads synchronise with writers.
+    ReadMode getReadMode() const {
+        return readMode;
+    }
+
+    /// @returns the index used to locate StoredValues within a bucket.
+    IndexType getIndexType() const {
+        return indexType;
+    }
+
+    /// @returns how the HashTable is resized.
+    ResizeMode getResizeMode() const {
+        return resizeMode;
+    }
+
     /**
      * Get the number of in-memory non-resident and resident items within
      * this hash table.
@@ -574,9 +796,38 @@ public:
 
     /**
      * Resize to the specified size.
+     *
+     * For ResizeMode::Incremental this only starts the resize (if one is
+     * not already in progress); elements are migrated by continueResize().
      */
     void resize(size_t to);
 
+    /**
+     * Continue an in-progress incremental resize, migrating slices of buckets
+     * from the old table until either all have been migrated or `budget` has
+     * elapsed. Each slice acquires (and releases) all ht_locks.
+     *
+     * @returns true if the resize is still in progress.
+     */
+    bool continueResize(std::chrono::steady_clock::duration budget =
+                                std::chrono::steady_clock::duration::max());
+
+    /// @returns true if an incremental resize is in progress.
+    bool isResizeInProgress() const {
+        return oldSize != 0;
+    }
+
+    /// Progress of an in-progress incremental resize.
+    struct ResizeProgress {
+        /// Number of buckets of the old table which have been migrated.
+        size_t bucketsMigrated = 0;
+        /// Number of buckets in the old table; zero if no resize is in
+        /// progress.
+        size_t bucketsTotal = 0;
+    };
+
+    ResizeProgress getResizeProgress() const;
+
     /**
      * Result of the findForRead() method.
      */
@@ -618,6 +869,57 @@ public:
             WantsDeleted wantsDeleted = WantsDeleted::No,
             ForGetReplicaOp fetchRequestedForReplicaItem = ForGetReplicaOp::No);
 
+    /**
+     * Result of the findForReadOptimistic() method.
+     */
+    struct OptimisticReadResult {
+        enum class Status : uint8_t {
+            /// A committed, alive, resident item was found; see `item`.
+            Found,
+            /// No committed item exists for the key, and no Prepare which
+            /// would block reading it.
+            NotFound,
+            /// The read could not be completed without the lock - either
+            /// due to concurrent modification, or because the item needs
+            /// processing which requires the lock (temporary, deleted,
+            /// non-resident, expired, or has a MaybeVisible prepare).
+            /// Caller should use findForRead().
+            Fallback,
+        };
+
+        Status status;
+        /// If status is Found, a copy of the found item; else nullptr.
+        std::unique_ptr<Item> item;
+    };
+
+    /**
+     * Attempt to find a committed item with the specified key for read-only
+     * access *without* acquiring the hash bucket lock.
+     *
+     * Only supported if the HashTable was created with ReadMode::Optimistic;
+     * otherwise (and for any case which needs the lock, see
+     * OptimisticReadResult::Status::Fallback) returns Fallback and the caller
+     * should use findForRead().
+     *
+     * As there is no lock to return, on success a copy of the item is
+     * returned (sharing the value Blob, as StoredValue::toItem() does).
+     *
+     * @param key The key of the item to find
+     * @param vbid VBucket to set in the returned Item
+     * @param trackReference Should this lookup update referenced status (i.e.
+     *                       increase the hotness of this key?)
+     * @param hideLockedCas If Yes and the item is locked, return the CAS as -1
+     * @param includeValue Should the value be included in the returned Item?
+     */
+    OptimisticReadResult findForReadOptimistic(
+            const DocKey& key,
+            Vbid vbid,
+            TrackReference trackReference = TrackReference::Yes,
+            StoredValue::HideLockedCas hideLockedCas =
+                    StoredValue::HideLockedCas::No,
+            StoredValue::IncludeValue includeValue =
+                    StoredValue::IncludeValue::Yes);
+
     /**
      * Result of the findFor...() methods which return a non-const result.
      */
@@ -957,6 +1259,16 @@ public:
      */
     void storeCompressedBuffer(std::string_view buf, StoredValue& v);
 
+    /**
+     * Store the given buffer, compressed with a ZstdDictionary, as the value
+     * of the given StoredValue
+     *
+     * @param buf buffer holding compressed data
+     * @param v   StoredValue in which compressed data has
+     *            to be stored
+     */
+    void storeZstdCompressedBuffer(std::string_view buf, StoredValue& v);
+
     /**
      * Result of an Update operation.
      */
@@ -1123,6 +1435,10 @@ public:
 
     /**
      * Visit all items within this hashtable.
+     *
+     * Blocks until all items have been visited; hence any in-progress
+     * incremental resize is migrated first (a slice at a time, releasing
+     * the ht_locks between slices).
      */
     void visit(HashTableVisitor &visitor);
 
@@ -1146,6 +1462,10 @@ public:
      * As a consequence, *DO NOT USE THIS METHOD* if you need to guarantee
      * that all items are visited!
      *
+     * If an incremental resize is in progress, a single slice of it is
+     * migrated and start_pos returned without visiting anything; the caller
+     * should pause and resume later.
+     *
      * @param visitor The visitor object to use.
      * @param start_pos At what position to start in the hashtable.
      * @return The final HashTable position visited; equal to
@@ -1300,6 +1620,116 @@ private:
     // The container for actually holding the StoredValues.
     using table_type = std::vector<StoredValue::UniquePtr>;
 
+    /**
+     * Tagged index for the StoredValues of one hash bucket, packed into a
+     * single cache line: a 1-byte tag per entry (see getTag()) followed by
+     * the corresponding StoredValue pointers. Only modified with the
+     * bucket's lock held.
+     */
+    struct alignas(folly::hardware_constructive_interference_size) TagGroup {
+        /// Number of entries which fit in one group.
+        static constexpr size_t Slots = 7;
+
+        /// Value of `count` when the bucket has more than Slots entries.
+        static constexpr uint8_t Overflow = 0xff;
+
+        bool isOverflowed() const {
+            return count == Overflow;
+        }
+
+        /// Add an entry, marking the group as overflowed if full.
+        void insert(uint8_t tag, StoredValue* v);
+
+        /**
+         * Remove the entry for the given StoredValue.
+         * @returns false if the group is overflowed (and hence the caller
+         *          may need to rebuild it), else true.
+         */
+        bool remove(const StoredValue* v);
+
+        /// Replace the pointer to `oldValue` (if indexed) with `newValue`.
+        void replace(const StoredValue* oldValue, StoredValue* newValue);
+
+        /**
+         * @returns a bitmask with bit N set if slot N's tag equals `tag`.
+         * Compares all tags at once (SWAR) - the tags and count occupy the
+         * first 8 bytes of the group.
+         */
+        uint32_t match(uint8_t tag) const;
+
+        std::array<uint8_t, Slots> tags{};
+        uint8_t count = 0;
+        std::array<StoredValue*, Slots> storedValues{};
+    };
+    static_assert(sizeof(TagGroup) ==
+                          folly::hardware_constructive_interference_size,
+                  "TagGroup should occupy exactly one cache line");
+
+    /// @returns the tag used to index a key with the given hash in a
+    /// TagGroup. Uses the top bits, which do not select the bucket.
+    static uint8_t getTag(int hash) {
+        return static_cast<uint8_t>(static_cast<uint32_t>(hash) >> 24);
+    }
+
+    /**
+     * Invoke `func` for each StoredValue in the locked bucket(s) which may
+     * have a key with the given hash - either those with a matching tag in
+     * the bucket's TagGroup, or every StoredValue in the chain; plus every
+     * StoredValue in the old table's bucket if resizing.
+     */
+    template <typename Func>
+    void forEachCandidate(const HashBucketLock& hbl, int hash, Func func) {
+        const int bucket = hbl.getBucketNum();
+        if (!tagGroups.empty() && !tagGroups[bucket].isOverflowed()) {
+            const auto& group = tagGroups[bucket];
+            for (auto matches = group.match(getTag(hash)); matches;
+                 matches &= matches - 1) {
+                func(group.storedValues[folly::findFirstSet(matches) - 1]);
+            }
+        } else {
+            for (StoredValue* v = values[bucket].get().get(); v;
+                 v = v->getNext().get().get()) {
+                func(v);
+            }
+        }
+        if (hbl.getOldBucketNum() >= 0) {
+            for (StoredValue* v = oldValues[hbl.getOldBucketNum()].get().get();
+                 v;
+                 v = v->getNext().get().get()) {
+                func(v);
+            }
+        }
+    }
+
+    /// Add the given (newly linked) StoredValue to the bucket's TagGroup,
+    /// and mark it as optimistically read if readMode is Optimistic.
+    void indexInsert(int bucket, StoredValue* v);
+
+    /// Remove the given (just unlinked) StoredValue from the bucket's
+    /// TagGroup.
+    void indexRemove(int bucket, const StoredValue* v);
+
+    /**
+     * Unlink the given StoredValue from whichever of the locked bucket(s)
+     * it is in.
+     * @returns the unlinked StoredValue, or null if not found.
+     */
+    StoredValue::UniquePtr unlinkStoredValue(const HashBucketLock& hbl,
+                                             const StoredValue* v);
+
+    /**
+     * Migrate the next slice of buckets of an incremental resize, holding
+     * all ht_locks. Completes the resize if this was the last slice.
+     * @returns true if the resize is still in progress.
+     */
+    bool migrateResizeSlice();
+
+    /**
+     * Complete an incremental resize (once oldValues is empty), releasing
+     * the old table. All ht_locks must be held.
+     */
+    void finishResize();
+
     friend class StoredValue;
     friend std::ostream& operator<<(std::ostream& os, const HashTable& ht);
 
@@ -1313,9 +1743,32 @@ private:
      * @return HashBucektLock which contains a lock and the hash bucket number
      */
     inline HashBucketLock getLockedBucket(int bucket) {
-        return HashBucketLock(bucket, mutexes[mutexForBucket(bucket)]);
+        const auto lock = mutexForBucket(bucket);
+        return HashBucketLock(bucket, mutexes[lock], getVersion(lock));
     }
 
+    /**
+     * @returns the BucketVersion for the given lock, or nullptr if this
+     * HashTable does not support optimistic reads.
+     */
+    BucketVersion* getVersion(size_t lock) {
+        return versions.empty() ? nullptr : &*versions[lock];
+    }
+
+    /**
+     * RAII helper marking a modification to every hash bucket (e.g. resize
+     * or clear) for the purposes of optimistic read validation. Must only be
+     * created while all mutexes are held.
+     */
+    class AllBucketsWriteGuard {
+    public:
+        explicit AllBucketsWriteGuard(HashTable& ht);
+        ~AllBucketsWriteGuard();
+
+    private:
+        HashTable& ht;
+    };
+
     /**
      * Get a lock holder holding a lock for the bucket for the given
      * hash.
@@ -1331,8 +1784,25 @@ private:
                         "Cannot call on a non-active object");
             }
             int bucket = getBucketForHash(h);
-            HashBucketLock rv(bucket, mutexes[mutexForBucket(bucket)]);
-            if (bucket == getBucketForHash(h)) {
+            const auto lock = mutexForBucket(bucket);
+            const size_t currOldSize = oldSize;
+            if (currOldSize == 0) {
+                HashBucketLock rv(bucket, mutexes[lock], getVersion(lock));
+                if (bucket == getBucketForHash(h) && oldSize == 0) {
+                    return rv;
+                }
+                continue;
+            }
+
+            // Incremental resize in progress - also lock the key's bucket
+            // in the old table.
+            const int oldBucket = abs(h % static_cast<int>(currOldSize));
+            HashBucketLock rv(bucket,
+                              oldBucket,
+                              mutexes[lock],
+                              mutexes[mutexForBucket(oldBucket)],
+                              getVersion(lock));
+            if (bucket == getBucketForHash(h) && oldSize == currOldSize) {
                 return rv;
             }
         }
@@ -1391,12 +1861,36 @@ private:
     // The initial (and minimum) size of the HashTable.
     const size_t initialSize;
 
+    // How front-end reads synchronise with writers.
+    const ReadMode readMode;
+
+    // Index used to locate StoredValues within a bucket.
+    const IndexType indexType;
+
+    // How the HashTable is resized.
+    const ResizeMode resizeMode;
+
     // The size of the hash table (number of buckets) - i.e. number of elements
     // in `values`
     std::atomic<size_t> size;
     table_type values;
+    // TagGroup for each element of `values`. Empty unless indexType is
+    // Tagged.
+    std::vector<TagGroup> tagGroups;
+    // During an incremental resize, the table being migrated from and its
+    // size; oldSize is zero (and oldValues empty) otherwise. Elements in
+    // oldValues are not indexed by tagGroups.
+    table_type oldValues;
+    std::atomic<size_t> oldSize{0};
+    // Number of buckets of oldValues migrated so far; all buckets below
+    // this are empty.
+    std::atomic<size_t> bucketsMigrated{0};
     // Mutable so that we can make dumpStoredValuesAsJson const
     mutable std::vector<std::mutex> mutexes;
+    // Version counter for each of mutexes, used to validate optimistic
+    // reads. Empty unless readMode is Optimistic. Cache line padded to avoid
+    // readers of one lock's buckets being disturbed by writes to another's.
+    std::vector<folly::cacheline_aligned<BucketVersion>> versions;
     EPStats&             stats;
     std::unique_ptr<AbstractStoredValueFactory> valFact;
     std::atomic<size_t>       visitors;
@@ -1424,6 +1918,16 @@ private:
     // responsible for waking the ItemFreqDecayer task.
     std::function<void()> frequencyCounterSaturated{[]() {}};
 
+    // Maximum number of times findForReadOptimistic() retries after
+    // observing a concurrent modification before asking the caller to fall
+    // back to a locked read.
+    static constexpr int maxOptimisticReadAttempts = 4;
+
+    // Number of buckets of the old table migrated by each step of an
+    // incremental resize. Bounds how long front-end operations can be
+    // blocked by a step.
+    static constexpr size_t resizeSliceSize = 1024;
+
     int getBucketForHash(int h) {
         return abs(h % static_cast<int>(size));
     }
@@ -1452,6 +1956,9 @@ private:
     template <typename Pred>
     StoredValue::UniquePtr hashChainRemoveFirst(StoredValue::UniquePtr& chain,
                                                 Pred p) {
+        if (!chain) {
+            return nullptr;
+        }
         if (p(chain.get().get())) {
             // Head element:
             auto removed = std::move(chain);
@@ -34,6 +34,9 @@ public:
 
     void visitBucket(const VBucketPtr& vb) override {
         vb->ht.resize();
+        // Migrate any incremental resize for up to one chunk's duration;
+        // the remainder is continued by the next run.
+        vb->ht.continueResize(maxChunkDuration);
     }
 };
 
@@ -51,9 +54,10 @@ bool HashtableResizerTask::run() {
 
     // [per-VBucket Task] While a Hashtable is resizing no user
     // requests can be performed (the resizing process needs to
-    // acquire all HT locks). As such we are sensitive to the duration
-    // of this task - we want to log anything which has a
-    // non-negligible impact on frontend operations.
+    // acquire all HT locks - for incremental resizing, only for each
+    // slice). As such we are sensitive to the duration of this task - we
+    // want to log anything which has a non-negligible impact on frontend
+    // operations.
     const auto maxExpectedDurationForVisitorTask =
             std::chrono::milliseconds(100);
 
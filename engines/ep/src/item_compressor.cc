@@ -22,8 +22,12 @@
 #include "item_compressor_visitor.h"
 #include "kv_bucket.h"
 #include "stored-value.h"
+#include "zstd_dictionary.h"
+#include <gsl/gsl-lite.hpp>
 #include <phosphor/phosphor.h>
 
+#include <algorithm>
+
 ItemCompressorTask::ItemCompressorTask(EventuallyPersistentEngine* e,
                                        EPStats& stats_)
     : GlobalTask(e, TaskId::ItemCompressorTask, 0, false),
@@ -69,6 +73,20 @@ bool ItemCompressorTask::run() {
         visitor.setCompressionMode(engine->getCompressionMode());
         visitor.setMinCompressionRatio(engine->getMinCompressionRatio());
 
+        // With the zstd codec, first sample documents to train a dictionary
+        // from (compressing with Snappy meanwhile) and only then compress
+        // with it.
+        auto& config = engine->getConfiguration();
+        const bool zstd = config.getCompressionCodec() == "zstd" &&
+                          ZstdDictionary::isSupported();
+        const auto* dictionary =
+                zstd ? engine->getKVBucket()->getZstdDictionary() : nullptr;
+        const bool sampling = zstd && !dictionary && zstdTrainingBackoff == 0;
+        const auto dictionarySize = config.getCompressionZstdDictSize();
+        visitor.setZstdDictionary(dictionary);
+        visitor.setZstdSampleLimit(
+                sampling ? dictionarySize * SamplesPerDictionaryByte : 0);
+
         // Do it - set off the visitor.
         epstore_position = engine->getKVBucket()->pauseResumeVisit(
                 *prAdapter, epstore_position);
@@ -82,6 +100,12 @@ bool ItemCompressorTask::run() {
         bool completed =
                 (epstore_position == engine->getKVBucket()->endPosition());
 
+        if (sampling && (completed || visitor.isZstdSampleLimitReached())) {
+            trainZstdDictionary(visitor.takeZstdSamples());
+        } else if (completed && !sampling && zstdTrainingBackoff > 0) {
+            --zstdTrainingBackoff;
+        }
+
         // Print status.
         if (globalBucketLogger->should_log(spdlog::level::debug)) {
             std::stringstream ss;
@@ -116,6 +140,56 @@ bool ItemCompressorTask::run() {
     return true;
 }
 
+void ItemCompressorTask::trainZstdDictionary(
+        std::vector<std::string> samples) {
+    const auto& config = engine->getConfiguration();
+    const auto start = std::chrono::steady_clock::now();
+    auto dictionary = ZstdDictionary::train(
+            samples,
+            config.getCompressionZstdDictSize(),
+            gsl::narrow<int>(config.getCompressionZstdLevel()));
+    if (!dictionary) {
+        zstdTrainingBackoff = zstdNextTrainingBackoff;
+        zstdNextTrainingBackoff =
+                std::min(zstdNextTrainingBackoff * 2, MaxZstdTrainingBackoff);
+        if (samples.size() < ZstdDictionary::MinSamples) {
+            // Expected for a bucket with few (compressible) documents
+            EP_LOG_INFO(
+                    "{} for bucket '{}': Too few documents ({}) to train a "
+                    "Zstd dictionary from, compressing with Snappy. Sampling "
+                    "again in {} passes",
+                    getDescription(),
+                    engine->getName(),
+                    samples.size(),
+                    zstdTrainingBackoff);
+        } else {
+            EP_LOG_WARN(
+                    "{} for bucket '{}': Failed to train a Zstd dictionary "
+                    "from {} documents, compressing with Snappy. Sampling "
+                    "again in {} passes",
+                    getDescription(),
+                    engine->getName(),
+                    samples.size(),
+                    zstdTrainingBackoff);
+        }
+        return;
+    }
+    zstdNextTrainingBackoff = 1;
+
+    EP_LOG_INFO(
+            "{} for bucket '{}': Trained Zstd dictionary id:{} of {} bytes "
+            "from {} documents in {} ms",
+            getDescription(),
+            engine->getName(),
+            dictionary->getId(),
+            dictionary->getSize(),
+            samples.size(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
+    engine->getKVBucket()->setZstdDictionary(std::move(dictionary));
+}
+
 void ItemCompressorTask::stop() {
     if (uid) {
         ExecutorPool::get()->cancel(uid);
@@ -19,6 +19,9 @@
 #include "globaltask.h"
 #include "kv_bucket_iface.h"
 
+#include <string>
+#include <vector>
+
 class ItemCompressorVisitor;
 class EPStats;
 class PauseResumeVBAdapter;
@@ -50,6 +53,19 @@ private:
     /// Returns the underlying ItemCompressorVisitor instance.
     ItemCompressorVisitor& getItemCompressorVisitor();
 
+    /**
+     * Train a ZstdDictionary from the given documents and hand it to the
+     * bucket. If training fails the following passes don't sample (see
+     * zstdTrainingBackoff).
+     */
+    void trainZstdDictionary(std::vector<std::string> samples);
+
+    /// Bytes of documents sampled for each byte of Zstd dictionary trained
+    static constexpr size_t SamplesPerDictionaryByte = 100;
+
+    /// The most complete passes to skip sampling for after failed training
+    static constexpr size_t MaxZstdTrainingBackoff = 64;
+
     /// Reference to EP stats, used to check on mem_used.
     EPStats& stats;
 
@@ -62,4 +78,10 @@ private:
      * complete pass.
      */
     std::unique_ptr<PauseResumeVBAdapter> prAdapter;
+
+    /// The number of complete passes still to skip sampling for, and the
+    /// number to skip after the next failed training (doubled after every
+    /// failure, up to MaxZstdTrainingBackoff)
+    size_t zstdTrainingBackoff = 0;
+    size_t zstdNextTrainingBackoff = 1;
 };
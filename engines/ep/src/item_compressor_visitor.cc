@@ -17,8 +17,11 @@
 
 #include "item_compressor_visitor.h"
 #include "vbucket.h"
+#include "zstd_dictionary.h"
 #include <platform/compress.h>
 
+#include <utility>
+
 // ItemCompressorVisitor implementation //////////////////////////////
 
 ItemCompressorVisitor::ItemCompressorVisitor()
@@ -39,8 +42,16 @@ void ItemCompressorVisitor::setDeadline(
 bool ItemCompressorVisitor::visit(const HashTable::HashBucketLock& lh,
                                   StoredValue& v) {
 
-    // Check if the item can be compressed
-    if (compressMode == BucketCompressionMode::Active && v.isCompressible()) {
+    if (compressMode == BucketCompressionMode::Active &&
+        (zstdDictionary || zstdSampleLimit)) {
+        visitZstd(v);
+    }
+
+    // Until there is a dictionary to compress with, compress with Snappy
+    // (after sampling the value, if sampling).
+    if (compressMode == BucketCompressionMode::Active && !zstdDictionary &&
+        v.isCompressible()) {
+        // Check if the item can be compressed
         cb::compression::Buffer deflated;
         if (cb::compression::deflate(cb::compression::Algorithm::Snappy,
                                      {v.getValue()->getData(), v.valuelen()},
@@ -69,6 +80,69 @@ bool ItemCompressorVisitor::visit(const HashTable::HashBucketLock& lh,
     return progressTracker.shouldContinueVisiting(visited_count);
 }
 
+void ItemCompressorVisitor::visitZstd(StoredValue& v) {
+    // Only resident documents which aren't already compressed with the
+    // dictionary (or found not to compress well). System events are read in
+    // place so are left alone.
+    if (!v.valuelen() || v.isZstdCompressed() ||
+        !v.getValue()->isCompressible() || v.getKey().isInSystemCollection()) {
+        return;
+    }
+
+    std::string_view value{v.getValue()->getData(), v.valuelen()};
+    cb::compression::Buffer inflated;
+    if (mcbp::datatype::is_snappy(v.getDatatype())) {
+        if (!cb::compression::inflate(
+                    cb::compression::Algorithm::Snappy, value, inflated)) {
+            return;
+        }
+        value = {inflated.data(), inflated.size()};
+    }
+
+    if (!zstdDictionary) {
+        if (!isZstdSampleLimitReached()) {
+            zstdSamples.emplace_back(value);
+            zstdSampleBytes += value.size();
+        }
+        return;
+    }
+
+    std::string deflated;
+    if (!zstdDictionary->compress(value, deflated)) {
+        return;
+    }
+
+    // The ratio is against the uncompressed document; re-compressing a
+    // Snappy document is worthwhile as long as it's smaller than it was.
+    auto comp_ratio = static_cast<float>(value.size()) /
+                      static_cast<float>(deflated.size());
+    if (comp_ratio >= currentMinCompressionRatio &&
+        deflated.size() < v.valuelen()) {
+        currentVb->ht.storeZstdCompressedBuffer(deflated, v);
+        compressed_count++;
+    } else {
+        v.setUncompressible();
+    }
+}
+
+void ItemCompressorVisitor::setZstdDictionary(
+        const ZstdDictionary* dictionary) {
+    zstdDictionary = dictionary;
+}
+
+void ItemCompressorVisitor::setZstdSampleLimit(size_t bytes) {
+    zstdSampleLimit = bytes;
+}
+
+bool ItemCompressorVisitor::isZstdSampleLimitReached() const {
+    return zstdSampleBytes >= zstdSampleLimit;
+}
+
+std::vector<std::string> ItemCompressorVisitor::takeZstdSamples() {
+    zstdSampleBytes = 0;
+    return std::exchange(zstdSamples, {});
+}
+
 void ItemCompressorVisitor::clearStats() {
     compressed_count = 0;
     visited_count = 0;
@@ -22,6 +22,11 @@
 #include "vb_visitors.h"
 #include <memcached/engine.h>
 
+#include <string>
+#include <vector>
+
+class ZstdDictionary;
+
 /**
  * Item Compressor visitor - visit all objects in a VBucket and compress
  * the values
@@ -41,6 +46,26 @@ public:
     // Set the minimum compression ratio
     void setMinCompressionRatio(float minCompressionRatio);
 
+    /**
+     * Set the dictionary to compress values with (compression_codec=zstd)
+     * instead of Snappy. Snappy compressed values are re-compressed with the
+     * dictionary.
+     */
+    void setZstdDictionary(const ZstdDictionary* dictionary);
+
+    /**
+     * Collect (up to the given number of bytes of) values to train a
+     * ZstdDictionary from. Values are still compressed with Snappy while
+     * there is no dictionary. Zero disables sampling.
+     */
+    void setZstdSampleLimit(size_t bytes);
+
+    /// @return true if the limit of bytes to sample was reached
+    bool isZstdSampleLimitReached() const;
+
+    /// Returns (and forgets) the values sampled so far
+    std::vector<std::string> takeZstdSamples();
+
     // Implementation of HashTableVisitor interface:
     bool visit(const HashTable::HashBucketLock& lh, StoredValue& v) override;
 
@@ -75,4 +100,16 @@ private:
 
     // The current minimum compression ratio supported by the bucket
     float currentMinCompressionRatio;
+
+    // Dictionary to compress with, if compressing with Zstd
+    const ZstdDictionary* zstdDictionary = nullptr;
+
+    // Values sampled to train a ZstdDictionary from, and the limit of their
+    // total size
+    std::vector<std::string> zstdSamples;
+    size_t zstdSampleBytes = 0;
+    size_t zstdSampleLimit = 0;
+
+    // Compress (or sample) the value of v with Zstd
+    void visitZstd(StoredValue& v);
 };
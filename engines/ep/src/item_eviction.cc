@@ -18,34 +18,60 @@
 #include "item_eviction.h"
 #include "item.h"
 
-#include <gsl/gsl>
+#include <algorithm>
 
 ItemEviction::ItemEviction() {
 }
 
 void ItemEviction::addFreqAndAgeToHistograms(uint8_t freq, uint64_t age) {
-    freqHistogram.addValue(freq);
-    ageHistogram.addValue(age);
-}
+    ++freqCounts[freq];
+    ++freqValueCount;
 
-uint64_t ItemEviction::getFreqHistogramValueCount() const {
-    return freqHistogram.getValueCount();
+    // Ages are only needed for a percentile, for which a sample (weighted
+    // by the sample interval) is as good as every value - and much cheaper
+    // than an HdrHistogram update per item.
+    if (freqValueCount <= learningPopulation) {
+        ageHistogram.addValue(age);
+    } else if (freqValueCount % ageSampleInterval == 0) {
+        ageHistogram.addValueAndCount(age, ageSampleInterval);
+    }
 }
 
 void ItemEviction::reset() {
-    freqHistogram.reset();
+    freqCounts.fill(0);
+    freqValueCount = 0;
     ageHistogram.reset();
     requiredToUpdateInterval = 1;
 }
 
 std::pair<uint16_t, uint64_t> ItemEviction::getThresholds(
         double freqPercentage, double agePercentage) const {
-    auto freqThreshold = gsl::narrow<uint16_t>(
-            freqHistogram.getValueAtPercentile(freqPercentage));
+    uint16_t freqThreshold = getFreqAtPercentile(freqPercentage);
     uint64_t ageThreshold = ageHistogram.getValueAtPercentile(agePercentage);
     return std::make_pair(freqThreshold, ageThreshold);
 }
 
+uint8_t ItemEviction::getFreqAtPercentile(double percentage) const {
+    if (freqValueCount == 0) {
+        return 0;
+    }
+
+    // Same definition of percentile as HdrHistogram: the lowest value such
+    // that (rounded) percentage% of the values are at or below it.
+    percentage = std::min(percentage, 100.0);
+    const auto countAtPercentile = std::max(
+            uint64_t(1),
+            uint64_t((percentage / 100.0) * freqValueCount + 0.5));
+    uint64_t total = 0;
+    for (size_t freq = 0; freq < freqCounts.size(); ++freq) {
+        total += freqCounts[freq];
+        if (total >= countAtPercentile) {
+            return uint8_t(freq);
+        }
+    }
+    return std::numeric_limits<uint8_t>::max();
+}
+
 uint8_t ItemEviction::convertFreqCountToNRUValue(uint8_t probCounter) {
     /*
      * The probabilistic counter has a range form 0 to 255, however the
@@ -69,5 +95,9 @@ uint8_t ItemEviction::convertFreqCountToNRUValue(uint8_t probCounter) {
 }
 
 void ItemEviction::copyFreqHistogram(HdrHistogram& hist) {
-    hist = freqHistogram;
+    for (size_t freq = 0; freq < freqCounts.size(); ++freq) {
+        if (freqCounts[freq] != 0) {
+            hist.addValueAndCount(freq, freqCounts[freq]);
+        }
+    }
 }
@@ -19,6 +19,7 @@
 
 #include "hdrhistogram.h"
 
+#include <array>
 #include <cstdlib> // Required due to the use of free
 #include <limits>
 #include <utility>
@@ -51,6 +52,11 @@
  * iterating over the hash table and evict all those values that have a
  * frequency count at or below the threshold.
  *
+ * As every item visited is added, the frequency "histogram" is a plain
+ * array with one counter per frequency count (rather than an HdrHistogram,
+ * whose every update takes a lock), and once past the learning population
+ * only one in ageSampleInterval ages is added to the age histogram (with
+ * a count of ageSampleInterval).
  */
 class ItemEviction {
 
@@ -61,7 +67,9 @@ public:
     void addFreqAndAgeToHistograms(uint8_t freq, uint64_t age);
 
     // Returns the number of values added to the frequency histogram.
-    uint64_t getFreqHistogramValueCount() const;
+    uint64_t getFreqHistogramValueCount() const {
+        return freqValueCount;
+    }
 
     // Clears the frequency histogram and sets the requiredToUpdateInterval
     // back to 1.
@@ -90,7 +98,7 @@ public:
     }
 
     // StatCounter:: Copies the contents of the frequency histogram into
-    // the histogram given as an input parameter
+    // the histogram given as an input parameter (which should be empty)
     // @param hist  the destination histogram for the copy
     void copyFreqHistogram(HdrHistogram& hist);
 
@@ -109,6 +117,10 @@ public:
 
     static const uint64_t casBitsNotTime = 16;
 
+    // Once past the learning population, one in this many ages is added to
+    // the age histogram.
+    static const uint64_t ageSampleInterval = 8;
+
 private:
 
     //  The minimum value that can be added to the age histogram
@@ -121,17 +133,20 @@ private:
     // between 1 and 5 (inclusive).
     static const int ageSignificantFigures = 1;
 
-    // The value units per bucket that we use when creating the iterator
-    // that traverses over the frequency histogram in the copyToHistogram
-    // method.
-    static const int valueUnitsPerBucket = 1;
+    // Returns the frequency count at the given percentile of the values
+    // added to the frequency histogram.
+    uint8_t getFreqAtPercentile(double percentage) const;
+
+    // The frequency histogram; the number of values added with each
+    // frequency count.
+    std::array<uint64_t, std::numeric_limits<uint8_t>::max() + 1> freqCounts{};
 
-    // The execution frequency histogram
-    HdrUint8Histogram freqHistogram;
+    // The number of values added to the frequency histogram
+    uint64_t freqValueCount{0};
 
-    // The age histogram.  Age is measured by taking the item's current cas
-    // from the maxCas (which is the maximum cas value of the associated
-    // vbucket).
+    // The (sampled) age histogram.  Age is measured by taking the item's
+    // current cas from the maxCas (which is the maximum cas value of the
+    // associated vbucket).
     // The time in nanoseconds is stored in the top 48 bits of the cas
     // therefore we shift the age by casBitsNotTime.  This allows us
     // to have an age histogram with a reduced maximum value and
@@ -50,6 +50,7 @@
 #include "vbucket.h"
 #include "vbucket_bgfetch_item.h"
 #include "vbucketdeletiontask.h"
+#include "zstd_dictionary.h"
 
 #include <memcached/server_document_iface.h>
 #include <nlohmann/json.hpp>
@@ -999,7 +1000,10 @@ cb::engine_errc KVBucket::createVBucket_UNLOCKED(
         // Initialize bloom filters upon vbucket creation during
         // bucket creation and rebalance
         newvb->createFilter(config.getBfilterKeyCount(),
-                            config.getBfilterFpProb());
+                            config.getBfilterFpProb(),
+                            config.getBfilterType() == "blocked"
+                                    ? BloomFilter::Type::Blocked
+                                    : BloomFilter::Type::Classic);
     }
 
     // The first checkpoint for active vbucket should start with id 2.
@@ -1933,9 +1937,10 @@ std::string KVBucket::validateKey(const DocKey& key,
 
         if (diskItem.getFlags() != v->getFlags()) {
             return "flags_mismatch";
-        } else if (v->isResident() && memcmp(diskItem.getData(),
-                                             v->getValue()->getData(),
-                                             diskItem.getNBytes())) {
+        } else if (v->isResident() &&
+                   memcmp(diskItem.getData(),
+                          v->getDecodedValue()->getData(),
+                          diskItem.getNBytes())) {
             return "data_mismatch";
         } else {
             return "valid";
@@ -2802,3 +2807,11 @@ cb::engine_errc KVBucket::setMinDurabilityLevel(cb::durability::Level level) {
 cb::durability::Level KVBucket::getMinDurabilityLevel() const {
     return minDurabilityLevel;
 }
+
+void KVBucket::setZstdDictionary(std::unique_ptr<ZstdDictionary> dictionary) {
+    if (zstdDictionary) {
+        throw std::logic_error(
+                "KVBucket::setZstdDictionary: dictionary is already set");
+    }
+    zstdDictionary = std::move(dictionary);
+}
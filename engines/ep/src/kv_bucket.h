@@ -31,6 +31,7 @@
 class DurabilityCompletionTask;
 class ReplicationThrottle;
 class VBucketCountVisitor;
+class ZstdDictionary;
 namespace Collections {
 class Manager;
 }
@@ -742,6 +743,21 @@ public:
 
     cb::durability::Level getMinDurabilityLevel() const;
 
+    /**
+     * @return the dictionary the item compressor compresses values with when
+     *         compression_codec is zstd, or nullptr if none is trained yet
+     */
+    const ZstdDictionary* getZstdDictionary() const {
+        return zstdDictionary.get();
+    }
+
+    /**
+     * Set the dictionary for the item compressor. May only be set once, as
+     * values compressed with it must remain readable for the lifetime of
+     * the bucket.
+     */
+    void setZstdDictionary(std::unique_ptr<ZstdDictionary> dictionary);
+
 protected:
     GetValue getInternal(const DocKey& key,
                          Vbid vbucket,
@@ -827,6 +843,9 @@ protected:
 
     EventuallyPersistentEngine     &engine;
     EPStats                        &stats;
+    // Declared before the vbMap so that it outlives the values compressed
+    // with it. Only set (once) by the item compressor.
+    std::unique_ptr<ZstdDictionary> zstdDictionary;
     VBucketMap                      vbMap;
     ExTask itemPagerTask;
     ExTask                          chkTask;
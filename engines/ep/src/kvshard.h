@@ -114,6 +114,15 @@ public:
 
     Flusher *getFlusher();
 
+    /**
+     * The rwStore supports a single transaction at a time; flushes of the
+     * shard's vBuckets which run concurrently must hold this lock from
+     * KVStore::begin() until the transaction is committed.
+     */
+    std::mutex& getFlushTransactionLock() {
+        return flushTransactionLock;
+    }
+
     VBucketPtr getBucket(Vbid id) const;
     void setBucket(VBucketPtr vb);
 
@@ -247,7 +256,10 @@ private:
     std::unique_ptr<KVStore> rwStore;
     std::unique_ptr<KVStore> roStore;
 
-    std::unique_ptr<Flusher> flusher;
+    // Shared with (weakly) the flusher's VBucketFlushTasks
+    std::shared_ptr<Flusher> flusher;
+
+    std::mutex flushTransactionLock;
 
 public:
     std::atomic<size_t> highPriorityCount;
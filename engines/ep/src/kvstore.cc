@@ -17,6 +17,7 @@
 
 #include <fcntl.h>
 #include <folly/lang/Assume.h>
+#include <folly/lang/Bits.h>
 #include <map>
 #include <string>
 #include <utility>
@@ -132,6 +133,7 @@ void FileStats::reset() {
     writeTimeHisto.reset();
     writeSizeHisto.reset();
     syncTimeHisto.reset();
+    syncConcurrencyHisto.reset();
     readCountHisto.reset();
     writeCountHisto.reset();
     totalBytesRead = 0;
@@ -142,6 +144,7 @@ size_t FileStats::getMemFootPrint() const {
     return readTimeHisto.getMemFootPrint() + readSeekHisto.getMemFootPrint() +
            readSizeHisto.getMemFootPrint() + writeTimeHisto.getMemFootPrint() +
            writeSizeHisto.getMemFootPrint() + syncTimeHisto.getMemFootPrint() +
+           syncConcurrencyHisto.getMemFootPrint() +
            readCountHisto.getMemFootPrint() + writeCountHisto.getMemFootPrint();
 }
 
@@ -161,6 +164,7 @@ void KVStoreStats::reset() {
     numVbSetFailure = 0;
 
     io_bg_fetch_docs_read = 0;
+    io_bg_fetch_coalesced = 0;
     io_num_write = 0;
     io_bgfetch_doc_bytes = 0;
     io_document_write_bytes = 0;
@@ -171,6 +175,7 @@ void KVStoreStats::reset() {
     writeSizeHisto.reset();
     delTimeHisto.reset();
     commitHisto.reset();
+    commitWriteHisto.reset();
     compactHisto.reset();
     saveDocsHisto.reset();
     batchSize.reset();
@@ -433,6 +438,11 @@ void KVStore::addStats(const AddStatFn& add_stat,
                       st.io_bg_fetch_docs_read,
                       add_stat,
                       c);
+    add_prefixed_stat(prefix,
+                      "io_bg_fetch_coalesced",
+                      st.io_bg_fetch_coalesced,
+                      add_stat,
+                      c);
     add_prefixed_stat(prefix, "io_num_write", st.io_num_write, add_stat, c);
     add_prefixed_stat(prefix,
                       "io_bg_fetch_doc_bytes",
@@ -496,6 +506,8 @@ void KVStore::addTimingStats(const AddStatFn& add_stat, const void* c) {
     const auto prefix = getStatsPrefix();
 
     add_prefixed_stat(prefix, "commit", st.commitHisto, add_stat, c);
+    add_prefixed_stat(
+            prefix, "commit_write", st.commitWriteHisto, add_stat, c);
     add_prefixed_stat(prefix, "compact", st.compactHisto, add_stat, c);
     add_prefixed_stat(prefix, "snapshot", st.snapshotHisto, add_stat, c);
     add_prefixed_stat(prefix, "delete", st.delTimeHisto, add_stat, c);
@@ -526,6 +538,11 @@ void KVStore::addTimingStats(const AddStatFn& add_stat, const void* c) {
             prefix, "fsWriteTime", st.fsStats.writeTimeHisto, add_stat, c);
     add_prefixed_stat(
             prefix, "fsSyncTime", st.fsStats.syncTimeHisto, add_stat, c);
+    add_prefixed_stat(prefix,
+                      "fsSyncConcurrency",
+                      st.fsStats.syncConcurrencyHisto,
+                      add_stat,
+                      c);
     add_prefixed_stat(
             prefix, "fsReadSize", st.fsStats.readSizeHisto, add_stat, c);
     add_prefixed_stat(
@@ -675,3 +692,39 @@ void CompactionConfig::merge(const CompactionConfig& other) {
     purge_before_seq =
             std::max<uint64_t>(purge_before_seq, other.purge_before_seq);
 }
+
+std::string PersistedBloomFilter::encode() const {
+    const auto seqno = folly::Endian::little(highSeqno);
+    std::string out(reinterpret_cast<const char*>(&seqno), sizeof(seqno));
+    out.append(filter);
+    return out;
+}
+
+std::optional<PersistedBloomFilter> PersistedBloomFilter::decode(
+        std::string_view data) {
+    PersistedBloomFilter result;
+    if (data.size() < sizeof(result.highSeqno)) {
+        return {};
+    }
+    std::memcpy(&result.highSeqno, data.data(), sizeof(result.highSeqno));
+    result.highSeqno = folly::Endian::little(result.highSeqno);
+    data.remove_prefix(sizeof(result.highSeqno));
+    result.filter = std::string(data);
+    return result;
+}
+
+void CompactionContext::addToPersistedFilter(const DocKey& key) {
+    std::lock_guard<std::mutex> lh(persistedFilterMutex);
+    if (persistedFilter) {
+        persistedFilter->addKey(key);
+    }
+}
+
+std::string CompactionContext::takePersistedFilter(uint64_t highSeqno) {
+    std::lock_guard<std::mutex> lh(persistedFilterMutex);
+    PersistedBloomFilter persisted;
+    persisted.highSeqno = highSeqno;
+    persisted.filter = persistedFilter->serialise();
+    persistedFilter.reset();
+    return persisted.encode();
+}
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "bloomfilter.h"
 #include "callbacks.h"
 #include "collections/eraser_context.h"
 #include "collections/kvstore.h"
@@ -31,6 +32,8 @@
 #include <cstring>
 #include <list>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -146,6 +149,25 @@ struct CompactionConfig {
     bool retain_erroneous_tombstones = false;
 };
 
+/**
+ * A vBucket's bloom filter as persisted alongside its data by compaction
+ * (see CompactionContext::persistedFilter), to be reloaded by warmup.
+ */
+struct PersistedBloomFilter {
+    /// @returns the filter in the form stored on disk.
+    std::string encode() const;
+
+    /// @returns the filter decoded from encode(); or empty if malformed.
+    static std::optional<PersistedBloomFilter> decode(std::string_view data);
+
+    /// Every key with a seqno up to and including this is in the filter;
+    /// keys persisted after it are not.
+    uint64_t highSeqno = 0;
+
+    /// The filter, as returned by BloomFilter::serialise().
+    std::string filter;
+};
+
 struct CompactionContext {
     CompactionContext(Vbid vbid,
                       const CompactionConfig& config,
@@ -159,6 +181,24 @@ struct CompactionContext {
 
     uint64_t max_purged_seq;
     BloomFilterCBPtr bloomFilterCallback;
+
+    /**
+     * If non-null, every (committed) key kept by compaction is added to this
+     * filter, which the KVStore then persists alongside the compacted data
+     * as a PersistedBloomFilter. Must be populated via addToPersistedFilter
+     * as KVStores may call it from multiple threads.
+     */
+    std::unique_ptr<BloomFilter> persistedFilter;
+
+    void addToPersistedFilter(const DocKey& key);
+
+    /**
+     * @returns persistedFilter (and resets it) in its persisted form, noting
+     * that it covers all keys up to highSeqno. Must only be called while
+     * persistedFilter is set.
+     */
+    std::string takePersistedFilter(uint64_t highSeqno);
+
     ExpiredItemsCBPtr expiryCallback;
     struct CompactionStats stats;
     /// pointer as context cannot be constructed until deeper inside storage
@@ -174,6 +214,9 @@ struct CompactionContext {
 
     /// The SyncRepl HCS, can purge any prepares before the HCS.
     uint64_t highCompletedSeqno = 0;
+
+private:
+    std::mutex persistedFilterMutex;
 };
 
 using MakeCompactionContextCallback =
@@ -421,6 +464,9 @@ struct FileStats {
     Hdr1sfInt32Histogram writeSizeHisto;
     // Time spent in sync
     Hdr1sfMicroSecHistogram syncTimeHisto;
+    // Number of syncs in progress (including the new one) as a sync starts
+    Hdr1sfInt32Histogram syncConcurrencyHisto;
+    std::atomic<int32_t> syncsInProgress{0};
     // Read count per open() / close() pair
     Hdr1sfInt32Histogram readCountHisto;
     // Write count per open() / close() pair
@@ -469,6 +515,12 @@ public:
      * fetch operations.
      */
     cb::RelaxedAtomic<size_t> io_bg_fetch_docs_read;
+    /**
+     * Number of background fetch document reads which were satisfied by
+     * a read issued for a neighbouring document (i.e. disk reads saved by
+     * coalescing).
+     */
+    cb::RelaxedAtomic<size_t> io_bg_fetch_coalesced;
     //! Number of logical write operations (i.e. one per saved doc; not
     //  considering how many actual pwrite() calls were made).
     cb::RelaxedAtomic<size_t> io_num_write;
@@ -493,6 +545,8 @@ public:
     Hdr1sfMicroSecHistogram delTimeHisto;
     // Time spent in commit
     Hdr1sfMicroSecHistogram commitHisto;
+    // Time spent writing a flush-batch, before it is synced by the commit
+    Hdr1sfMicroSecHistogram commitWriteHisto;
     // Time spent in compaction
     Hdr1sfMicroSecHistogram compactHisto;
     // Time spent in saving documents to disk
@@ -531,6 +585,7 @@ public:
                writeSizeHisto.getMemFootPrint() +
                delTimeHisto.getMemFootPrint() + compactHisto.getMemFootPrint() +
                snapshotHisto.getMemFootPrint() + commitHisto.getMemFootPrint() +
+               commitWriteHisto.getMemFootPrint() +
                saveDocsHisto.getMemFootPrint() + batchSize.getMemFootPrint() +
                getMultiFsReadHisto.getMemFootPrint() +
                getMultiFsReadPerDocHisto.getMemFootPrint() +
@@ -905,6 +960,16 @@ public:
      */
     virtual vbucket_state getPersistedVBucketState(Vbid vbid) = 0;
 
+    /**
+     * Return the bloom filter persisted for the given vBucket by its most
+     * recent compaction (see CompactionContext::persistedFilter), if any.
+     * KVStores which do not persist filters always return none.
+     */
+    virtual std::optional<PersistedBloomFilter> getPersistedBloomFilter(
+            Vbid vbid) {
+        return {};
+    }
+
     /**
      * Get the number of deleted items that are persisted to a vbucket file
      *
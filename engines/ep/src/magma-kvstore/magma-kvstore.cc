@@ -51,6 +51,7 @@ static const std::string manifestKey = "_collections/manifest";
 static const std::string openCollectionsKey = "_collections/open";
 static const std::string openScopesKey = "_scopes/open";
 static const std::string droppedCollectionsKey = "_collections/dropped";
+static const std::string bloomFilterKey = "_bloomfilter";
 
 // Unfortunately, turning on logging for the tests is limited to debug
 // mode. While we are in the midst of dropping in magma, this provides
@@ -413,6 +414,10 @@ bool MagmaKVStore::compactionCallBack(MagmaKVStore::MagmaCompactionCB& cbCtx,
         }
     }
 
+    if (cbCtx.ctx->persistedFilter && !magmakv::isPrepared(metaSlice)) {
+        cbCtx.ctx->addToPersistedFilter(makeDiskDocKey(keySlice).getDocKey());
+    }
+
     if (logger->should_log(spdlog::level::TRACE)) {
         logger->TRACE("MagmaCompactionCB: {} KEEP {}",
                       vbid,
@@ -1704,6 +1709,16 @@ uint64_t MagmaKVStore::getKVStoreRevision(Vbid vbid) const {
     return kvstoreRev;
 }
 
+std::optional<PersistedBloomFilter> MagmaKVStore::getPersistedBloomFilter(
+        Vbid vbid) {
+    Slice keySlice(bloomFilterKey);
+    auto [status, value] = readLocalDoc(vbid, keySlice);
+    if (!status.IsOK()) {
+        return {};
+    }
+    return PersistedBloomFilter::decode(value);
+}
+
 MagmaKVStore::DiskState MagmaKVStore::readVBStateFromDisk(Vbid vbid) {
     Slice keySlice(vbstateKey);
     auto kvstoreRev = getKVStoreRevision(vbid);
@@ -2023,6 +2038,18 @@ bool MagmaKVStore::compactDBInternal(std::shared_ptr<CompactionContext> ctx) {
     uint64_t collectionItemsDropped = 0;
     LocalDbReqs localDbReqs;
 
+    // A persisted bloom filter must hold every key up to the seqno recorded
+    // with it, so is only built when compacting the entire key range. Sync
+    // first so that everything up to that seqno is visible to compaction.
+    uint64_t filterSeqno = 0;
+    if (ctx->persistedFilter) {
+        if (!dropped.empty() ||
+            !magma->GetMaxSeqno(vbid.get(), filterSeqno) ||
+            !magma->Sync(true)) {
+            ctx->persistedFilter.reset();
+        }
+    }
+
     Status status;
     if (dropped.empty()) {
         // Compact the entire key range
@@ -2124,6 +2151,23 @@ bool MagmaKVStore::compactDBInternal(std::shared_ptr<CompactionContext> ctx) {
         ctx->completionCallback(*ctx);
     }
 
+    if (ctx->persistedFilter) {
+        LocalDbReqs filterReqs;
+        filterReqs.emplace_back(MagmaLocalReq(
+                bloomFilterKey, ctx->takePersistedFilter(filterSeqno)));
+        WriteOps writeOps;
+        addLocalDbReqs(filterReqs, writeOps);
+        status = magma->WriteDocs(
+                vbid.get(), writeOps, kvstoreRevList[vbid.get()]);
+        if (!status) {
+            // Not fatal - warmup will just not have a filter to load.
+            logger->warn(
+                    "MagmaKVStore::compactDBInternal {} failed to write "
+                    "bloom filter. Status:{}",
+                    vbid,
+                    status.String());
+        }
+    }
 
     if (ctx->eraserContext->needToUpdateCollectionsMetadata()) {
         // Delete dropped collections.
@@ -604,6 +604,9 @@ public:
 
     vbucket_state getPersistedVBucketState(Vbid vbid) override;
 
+    std::optional<PersistedBloomFilter> getPersistedBloomFilter(
+            Vbid vbid) override;
+
     /**
      * Populate kvstore stats with magma specific stats
      */
@@ -28,6 +28,7 @@
 #include "kv_bucket.h"
 #include "kv_bucket_iface.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -109,6 +110,25 @@ bool PagingVisitor::visit(const HashTable::HashBucketLock& lh, StoredValue& v) {
     auto storedValueFreqCounter = v.getFreqCounterValue();
     bool evicted = true;
 
+    // The frequency counter as seen through the eviction priority of the
+    // item's collection; this is what is compared against the thresholds and
+    // added to the histogram.
+    const auto& collection =
+            getCollectionEvictionState(v.getKey().getCollectionID());
+    uint8_t freqCounter = storedValueFreqCounter;
+    switch (collection.priority) {
+    case Collections::EvictionPriority::Low:
+        freqCounter -= std::min(freqCounter, EvictionPriorityFreqCounterBias);
+        break;
+    case Collections::EvictionPriority::Normal:
+        break;
+    case Collections::EvictionPriority::High:
+        freqCounter = std::min(
+                int(std::numeric_limits<uint8_t>::max()),
+                int(freqCounter) + int(EvictionPriorityFreqCounterBias));
+        break;
+    }
+
     /*
      * Calculate the age when the item was last stored / modified.
      * We do this by taking the item's current cas from the maxCas
@@ -127,8 +147,7 @@ bool PagingVisitor::visit(const HashTable::HashBucketLock& lh, StoredValue& v) {
     uint64_t age = (maxCas > v.getCas()) ? (maxCas - v.getCas()) : 0;
     age = age >> ItemEviction::casBitsNotTime;
 
-    const bool belowMFUThreshold =
-            storedValueFreqCounter <= freqCounterThreshold;
+    const bool belowMFUThreshold = freqCounter <= freqCounterThreshold;
     // age exceeds threshold (from age histogram, set by config param
     // item_eviction_age_percentage
     // OR
@@ -137,13 +156,22 @@ bool PagingVisitor::visit(const HashTable::HashBucketLock& lh, StoredValue& v) {
     // Below this threshold the item is considered "cold" enough
     // to be evicted even if it is "young".
     const bool meetsAgeRequirements =
-            age >= ageThreshold ||
-            storedValueFreqCounter < freqCounterAgeThreshold;
+            age >= ageThreshold || freqCounter < freqCounterAgeThreshold;
 
-    // For replica vbuckets, young items are not protected from eviction.
+    // For replica vbuckets, and Low priority collections, young items are not
+    // protected from eviction. They always are in High priority collections.
     const bool isReplica = currentBucket->getState() == vbucket_state_replica;
-
-    if (belowMFUThreshold && (meetsAgeRequirements || isReplica)) {
+    const bool ignoreAge =
+            collection.priority == Collections::EvictionPriority::Low ||
+            (isReplica &&
+             collection.priority != Collections::EvictionPriority::High);
+
+    if (collection.withinMemoryShare) {
+        // Nothing is evicted from a collection within its share of the
+        // quota; count it as not eligible.
+        evicted = false;
+        freqCounter = std::numeric_limits<uint8_t>::max();
+    } else if (belowMFUThreshold && (meetsAgeRequirements || ignoreAge)) {
         /*
          * If the storedValue is eligible for eviction then add its
          * frequency counter value to the histogram, otherwise add the
@@ -157,14 +185,14 @@ bool PagingVisitor::visit(const HashTable::HashBucketLock& lh, StoredValue& v) {
          */
         if (!doEviction(lh, &v)) {
             evicted = false;
-            storedValueFreqCounter = std::numeric_limits<uint8_t>::max();
+            freqCounter = std::numeric_limits<uint8_t>::max();
         }
     } else {
         evicted = false;
         // If the storedValue is NOT eligible for eviction then
         // we want to add the maximum value (255).
         if (!currentBucket->eligibleToPageOut(lh, v)) {
-            storedValueFreqCounter = std::numeric_limits<uint8_t>::max();
+            freqCounter = std::numeric_limits<uint8_t>::max();
         } else {
             /*
              * MB-29333 - For items that we have visited and did not
@@ -179,7 +207,7 @@ bool PagingVisitor::visit(const HashTable::HashBucketLock& lh, StoredValue& v) {
             }
         }
     }
-    itemEviction.addFreqAndAgeToHistograms(storedValueFreqCounter, age);
+    itemEviction.addFreqAndAgeToHistograms(freqCounter, age);
 
     if (evicted) {
         /**
@@ -235,6 +263,8 @@ void PagingVisitor::visitBucket(const VBucketPtr& vb) {
             maxCas = currentBucket->getMaxCas();
             itemEviction.reset();
             freqCounterThreshold = 0;
+            collectionEvictionStates.clear();
+            collectionMemStats.reset();
 
             // Percent of items in the hash table to be visited
             // between updating the interval.
@@ -401,6 +431,32 @@ bool PagingVisitor::doEviction(const HashTable::HashBucketLock& lh,
     return false;
 }
 
+const PagingVisitor::CollectionEvictionState&
+PagingVisitor::getCollectionEvictionState(CollectionID cid) {
+    auto itr = collectionEvictionStates.find(cid);
+    if (itr != collectionEvictionStates.end()) {
+        return itr->second;
+    }
+
+    const auto settings = readHandle.getEvictionSettings(cid);
+    bool withinMemoryShare = false;
+    if (settings.memoryShare) {
+        if (!collectionMemStats) {
+            collectionMemStats = stats.getAllCollectionsMemStats();
+        }
+        auto memItr = collectionMemStats->find(cid);
+        const size_t memUsed =
+                memItr == collectionMemStats->end() ? 0 : memItr->second.memUsed;
+        withinMemoryShare =
+                memUsed <= stats.getMaxDataSize() / 100 * settings.memoryShare;
+    }
+    return collectionEvictionStates
+            .emplace(cid,
+                     CollectionEvictionState{settings.priority,
+                                             withinMemoryShare})
+            .first->second;
+}
+
 void PagingVisitor::setUpHashBucketVisit() {
     // Grab a locked ReadHandle
     readHandle = currentBucket->lockCollections();
@@ -21,10 +21,13 @@
 #include "hash_table.h"
 #include "item_eviction.h"
 #include "item_pager.h"
+#include "stats.h"
 #include "vb_visitors.h"
 
 #include <atomic>
 #include <list>
+#include <optional>
+#include <unordered_map>
 
 class EPStats;
 class Item;
@@ -108,6 +111,13 @@ public:
         return ejected;
     }
 
+    /**
+     * How much colder (Low) or hotter (High) than their frequency counter
+     * the items of collections with a non-Normal eviction priority are
+     * considered.
+     */
+    static constexpr uint8_t EvictionPriorityFreqCounterBias = 16;
+
 protected:
     // Protected for testing purposes
     // Holds the data structures used during the selection of documents to
@@ -129,6 +139,22 @@ protected:
     uint64_t ageThreshold;
 
 private:
+    /// How the items of a collection are treated in the current vbucket
+    struct CollectionEvictionState {
+        Collections::EvictionPriority priority;
+        /// The collection uses no more than its memory share, so none of
+        /// its items are evicted
+        bool withinMemoryShare;
+    };
+
+    /**
+     * @return the eviction state of the collection; looked up from the
+     *         vbucket's manifest (under the readHandle) and cached for the
+     *         rest of the vbucket
+     */
+    const CollectionEvictionState& getCollectionEvictionState(
+            CollectionID cid);
+
     // Removes checkpoints that are both closed and unreferenced, thereby
     // freeing the associated memory.
     // @param vb  The vbucket whose eligible checkpoints are removed from.
@@ -174,4 +200,13 @@ private:
     // The VB::Manifest read handle that we use to lock around HashBucket
     // visits. Will contain a nullptr if we aren't currently locking anything.
     Collections::VB::ReadHandle readHandle;
+
+    // The eviction state of the collections seen in the current vbucket
+    std::unordered_map<CollectionID, CollectionEvictionState>
+            collectionEvictionStates;
+
+    // The memory usage of all collections, fetched at most once per vbucket
+    // and only if a collection has a memory share
+    std::optional<std::unordered_map<CollectionID, CollectionMemStats>>
+            collectionMemStats;
 };
@@ -56,6 +56,10 @@ EPStats::EPStats()
       dirtyAge(0),
       dirtyAgeHighWat(0),
       commit_time(0),
+      flusherBatchSize(0),
+      flusherPacingDelay(0),
+      flusherBatchSizeIncreases(0),
+      flusherBatchSizeDecreases(0),
       vbucketDeletions(0),
       vbucketDeletionFail(0),
       mem_low_wat(0),
@@ -71,6 +75,7 @@ EPStats::EPStats()
       freqDecayerRuns(0),
       itemsExpelledFromCheckpoints(0),
       itemsRemovedFromCheckpoints(0),
+      dcpCursorBatchesShared(0),
       numValueEjects(0),
       numFailedEjects(0),
       numNotMyVBuckets(0),
@@ -84,6 +89,7 @@ EPStats::EPStats()
       pendingCompactions(0),
       bg_fetched(0),
       bg_meta_fetched(0),
+      bgFetchNotAdmitted(0),
       numRemainingBgItems(0),
       numRemainingBgJobs(0),
       bgNumOperations(0),
@@ -219,24 +225,45 @@ size_t EPStats::getNumItem() const {
     return std::max(int64_t(0), result);
 }
 
+CollectionMemStats& CollectionMemStats::operator+=(
+        const CollectionMemStats& other) {
+    memUsed += other.memUsed;
+    numItems += other.numItems;
+    numNonResident += other.numNonResident;
+    return *this;
+}
+
+size_t CollectionMemStats::getResidentRatio() const {
+    if (numItems <= 0) {
+        return 100;
+    }
+    const auto resident =
+            std::clamp(numItems - numNonResident, int64_t(0), numItems);
+    return size_t(resident * 100 / numItems);
+}
+
 size_t EPStats::getCollectionMemUsed(CollectionID cid) const {
-    size_t result = 0;
+    return getCollectionMemStats(cid).memUsed;
+}
+
+CollectionMemStats EPStats::getCollectionMemStats(CollectionID cid) const {
+    CollectionMemStats result;
     for (const auto& core : coreLocal) {
-        auto collectionMemUsed = core->collectionMemUsed.lock();
-        auto itr = collectionMemUsed->find(cid);
-        if (itr != collectionMemUsed->end()) {
+        auto collectionMemStats = core->collectionMemStats.lock();
+        auto itr = collectionMemStats->find(cid);
+        if (itr != collectionMemStats->end()) {
             result += itr->second;
         }
     }
     return result;
 }
 
-std::unordered_map<CollectionID, size_t> EPStats::getAllCollectionsMemUsed()
-        const {
-    std::unordered_map<CollectionID, size_t> result;
+std::unordered_map<CollectionID, CollectionMemStats>
+EPStats::getAllCollectionsMemStats() const {
+    std::unordered_map<CollectionID, CollectionMemStats> result;
     for (const auto& core : coreLocal) {
-        auto collectionMemUsed = core->collectionMemUsed.lock();
-        for (auto& pair : *collectionMemUsed) {
+        auto collectionMemStats = core->collectionMemStats.lock();
+        for (auto& pair : *collectionMemStats) {
             result[pair.first] += pair.second;
         }
     }
@@ -245,13 +272,13 @@ std::unordered_map<CollectionID, size_t> EPStats::getAllCollectionsMemUsed()
 
 void EPStats::trackCollectionStats(CollectionID cid) {
     for (auto& core : coreLocal) {
-        core->collectionMemUsed.lock()->emplace(cid, 0);
+        core->collectionMemStats.lock()->emplace(cid, CollectionMemStats{});
     }
 }
 
 void EPStats::dropCollectionStats(CollectionID cid) {
     for (auto& core : coreLocal) {
-        core->collectionMemUsed.lock()->erase(cid);
+        core->collectionMemStats.lock()->erase(cid);
     }
 }
 
@@ -272,6 +299,8 @@ void EPStats::reset() {
     dirtyAge.store(0);
     dirtyAgeHighWat.store(0);
     commit_time.store(0);
+    flusherBatchSizeIncreases.store(0);
+    flusherBatchSizeDecreases.store(0);
     cursorsDropped.store(0);
     cursorMemoryFreed.store(0);
     pagerRuns.store(0);
@@ -279,10 +308,12 @@ void EPStats::reset() {
     freqDecayerRuns.store(0);
     itemsExpelledFromCheckpoints.store(0);
     itemsRemovedFromCheckpoints.store(0);
+    dcpCursorBatchesShared.store(0);
     numValueEjects.store(0);
     numFailedEjects.store(0);
     numNotMyVBuckets.store(0);
     bg_fetched.store(0);
+    bgFetchNotAdmitted.store(0);
     bgNumOperations.store(0);
     bgWait.store(0);
     bgLoad.store(0);
@@ -43,6 +43,25 @@ constexpr bool GlobalNewDeleteIsOurs = false;
 constexpr bool GlobalNewDeleteIsOurs = true;
 #endif
 
+/**
+ * The memory usage and residency tracked for a collection, across all of the
+ * bucket's vbuckets.
+ */
+struct CollectionMemStats {
+    CollectionMemStats& operator+=(const CollectionMemStats& other);
+
+    /// @return the percentage of the collection's items which are resident
+    size_t getResidentRatio() const;
+
+    /// Memory used by the collection's StoredValues
+    size_t memUsed{0};
+    /// Number of (non-deleted) items of the collection in the HashTables.
+    /// Signed as the core-local parts may be negative.
+    int64_t numItems{0};
+    /// Number of those items whose value is not resident
+    int64_t numNonResident{0};
+};
+
 /**
  * Core-local statistics
  *
@@ -55,15 +74,17 @@ constexpr bool GlobalNewDeleteIsOurs = true;
 class CoreLocalStats {
 public:
     /**
-     * Map of collection id to the memory usage tracked for that collection.
+     * Map of collection id to the memory usage (and residency) tracked for
+     * that collection.
      *
      folly::AtomicHashMap would avoid locking here but is unsuitable - it has a
      max capacity, and erased elements still count towards that capacity. It
      would either need to be grossly oversized, or would eventually be filled by
      collection creation/deletions.
      */
-    folly::Synchronized<std::unordered_map<CollectionID, size_t>, std::mutex>
-            collectionMemUsed;
+    folly::Synchronized<std::unordered_map<CollectionID, CollectionMemStats>,
+                        std::mutex>
+            collectionMemStats;
 
     // Thread-safe type for counting occurances of discrete,
     // non-negative entities (# events, sizes).  Relaxed memory
@@ -181,8 +202,12 @@ public:
     /// @returns total size of stored objects for a single collection.
     size_t getCollectionMemUsed(CollectionID cid) const;
 
-    /// @returns total size of stored objects for each existing collection.
-    std::unordered_map<CollectionID, size_t> getAllCollectionsMemUsed() const;
+    /// @returns memory usage and residency of a single collection.
+    CollectionMemStats getCollectionMemStats(CollectionID cid) const;
+
+    /// @returns memory usage and residency of each existing collection.
+    std::unordered_map<CollectionID, CollectionMemStats>
+    getAllCollectionsMemStats() const;
 
     /**
      * Used when adding a collection.
@@ -290,6 +315,16 @@ public:
     std::atomic<rel_time_t> dirtyAgeHighWat;
     //! Amount of time spent in the commit phase.
     std::atomic<rel_time_t> commit_time;
+    //! Current (approximate) flush-batch size chosen by the
+    //! FlushBatchController
+    std::atomic<size_t> flusherBatchSize;
+    //! Current delay (in microseconds) between flush-batches chosen by the
+    //! FlushBatchController
+    std::atomic<size_t> flusherPacingDelay;
+    //! Number of times the FlushBatchController increased the batch size
+    Counter flusherBatchSizeIncreases;
+    //! Number of times the FlushBatchController decreased the batch size
+    Counter flusherBatchSizeDecreases;
     //! Number of times we deleted a vbucket.
     Counter vbucketDeletions;
     //! Number of times we failed to delete a vbucket.
@@ -323,6 +358,9 @@ public:
     Counter itemsExpelledFromCheckpoints;
     //! Number of items removed from closed unreferenced checkpoints.
     Counter itemsRemovedFromCheckpoints;
+    //! Number of times a DCP cursor was given the items another cursor read
+    //! from the same position, instead of reading the checkpoints itself
+    Counter dcpCursorBatchesShared;
     //! Number of times a value is ejected
     Counter numValueEjects;
     //! Number of times a value could not be ejected
@@ -365,6 +403,9 @@ public:
     Counter bg_fetched;
     //! Number of times meta background fetches occurred.
     Counter bg_meta_fetched;
+    //! Number of background fetched values which were not admitted to the
+    //! HashTable normally (see bgfetch_admission_control)
+    Counter bgFetchNotAdmitted;
     //! Number of remaining bg fetch items
     Counter numRemainingBgItems;
     //! Number of remaining bg fetch jobs.
@@ -17,16 +17,19 @@
 
 #include "stored-value.h"
 
+#include "deferred_reclamation.h"
 #include "ep_time.h"
 #include "item.h"
 #include "objectregistry.h"
 #include "stats.h"
 #include "systemevent_factory.h"
+#include "zstd_dictionary.h"
 
 #include <platform/cb_malloc.h>
 #include <platform/compress.h>
 
 #include <collections/vbucket_manifest.h>
+#include <logtags.h>
 #include <mcbp/protocol/unsigned_leb128.h>
 #include <nlohmann/json.hpp>
 #include <sstream>
@@ -55,6 +58,7 @@ StoredValue::StoredValue(const Item& itm,
     setOrdered(isOrdered);
     setResident(!isTempItem());
     setStale(false);
+    setZstdCompressed(false);
     setCommitted(itm.getCommitted());
     setAge(0);
     // dirty initialised below
@@ -100,6 +104,7 @@ StoredValue::StoredValue(const StoredValue& other, UniquePtr n, EPStats& stats)
     setOrdered(other.isOrdered());
     setResident(other.isResident());
     setStale(false);
+    setZstdCompressed(other.isZstdCompressed());
     setCommitted(other.getCommitted());
     setAge(0);
     // Placement-new the key which lives in memory directly after this
@@ -141,7 +146,9 @@ void StoredValue::restoreValue(const Item& itm) {
     auto freq = itm.getFreqCounterValue();
     auto age = getAge();
 
+    retireValue();
     value = itm.getValue();
+    setZstdCompressed(false);
 
     setFreqCounterValue(freq);
     setCommitted(itm.getCommitted());
@@ -173,9 +180,32 @@ size_t StoredValue::uncompressedValuelen() const {
                 cb::compression::Algorithm::Snappy,
                 {value->getData(), value->valueSize()});
     }
+    if (isZstdCompressed()) {
+        return ZstdDictionary::getUncompressedLength(
+                {value->getData(), value->valueSize()});
+    }
     return valuelen();
 }
 
+value_t StoredValue::getDecodedValue() const {
+    if (!value || !isZstdCompressed()) {
+        return value;
+    }
+    const std::string_view deflated{value->getData(), value->valueSize()};
+    value_t inflated{
+            Blob::New(ZstdDictionary::getUncompressedLength(deflated))};
+    if (!ZstdDictionary::decompressWithAny(
+                deflated,
+                {const_cast<char*>(inflated->getData()),
+                 inflated->valueSize()})) {
+        throw std::runtime_error(
+                "StoredValue::getDecodedValue: Failed to decompress value "
+                "of " +
+                cb::UserDataView(getKey().to_string()).getSanitizedValue());
+    }
+    return inflated;
+}
+
 bool StoredValue::del(DeleteSource delSource) {
     if (isOrdered()) {
         return static_cast<OrderedStoredValue*>(this)->deleteImpl(delSource);
@@ -239,14 +269,34 @@ std::unique_ptr<Item> StoredValue::toItemAbort(Vbid vbid) const {
 void StoredValue::reallocate() {
     // Allocate a new Blob for this stored value; copy the existing Blob to
     // the new one and free the old.
+    const auto zstdCompressed = isZstdCompressed();
     replaceValue(std::unique_ptr<Blob>{Blob::Copy(*value)});
+    setZstdCompressed(zstdCompressed);
 }
 
 void StoredValue::Deleter::operator()(StoredValue* val) {
-    if (val->isOrdered()) {
-        delete static_cast<OrderedStoredValue*>(val);
+    const auto free = [](StoredValue* sv) {
+        if (sv->isOrdered()) {
+            delete static_cast<OrderedStoredValue*>(sv);
+        } else {
+            delete sv;
+        }
+    };
+    // StoredValues of an optimistically read HashTable may be read without
+    // the HashTable lock held; defer the free until such readers finished.
+    if (val->isOptimisticallyRead()) {
+        DeferredReclamation::retire(val, free);
     } else {
-        delete val;
+        free(val);
+    }
+}
+
+void StoredValue::retireValue() {
+    if (isOptimisticallyRead() && value) {
+        // Keep a reference to the value (and so the Blob) until optimistic
+        // readers which may have loaded it have finished.
+        DeferredReclamation::retire(new value_t(value),
+                                    [](value_t* v) { delete v; });
     }
 }
 
@@ -314,7 +364,7 @@ std::unique_ptr<Item> StoredValue::toItemBase(Vbid vbid,
             getKey(),
             getFlags(),
             getExptime(),
-            includeValue == IncludeValue::Yes ? value : value_t{},
+            includeValue == IncludeValue::Yes ? getDecodedValue() : value_t{},
             datatype,
             hideLockedCas == HideLockedCas::Yes ? static_cast<uint64_t>(-1)
                                                 : getCas(),
@@ -361,7 +411,7 @@ void StoredValue::setValueImpl(const Item& itm) {
 }
 
 bool StoredValue::compressValue() {
-    if (!mcbp::datatype::is_snappy(datatype)) {
+    if (!mcbp::datatype::is_snappy(datatype) && !isZstdCompressed()) {
         // Attempt compression only if datatype indicates
         // that the value is not compressed already
         cb::compression::Buffer deflated;
@@ -391,6 +441,13 @@ void StoredValue::storeCompressedBuffer(std::string_view deflated) {
     replaceValue(std::move(data));
 }
 
+void StoredValue::storeZstdCompressedBuffer(std::string_view deflated) {
+    std::unique_ptr<Blob> data(Blob::New(deflated.data(), deflated.size()));
+    datatype &= ~PROTOCOL_BINARY_DATATYPE_SNAPPY;
+    replaceValue(std::move(data));
+    setZstdCompressed(true);
+}
+
 /**
  * Get an item_info from the StoredValue
  */
@@ -409,7 +466,9 @@ std::optional<item_info> StoredValue::getItemInfo(uint64_t vbuuid) const {
     info.datatype = datatype;
     info.document_state =
             isDeleted() ? DocumentState::Deleted : DocumentState::Alive;
-    if (getValue()) {
+    // A value compressed with a ZstdDictionary can't be exposed in place;
+    // the info then only describes the document's metadata.
+    if (getValue() && !isZstdCompressed()) {
         info.value[0].iov_base = const_cast<char*>(getValue()->getData());
         info.value[0].iov_len = getValue()->valueSize();
     }
@@ -513,7 +572,11 @@ std::ostream& operator<<(std::ostream& os, const StoredValue& sv) {
 
     // datatype: XCJ
     os << (mcbp::datatype::is_xattr(sv.getDatatype()) ? 'X' : '.');
-    os << (mcbp::datatype::is_snappy(sv.getDatatype()) ? 'C' : '.');
+    if (mcbp::datatype::is_snappy(sv.getDatatype())) {
+        os << 'C';
+    } else {
+        os << (sv.isZstdCompressed() ? 'Z' : '.');
+    }
     os << (mcbp::datatype::is_json(sv.getDatatype()) ? 'J' : '.');
     os << ' ';
 
@@ -174,6 +174,41 @@ public:
      */
     void storeCompressedBuffer(std::string_view deflated);
 
+    /**
+     * Replace the existing value with the given buffer compressed with a
+     * ZstdDictionary. The value is decompressed whenever it is read (see
+     * getDecodedValue()), so the datatype is that of the uncompressed value;
+     * i.e. Snappy is cleared.
+     *
+     * @param deflated the input buffer holding the uncompressed value
+     *        compressed with a ZstdDictionary
+     */
+    void storeZstdCompressedBuffer(std::string_view deflated);
+
+    /**
+     * @return true if the value is compressed with a ZstdDictionary (which
+     *         only the engine knows about).
+     */
+    bool isZstdCompressed() const {
+        return bits.test(zstdIndex);
+    }
+
+    /**
+     * @return true if this StoredValue is (or was) linked into a HashTable
+     *         which permits optimistic (lock-free) reads; it and its value
+     *         are then only freed after an RCU grace period (see
+     *         DeferredReclamation).
+     */
+    bool isOptimisticallyRead() const {
+        return bits.test(optimisticIndex);
+    }
+
+    /// Mark this StoredValue as linked into an optimistically read
+    /// HashTable; cannot be undone.
+    void setOptimisticallyRead() {
+        bits.set(optimisticIndex, true);
+    }
+
     // Custom deleter for StoredValue objects.
     struct Deleter {
         void operator()(StoredValue* val);
@@ -225,7 +260,8 @@ public:
      *                  value exists but has zero length
      */
     bool isCompressible() {
-        if (mcbp::datatype::is_snappy(datatype) || !valuelen()) {
+        if (mcbp::datatype::is_snappy(datatype) || isZstdCompressed() ||
+            !valuelen()) {
             return false;
         }
         return value->isCompressible();
@@ -277,11 +313,19 @@ public:
 
     /**
      * Get this item's value.
+     * Note: this is the value as stored, which may be compressed with a
+     * ZstdDictionary; use getDecodedValue() if the value is to be read.
      */
     const value_t &getValue() const {
         return value;
     }
 
+    /**
+     * Get this item's value as it was set; i.e. decompressed if the value is
+     * compressed with a ZstdDictionary, otherwise the same as getValue().
+     */
+    value_t getDecodedValue() const;
+
     /**
      * Get the expiration time of this item.
      *
@@ -563,8 +607,10 @@ public:
      */
     void resetValue() {
         auto age = getAge();
+        retireValue();
         value.reset();
         setAge(age);
+        setZstdCompressed(false);
     }
 
     /**
@@ -575,7 +621,9 @@ public:
     void replaceValue(std::unique_ptr<Blob> data) {
         // Maintain the tag
         auto tag = getValueTag();
+        retireValue();
         value.reset({data.release(), tag.raw});
+        setZstdCompressed(false);
     }
 
     /**
@@ -585,8 +633,10 @@ public:
     void replaceValue(const value_t& value) {
         // Maintain the tag
         auto tag = getValueTag();
+        retireValue();
         this->value = value;
         setValueTag(tag);
+        setZstdCompressed(false);
     }
 
     /**
@@ -682,6 +732,16 @@ public:
         return chain_next_or_replacement;
     }
 
+    /**
+     * Returns the next StoredValue in the hash chain, *without* checking if
+     * this StoredValue is stale. Only for use by optimistic (lock-free)
+     * HashTable readers, which validate the chain they walked afterwards
+     * and hence tolerate observing a StoredValue mid-modification.
+     */
+    const StoredValue* getNextUnchecked() const {
+        return chain_next_or_replacement.get().get();
+    }
+
     /**
      * The age is get/set via the fragmenter
      * @return the age of the StoredValue since it was allocated
@@ -890,6 +950,13 @@ protected:
      */
     void setValueImpl(const Item& itm);
 
+    /**
+     * Called before the value is replaced or discarded. If this StoredValue
+     * may be read optimistically, hands a reference to the current value to
+     * DeferredReclamation so it outlives any such readers.
+     */
+    void retireValue();
+
     // name clash with public OSV isStale
     bool isStalePriv() const {
         return bits.test(staleIndex);
@@ -919,6 +986,10 @@ protected:
         bits.set(dirtyIndex, value);
     }
 
+    void setZstdCompressed(bool value) {
+        bits.set(zstdIndex, value);
+    }
+
     void setDeletionSource(DeleteSource delSource) {
         deletionSource = static_cast<uint8_t>(delSource);
     }
@@ -1001,14 +1072,16 @@ protected:
      */
     static constexpr size_t dirtyIndex = 0;
     static constexpr size_t deletedIndex = 1;
-    // Bit 2 of bits is currently unused and may be used for new purposes.
-    // static constexpr size_t unused = 2;
+    // zstd := true if the value is compressed with a ZstdDictionary
+    static constexpr size_t zstdIndex = 2;
     // ordered := true if this is an instance of OrderedStoredValue
     static constexpr size_t orderedIndex = 3;
-    // Bit 4 and 5 of bits are currently unused and may be used for new purposes
-    // These bits were used for nru value but this was replaced by
-    // frequencyCounter stored in the tag of value
-    // static constexpr size_t unused = 4;
+    // optimistic := true if linked into a HashTable permitting optimistic
+    //               reads (see isOptimisticallyRead).
+    static constexpr size_t optimisticIndex = 4;
+    // Bit 5 of bits is currently unused and may be used for new purposes
+    // (it was used for nru value but this was replaced by frequencyCounter
+    // stored in the tag of value)
     // static constexpr size_t unused = 5;
     static constexpr size_t residentIndex = 6;
     // stale := Indicates if a newer instance of the item is added. Logically
@@ -1131,6 +1204,10 @@ public:
         this->prepareSeqno = prepareSeqno;
     }
 
+    int64_t getPrepareSeqno() const {
+        return prepareSeqno;
+    }
+
 protected:
     SerialisedDocKey* key() {
         return reinterpret_cast<SerialisedDocKey*>(this + 1);
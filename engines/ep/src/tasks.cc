@@ -34,6 +34,23 @@ bool FlusherTask::run() {
     return flusher->step(this);
 }
 
+VBucketFlushTask::~VBucketFlushTask() {
+    if (ran) {
+        return;
+    }
+    if (auto f = flusher.lock()) {
+        f->cancelConcurrentFlush(vbid);
+    }
+}
+
+bool VBucketFlushTask::run() {
+    if (auto f = flusher.lock()) {
+        f->flushVBConcurrently(vbid);
+    }
+    ran = true;
+    return false;
+}
+
 CompactTask::CompactTask(EPBucket& bucket,
                          Vbid vbid,
                          std::optional<CompactionConfig> config,
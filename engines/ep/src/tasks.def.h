@@ -36,6 +36,7 @@ TASK(WarmupCreateVBuckets, READER_TASK_IDX, 0)
 TASK(WarmupLoadingCollectionCounts, READER_TASK_IDX, 0)
 TASK(WarmupEstimateDatabaseItemCount, READER_TASK_IDX, 0)
 TASK(WarmupLoadPreparedSyncWrites, READER_TASK_IDX, 0)
+TASK(WarmupLoadingBloomFilters, READER_TASK_IDX, 0)
 TASK(WarmupPopulateVBucketMap, READER_TASK_IDX, 0)
 TASK(WarmupKeyDump, READER_TASK_IDX, 0)
 TASK(WarmupCheckforAccessLog, READER_TASK_IDX, 0)
@@ -56,6 +57,7 @@ TASK(BackfillManagerTask, AUXIO_TASK_IDX, 4)
 TASK(RollbackTask, WRITER_TASK_IDX, 1)
 TASK(CompactVBucketTask, WRITER_TASK_IDX, 2)
 TASK(FlusherTask, WRITER_TASK_IDX, 5)
+TASK(VBucketFlushTask, WRITER_TASK_IDX, 5)
 TASK(StatSnap, WRITER_TASK_IDX, 9)
 
 // Non-IO tasks
@@ -23,6 +23,7 @@
 
 #include <array>
 #include <chrono>
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -65,6 +66,44 @@ private:
     std::string desc;
 };
 
+/**
+ * A task for persisting the items of a single vBucket; scheduled by a shard's
+ * Flusher to flush a number of its vBuckets concurrently.
+ */
+class VBucketFlushTask : public GlobalTask {
+public:
+    VBucketFlushTask(EventuallyPersistentEngine* e,
+                     std::weak_ptr<Flusher> f,
+                     Vbid vbid)
+        : GlobalTask(e, TaskId::VBucketFlushTask, 0, true),
+          flusher(std::move(f)),
+          vbid(vbid) {
+    }
+
+    /**
+     * If the task never ran (it was cancelled, e.g. by the bucket's tasks
+     * being unregistered) hands the vBucket back to the flusher.
+     */
+    ~VBucketFlushTask() override;
+
+    bool run() override;
+
+    std::string getDescription() override {
+        return "Flushing " + vbid.to_string();
+    }
+
+    std::chrono::microseconds maxExpectedDuration() override {
+        // A single flush-batch of the FlusherTask.
+        return std::chrono::seconds(1);
+    }
+
+private:
+    // The flusher may be destroyed before the task (the shard owns it)
+    const std::weak_ptr<Flusher> flusher;
+    const Vbid vbid;
+    bool ran = false;
+};
+
 /**
  * A task for compacting a vbucket db file
  */
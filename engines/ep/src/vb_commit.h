@@ -22,6 +22,8 @@
 
 #include "libcouchstore/couch_db.h"
 
+#include <functional>
+
 namespace Collections::VB {
 class Manifest;
 } // namespace Collections::VB
@@ -59,6 +61,14 @@ public:
      * Allows EP to take decisions on how to react to the failure.
      */
     SysErrorCallback sysErrorCallback;
+
+    /**
+     * Executed at KVStore::commit once the flush-batch is written but before
+     * it is synced to disk, if the KVStore may begin its next transaction
+     * while this one is synced (couchstore_group_commit).
+     * Allows EP to start flushing another vBucket meanwhile.
+     */
+    std::function<void()> writeCompleteCallback;
 };
 
 } // end namespace VB
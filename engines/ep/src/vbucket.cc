@@ -176,7 +176,18 @@ VBucket::VBucket(Vbid i,
                  bool mightContainXattrs,
                  const nlohmann::json* replTopology,
                  uint64_t maxVisibleSeqno)
-    : ht(st, std::move(valFact), config.getHtSize(), config.getHtLocks()),
+    : ht(st,
+         std::move(valFact),
+         config.getHtSize(),
+         config.getHtLocks(),
+         config.getHtReadMode() == "optimistic"
+                 ? HashTable::ReadMode::Optimistic
+                 : HashTable::ReadMode::Locked,
+         config.getHtIndexType() == "tagged" ? HashTable::IndexType::Tagged
+                                             : HashTable::IndexType::Chained,
+         config.getHtResizeMode() == "incremental"
+                 ? HashTable::ResizeMode::Incremental
+                 : HashTable::ResizeMode::Blocking),
       failovers(std::move(table)),
       opsCreate(0),
       opsDelete(0),
@@ -227,6 +238,11 @@ VBucket::VBucket(Vbid i,
       syncWriteCompleteCb(std::move(syncWriteCb)),
       seqnoAckCb(std::move(seqnoAckCb)),
       mayContainXattrs(mightContainXattrs) {
+    this->manifest->setReadMode(
+            config.getCollectionsReadMode() == "lock_free"
+                    ? Collections::VB::Manifest::ReadMode::LockFree
+                    : Collections::VB::Manifest::ReadMode::Locked);
+
     if (config.getConflictResolutionType() == "seqno") {
         conflictResolver = std::make_unique<RevisionSeqnoResolution>();
     } else {
@@ -391,8 +407,7 @@ VBucket::ItemsToFlush VBucket::getItemsToPersist(size_t approxLimit) {
     ItemsToFlush result;
 
     if (approxLimit == 0) {
-        result.moreAvailable =
-                (checkpointManager->getNumItemsForPersistence() > 0);
+        result.moreAvailable = checkpointManager->hasItemsForPersistence();
         return result;
     }
 
@@ -1061,32 +1076,45 @@ bool VBucket::isResidentRatioUnderThreshold(float threshold) {
     }
 }
 
-void VBucket::createFilter(size_t key_count, double probability) {
+void VBucket::createFilter(size_t key_count,
+                           double probability,
+                           BloomFilter::Type type) {
     // Create the actual bloom filter upon vbucket creation during
     // scenarios:
     //      - Bucket creation
     //      - Rebalance
     LockHolder lh(bfMutex);
     if (bFilter == nullptr && tempFilter == nullptr) {
-        bFilter = std::make_unique<BloomFilter>(key_count, probability,
-                                        BFILTER_ENABLED);
+        bFilter = std::make_unique<BloomFilter>(
+                key_count, probability, BFILTER_ENABLED, type);
     } else {
         EP_LOG_WARN("({}) Bloom filter / Temp filter already exist!", id);
     }
 }
 
-void VBucket::initTempFilter(size_t key_count, double probability) {
+void VBucket::initTempFilter(size_t key_count,
+                             double probability,
+                             BloomFilter::Type type) {
     // Create a temp bloom filter with status as COMPACTING,
     // if the main filter is found to exist, set its state to
     // COMPACTING as well.
     LockHolder lh(bfMutex);
-    tempFilter = std::make_unique<BloomFilter>(key_count, probability,
-                                     BFILTER_COMPACTING);
+    tempFilter = std::make_unique<BloomFilter>(
+            key_count, probability, BFILTER_COMPACTING, type);
     if (bFilter) {
         bFilter->setStatus(BFILTER_COMPACTING);
     }
 }
 
+void VBucket::restoreFilter(std::unique_ptr<BloomFilter> filter) {
+    LockHolder lh(bfMutex);
+    if (bFilter == nullptr && tempFilter == nullptr) {
+        bFilter = std::move(filter);
+    } else {
+        EP_LOG_WARN("({}) Bloom filter / Temp filter already exist!", id);
+    }
+}
+
 void VBucket::addToFilter(const DocKey& key) {
     LockHolder lh(bfMutex);
     if (bFilter) {
@@ -1637,7 +1665,7 @@ cb::engine_errc VBucket::set(
             // full eviction.
             if (v) {
                 // temp item is already created. Simply schedule a bg fetch job
-                hbl.getHTLock().unlock();
+                hbl.unlock();
                 bgFetch(itm.getKey(), cookie, engine, true);
                 return cb::engine_errc::would_block;
             }
@@ -1752,7 +1780,7 @@ cb::engine_errc VBucket::replace(
                 break;
             case MutationStatus::NeedBgFetch: {
                 // temp item is already created. Simply schedule a bg fetch job
-                hbl.getHTLock().unlock();
+                hbl.unlock();
                 bgFetch(itm.getKey(), cookie, engine, true);
                 ret = cb::engine_errc::would_block;
                 break;
@@ -1908,7 +1936,7 @@ cb::engine_errc VBucket::prepare(
         }
         // we unlock ht lock here because we want to avoid potential lock
         // inversions arising from notifyNewSeqno() call
-        hbl.getHTLock().unlock();
+        hbl.unlock();
         notifyNewSeqno(*notifyCtx);
         doCollectionsStats(cHandle, *notifyCtx);
     } break;
@@ -1918,7 +1946,7 @@ cb::engine_errc VBucket::prepare(
     case MutationStatus::NeedBgFetch: { // CAS operation with non-resident item
         // + full eviction.
         if (v) { // temp item is already created. Simply schedule a
-            hbl.getHTLock().unlock(); // bg fetch job.
+            hbl.unlock(); // bg fetch job.
             bgFetch(itm.getKey(), cookie, engine, true);
             return cb::engine_errc::would_block;
         }
@@ -2047,7 +2075,7 @@ cb::engine_errc VBucket::setWithMeta(
         }
         // we unlock ht lock here because we want to avoid potential lock
         // inversions arising from notifyNewSeqno() call
-        hbl.getHTLock().unlock();
+        hbl.unlock();
         notifyNewSeqno(*notifyCtx);
         doCollectionsStats(cHandle, *notifyCtx);
     } break;
@@ -2057,7 +2085,7 @@ cb::engine_errc VBucket::setWithMeta(
     case MutationStatus::NeedBgFetch: { // CAS operation with non-resident item
         // + full eviction.
         if (v) { // temp item is already created. Simply schedule a
-            hbl.getHTLock().unlock(); // bg fetch job.
+            hbl.unlock(); // bg fetch job.
             bgFetch(itm.getKey(), cookie, engine, true);
             return cb::engine_errc::would_block;
         }
@@ -2121,7 +2149,7 @@ cb::engine_errc VBucket::deleteItem(
                         return cb::engine_errc::no_such_key;
                     }
                 } else if (htRes.committed->isTempInitialItem()) {
-                    hbl.getHTLock().unlock();
+                    hbl.unlock();
                     bgFetch(cHandle.getKey(), cookie, engine, true);
                     return cb::engine_errc::would_block;
                 } else { // Non-existent or deleted key.
@@ -2387,13 +2415,13 @@ cb::engine_errc VBucket::deleteWithMeta(
         }
         // we unlock ht lock here because we want to avoid potential lock
         // inversions arising from notifyNewSeqno() call
-        hbl.getHTLock().unlock();
+        hbl.unlock();
         notifyNewSeqno(*notifyCtx);
         doCollectionsStats(cHandle, *notifyCtx);
         break;
     }
     case MutationStatus::NeedBgFetch:
-        hbl.getHTLock().unlock();
+        hbl.unlock();
         bgFetch(key, cookie, engine, metaBgFetch);
         return cb::engine_errc::would_block;
 
@@ -2464,7 +2492,7 @@ void VBucket::deleteExpiredItem(const Item& it,
                     processExpiredItem(htRes, cHandle, source);
             // we unlock ht lock here because we want to avoid potential lock
             // inversions arising from notifyNewSeqno() call
-            hbl.getHTLock().unlock();
+            hbl.unlock();
             notifyNewSeqno(notifyCtx);
             doCollectionsStats(cHandle, notifyCtx);
         }
@@ -2514,7 +2542,7 @@ void VBucket::deleteExpiredItem(const Item& it,
                     processExpiredItem(htRes, cHandle, source);
             // we unlock ht lock here because we want to avoid potential
             // lock inversions arising from notifyNewSeqno() call
-            hbl.getHTLock().unlock();
+            hbl.unlock();
             notifyNewSeqno(notifyCtx);
             doCollectionsStats(cHandle, notifyCtx);
         }
@@ -2573,7 +2601,7 @@ cb::engine_errc VBucket::add(
             return addTempItemAndBGFetch(
                     hbl, itm.getKey(), cookie, engine, true);
         case AddStatus::BgFetch:
-            hbl.getHTLock().unlock();
+            hbl.unlock();
             bgFetch(itm.getKey(), cookie, engine, true);
             return cb::engine_errc::would_block;
         case AddStatus::Success:
@@ -2657,7 +2685,7 @@ std::pair<MutationStatus, GetValue> VBucket::processGetAndUpdateTtl(
             rv.item->setCas(v->getCas());
             // we unlock ht lock here because we want to avoid potential lock
             // inversions arising from notifyNewSeqno() call
-            hbl.getHTLock().unlock();
+            hbl.unlock();
             notifyNewSeqno(notifyCtx);
             doCollectionsStats(cHandle, notifyCtx);
         }
@@ -2727,6 +2755,46 @@ GetValue VBucket::getInternal(const void* cookie,
     const bool getDeletedValue = (options & GET_DELETED_VALUE);
     const bool bgFetchRequired = (options & QUEUE_BG_FETCH);
 
+    if (ht.getReadMode() == HashTable::ReadMode::Optimistic) {
+        // Attempt to serve the common case (alive, resident item) without
+        // acquiring the HashBucketLock; anything else falls through to the
+        // locked path below.
+        const auto hideLockedCas = (getKeyOnly == GetKeyOnly::No &&
+                                    (options & HIDE_LOCKED_CAS))
+                                           ? StoredValue::HideLockedCas::Yes
+                                           : StoredValue::HideLockedCas::No;
+        const auto includeValue = (getKeyOnly == GetKeyOnly::Yes)
+                                          ? StoredValue::IncludeValue::No
+                                          : StoredValue::IncludeValue::Yes;
+        auto optRes = ht.findForReadOptimistic(cHandle.getKey(),
+                                               getId(),
+                                               trackReference,
+                                               hideLockedCas,
+                                               includeValue);
+        switch (optRes.status) {
+        case HashTable::OptimisticReadResult::Status::Found: {
+            const auto seqno = optRes.item->getBySeqno();
+            if (cHandle.isLogicallyDeleted(seqno)) {
+                return GetValue();
+            }
+            if (options & TRACK_STATISTICS) {
+                opsGet++;
+            }
+            return GetValue(std::move(optRes.item),
+                            cb::engine_errc::success,
+                            seqno,
+                            false);
+        }
+        case HashTable::OptimisticReadResult::Status::NotFound:
+            if (!getDeletedValue && (eviction == EvictionPolicy::Value)) {
+                return GetValue();
+            }
+            break;
+        case HashTable::OptimisticReadResult::Status::Fallback:
+            break;
+        }
+    }
+
     auto res = fetchValidValue(WantsDeleted::Yes,
                                trackReference,
                                QueueExpired::Yes,
@@ -2917,7 +2985,7 @@ cb::engine_errc VBucket::getKeyStats(
             return cb::engine_errc::no_such_key;
         }
         if (eviction == EvictionPolicy::Full && v->isTempInitialItem()) {
-            res.lock.getHTLock().unlock();
+            res.lock.unlock();
             bgFetch(cHandle.getKey(), cookie, engine, true);
             return cb::engine_errc::would_block;
         }
@@ -3111,6 +3179,15 @@ void VBucket::_addStats(VBucketStatsDetailLevel detail,
                 c);
         addStat("ht_cache_size", ht.getCacheSize(), add_stat, c);
         addStat("ht_size", ht.getSize(), add_stat, c);
+        const auto resizeProgress = ht.getResizeProgress();
+        addStat("ht_resize_buckets_migrated",
+                resizeProgress.bucketsMigrated,
+                add_stat,
+                c);
+        addStat("ht_resize_buckets_total",
+                resizeProgress.bucketsTotal,
+                add_stat,
+                c);
         addStat("num_ejects", ht.getNumEjects(), add_stat, c);
         addStat("ops_create", opsCreate.load(), add_stat, c);
         addStat("ops_delete", opsDelete.load(), add_stat, c);
@@ -3903,14 +3980,21 @@ std::unique_ptr<Item> VBucket::pruneXattrDocument(
         StoredValue& v, const ItemMetaData& itemMeta) {
     // Need to take a copy of the value, prune it, and add it back
 
-    // Create work-space document
-    std::vector<char> workspace(
-            v.getValue()->getData(),
-            v.getValue()->getData() + v.getValue()->valueSize());
+    const auto value = v.getDecodedValue();
+    const std::string_view data{value->getData(), value->valueSize()};
 
-    // Now attach to the XATTRs in the document
-    cb::xattr::Blob xattr({workspace.data(), workspace.size()},
-                          mcbp::datatype::is_snappy(v.getDatatype()));
+    // Now attach to the XATTRs in the document. A compressed value is only
+    // read (the Blob inflates the XATTRs into a buffer of its own), otherwise
+    // create a work-space copy of just the XATTRs.
+    std::vector<char> workspace;
+    cb::xattr::Blob xattr;
+    if (mcbp::datatype::is_snappy(v.getDatatype())) {
+        xattr.assign(data, true);
+    } else {
+        workspace.assign(data.begin(),
+                         data.begin() + cb::xattr::get_body_offset(data));
+        xattr.assign({workspace.data(), workspace.size()}, false);
+    }
     xattr.prune_user_keys();
 
     auto prunedXattrs = xattr.finalize();
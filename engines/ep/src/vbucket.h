@@ -669,8 +669,18 @@ public:
     /**
      * BloomFilter operations for vbucket
      */
-    void createFilter(size_t key_count, double probability);
-    void initTempFilter(size_t key_count, double probability);
+    void createFilter(size_t key_count,
+                      double probability,
+                      BloomFilter::Type type = BloomFilter::Type::Classic);
+    void initTempFilter(size_t key_count,
+                        double probability,
+                        BloomFilter::Type type = BloomFilter::Type::Classic);
+    /**
+     * Install a bloom filter previously built elsewhere (e.g. loaded from
+     * disk at warmup) as this vBucket's main filter. Ignored if a filter
+     * already exists.
+     */
+    void restoreFilter(std::unique_ptr<BloomFilter> filter);
     void addToFilter(const DocKey& key);
     virtual bool maybeKeyExistsInFilter(const DocKey& key);
     bool isTempFilterAvailable();
@@ -114,6 +114,25 @@ private:
     WarmupState::State warmupState;
 };
 
+/**
+ * Helper class which adds the key of each committed item scanned to a
+ * bloom filter.
+ */
+class AddToBloomFilterCallback : public StatusCallback<GetValue> {
+public:
+    explicit AddToBloomFilterCallback(BloomFilter& filter) : filter(filter) {
+    }
+
+    void callback(GetValue& val) override {
+        if (val.item->isCommitted()) {
+            filter.addKey(val.item->getKey());
+        }
+    }
+
+private:
+    BloomFilter& filter;
+};
+
 class LoadValueCallback : public StatusCallback<CacheLookup> {
 public:
     LoadValueCallback(VBucketMap& vbMap, WarmupState::State warmupState)
@@ -305,6 +324,47 @@ private:
     const std::string description;
 };
 
+/**
+ * Warmup task which loads the bloom filters persisted by compaction.
+ */
+class WarmupLoadingBloomFilters : public GlobalTask {
+public:
+    WarmupLoadingBloomFilters(EPBucket& st, uint16_t shard, Warmup& warmup)
+        : GlobalTask(&st.getEPEngine(),
+                     TaskId::WarmupLoadingBloomFilters,
+                     0,
+                     false),
+          shardId(shard),
+          warmup(warmup),
+          description("Warmup - loading bloom filters: shard " +
+                      std::to_string(shardId)){};
+
+    std::string getDescription() override {
+        return description;
+    }
+
+    std::chrono::microseconds maxExpectedDuration() override {
+        // Runtime is a function of the size of the filters, plus the number
+        // of items persisted since each vBucket was last compacted.
+        return std::chrono::seconds(10);
+    }
+
+    bool run() override {
+        TRACE_EVENT1("ep-engine/task",
+                     "WarmupLoadingBloomFilters",
+                     "shard",
+                     shardId);
+        warmup.loadBloomFiltersForShard(shardId);
+        warmup.removeFromTaskSet(uid);
+        return false;
+    }
+
+private:
+    uint16_t shardId;
+    Warmup& warmup;
+    const std::string description;
+};
+
 /**
  * Warmup task which moves all warmed-up VBuckets into the bucket's vbMap
  */
@@ -624,6 +684,8 @@ const char* WarmupState::getStateDescription(State st) const {
         return "estimating database item count";
     case State::LoadPreparedSyncWrites:
         return "loading prepared SyncWrites";
+    case State::LoadingBloomFilters:
+        return "loading bloom filters";
     case State::PopulateVBucketMap:
         return "populating vbucket map";
     case State::KeyDump:
@@ -668,6 +730,9 @@ bool WarmupState::legalTransition(State to) const {
     case State::EstimateDatabaseItemCount:
         return (to == State::LoadPreparedSyncWrites);
     case State::LoadPreparedSyncWrites:
+        return (to == State::LoadingBloomFilters ||
+                to == State::PopulateVBucketMap);
+    case State::LoadingBloomFilters:
         return (to == State::PopulateVBucketMap);
     case State::PopulateVBucketMap:
         return (to == State::KeyDump || to == State::CheckForAccessLog);
@@ -1253,6 +1318,75 @@ void Warmup::loadPreparedSyncWrites(uint16_t shardId) {
                 result.preparesLoaded;
     }
 
+    if (++threadtask_count == store.vbMap.getNumShards()) {
+        if (config.isBfilterEnabled() && config.isBfilterPersist() &&
+            store.getItemEvictionPolicy() == EvictionPolicy::Full) {
+            transition(WarmupState::State::LoadingBloomFilters);
+        } else {
+            transition(WarmupState::State::PopulateVBucketMap);
+        }
+    }
+}
+
+void Warmup::scheduleLoadingBloomFilters() {
+    threadtask_count = 0;
+    for (size_t i = 0; i < store.vbMap.shards.size(); i++) {
+        ExTask task =
+                std::make_shared<WarmupLoadingBloomFilters>(store, i, *this);
+        ExecutorPool::get()->schedule(task);
+    }
+}
+
+void Warmup::loadBloomFiltersForShard(uint16_t shardId) {
+    KVStore* kvstore = store.getROUnderlyingByShard(shardId);
+    for (const auto vbid : shardVbIds[shardId]) {
+        auto itr = warmedUpVbuckets.find(vbid.get());
+        if (itr == warmedUpVbuckets.end()) {
+            continue;
+        }
+
+        auto persisted = kvstore->getPersistedBloomFilter(vbid);
+        if (!persisted) {
+            // Never compacted with bfilter_persist enabled.
+            continue;
+        }
+        auto filter =
+                BloomFilter::deserialise(persisted->filter, BFILTER_ENABLED);
+        if (!filter) {
+            EP_LOG_WARN(
+                    "Warmup::loadBloomFiltersForShard: {} ignoring malformed "
+                    "persisted bloom filter",
+                    vbid);
+            continue;
+        }
+
+        // The filter only holds the keys as of the compaction which wrote
+        // it; add everything persisted since (including deletes, which the
+        // filter must also report).
+        auto& vb = *(itr->second);
+        if (uint64_t(vb.getHighSeqno()) > persisted->highSeqno) {
+            auto ctx = kvstore->initBySeqnoScanContext(
+                    std::make_unique<AddToBloomFilterCallback>(*filter),
+                    std::make_unique<NoLookupCallback>(),
+                    vbid,
+                    persisted->highSeqno + 1,
+                    DocumentFilter::ALL_ITEMS,
+                    ValueFilter::KEYS_ONLY,
+                    SnapshotSource::Head);
+            if (!ctx || kvstore->scan(*ctx) != scan_success) {
+                EP_LOG_WARN(
+                        "Warmup::loadBloomFiltersForShard: {} failed to scan "
+                        "from seqno {}, not loading persisted bloom filter",
+                        vbid,
+                        persisted->highSeqno + 1);
+                continue;
+            }
+        }
+
+        vb.restoreFilter(std::move(filter));
+        ++bloomFiltersLoaded;
+    }
+
     if (++threadtask_count == store.vbMap.getNumShards()) {
         transition(WarmupState::State::PopulateVBucketMap);
     }
@@ -1613,6 +1747,9 @@ void Warmup::step() {
     case WarmupState::State::LoadPreparedSyncWrites:
         scheduleLoadPreparedSyncWrites();
         return;
+    case WarmupState::State::LoadingBloomFilters:
+        scheduleLoadingBloomFilters();
+        return;
     case WarmupState::State::KeyDump:
         scheduleKeyDump();
         return;
@@ -1684,6 +1821,7 @@ void Warmup::addStats(const AddStatFn& add_stat, const void* c) const {
             add_stat,
             c);
     addStat("min_item_threshold", stats.warmupNumReadCap * 100.0, add_stat, c);
+    addStat("bloom_filters_loaded", bloomFiltersLoaded.load(), add_stat, c);
 
     auto md_time = metadata.load();
     if (md_time > md_time.zero()) {
@@ -65,6 +65,7 @@ public:
         LoadingCollectionCounts,
         EstimateDatabaseItemCount,
         LoadPreparedSyncWrites,
+        LoadingBloomFilters,
         PopulateVBucketMap,
         KeyDump,
         LoadingAccessLog,
@@ -134,7 +135,14 @@ private:
  *                     V
  *          [LoadPreparedSyncWrites]
  *                     |
- *                     V
+ *           Persisted bloom filters?
+ *               /            \
+ *             Yes             No
+ *              |              |
+ *              V              |
+ *     [LoadingBloomFilters]   |
+ *              |              |
+ *              V              V
  *            [PopulateVBucketMap]
  *                     |
  *                Eviction mode?
@@ -177,6 +185,7 @@ private:
  *    LoadingCollectionCounts
  *    EstimateDatabaseItemCount
  *    LoadPreparedSyncWrites
+ *    LoadingBloomFilters
  *    PopulateVBucketMap
  *
  *  1) setVBucket requests are queued (using the EWOULDBLOCK mechanism)
@@ -343,6 +352,15 @@ private:
      */
     void loadPreparedSyncWrites(uint16_t shardId);
 
+    /**
+     * [Full-eviction only, if bfilter_persist is enabled]
+     * Loads the bloom filter persisted by the last compaction of each
+     * vBucket in the given shard, adding the keys persisted since by
+     * scanning the seqnos after the filter's, so lookups of non-existent
+     * keys can be answered without a disk read from the start.
+     */
+    void loadBloomFiltersForShard(uint16_t shardId);
+
     /**
      * Adds all warmed up vbuckets (for the shard) to the bucket's VBMap, once
      * added to the VBMap the rest of the system will be able to locate and
@@ -403,6 +421,7 @@ private:
     void scheduleLoadingCollectionCounts();
     void scheduleEstimateDatabaseItemCount();
     void scheduleLoadPreparedSyncWrites();
+    void scheduleLoadingBloomFilters();
     void schedulePopulateVBucketMap();
     void scheduleKeyDump();
     void scheduleCheckForAccessLog();
@@ -449,6 +468,7 @@ private:
     std::atomic<bool> warmupOOMFailure{false};
     std::atomic<size_t> estimatedWarmupCount{
             std::numeric_limits<size_t>::max()};
+    std::atomic<size_t> bloomFiltersLoaded{0};
 
     /// All of the cookies which need notifying when create-vbuckets is done
     std::deque<const void*> pendingCookies;
@@ -470,6 +490,7 @@ private:
     friend class WarmupLoadingCollectionCounts;
     friend class WarmupEstimateDatabaseItemCount;
     friend class WarmupLoadPreparedSyncWrites;
+    friend class WarmupLoadingBloomFilters;
     friend class WarmupPopulateVBucketMap;
     friend class WarmupKeyDump;
     friend class WarmupCheckforAccessLog;
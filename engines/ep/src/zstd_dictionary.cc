@@ -0,0 +1,295 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "zstd_dictionary.h"
+
+#include "bucket_logger.h"
+#include "objectregistry.h"
+
+#include <folly/synchronization/Rcu.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef EP_USE_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+namespace {
+/**
+ * The live dictionaries, by id. Readers (decompressWithAny()) load the
+ * current map inside a read-side critical section of a domain of its own;
+ * writers (train() and ~ZstdDictionary(), both rare) publish a modified
+ * copy and wait for a grace period before freeing the old map.
+ */
+class Registry {
+public:
+    using Map = std::unordered_map<uint32_t, const ZstdDictionary*>;
+    struct RcuTag {};
+    using RcuDomain = folly::rcu_domain<RcuTag>;
+
+    ~Registry() {
+        delete current.load();
+    }
+
+    RcuDomain& getDomain() {
+        return domain;
+    }
+
+    /// Must be called from within a read-side critical section of domain
+    const ZstdDictionary* find(uint32_t id) const {
+        const auto* map = current.load(std::memory_order_acquire);
+        auto it = map->find(id);
+        return it == map->end() ? nullptr : it->second;
+    }
+
+    /// @return false if the id is already in use
+    bool insert(uint32_t id, const ZstdDictionary* dictionary) {
+        return update([id, dictionary](Map& map) {
+            return map.emplace(id, dictionary).second;
+        });
+    }
+
+    void erase(uint32_t id, const ZstdDictionary* dictionary) {
+        update([id, dictionary](Map& map) {
+            auto it = map.find(id);
+            if (it == map.end() || it->second != dictionary) {
+                return false;
+            }
+            map.erase(it);
+            return true;
+        });
+    }
+
+private:
+    template <class Func>
+    bool update(Func func) {
+        // The registry outlives any one bucket
+        NonBucketAllocationGuard guard;
+        std::lock_guard<std::mutex> lh(writeMutex);
+        auto* old = current.load();
+        auto next = std::make_unique<Map>(*old);
+        if (!func(*next)) {
+            return false;
+        }
+        current.store(next.release(), std::memory_order_release);
+        domain.synchronize();
+        delete old;
+        return true;
+    }
+
+    RcuDomain domain;
+    std::mutex writeMutex;
+    std::atomic<const Map*> current{new Map};
+};
+
+Registry& getRegistry() {
+    // folly permits a single domain per tag
+    static Registry registry;
+    return registry;
+}
+
+#ifdef EP_USE_ZSTD
+// Compression contexts are expensive to create; keep one per thread. They
+// outlive any one bucket so don't account them to the current one.
+ZSTD_CCtx* getCompressionContext() {
+    thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> ctx{
+            nullptr, &ZSTD_freeCCtx};
+    if (!ctx) {
+        NonBucketAllocationGuard guard;
+        ctx.reset(ZSTD_createCCtx());
+    }
+    return ctx.get();
+}
+
+ZSTD_DCtx* getDecompressionContext() {
+    thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> ctx{
+            nullptr, &ZSTD_freeDCtx};
+    if (!ctx) {
+        NonBucketAllocationGuard guard;
+        ctx.reset(ZSTD_createDCtx());
+    }
+    return ctx.get();
+}
+#endif
+} // namespace
+
+std::unique_ptr<ZstdDictionary> ZstdDictionary::train(
+        const std::vector<std::string>& samples,
+        size_t dictionarySize,
+        int level) {
+#ifdef EP_USE_ZSTD
+    if (samples.size() < MinSamples) {
+        return {};
+    }
+
+    std::string buffer;
+    std::vector<size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        buffer.append(sample);
+        sizes.push_back(sample.size());
+    }
+
+    std::string dictionary(dictionarySize, '\0');
+    const auto size = ZDICT_trainFromBuffer(dictionary.data(),
+                                            dictionary.size(),
+                                            buffer.data(),
+                                            sizes.data(),
+                                            unsigned(sizes.size()));
+    if (ZDICT_isError(size)) {
+        EP_LOG_WARN(
+                "ZstdDictionary::train: Failed to train a dictionary from {} "
+                "samples: {}",
+                sizes.size(),
+                ZDICT_getErrorName(size));
+        return {};
+    }
+    dictionary.resize(size);
+
+    const auto id = ZDICT_getDictID(dictionary.data(), dictionary.size());
+    std::unique_ptr<ZstdDictionary> result(
+            new ZstdDictionary(std::move(dictionary), id, level));
+    if (!result->cdict || !result->ddict) {
+        return {};
+    }
+
+    // The id is random; in the unlikely event it is already in use the
+    // caller may simply train again.
+    if (id == 0 || !getRegistry().insert(id, result.get())) {
+        EP_LOG_INFO(
+                "ZstdDictionary::train: Dictionary id {} is not unique, "
+                "discarding the dictionary",
+                id);
+        return {};
+    }
+    return result;
+#else
+    (void)samples;
+    (void)dictionarySize;
+    (void)level;
+    return {};
+#endif
+}
+
+ZstdDictionary::ZstdDictionary(std::string dictionary, uint32_t id, int level)
+    : dictionary(std::move(dictionary)), id(id) {
+#ifdef EP_USE_ZSTD
+    cdict = ZSTD_createCDict(
+            this->dictionary.data(), this->dictionary.size(), level);
+    ddict = ZSTD_createDDict(this->dictionary.data(), this->dictionary.size());
+#else
+    (void)level;
+#endif
+}
+
+ZstdDictionary::~ZstdDictionary() {
+    // Waits for any reader which may have found this dictionary
+    getRegistry().erase(id, this);
+#ifdef EP_USE_ZSTD
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeDDict(ddict);
+#endif
+}
+
+bool ZstdDictionary::compress(std::string_view input,
+                              std::string& output) const {
+#ifdef EP_USE_ZSTD
+    output.resize(ZSTD_compressBound(input.size()));
+    const auto size = ZSTD_compress_usingCDict(getCompressionContext(),
+                                               output.data(),
+                                               output.size(),
+                                               input.data(),
+                                               input.size(),
+                                               cdict);
+    if (ZSTD_isError(size)) {
+        return false;
+    }
+    output.resize(size);
+    return true;
+#else
+    (void)input;
+    (void)output;
+    return false;
+#endif
+}
+
+bool ZstdDictionary::decompress(std::string_view input,
+                                cb::char_buffer output) const {
+#ifdef EP_USE_ZSTD
+    const auto length = getUncompressedLength(input);
+    if ((length == 0 && !input.empty()) || length != output.size()) {
+        return false;
+    }
+    const auto size = ZSTD_decompress_usingDDict(getDecompressionContext(),
+                                                 output.data(),
+                                                 output.size(),
+                                                 input.data(),
+                                                 input.size(),
+                                                 ddict);
+    if (ZSTD_isError(size) || size != length) {
+        return false;
+    }
+    return true;
+#else
+    (void)input;
+    (void)output;
+    return false;
+#endif
+}
+
+bool ZstdDictionary::decompressWithAny(std::string_view input,
+                                       cb::char_buffer output) {
+#ifdef EP_USE_ZSTD
+    const auto id = ZSTD_getDictID_fromFrame(input.data(), input.size());
+    auto& registry = getRegistry();
+    folly::rcu_reader_domain<Registry::RcuTag> guard(&registry.getDomain());
+    const auto* dictionary = registry.find(id);
+    if (!dictionary) {
+        return false;
+    }
+    return dictionary->decompress(input, output);
+#else
+    (void)input;
+    (void)output;
+    return false;
+#endif
+}
+
+size_t ZstdDictionary::getUncompressedLength(std::string_view input) {
+#ifdef EP_USE_ZSTD
+    const auto length = ZSTD_getFrameContentSize(input.data(), input.size());
+    if (length == ZSTD_CONTENTSIZE_UNKNOWN ||
+        length == ZSTD_CONTENTSIZE_ERROR) {
+        return 0;
+    }
+    return size_t(length);
+#else
+    (void)input;
+    return 0;
+#endif
+}
+
+bool ZstdDictionary::isSupported() {
+#ifdef EP_USE_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,124 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <platform/sized_buffer.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+/**
+ * A Zstd dictionary trained from a sample of a bucket's documents, used by
+ * the item compressor to compress resident values (see compression_codec).
+ *
+ * Small JSON documents compress poorly on their own (Snappy has nothing to
+ * refer back to), but documents of a bucket tend to share field names and
+ * much of their structure; with a dictionary holding those each document
+ * compresses to a fraction of its size.
+ *
+ * Values compressed with a dictionary never leave the engine - they are
+ * decompressed when an Item is created from the StoredValue - as no client
+ * (or DCP consumer, or KVStore) has the dictionary.
+ *
+ * Every dictionary has a process-wide unique id which is recorded in each
+ * value it compresses, so the value can be decompressed (see
+ * decompressWithAny()) without knowing which bucket it belongs to. The
+ * registry of dictionaries by id is read lock-free (RCU), as every read of a
+ * Zstd compressed value looks it up.
+ *
+ * Only available if built with Zstd (EP_USE_ZSTD), otherwise train() always
+ * fails.
+ */
+class ZstdDictionary {
+public:
+    /**
+     * Train a new dictionary.
+     *
+     * @param samples documents to train the dictionary from
+     * @param dictionarySize the maximum size (in bytes) of the dictionary
+     * @param level the Zstd compression level to compress with
+     * @return the dictionary, or nullptr if it could not be trained (e.g.
+     *         there are too few samples, or built without Zstd)
+     */
+    static std::unique_ptr<ZstdDictionary> train(
+            const std::vector<std::string>& samples,
+            size_t dictionarySize,
+            int level);
+
+    ~ZstdDictionary();
+
+    ZstdDictionary(const ZstdDictionary&) = delete;
+    ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+    /**
+     * Compress the input with this dictionary.
+     *
+     * @return false if compression failed
+     */
+    bool compress(std::string_view input, std::string& output) const;
+
+    /**
+     * Decompress input which was compressed with this dictionary.
+     *
+     * @param output buffer of exactly getUncompressedLength(input) bytes
+     * @return false if decompression failed
+     */
+    bool decompress(std::string_view input, cb::char_buffer output) const;
+
+    /**
+     * Decompress input which was compressed with any (live) dictionary.
+     *
+     * @param output buffer of exactly getUncompressedLength(input) bytes
+     * @return false if decompression failed, or the dictionary the input was
+     *         compressed with no longer exists
+     */
+    static bool decompressWithAny(std::string_view input,
+                                  cb::char_buffer output);
+
+    /// @return the decompressed length of the given compressed input
+    static size_t getUncompressedLength(std::string_view input);
+
+    /// @return the size of the dictionary in bytes
+    size_t getSize() const {
+        return dictionary.size();
+    }
+
+    uint32_t getId() const {
+        return id;
+    }
+
+    /// @return true if built with Zstd
+    static bool isSupported();
+
+    /// The fewest samples train() attempts to train a dictionary from
+    static constexpr size_t MinSamples = 100;
+
+private:
+    ZstdDictionary(std::string dictionary, uint32_t id, int level);
+
+    const std::string dictionary;
+    const uint32_t id;
+    ZSTD_CDict_s* cdict = nullptr;
+    ZSTD_DDict_s* ddict = nullptr;
+};
@@ -6897,6 +6897,8 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "vb_0:ht_item_memory",
               "vb_0:ht_item_memory_uncompressed",
               "vb_0:ht_memory",
+              "vb_0:ht_resize_buckets_migrated",
+              "vb_0:ht_resize_buckets_total",
               "vb_0:ht_size",
               "vb_0:logical_clock_ticks",
               "vb_0:max_cas",
@@ -6999,7 +7001,11 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_bfilter_enabled",
               "ep_bfilter_fp_prob",
               "ep_bfilter_key_count",
+              "ep_bfilter_persist",
               "ep_bfilter_residency_threshold",
+              "ep_bfilter_type",
+              "ep_bgfetch_admission_control",
+              "ep_bgfetch_admission_sketch_size",
               "ep_bucket_type",
               "ep_cache_size",
               "ep_chk_expel_enabled",
@@ -7008,9 +7014,13 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_chk_remover_stime",
               "ep_collections_drop_compaction_delay",
               "ep_collections_enabled",
+              "ep_collections_read_mode",
               "ep_compaction_exp_mem_threshold",
               "ep_compaction_write_queue_cap",
+              "ep_compression_codec",
               "ep_compression_mode",
+              "ep_compression_zstd_dict_size",
+              "ep_compression_zstd_level",
               "ep_conflict_resolution_type",
               "ep_connection_manager_interval",
               "ep_couch_bucket",
@@ -7037,6 +7047,7 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_dcp_consumer_process_buffered_messages_batch_size",
               "ep_dcp_scan_byte_limit",
               "ep_dcp_scan_item_limit",
+              "ep_dcp_shared_checkpoint_reads",
               "ep_dcp_takeover_max_time",
               "ep_defragmenter_age_threshold",
               "ep_defragmenter_chunk_duration",
@@ -7050,18 +7061,27 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_exp_pager_initial_run_time",
               "ep_exp_pager_stime",
               "ep_failpartialwarmup",
+              "ep_flusher_adaptive_batch_size",
+              "ep_flusher_concurrent_vbuckets",
+              "ep_flusher_target_commit_latency",
               "ep_flusher_total_batch_limit",
               "ep_fsync_after_every_n_bytes_written",
               "ep_couchstore_tracing",
               "ep_couchstore_write_validation",
               "ep_couchstore_mprotect",
+              "ep_couchstore_bg_fetch_coalesce_gap",
               "ep_couchstore_file_cache_max_size",
+              "ep_couchstore_group_commit",
+              "ep_couchstore_io_uring_queue_depth",
               "ep_getl_default_timeout",
               "ep_getl_max_timeout",
               "ep_hlc_drift_ahead_threshold_us",
               "ep_hlc_drift_behind_threshold_us",
+              "ep_ht_index_type",
               "ep_ht_locks",
+              "ep_ht_read_mode",
               "ep_ht_resize_interval",
+              "ep_ht_resize_mode",
               "ep_ht_size",
               "ep_item_compressor_chunk_duration",
               "ep_item_compressor_interval",
@@ -7196,12 +7216,18 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_bfilter_enabled",
               "ep_bfilter_fp_prob",
               "ep_bfilter_key_count",
+              "ep_bfilter_persist",
               "ep_bfilter_residency_threshold",
+              "ep_bfilter_type",
               "ep_bg_fetch_avg_read_amplification",
+              "ep_bg_fetch_coalesced",
+              "ep_bg_fetch_not_admitted",
               "ep_bg_fetched",
               "ep_bg_meta_fetched",
               "ep_bg_remaining_items",
               "ep_bg_remaining_jobs",
+              "ep_bgfetch_admission_control",
+              "ep_bgfetch_admission_sketch_size",
               "ep_blob_num",
               "ep_blob_overhead",
               "ep_bucket_priority",
@@ -7215,9 +7241,13 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_clock_cas_drift_threshold_exceeded",
               "ep_collections_drop_compaction_delay",
               "ep_collections_enabled",
+              "ep_collections_read_mode",
               "ep_compaction_exp_mem_threshold",
               "ep_compaction_write_queue_cap",
+              "ep_compression_codec",
               "ep_compression_mode",
+              "ep_compression_zstd_dict_size",
+              "ep_compression_zstd_level",
               "ep_conflict_resolution_type",
               "ep_connection_manager_interval",
               "ep_couch_bucket",
@@ -7241,6 +7271,7 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_dcp_conn_buffer_size_perc",
               "ep_dcp_consumer_process_buffered_messages_batch_size",
               "ep_dcp_consumer_process_buffered_messages_yield_limit",
+              "ep_dcp_cursor_batches_shared",
               "ep_dcp_enable_noop",
               "ep_dcp_flow_control_policy",
               "ep_dcp_idle_timeout",
@@ -7250,6 +7281,7 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_dcp_producer_snapshot_marker_yield_limit",
               "ep_dcp_scan_byte_limit",
               "ep_dcp_scan_item_limit",
+              "ep_dcp_shared_checkpoint_reads",
               "ep_dcp_takeover_max_time",
               "ep_defragmenter_age_threshold",
               "ep_defragmenter_chunk_duration",
@@ -7277,18 +7309,27 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
               "ep_expiry_pager_task_time",
               "ep_failpartialwarmup",
               "ep_flush_duration_total",
+              "ep_flusher_adaptive_batch_size",
+              "ep_flusher_concurrent_vbuckets",
+              "ep_flusher_target_commit_latency",
               "ep_flusher_total_batch_limit",
               "ep_fsync_after_every_n_bytes_written",
               "ep_couchstore_tracing",
               "ep_couchstore_write_validation",
               "ep_couchstore_mprotect",
+              "ep_couchstore_bg_fetch_coalesce_gap",
               "ep_couchstore_file_cache_max_size",
+              "ep_couchstore_group_commit",
+              "ep_couchstore_io_uring_queue_depth",
               "ep_getl_default_timeout",
               "ep_getl_max_timeout",
               "ep_hlc_drift_ahead_threshold_us",
               "ep_hlc_drift_behind_threshold_us",
+              "ep_ht_index_type",
               "ep_ht_locks",
+              "ep_ht_read_mode",
               "ep_ht_resize_interval",
+              "ep_ht_resize_mode",
               "ep_ht_size",
               "ep_io_bg_fetch_read_count",
               "ep_io_compaction_read_bytes",
@@ -7627,6 +7668,10 @@ static enum test_result test_mb19687_fixed(EngineIface* h) {
                          {"ep_commit_num",
                           "ep_commit_time",
                           "ep_commit_time_total",
+                          "ep_flusher_batch_size",
+                          "ep_flusher_batch_size_decreases",
+                          "ep_flusher_batch_size_increases",
+                          "ep_flusher_pacing_delay",
                           "ep_item_begin_failed",
                           "ep_item_commit_failed",
                           "ep_item_flush_expired",
@@ -7866,7 +7911,8 @@ static enum test_result test_mb19687_variable(EngineIface* h) {
                                         "ep_warmup_min_memory_threshold",
                                         "ep_warmup_min_item_threshold",
                                         "ep_warmup_estimated_key_count",
-                                        "ep_warmup_estimated_value_count" } });
+                                        "ep_warmup_estimated_value_count",
+                                        "ep_warmup_bloom_filters_loaded" } });
     }
 
     if (isPersistentBucket(h)) {
@@ -100,6 +100,144 @@ TEST_F(BloomFilterTest, FalsePositiveRate) {
                 expectedFalsePositives * 0.1);
 }
 
+// Test the size calculation of a Blocked filter - it should be a whole
+// number of blocks, and (as keys are unevenly spread over blocks) somewhat
+// larger than a Classic filter for the same parameters.
+TEST_F(BloomFilterTest, BlockedSizeCalculation) {
+    for (size_t keys : {1, 10, 100, 1000, 10000, 100000}) {
+        BloomFilter classic(keys, 0.01, BFILTER_ENABLED);
+        BloomFilter blocked(
+                keys, 0.01, BFILTER_ENABLED, BloomFilter::Type::Blocked);
+        EXPECT_EQ(BloomFilter::Type::Blocked, blocked.getType());
+        EXPECT_EQ(0, blocked.getFilterSize() % 512) << "For keys=" << keys;
+        EXPECT_GE(blocked.getFilterSize(), classic.getFilterSize())
+                << "For keys=" << keys;
+        EXPECT_LE(blocked.getFilterSize(), classic.getFilterSize() * 1.5 + 512)
+                << "For keys=" << keys;
+        EXPECT_EQ(8, blocked.getNoOfHashes());
+        EXPECT_EQ(1, blocked.getNumOfStages());
+    }
+}
+
+// Test the filtering and false positive rate of a Blocked filter.
+TEST_F(BloomFilterTest, BlockedPositiveCheckAndFalsePositiveRate) {
+    const int numKeys = 10000;
+    const double targetFalsePositive = 0.01;
+
+    BloomFilter bf(numKeys,
+                   targetFalsePositive,
+                   BFILTER_ENABLED,
+                   BloomFilter::Type::Blocked);
+    for (int i = 0; i < numKeys; i++) {
+        bf.addKey(makeStoredDocKey("key_" + std::to_string(i)));
+    }
+
+    for (int i = 0; i < numKeys; i++) {
+        auto key = makeStoredDocKey("key_" + std::to_string(i));
+        EXPECT_TRUE(bf.maybeKeyExists(key)) << "For key:" << key.to_string();
+    }
+
+    int falsePositives = 0;
+    for (int i = 0; i < numKeys; i++) {
+        if (bf.maybeKeyExists(
+                    makeStoredDocKey("key_" + std::to_string(numKeys + i)))) {
+            falsePositives++;
+        }
+    }
+
+    // The filter is sized so the expected FP rate is at or slightly under
+    // the target; allow 20% over it.
+    const int expectedFalsePositives = numKeys * targetFalsePositive;
+    EXPECT_LT(falsePositives, expectedFalsePositives * 1.2);
+    EXPECT_GT(falsePositives, expectedFalsePositives * 0.5);
+    EXPECT_EQ(1, bf.getNumOfStages());
+}
+
+// Test that a Blocked filter which has more keys added than it was sized for
+// grows additional stages, keeping all keys and bounding the FP rate.
+TEST_F(BloomFilterTest, BlockedGrowth) {
+    const int estimatedKeys = 1000;
+    const int numKeys = 4000;
+    const double targetFalsePositive = 0.01;
+
+    BloomFilter bf(estimatedKeys,
+                   targetFalsePositive,
+                   BFILTER_ENABLED,
+                   BloomFilter::Type::Blocked);
+    const auto initialSize = bf.getFilterSize();
+    for (int i = 0; i < numKeys; i++) {
+        bf.addKey(makeStoredDocKey("key_" + std::to_string(i)));
+    }
+
+    // Stages of 1000, 2000 and 4000 keys.
+    EXPECT_EQ(3, bf.getNumOfStages());
+    EXPECT_GT(bf.getFilterSize(), initialSize * 4);
+    EXPECT_LE(bf.getNumOfKeysInFilter(), numKeys);
+
+    for (int i = 0; i < numKeys; i++) {
+        auto key = makeStoredDocKey("key_" + std::to_string(i));
+        EXPECT_TRUE(bf.maybeKeyExists(key)) << "For key:" << key.to_string();
+    }
+
+    // Each later stage halves the FP probability, so overall the rate
+    // should be under twice the target.
+    const int numChecks = 10000;
+    int falsePositives = 0;
+    for (int i = 0; i < numChecks; i++) {
+        if (bf.maybeKeyExists(
+                    makeStoredDocKey("key_" + std::to_string(numKeys + i)))) {
+            falsePositives++;
+        }
+    }
+    EXPECT_LT(falsePositives, numChecks * targetFalsePositive * 2);
+
+    // Disabling the filter releases all stages.
+    bf.setStatus(BFILTER_DISABLED);
+    EXPECT_EQ(0, bf.getNumOfStages());
+    EXPECT_TRUE(bf.maybeKeyExists(makeStoredDocKey("key_0")));
+}
+
+// Test that a filter survives a serialise / deserialise round-trip for
+// both layouts, and that malformed input is rejected.
+TEST_F(BloomFilterTest, SerialiseRoundTrip) {
+    for (auto type : {BloomFilter::Type::Classic, BloomFilter::Type::Blocked}) {
+        // Add more keys than estimated so Blocked filters have many stages.
+        BloomFilter bf(500, 0.01, BFILTER_ENABLED, type);
+        for (int i = 0; i < 2000; i++) {
+            bf.addKey(makeStoredDocKey("key_" + std::to_string(i)));
+        }
+        const auto data = bf.serialise();
+
+        auto restored = BloomFilter::deserialise(data, BFILTER_ENABLED);
+        ASSERT_TRUE(restored);
+        EXPECT_EQ(type, restored->getType());
+        EXPECT_EQ(bf.getFilterSize(), restored->getFilterSize());
+        EXPECT_EQ(bf.getNoOfHashes(), restored->getNoOfHashes());
+        EXPECT_EQ(bf.getNumOfKeysInFilter(),
+                  restored->getNumOfKeysInFilter());
+        EXPECT_EQ(bf.getNumOfStages(), restored->getNumOfStages());
+        for (int i = 0; i < 4000; i++) {
+            auto key = makeStoredDocKey("key_" + std::to_string(i));
+            EXPECT_EQ(bf.maybeKeyExists(key), restored->maybeKeyExists(key))
+                    << "For key:" << key.to_string();
+        }
+
+        // A restored filter can continue to have keys added.
+        auto key = makeStoredDocKey("new_key");
+        restored->addKey(key);
+        EXPECT_TRUE(restored->maybeKeyExists(key));
+
+        // Truncated or corrupt data is rejected.
+        EXPECT_FALSE(BloomFilter::deserialise(data.substr(0, data.size() - 1),
+                                              BFILTER_ENABLED));
+        EXPECT_FALSE(BloomFilter::deserialise(data + "x", BFILTER_ENABLED));
+        EXPECT_FALSE(BloomFilter::deserialise({}, BFILTER_ENABLED));
+        auto badVersion = data;
+        badVersion[0] = 0x7f;
+        EXPECT_FALSE(BloomFilter::deserialise(badVersion, BFILTER_ENABLED));
+    }
+}
+
 class BloomFilterDocKeyTest
     : public BloomFilter,
       public ::testing::TestWithParam<std::tuple<CollectionID, CollectionID>> {
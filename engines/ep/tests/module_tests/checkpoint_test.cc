@@ -435,6 +435,28 @@ TEST_P(CheckpointTest, Delete) {
 }
 
 // Test with one open and one closed checkpoint.
+// The high prepared seqno of the manager is that of the last prepare queued,
+// whichever checkpoint it is in.
+TEST_P(CheckpointTest, HighPreparedSeqno) {
+    EXPECT_FALSE(this->manager->getHighPreparedSeqno());
+    EXPECT_TRUE(this->queueNewItem("key1"));
+    EXPECT_FALSE(this->manager->getHighPreparedSeqno());
+
+    auto prepare = makePendingItem(makeStoredDocKey("key2"), "value");
+    EXPECT_TRUE(this->manager->queueDirty(*this->vbucket,
+                                          prepare,
+                                          GenerateBySeqno::Yes,
+                                          GenerateCas::Yes,
+                                          /*preLinkDocCtx*/ nullptr));
+    const auto prepareSeqno = uint64_t(prepare->getBySeqno());
+    EXPECT_EQ(prepareSeqno, this->manager->getHighPreparedSeqno());
+
+    // Still found once its checkpoint is closed
+    this->manager->createNewCheckpoint();
+    EXPECT_TRUE(this->queueNewItem("key3"));
+    EXPECT_EQ(prepareSeqno, this->manager->getHighPreparedSeqno());
+}
+
 TEST_P(CheckpointTest, OneOpenOneClosed) {
     // Add some items to the initial (open) checkpoint.
     for (auto i : {1,2}) {
@@ -797,6 +819,118 @@ TEST_P(CheckpointTest, ItemsForCheckpointCursor) {
     EXPECT_FALSE(result.highCompletedSeqno);
 }
 
+// Test that with dcp_shared_checkpoint_reads enabled a DCP cursor at the same
+// position as a cursor which just read the checkpoints is given the same items
+// (and moved to the same position) without reading the checkpoints itself.
+TEST_P(CheckpointTest, DcpCursorsShareCheckpointReads) {
+    this->checkpoint_config =
+            CheckpointConfig(DEFAULT_CHECKPOINT_PERIOD,
+                             MIN_CHECKPOINT_ITEMS,
+                             /*numCheckpoints*/ 2,
+                             /*itemBased*/ true,
+                             /*keepClosed*/ false,
+                             persistent() /*persistenceEnabled*/,
+                             /*dcpSharedCheckpointReads*/ true);
+    createManager();
+
+    for (unsigned int ii = 0; ii < 2 * MIN_CHECKPOINT_ITEMS; ii++) {
+        EXPECT_TRUE(this->queueNewItem("key" + std::to_string(ii)));
+    }
+    ASSERT_EQ(2, this->manager->getNumCheckpoints());
+
+    auto dcpCursor1 =
+            this->manager->registerCursorBySeqno(DCP_CURSOR_PREFIX "1", 0)
+                    .cursor.lock();
+    auto dcpCursor2 =
+            this->manager->registerCursorBySeqno(DCP_CURSOR_PREFIX "2", 0)
+                    .cursor.lock();
+    const auto shared = global_stats.dcpCursorBatchesShared.load();
+
+    std::vector<queued_item> items1;
+    auto result1 =
+            this->manager->getNextItemsForCursor(dcpCursor1.get(), items1);
+    EXPECT_EQ(2 * MIN_CHECKPOINT_ITEMS + 3, items1.size());
+    EXPECT_EQ(shared, global_stats.dcpCursorBatchesShared.load());
+
+    std::vector<queued_item> items2;
+    auto result2 =
+            this->manager->getNextItemsForCursor(dcpCursor2.get(), items2);
+    EXPECT_EQ(shared + 1, global_stats.dcpCursorBatchesShared.load());
+    EXPECT_EQ(items1, items2);
+    ASSERT_EQ(2, result2.ranges.size());
+    EXPECT_EQ(result1.ranges.at(0).getStart(), result2.ranges.at(0).getStart());
+    EXPECT_EQ(result1.ranges.at(0).getEnd(), result2.ranges.at(0).getEnd());
+    EXPECT_EQ(result1.ranges.at(1).getStart(), result2.ranges.at(1).getStart());
+    EXPECT_EQ(result1.ranges.at(1).getEnd(), result2.ranges.at(1).getEnd());
+    EXPECT_EQ(result1.visibleSeqno, result2.visibleSeqno);
+    EXPECT_EQ(result1.moreAvailable, result2.moreAvailable);
+
+    // Both DCP cursors moved into the open checkpoint, leaving only the test
+    // cursor in the closed one
+    const auto& ckptList =
+            CheckpointManagerTestIntrospector::public_getCheckpointList(
+                    *manager);
+    EXPECT_EQ(1, ckptList.front()->getNumCursorsInCheckpoint());
+    EXPECT_EQ(2, ckptList.back()->getNumCursorsInCheckpoint());
+    EXPECT_EQ(0, this->manager->getNumItemsForCursor(dcpCursor2.get()));
+
+    // A new item is shared the same way
+    EXPECT_TRUE(this->queueNewItem("key_new"));
+    items1.clear();
+    items2.clear();
+    this->manager->getNextItemsForCursor(dcpCursor1.get(), items1);
+    this->manager->getNextItemsForCursor(dcpCursor2.get(), items2);
+    ASSERT_EQ(1, items1.size());
+    EXPECT_EQ(items1, items2);
+    EXPECT_EQ(shared + 2, global_stats.dcpCursorBatchesShared.load());
+
+    // De-duplicating the item the batch ended at drops the batch; the 2nd
+    // cursor must then read the checkpoint itself and see the new version
+    EXPECT_TRUE(this->queueNewItem("key_other"));
+    items1.clear();
+    this->manager->getNextItemsForCursor(dcpCursor1.get(), items1);
+    ASSERT_EQ(1, items1.size());
+    this->queueNewItem("key_other");
+
+    items2.clear();
+    this->manager->getNextItemsForCursor(dcpCursor2.get(), items2);
+    EXPECT_EQ(shared + 2, global_stats.dcpCursorBatchesShared.load());
+    ASSERT_EQ(1, items2.size());
+    EXPECT_NE(items1.front().get(), items2.front().get());
+    EXPECT_EQ(items1.front()->getKey(), items2.front()->getKey());
+    EXPECT_GT(items2.front()->getBySeqno(), items1.front()->getBySeqno());
+}
+
+// Test that hasItemsForCursor() agrees with getNumItemsForCursor() as the
+// cursor moves past items, meta items and into subsequent checkpoints.
+TEST_P(CheckpointTest, HasItemsForCursor) {
+    auto dcpCursor =
+            this->manager->registerCursorBySeqno(DCP_CURSOR_PREFIX "1", 0)
+                    .cursor.lock();
+    EXPECT_FALSE(this->manager->hasItemsForCursor(dcpCursor.get()));
+    EXPECT_FALSE(this->manager->hasItemsForCursor(nullptr));
+
+    EXPECT_TRUE(this->queueNewItem("key1"));
+    EXPECT_TRUE(this->manager->hasItemsForCursor(dcpCursor.get()));
+    EXPECT_EQ(1, this->manager->getNumItemsForCursor(dcpCursor.get()));
+
+    std::vector<queued_item> items;
+    this->manager->getNextItemsForCursor(dcpCursor.get(), items);
+    EXPECT_FALSE(this->manager->hasItemsForCursor(dcpCursor.get()));
+
+    // Closing the checkpoint only adds meta items (checkpoint_end in the
+    // cursor's checkpoint and checkpoint_start in the new one)
+    this->manager->createNewCheckpoint();
+    EXPECT_EQ(2, this->manager->getNumCheckpoints());
+    EXPECT_FALSE(this->manager->hasItemsForCursor(dcpCursor.get()));
+    EXPECT_EQ(0, this->manager->getNumItemsForCursor(dcpCursor.get()));
+
+    // An item in the next checkpoint is found
+    EXPECT_TRUE(this->queueNewItem("key2"));
+    EXPECT_TRUE(this->manager->hasItemsForCursor(dcpCursor.get()));
+    EXPECT_EQ(1, this->manager->getNumItemsForCursor(dcpCursor.get()));
+}
+
 // Test getNextItemsForCursor() when it is limited to fewer items than exist
 // in total. Cursor should only advanced to the start of the 2nd checkpoint.
 TEST_P(CheckpointTest, ItemsForCheckpointCursorLimited) {
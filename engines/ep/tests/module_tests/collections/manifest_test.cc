@@ -283,6 +283,38 @@ TEST(ManifestTest, validation) {
                 "scopes":[{"name":"_default", "uid":"0",
                 "collections":[{"name":"_default","uid":"0"},
                                {"name":"brewery","uid":"9","maxTTL":4294967296}]}]})",
+            // memoryShare invalid cases
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0"},
+                               {"name":"brewery","uid":"9","memoryShare":"50"}]}]})",
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0"},
+                               {"name":"brewery","uid":"9","memoryShare":-1}]}]})",
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0"},
+                               {"name":"brewery","uid":"9","memoryShare":101}]}]})",
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0","memoryShare":40},
+                               {"name":"brewery","uid":"9","memoryShare":61}]}]})",
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0"},
+                               {"name":"brewery","uid":"9","memoryShare":60}]},
+                          {"name":"brewerA", "uid":"8",
+                "collections":[{"name":"beer","uid":"a","memoryShare":41}]}]})",
+            // evictionPriority invalid cases
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0"},
+                               {"name":"brewery","uid":"9","evictionPriority":1}]}]})",
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0"},
+                               {"name":"brewery","uid":"9","evictionPriority":"top"}]}]})",
             // Test duplicate scope names
             R"({"uid" : "1",
                 "scopes":[{"name":"_default", "uid":"0",
@@ -411,6 +443,22 @@ TEST(ManifestTest, validation) {
                 "collections":[{"name":"_default","uid":"0"},
                                {"name":"brewery","uid":"9","maxTTL":4294967295}]}]})",
 
+            // eviction settings valid cases
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0"},
+                               {"name":"brewery","uid":"9","memoryShare":100,
+                                "evictionPriority":"low"}]}]})",
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0"},
+                               {"name":"brewery","uid":"9","memoryShare":0,
+                                "evictionPriority":"high"}]}]})",
+            R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                "collections":[{"name":"_default","uid":"0","memoryShare":40},
+                               {"name":"brewery","uid":"9","memoryShare":60}]}]})",
+
             R"({"uid" : "1",
                 "scopes":[{"name":"_default", "uid":"0",
                 "collections":[{"name":"brewery","uid":"8"}]}]})",
@@ -938,6 +986,64 @@ TEST(ManifestTest, isNotSuccesor) {
     EXPECT_NE(cb::engine_errc::success, current.isSuccessor(incoming3).code());
 }
 
+// The eviction settings are parsed, persisted and may change between
+// manifests
+TEST(ManifestTest, evictionSettings) {
+    std::string json = R"({"uid" : "1",
+                "scopes":[{"name":"_default", "uid":"0",
+                                "collections":[
+                                    {"name":"_default", "uid":"0"},
+                                    {"name":"meat", "uid":"8",
+                                     "memoryShare":25,
+                                     "evictionPriority":"high"}]}]})";
+    Collections::Manifest m(json);
+
+    auto meat = m.findCollection(CollectionEntry::meat.uid);
+    ASSERT_NE(m.end(), meat);
+    EXPECT_EQ(25, meat->second.eviction.memoryShare);
+    EXPECT_EQ(Collections::EvictionPriority::High,
+              meat->second.eviction.priority);
+
+    auto defaultCollection = m.findCollection(CollectionID::Default);
+    ASSERT_NE(m.end(), defaultCollection);
+    EXPECT_EQ(Collections::EvictionSettings{},
+              defaultCollection->second.eviction);
+
+    auto fb = m.toFlatbuffer();
+    std::string_view view(reinterpret_cast<const char*>(fb.data()), fb.size());
+    Collections::Manifest m2(view, Collections::Manifest::FlatBuffers{});
+    EXPECT_EQ(m, m2);
+
+    Collections::IsVisibleFunction isVisible =
+            [](ScopeID, std::optional<CollectionID>) -> bool { return true; };
+    auto output = m.toJson(isVisible);
+    auto collections = output["scopes"][0]["collections"];
+    ASSERT_EQ(2, collections.size());
+    for (const auto& collection : collections) {
+        if (collection["name"] == "meat") {
+            EXPECT_EQ(25, collection["memoryShare"]);
+            EXPECT_EQ("high", collection["evictionPriority"]);
+        } else {
+            EXPECT_EQ(2, collection.size());
+        }
+    }
+
+    // Only the eviction settings change; that is a valid successor
+    std::string successor = R"({"uid" : "2",
+                "scopes":[{"name":"_default", "uid":"0",
+                                "collections":[
+                                    {"name":"_default", "uid":"0"},
+                                    {"name":"meat", "uid":"8",
+                                     "evictionPriority":"low"}]}]})";
+    Collections::Manifest m3(successor);
+    EXPECT_EQ(cb::engine_errc::success, m.isSuccessor(m3).code());
+    meat = m3.findCollection(CollectionEntry::meat.uid);
+    ASSERT_NE(m3.end(), meat);
+    EXPECT_EQ(0, meat->second.eviction.memoryShare);
+    EXPECT_EQ(Collections::EvictionPriority::Low,
+              meat->second.eviction.priority);
+}
+
 TEST(ManifestTest, forcedUpdate) {
     std::string manifest = R"({"uid" : "1",
                 "force" : true,
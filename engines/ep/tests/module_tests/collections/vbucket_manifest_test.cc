@@ -33,6 +33,9 @@
 
 #include <folly/portability/GTest.h>
 
+#include <atomic>
+#include <thread>
+
 class MockVBManifest : public Collections::VB::Manifest {
 public:
     MockVBManifest(std::shared_ptr<Collections::Manager> manager)
@@ -1087,3 +1090,56 @@ TEST_F(VBucketManifestCachingReadHandle, deleted_default) {
     // Real items begin at seqno 1
     EXPECT_TRUE(rh.isLogicallyDeleted(1 /*seqno*/));
 }
+
+// A WriteHandle cannot be obtained while a CachingReadHandle exists, even
+// though with ReadMode::LockFree the CachingReadHandle does not (normally)
+// obtain the manifest's lock
+TEST_F(VBucketManifestCachingReadHandle, writerWaitsForReader) {
+    manifest.active.setReadMode(Collections::VB::Manifest::ReadMode::LockFree);
+    EXPECT_TRUE(manifest.update(cm));
+    StoredDocKey key{"vegetable:v1", CollectionEntry::vegetable};
+
+    std::atomic<bool> locked{false};
+    std::thread writer;
+    {
+        auto rh = manifest.active.lock(key);
+        ASSERT_TRUE(rh.valid());
+        writer = std::thread([this, &locked]() {
+            auto wh = manifest.active.wlock();
+            locked = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_FALSE(locked);
+    }
+    writer.join();
+    EXPECT_TRUE(locked);
+
+    // And once the WriteHandle is gone the manifest can be read again
+    auto rh = manifest.active.lock(key);
+    EXPECT_TRUE(rh.valid());
+}
+
+// A pending WriteHandle waits for CachingReadHandles before it locks the
+// manifest, so a CachingReadHandle can still obtain a ReadHandle
+TEST_F(VBucketManifestCachingReadHandle, pendingWriterAllowsNestedReader) {
+    manifest.active.setReadMode(Collections::VB::Manifest::ReadMode::LockFree);
+    EXPECT_TRUE(manifest.update(cm));
+    StoredDocKey key{"vegetable:v1", CollectionEntry::vegetable};
+
+    std::atomic<bool> locked{false};
+    std::thread writer;
+    {
+        auto rh = manifest.active.lock(key);
+        ASSERT_TRUE(rh.valid());
+        writer = std::thread([this, &locked]() {
+            auto wh = manifest.active.wlock();
+            locked = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto nested = manifest.active.lock();
+        EXPECT_TRUE(nested.doesKeyContainValidCollection(key));
+        EXPECT_FALSE(locked);
+    }
+    writer.join();
+    EXPECT_TRUE(locked);
+}
@@ -126,6 +126,79 @@ TEST_F(CouchKVStoreTest, CompactStatsTest) {
     EXPECT_GE(io_compaction_write_bytes, io_write_bytes);
 }
 
+// Verify that getMulti returns the same results when the documents are read
+// as one coalesced batch (via io_uring if available), including values
+// spanning multiple 4KiB blocks and a key which does not exist.
+TEST_F(CouchKVStoreTest, GetMultiBatchedReads) {
+    CouchKVStoreConfig config(1, 4, data_dir, "couchdb", 0);
+    config.setBgFetchCoalesceGap(4096);
+    config.setIoUringQueueDepth(4);
+    auto kvstore = setup_kv_store(config);
+
+    const int numDocs = 20;
+    kvstore->begin(std::make_unique<TransactionContext>(vbid));
+    for (int i = 0; i < numDocs; i++) {
+        kvstore->set(makeCommittedItem(
+                makeStoredDocKey("key_" + std::to_string(i)),
+                std::string(1 + i * 1000, 'a' + i)));
+    }
+    EXPECT_TRUE(kvstore->commit(flush));
+
+    vb_bgfetch_queue_t itms;
+    for (int i = 0; i <= numDocs; i++) {
+        vb_bgfetch_item_ctx_t ctx;
+        ctx.addBgFetch(std::make_unique<FrontEndBGFetchItem>(
+                nullptr, ValueFilter::VALUES_DECOMPRESSED));
+        itms[makeDiskDocKey("key_" + std::to_string(i))] = std::move(ctx);
+    }
+    kvstore->getMulti(vbid, itms);
+
+    for (int i = 0; i < numDocs; i++) {
+        const auto& fetched =
+                itms[makeDiskDocKey("key_" + std::to_string(i))].value;
+        ASSERT_EQ(cb::engine_errc::success, fetched.getStatus());
+        EXPECT_EQ(std::string(1 + i * 1000, 'a' + i),
+                  fetched.item->getValue()->to_s());
+    }
+    EXPECT_EQ(cb::engine_errc::no_such_key,
+              itms[makeDiskDocKey("key_" + std::to_string(numDocs))]
+                      .value.getStatus());
+    EXPECT_EQ(numDocs, kvstore->getKVStoreStat().io_bg_fetch_docs_read);
+    // Documents were written back-to-back, so at least some of them must
+    // have been read together.
+    EXPECT_GT(kvstore->getKVStoreStat().io_bg_fetch_coalesced, 0);
+}
+
+// With group commit the KVStore may begin the next transaction (here for
+// another vBucket) once the first one is written, while it is synced.
+TEST_F(CouchKVStoreTest, GroupCommitBeginsNextTransactionBeforeSync) {
+    CouchKVStoreConfig config(2, 1, data_dir, "couchdb", 0);
+    config.setGroupCommitEnabled(true);
+    auto kvstore = setup_kv_store(config, {Vbid(0), Vbid(1)});
+
+    Collections::VB::Manifest manifest1{
+            std::make_shared<Collections::Manager>()};
+    VB::Commit flush1(manifest1);
+    bool vb1Committed = false;
+    flush.writeCompleteCallback = [&kvstore, &flush1, &vb1Committed]() {
+        kvstore->begin(std::make_unique<TransactionContext>(Vbid(1)));
+        kvstore->set(makeCommittedItem(makeStoredDocKey("key1"), "value1"));
+        vb1Committed = kvstore->commit(flush1);
+    };
+
+    kvstore->begin(std::make_unique<TransactionContext>(vbid));
+    kvstore->set(makeCommittedItem(makeStoredDocKey("key0"), "value0"));
+    EXPECT_TRUE(kvstore->commit(flush));
+    EXPECT_TRUE(vb1Committed);
+
+    auto gv = kvstore->get(makeDiskDocKey("key0"), Vbid(0));
+    EXPECT_EQ(cb::engine_errc::success, gv.getStatus());
+    gv = kvstore->get(makeDiskDocKey("key1"), Vbid(1));
+    EXPECT_EQ(cb::engine_errc::success, gv.getStatus());
+
+    EXPECT_EQ(2, kvstore->getKVStoreStat().commitWriteHisto.getValueCount());
+}
+
 // Regression test for MB-17517 - ensure that if a couchstore file has a max
 // CAS of -1, it is detected and reset to zero when file is loaded.
 TEST_F(CouchKVStoreTest, MB_17517MaxCasOfMinus1) {
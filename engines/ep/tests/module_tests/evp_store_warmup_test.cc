@@ -616,6 +616,53 @@ TEST_F(WarmupTest, MB_31450) {
     MB_31450(false);
 }
 
+// Test that with bfilter_persist enabled, the bloom filter written by
+// compaction is loaded at warmup, including keys persisted after the
+// compaction ran.
+TEST_F(WarmupTest, LoadPersistedBloomFilter) {
+    const std::string config =
+            "item_eviction_policy=full_eviction;bfilter_persist=true";
+    resetEngineAndWarmup(config);
+    setVBucketStateAndRunPersistTask(vbid, vbucket_state_active);
+
+    const int numKeys = 100;
+    for (int i = 0; i < numKeys; i++) {
+        store_item(vbid, makeStoredDocKey("key_" + std::to_string(i)), "v");
+    }
+    flush_vbucket_to_disk(vbid, numKeys);
+    runCompaction(vbid);
+
+    // Written after the compaction, so only found by warmup's catch-up scan.
+    auto lateKey = makeStoredDocKey("late_key");
+    store_item(vbid, lateKey, "v");
+    flush_vbucket_to_disk(vbid);
+
+    resetEngineAndWarmup(config);
+
+    auto vb = store->getVBucket(vbid);
+    ASSERT_GT(vb->getFilterSize(), 0);
+    EXPECT_EQ(numKeys + 1, vb->getNumOfKeysInFilter());
+    for (int i = 0; i < numKeys; i++) {
+        EXPECT_TRUE(vb->maybeKeyExistsInFilter(
+                makeStoredDocKey("key_" + std::to_string(i))));
+    }
+    EXPECT_TRUE(vb->maybeKeyExistsInFilter(lateKey));
+
+    int falsePositives = 0;
+    for (int i = 0; i < numKeys; i++) {
+        if (vb->maybeKeyExistsInFilter(
+                    makeStoredDocKey("missing_" + std::to_string(i)))) {
+            falsePositives++;
+        }
+    }
+    EXPECT_LT(falsePositives, numKeys / 10);
+
+    // Without bfilter_persist the filter is not loaded.
+    vb.reset();
+    resetEngineAndWarmup("item_eviction_policy=full_eviction");
+    EXPECT_EQ(0, store->getVBucket(vbid)->getFilterSize());
+}
+
 // Test fixture for Durability-related Warmup tests.
 class DurabilityWarmupTest : public DurabilityKVBucketTest {
 protected:
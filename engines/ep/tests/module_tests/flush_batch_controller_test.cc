@@ -0,0 +1,138 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <folly/portability/GTest.h>
+
+#include "flush_batch_controller.h"
+#include "stats.h"
+
+using namespace std::chrono_literals;
+
+class FlushBatchControllerTest : public ::testing::Test {
+protected:
+    static constexpr size_t maxBatchSize = 6400;
+
+    EPStats stats;
+    FlushBatchController controller{stats, maxBatchSize, 100ms};
+};
+
+TEST_F(FlushBatchControllerTest, InitialState) {
+    EXPECT_EQ(maxBatchSize, controller.getBatchSize());
+    EXPECT_EQ(0us, controller.getPacingDelay());
+    EXPECT_EQ(maxBatchSize, stats.flusherBatchSize.load());
+    EXPECT_EQ(0u, stats.flusherPacingDelay.load());
+}
+
+// A commit slower than the target halves the batch size, down to the minimum
+TEST_F(FlushBatchControllerTest, SlowCommitDecreasesBatchSize) {
+    controller.recordCommit(true, false, 200ms, 1000);
+    EXPECT_EQ(maxBatchSize / 2, controller.getBatchSize());
+    EXPECT_EQ(maxBatchSize / 2, stats.flusherBatchSize.load());
+    EXPECT_EQ(1u, stats.flusherBatchSizeDecreases.load());
+
+    for (int ii = 0; ii < 10; ++ii) {
+        controller.recordCommit(true, false, 200ms, 1000);
+    }
+    const auto minBatchSize =
+            maxBatchSize / FlushBatchController::MinBatchSizeDivisor;
+    EXPECT_EQ(minBatchSize, controller.getBatchSize());
+    // Not counted once the minimum is reached
+    EXPECT_EQ(6u, stats.flusherBatchSizeDecreases.load());
+    EXPECT_EQ(0us, controller.getPacingDelay());
+}
+
+// A full batch committed within the target while the disk queue grows
+// increases the batch size, up to the maximum
+TEST_F(FlushBatchControllerTest, FallingBehindIncreasesBatchSize) {
+    controller.recordCommit(true, false, 200ms, 1000);
+    controller.recordCommit(true, false, 200ms, 1000);
+    ASSERT_EQ(maxBatchSize / 4, controller.getBatchSize());
+
+    // Queue not growing - no change
+    controller.recordCommit(true, false, 10ms, 1000);
+    EXPECT_EQ(maxBatchSize / 4, controller.getBatchSize());
+
+    controller.recordCommit(true, false, 10ms, 2000);
+    EXPECT_EQ(maxBatchSize / 4 +
+                      maxBatchSize / FlushBatchController::IncreaseDivisor,
+              controller.getBatchSize());
+    EXPECT_EQ(1u, stats.flusherBatchSizeIncreases.load());
+
+    for (size_t queue = 3000; queue < 30000; queue += 1000) {
+        controller.recordCommit(true, false, 10ms, queue);
+    }
+    EXPECT_EQ(maxBatchSize, controller.getBatchSize());
+    EXPECT_EQ(12u, stats.flusherBatchSizeIncreases.load());
+    EXPECT_EQ(0us, controller.getPacingDelay());
+}
+
+// Under light load the flusher is paced by the commit time, up to a quarter
+// of the target
+TEST_F(FlushBatchControllerTest, LightLoadPacesFlusher) {
+    controller.recordCommit(false, false, 5ms, 0);
+    EXPECT_EQ(5ms, controller.getPacingDelay());
+    EXPECT_EQ(5000u, stats.flusherPacingDelay.load());
+
+    controller.recordCommit(false, false, 80ms, 0);
+    EXPECT_EQ(25ms, controller.getPacingDelay());
+
+    // Not paced once the queue grows...
+    controller.recordCommit(false, false, 5ms, 10);
+    EXPECT_EQ(0us, controller.getPacingDelay());
+
+    // ... or when the batch is full
+    controller.recordCommit(false, false, 5ms, 10);
+    ASSERT_EQ(5ms, controller.getPacingDelay());
+    controller.recordCommit(true, false, 5ms, 10);
+    EXPECT_EQ(0us, controller.getPacingDelay());
+    EXPECT_EQ(maxBatchSize, controller.getBatchSize());
+}
+
+// Batches with prepares are never paced, as a SyncWrite may be waiting for
+// them to be persisted
+TEST_F(FlushBatchControllerTest, SyncWritesNotPaced) {
+    controller.recordCommit(false, true, 5ms, 0);
+    EXPECT_EQ(0us, controller.getPacingDelay());
+}
+
+TEST_F(FlushBatchControllerTest, SetMaxBatchSize) {
+    controller.setMaxBatchSize(100);
+    EXPECT_EQ(100u, controller.getBatchSize());
+
+    // Min batch size never drops to zero
+    for (int ii = 0; ii < 10; ++ii) {
+        controller.recordCommit(true, false, 200ms, 0);
+    }
+    EXPECT_EQ(1u, controller.getBatchSize());
+
+    controller.setMaxBatchSize(6400);
+    EXPECT_EQ(100u, controller.getBatchSize());
+
+    controller.reset();
+    EXPECT_EQ(6400u, controller.getBatchSize());
+}
+
+TEST_F(FlushBatchControllerTest, SetTargetCommitLatency) {
+    controller.recordCommit(false, false, 20ms, 0);
+    ASSERT_EQ(20ms, controller.getPacingDelay());
+
+    controller.setTargetCommitLatency(40ms);
+    EXPECT_EQ(10ms, controller.getPacingDelay());
+
+    controller.recordCommit(true, false, 50ms, 0);
+    EXPECT_EQ(maxBatchSize / 2, controller.getBatchSize());
+}
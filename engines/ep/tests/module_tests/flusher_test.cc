@@ -31,7 +31,7 @@ class FlusherTest : public ::testing::Test {
 protected:
     void SetUp() override {
         SingleThreadedExecutorPool::replaceExecutorPoolWithFake();
-        engine = SynchronousEPEngine::build({});
+        engine = SynchronousEPEngine::build(config);
         task_executor = reinterpret_cast<SingleThreadedExecutorPool*>(
                 ExecutorPool::get());
 
@@ -52,6 +52,9 @@ protected:
         ExecutorPool::shutdown();
     }
 
+    /// Extra configuration for the engine
+    std::string config;
+
     SynchronousEPEngineUniquePtr engine;
 
     // Non-owning poitner to SingleThreadedExecutorPool.
@@ -157,4 +160,91 @@ TEST_F(FlusherTest, GetToLowPrioWhenSomeHighPriIsPending) {
     // Run the FLusher again, should drain the low-priority queue
     task_executor->runNextTask(WRITER_TASK_IDX, flusherName);
     ASSERT_EQ(0, flusher->getLPQueueSize());
-}
\ No newline at end of file
+}
+class ConcurrentFlusherTest : public FlusherTest {
+protected:
+    ConcurrentFlusherTest() {
+        config = "flusher_concurrent_vbuckets=2";
+    }
+
+    void storeItem(Vbid vbid, std::string_view key) {
+        auto item = make_item(
+                vbid, makeStoredDocKey(std::string(key)), "value");
+        item.setCas();
+        uint64_t seqno;
+        ASSERT_EQ(cb::engine_errc::success,
+                  engine->getKVBucket()->setWithMeta(
+                          item,
+                          0 /*cas*/,
+                          &seqno,
+                          nullptr /*cookie*/,
+                          {vbucket_state_active},
+                          CheckConflicts::No,
+                          /*allowExisting*/ true));
+    }
+};
+
+// The flusher hands off ready vBuckets to a task of their own when
+// flusher_concurrent_vbuckets is greater than one.
+TEST_F(ConcurrentFlusherTest, FlushesVBucketsConcurrently) {
+    // Two vBuckets of the same shard (see GetToLowPrioWhenSomeHighPriIsPending)
+    auto* kvBucket = engine->getKVBucket();
+    const auto vbid1 = Vbid(kvBucket->getVBuckets().getNumShards());
+    ASSERT_EQ(flusher,
+              dynamic_cast<MockEPBucket*>(kvBucket)->getFlusherNonConst(vbid1));
+
+    for (auto vbid : {vbid0, vbid1}) {
+        kvBucket->setVBucketState(vbid, vbucket_state_active);
+        storeItem(vbid, "key");
+    }
+    ASSERT_EQ(2, flusher->getLPQueueSize());
+
+    // The flusher task flushes the first vBucket and schedules a task to
+    // flush the second one.
+    task_executor->runNextTask(WRITER_TASK_IDX, flusherName);
+    EXPECT_EQ(0, flusher->getLPQueueSize());
+    EXPECT_EQ(1, engine->getVBucket(vbid0)->getPersistenceSeqno());
+    EXPECT_EQ(0, engine->getVBucket(vbid1)->getPersistenceSeqno());
+    const auto vbid1TaskName = "Flushing " + vbid1.to_string();
+    ASSERT_TRUE(task_executor->isTaskScheduled(WRITER_TASK_IDX, vbid1TaskName));
+
+    // A mutation while vbid1 is in flight doesn't get it flushed by the
+    // flusher task too; the VBucketFlushTask (which was scheduled first)
+    // persists it.
+    storeItem(vbid1, "key2");
+    ASSERT_EQ(1, flusher->getLPQueueSize());
+    task_executor->runNextTask(WRITER_TASK_IDX, vbid1TaskName);
+    EXPECT_EQ(2, engine->getVBucket(vbid1)->getPersistenceSeqno());
+
+    // Nothing left for the flusher task to do
+    task_executor->runNextTask(WRITER_TASK_IDX, flusherName);
+    EXPECT_EQ(0, flusher->getLPQueueSize());
+    EXPECT_FALSE(
+            task_executor->isTaskScheduled(WRITER_TASK_IDX, vbid1TaskName));
+}
+
+// A VBucketFlushTask which is cancelled before it runs (e.g. when the
+// bucket's tasks are unregistered) hands its vBucket back to the flusher
+// task, rather than leaving it claimed forever.
+TEST_F(ConcurrentFlusherTest, CancelledVBucketFlushTaskReleasesVBucket) {
+    auto* kvBucket = engine->getKVBucket();
+    const auto vbid1 = Vbid(kvBucket->getVBuckets().getNumShards());
+    for (auto vbid : {vbid0, vbid1}) {
+        kvBucket->setVBucketState(vbid, vbucket_state_active);
+        storeItem(vbid, "key");
+    }
+
+    task_executor->runNextTask(WRITER_TASK_IDX, flusherName);
+    const auto vbid1TaskName = "Flushing " + vbid1.to_string();
+    ASSERT_TRUE(task_executor->isTaskScheduled(WRITER_TASK_IDX, vbid1TaskName));
+    ASSERT_EQ(0, flusher->getLPQueueSize());
+
+    task_executor->cancelByName(vbid1TaskName);
+    task_executor->runNextTask(WRITER_TASK_IDX, vbid1TaskName);
+    EXPECT_EQ(0, engine->getVBucket(vbid1)->getPersistenceSeqno());
+    EXPECT_EQ(1, flusher->getLPQueueSize());
+
+    // The flusher task now flushes it itself
+    task_executor->runNextTask(WRITER_TASK_IDX, flusherName);
+    EXPECT_EQ(1, engine->getVBucket(vbid1)->getPersistenceSeqno());
+}
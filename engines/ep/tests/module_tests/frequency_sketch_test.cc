@@ -0,0 +1,87 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <folly/portability/GTest.h>
+
+#include "frequency_sketch.h"
+
+TEST(FrequencySketchTest, Width) {
+    EXPECT_EQ(1024u, FrequencySketch(1000).getWidth());
+    EXPECT_EQ(1024u, FrequencySketch(1024).getWidth());
+    EXPECT_EQ(16u, FrequencySketch(1).getWidth());
+}
+
+TEST(FrequencySketchTest, IncrementSaturates) {
+    FrequencySketch sketch(1024);
+    EXPECT_EQ(0, sketch.estimate(1));
+
+    for (uint8_t expected = 1; expected <= FrequencySketch::MaxFrequency;
+         ++expected) {
+        EXPECT_EQ(expected, sketch.increment(1));
+        EXPECT_EQ(expected, sketch.estimate(1));
+    }
+    EXPECT_EQ(FrequencySketch::MaxFrequency, sketch.increment(1));
+    EXPECT_EQ(FrequencySketch::MaxFrequency, sketch.estimate(1));
+}
+
+// Keys which have not been seen mostly estimate zero; collisions in every row
+// are rare while the sketch is lightly loaded
+TEST(FrequencySketchTest, FewCollisions) {
+    FrequencySketch sketch(1024);
+    for (uint32_t hash = 0; hash < 100; ++hash) {
+        sketch.increment(hash);
+    }
+    for (uint32_t hash = 0; hash < 100; ++hash) {
+        EXPECT_LE(1, sketch.estimate(hash));
+    }
+
+    int collisions = 0;
+    for (uint32_t hash = 100; hash < 1100; ++hash) {
+        if (sketch.estimate(hash) != 0) {
+            ++collisions;
+        }
+    }
+    EXPECT_LT(collisions, 10);
+}
+
+// Every width * SampleFactor increments all of the estimates are halved
+TEST(FrequencySketchTest, Aging) {
+    FrequencySketch sketch(1024);
+    for (int ii = 0; ii < 8; ++ii) {
+        sketch.increment(1);
+    }
+    ASSERT_EQ(8, sketch.estimate(1));
+
+    const auto sampleSize = sketch.getWidth() * FrequencySketch::SampleFactor;
+    for (size_t ii = 8; ii < sampleSize - 1; ++ii) {
+        sketch.increment(2);
+    }
+    EXPECT_EQ(8, sketch.estimate(1));
+
+    sketch.increment(2);
+    EXPECT_EQ(4, sketch.estimate(1));
+    EXPECT_EQ(7, sketch.estimate(2));
+
+    // Half of the samples are carried over, so the next halving happens
+    // after another sampleSize / 2 increments
+    for (size_t ii = 0; ii < sampleSize / 2 - 1; ++ii) {
+        sketch.increment(3);
+    }
+    EXPECT_EQ(4, sketch.estimate(1));
+    sketch.increment(3);
+    EXPECT_EQ(2, sketch.estimate(1));
+}
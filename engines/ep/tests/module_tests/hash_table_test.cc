@@ -1190,4 +1190,399 @@ TEST_F(HashTableTest, ReplaceValueAndDatatype) {
     EXPECT_EQ(initialFreqCounter, sv->getFreqCounterValue());
     EXPECT_EQ(initialAge, sv->getAge());
     EXPECT_EQ(initialCommittedState, sv->getCommitted());
-}
\ No newline at end of file
+}
+// Check that optimistic reads are not attempted for a Locked HashTable.
+TEST_F(HashTableTest, OptimisticReadLockedMode) {
+    HashTable ht(global_stats, makeFactory(), 5, 1);
+    auto key = makeStoredDocKey("key");
+    store(ht, key);
+
+    auto res = ht.findForReadOptimistic(key, Vbid(0));
+    EXPECT_EQ(HashTable::OptimisticReadResult::Status::Fallback, res.status);
+    EXPECT_FALSE(res.item);
+}
+
+// Check that only the StoredValues of an Optimistic HashTable have their
+// frees deferred; other HashTables (e.g. of other buckets) are unaffected.
+TEST_F(HashTableTest, OptimisticReadDeferralScopedToHashTable) {
+    HashTable locked(global_stats, makeFactory(), 5, 1);
+    HashTable optimistic(global_stats,
+                         makeFactory(),
+                         5,
+                         1,
+                         HashTable::ReadMode::Optimistic);
+    auto key = makeStoredDocKey("key");
+    store(locked, key);
+    store(optimistic, key);
+
+    EXPECT_FALSE(locked.findForRead(key).storedValue->isOptimisticallyRead());
+    EXPECT_TRUE(
+            optimistic.findForRead(key).storedValue->isOptimisticallyRead());
+
+    // Replacing by copy links a new StoredValue, which must be marked too.
+    {
+        auto res = optimistic.findForWrite(key);
+        ASSERT_TRUE(res.storedValue);
+        optimistic.unlocked_replaceByCopy(res.lock, *res.storedValue);
+    }
+    EXPECT_TRUE(
+            optimistic.findForRead(key).storedValue->isOptimisticallyRead());
+}
+
+// Check that an optimistic read returns the same item as a locked read.
+TEST_F(HashTableTest, OptimisticReadFound) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 1,
+                 HashTable::ReadMode::Optimistic);
+    auto keys = generateKeys(100);
+    storeMany(ht, keys);
+
+    for (const auto& key : keys) {
+        auto res = ht.findForReadOptimistic(key, Vbid(0));
+        ASSERT_EQ(HashTable::OptimisticReadResult::Status::Found, res.status);
+        ASSERT_TRUE(res.item);
+
+        auto locked = ht.findForRead(key).storedValue->toItem(Vbid(0));
+        EXPECT_EQ(*locked, *res.item);
+    }
+
+    auto res = ht.findForReadOptimistic(makeStoredDocKey("missing"), Vbid(0));
+    EXPECT_EQ(HashTable::OptimisticReadResult::Status::NotFound, res.status);
+}
+
+// Check that items which need the lock to be processed are not returned by
+// an optimistic read.
+TEST_F(HashTableTest, OptimisticReadFallback) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 1,
+                 HashTable::ReadMode::Optimistic);
+    auto deleted = makeStoredDocKey("deleted");
+    store(ht, deleted);
+    {
+        auto res = ht.findForWrite(deleted);
+        ASSERT_TRUE(res.storedValue);
+        ht.unlocked_softDelete(
+                res.lock, *res.storedValue, false, DeleteSource::Explicit);
+    }
+    EXPECT_EQ(HashTable::OptimisticReadResult::Status::Fallback,
+              ht.findForReadOptimistic(deleted, Vbid(0)).status);
+
+    auto ejected = makeStoredDocKey("ejected");
+    store(ht, ejected);
+    {
+        auto res = ht.findForWrite(ejected);
+        res.storedValue->markClean();
+        ASSERT_TRUE(ht.unlocked_ejectItem(
+                res.lock, res.storedValue, EvictionPolicy::Value));
+    }
+    EXPECT_EQ(HashTable::OptimisticReadResult::Status::Fallback,
+              ht.findForReadOptimistic(ejected, Vbid(0)).status);
+
+    // Non-resident items are left to the locked path even if the value is
+    // not required.
+    EXPECT_EQ(HashTable::OptimisticReadResult::Status::Fallback,
+              ht.findForReadOptimistic(ejected,
+                                       Vbid(0),
+                                       TrackReference::No,
+                                       StoredValue::HideLockedCas::No,
+                                       StoredValue::IncludeValue::No)
+                      .status);
+}
+
+// Check that an optimistic read conflicting with a writer which holds the
+// hash bucket lock does not return a result.
+TEST_F(HashTableTest, OptimisticReadConflict) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 1,
+                 HashTable::ReadMode::Optimistic);
+    auto key = makeStoredDocKey("key");
+    store(ht, key);
+
+    {
+        auto res = ht.findForWrite(key);
+        ASSERT_TRUE(res.storedValue);
+        EXPECT_EQ(HashTable::OptimisticReadResult::Status::Fallback,
+                  ht.findForReadOptimistic(key, Vbid(0)).status);
+
+        // Once the lock is released the read should succeed again.
+        res.lock.unlock();
+        EXPECT_EQ(HashTable::OptimisticReadResult::Status::Found,
+                  ht.findForReadOptimistic(key, Vbid(0)).status);
+    }
+}
+
+// Stress test - optimistic readers racing with writers and resizes should
+// only ever observe complete items.
+TEST_F(HashTableTest, OptimisticReadConcurrentWriters) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 3,
+                 HashTable::ReadMode::Optimistic);
+    auto keys = generateKeys(1000);
+    storeMany(ht, keys);
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&ht, &keys, &stop]() {
+        size_t size = 1000;
+        while (!stop) {
+            for (const auto& key : keys) {
+                HashTableTest::del(ht, key);
+                store(ht, key);
+            }
+            ht.resize(size);
+            size = size == 1000 ? 3000 : 1000;
+        }
+    });
+
+    for (int iteration = 0; iteration < 20; ++iteration) {
+        for (const auto& key : keys) {
+            auto res = ht.findForReadOptimistic(key, Vbid(0));
+            if (res.status == HashTable::OptimisticReadResult::Status::Found) {
+                ASSERT_EQ(key, res.item->getKey());
+                ASSERT_EQ(key.to_string(),
+                          std::string(res.item->getData(),
+                                      res.item->getNBytes()));
+            }
+        }
+    }
+    stop = true;
+    writer.join();
+}
+
+// Check that a Tagged index finds items both when buckets fit in a TagGroup
+// and when they have overflowed, including after shrinking back.
+TEST_F(HashTableTest, TaggedIndexFind) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 1,
+                 HashTable::ReadMode::Locked,
+                 HashTable::IndexType::Tagged);
+    // 100 keys in 5 buckets - every bucket overflows its TagGroup.
+    auto keys = generateKeys(100);
+    storeMany(ht, keys);
+    for (const auto& key : keys) {
+        EXPECT_TRUE(ht.findForRead(key).storedValue) << key.to_string();
+    }
+    EXPECT_FALSE(ht.findForRead(makeStoredDocKey("missing")).storedValue);
+
+    // Delete all but 10 keys so buckets fit in their TagGroup again.
+    for (size_t i = 10; i < keys.size(); ++i) {
+        EXPECT_TRUE(del(ht, keys[i]));
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(i < 10, bool(ht.findForRead(keys[i]).storedValue))
+                << keys[i].to_string();
+    }
+
+    // And re-add them.
+    storeMany(ht, keys);
+    EXPECT_EQ(100, count(ht));
+    for (const auto& key : keys) {
+        EXPECT_TRUE(ht.findForRead(key).storedValue) << key.to_string();
+    }
+}
+
+// Check that the Tagged index is rebuilt on resize.
+TEST_F(HashTableTest, TaggedIndexResize) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 3,
+                 HashTable::ReadMode::Locked,
+                 HashTable::IndexType::Tagged);
+    auto keys = generateKeys(1000);
+    storeMany(ht, keys);
+
+    for (auto newSize : {6143, 769, 5}) {
+        ht.resize(newSize);
+        EXPECT_EQ(newSize, ht.getSize());
+        for (const auto& key : keys) {
+            ASSERT_TRUE(ht.findForRead(key).storedValue) << key.to_string();
+        }
+        EXPECT_FALSE(ht.findForRead(makeStoredDocKey("missing")).storedValue);
+    }
+}
+
+// Check that replacing (by copy, or reallocating) a StoredValue updates the
+// Tagged index to reference the new StoredValue.
+TEST_F(HashTableTest, TaggedIndexReplace) {
+    HashTable ht(global_stats,
+                 makeFactory(true),
+                 100,
+                 1,
+                 HashTable::ReadMode::Locked,
+                 HashTable::IndexType::Tagged);
+    auto keys = generateKeys(10);
+    storeMany(ht, keys);
+
+    for (const auto& key : keys) {
+        StoredValue* v = ht.findForWrite(key).storedValue;
+        ASSERT_NE(nullptr, v);
+        EXPECT_TRUE(ht.reallocateStoredValue(std::forward<StoredValue>(*v)));
+        StoredValue* newV = ht.findForWrite(key).storedValue;
+        ASSERT_NE(nullptr, newV);
+        EXPECT_NE(v, newV);
+
+        StoredValue* copy;
+        {
+            auto res = ht.findForWrite(key);
+            copy = ht.unlocked_replaceByCopy(res.lock, *res.storedValue).first;
+        }
+        EXPECT_NE(newV, copy);
+        EXPECT_EQ(copy, ht.findForWrite(key).storedValue);
+    }
+}
+
+// Check that items can be found, added and removed while an incremental
+// resize is in progress, and that migration moves all items.
+TEST_F(HashTableTest, IncrementalResize) {
+    for (auto indexType :
+         {HashTable::IndexType::Chained, HashTable::IndexType::Tagged}) {
+        HashTable ht(global_stats,
+                     makeFactory(),
+                     5,
+                     3,
+                     HashTable::ReadMode::Locked,
+                     indexType,
+                     HashTable::ResizeMode::Incremental);
+        auto keys = generateKeys(10000);
+        storeMany(ht, keys);
+
+        // Resize from 5 buckets completes in a single slice.
+        ht.resize(6143);
+        EXPECT_TRUE(ht.isResizeInProgress());
+        EXPECT_EQ(5, ht.getResizeProgress().bucketsTotal);
+        EXPECT_FALSE(ht.continueResize());
+        EXPECT_FALSE(ht.isResizeInProgress());
+        EXPECT_EQ(6143, ht.getSize());
+
+        // Growing from 6143 buckets takes multiple slices; step through
+        // one slice at a time checking items remain accessible.
+        ht.resize(12289);
+        EXPECT_EQ(12289, ht.getSize());
+        auto progress = ht.getResizeProgress();
+        EXPECT_EQ(0, progress.bucketsMigrated);
+        EXPECT_EQ(6143, progress.bucketsTotal);
+
+        // Another resize cannot start until this one completes.
+        ht.resize(3079);
+        EXPECT_EQ(12289, ht.getSize());
+
+        auto newKeys = generateKeys(11000, 10000);
+        size_t step = 0;
+        while (ht.isResizeInProgress()) {
+            for (const auto& key : keys) {
+                ASSERT_TRUE(ht.findForRead(key).storedValue)
+                        << key.to_string();
+            }
+            // Delete and re-add a key which may still be in the old table.
+            EXPECT_TRUE(del(ht, keys[step]));
+            EXPECT_FALSE(ht.findForRead(keys[step]).storedValue);
+            store(ht, keys[step]);
+
+            // Add new items (always to the new table).
+            store(ht, newKeys[step]);
+
+            ht.continueResize(std::chrono::steady_clock::duration::zero());
+            const auto next = ht.getResizeProgress();
+            if (ht.isResizeInProgress()) {
+                EXPECT_GT(next.bucketsMigrated, progress.bucketsMigrated);
+            }
+            progress = next;
+            ++step;
+        }
+        EXPECT_EQ(6, step);
+        EXPECT_EQ(0, ht.getResizeProgress().bucketsTotal);
+        EXPECT_EQ(10000 + step, count(ht));
+        for (const auto& key : keys) {
+            EXPECT_TRUE(ht.findForRead(key).storedValue) << key.to_string();
+        }
+    }
+}
+
+// Check that visiting a HashTable (blocking) completes an in-progress
+// incremental resize, so all items are visited exactly once.
+TEST_F(HashTableTest, IncrementalResizeVisit) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 3,
+                 HashTable::ReadMode::Locked,
+                 HashTable::IndexType::Chained,
+                 HashTable::ResizeMode::Incremental);
+    auto keys = generateKeys(10000);
+    storeMany(ht, keys);
+    ht.resize(6143);
+    ht.continueResize();
+    ht.resize(769);
+    ASSERT_TRUE(ht.isResizeInProgress());
+
+    EXPECT_EQ(10000, count(ht));
+    EXPECT_FALSE(ht.isResizeInProgress());
+    EXPECT_EQ(769, ht.getSize());
+}
+
+// Check that a pausable visitor started mid-resize only migrates a single
+// slice per call (pausing without visiting anything), rather than completing
+// the whole migration synchronously.
+TEST_F(HashTableTest, IncrementalResizePauseResumeVisit) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 3,
+                 HashTable::ReadMode::Locked,
+                 HashTable::IndexType::Chained,
+                 HashTable::ResizeMode::Incremental);
+    auto keys = generateKeys(10000);
+    storeMany(ht, keys);
+    ht.resize(6143);
+    ht.continueResize();
+    ht.resize(769);
+    ASSERT_TRUE(ht.isResizeInProgress());
+
+    Counter c(true);
+    HashTable::Position pos;
+    pos = ht.pauseResumeVisit(c, pos);
+    EXPECT_NE(ht.endPosition(), pos);
+    EXPECT_EQ(0, c.count);
+    EXPECT_TRUE(ht.isResizeInProgress());
+
+    while (pos != ht.endPosition()) {
+        pos = ht.pauseResumeVisit(c, pos);
+    }
+    EXPECT_EQ(10000, c.count);
+    EXPECT_FALSE(ht.isResizeInProgress());
+}
+
+// Check that clearing a HashTable abandons an in-progress incremental
+// resize.
+TEST_F(HashTableTest, IncrementalResizeClear) {
+    HashTable ht(global_stats,
+                 makeFactory(),
+                 5,
+                 3,
+                 HashTable::ReadMode::Locked,
+                 HashTable::IndexType::Chained,
+                 HashTable::ResizeMode::Incremental);
+    auto keys = generateKeys(10000);
+    storeMany(ht, keys);
+    ht.resize(6143);
+    ht.continueResize();
+    ht.resize(12289);
+    ASSERT_TRUE(ht.isResizeInProgress());
+
+    ht.clear();
+    EXPECT_FALSE(ht.isResizeInProgress());
+    EXPECT_EQ(0, ht.getNumItems());
+    EXPECT_EQ(0, count(ht));
+    storeMany(ht, keys);
+    EXPECT_EQ(10000, count(ht));
+}
@@ -19,6 +19,7 @@
 #include "item.h"
 #include "item_compressor_visitor.h"
 #include "test_helpers.h"
+#include "zstd_dictionary.h"
 
 TEST_P(ItemCompressorTest, testCompressionInActiveMode) {
     std::string compressibleValue(
@@ -128,6 +129,143 @@ TEST_P(ItemCompressorTest, testStoreUncompressedInActiveMode) {
     EXPECT_EQ(PROTOCOL_BINARY_DATATYPE_JSON, v->getDatatype());
 }
 
+// Test that with a dictionary trained from sampled documents the visitor
+// compresses values with Zstd, and that the values are decompressed when
+// read back out of the HashTable.
+TEST_P(ItemCompressorTest, testZstdCompressionInActiveMode) {
+    if (!ZstdDictionary::isSupported()) {
+        GTEST_SKIP();
+    }
+
+    auto makeValue = [](int ii) {
+        return R"({"product": "widget-)" + std::to_string(ii) +
+               R"(", "description": "A widget of the usual kind", )"
+               R"("price": )" +
+               std::to_string(ii * 7) + R"(, "stock": )" +
+               std::to_string(ii % 13) + "}";
+    };
+    const int numItems = 500;
+    for (int ii = 0; ii < numItems; ++ii) {
+        auto item = make_item(vbucket->getId(),
+                              makeStoredDocKey("key" + std::to_string(ii)),
+                              makeValue(ii),
+                              0,
+                              PROTOCOL_BINARY_DATATYPE_JSON);
+        ASSERT_EQ(MutationStatus::WasClean, public_processSet(item, 0));
+    }
+
+    const auto jsonCount =
+            vbucket->ht.getDatatypeCounts()[PROTOCOL_BINARY_DATATYPE_JSON];
+    const auto itemCount = vbucket->ht.getNumItems();
+
+    // First pass samples the documents (compressing with Snappy meanwhile).
+    PauseResumeVBAdapter sampler(std::make_unique<ItemCompressorVisitor>());
+    auto& samplingVisitor =
+            dynamic_cast<ItemCompressorVisitor&>(sampler.getHTVisitor());
+    samplingVisitor.setCompressionMode(BucketCompressionMode::Active);
+    samplingVisitor.setMinCompressionRatio(config.getMinCompressionRatio());
+    samplingVisitor.setZstdSampleLimit(1024 * 1024);
+    sampler.visit(*vbucket);
+    EXPECT_EQ(samplingVisitor.getCompressedCount(),
+              vbucket->ht.getDatatypeCounts()[PROTOCOL_BINARY_DATATYPE_JSON |
+                                              PROTOCOL_BINARY_DATATYPE_SNAPPY]);
+    EXPECT_FALSE(samplingVisitor.isZstdSampleLimitReached());
+
+    auto samples = samplingVisitor.takeZstdSamples();
+    ASSERT_EQ(size_t(numItems), samples.size());
+    auto dictionary = ZstdDictionary::train(samples, 4096, 3);
+    ASSERT_TRUE(dictionary);
+
+    // Second pass compresses with the dictionary.
+    PauseResumeVBAdapter prAdapter(std::make_unique<ItemCompressorVisitor>());
+    auto& visitor =
+            dynamic_cast<ItemCompressorVisitor&>(prAdapter.getHTVisitor());
+    visitor.setCompressionMode(BucketCompressionMode::Active);
+    visitor.setMinCompressionRatio(config.getMinCompressionRatio());
+    visitor.setZstdDictionary(dictionary.get());
+    prAdapter.visit(*vbucket);
+    EXPECT_EQ(size_t(numItems), visitor.getCompressedCount());
+
+    // The datatype is unchanged - the encoding never leaves the engine.
+    EXPECT_EQ(jsonCount,
+              vbucket->ht.getDatatypeCounts()[PROTOCOL_BINARY_DATATYPE_JSON]);
+    EXPECT_EQ(itemCount, vbucket->ht.getNumItems());
+
+    for (int ii = 0; ii < numItems; ++ii) {
+        const auto value = makeValue(ii);
+        auto* v = findValue(makeStoredDocKey("key" + std::to_string(ii)));
+        ASSERT_NE(nullptr, v);
+        EXPECT_TRUE(v->isZstdCompressed());
+        EXPECT_FALSE(v->isCompressible());
+        EXPECT_EQ(PROTOCOL_BINARY_DATATYPE_JSON, v->getDatatype());
+        EXPECT_LT(v->valuelen(), value.size());
+        EXPECT_EQ(value.size(), v->uncompressedValuelen());
+        EXPECT_EQ(value, v->getDecodedValue()->to_s());
+        EXPECT_EQ(value, v->toItem(vbucket->getId())->getValue()->to_s());
+    }
+
+    // Replacing the value drops the Zstd encoding.
+    auto item = make_item(vbucket->getId(),
+                          makeStoredDocKey("key0"),
+                          makeValue(numItems),
+                          0,
+                          PROTOCOL_BINARY_DATATYPE_JSON);
+    const auto rv = public_processSet(item, 0);
+    ASSERT_TRUE(rv == MutationStatus::WasClean ||
+                rv == MutationStatus::WasDirty);
+    auto* v = findValue(makeStoredDocKey("key0"));
+    EXPECT_FALSE(v->isZstdCompressed());
+    EXPECT_EQ(makeValue(numItems), v->getValue()->to_s());
+}
+
+// Test that when sampling for a Zstd dictionary values are still compressed
+// with Snappy, so a bucket with too few documents to train a dictionary from
+// is compressed as with compression_codec=snappy.
+TEST_P(ItemCompressorTest, testZstdTooFewSamplesCompressesWithSnappy) {
+    if (!ZstdDictionary::isSupported()) {
+        GTEST_SKIP();
+    }
+
+    std::string compressibleValue(
+            "{\"product\": \"car\",\"price\": \"100\"},"
+            "{\"product\": \"bus\",\"price\": \"1000\"},"
+            "{\"product\": \"Train\",\"price\": \"100000\"}");
+    const int numItems = ZstdDictionary::MinSamples - 1;
+    for (int ii = 0; ii < numItems; ++ii) {
+        auto item = make_item(vbucket->getId(),
+                              makeStoredDocKey("key" + std::to_string(ii)),
+                              compressibleValue,
+                              0,
+                              PROTOCOL_BINARY_DATATYPE_JSON);
+        ASSERT_EQ(MutationStatus::WasClean, public_processSet(item, 0));
+    }
+
+    PauseResumeVBAdapter sampler(std::make_unique<ItemCompressorVisitor>());
+    auto& visitor =
+            dynamic_cast<ItemCompressorVisitor&>(sampler.getHTVisitor());
+    visitor.setCompressionMode(BucketCompressionMode::Active);
+    visitor.setMinCompressionRatio(config.getMinCompressionRatio());
+    visitor.setZstdSampleLimit(1024 * 1024);
+    sampler.visit(*vbucket);
+    EXPECT_EQ(size_t(numItems), visitor.getCompressedCount());
+
+    auto samples = visitor.takeZstdSamples();
+    ASSERT_EQ(size_t(numItems), samples.size());
+    for (const auto& sample : samples) {
+        EXPECT_EQ(compressibleValue, sample);
+    }
+    EXPECT_FALSE(ZstdDictionary::train(samples, 4096, 3));
+
+    for (int ii = 0; ii < numItems; ++ii) {
+        auto* v = findValue(makeStoredDocKey("key" + std::to_string(ii)));
+        ASSERT_NE(nullptr, v);
+        EXPECT_FALSE(v->isZstdCompressed());
+        EXPECT_EQ(PROTOCOL_BINARY_DATATYPE_JSON |
+                          PROTOCOL_BINARY_DATATYPE_SNAPPY,
+                  v->getDatatype());
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
         AllVBTypesAllEvictionModes,
         ItemCompressorTest,
@@ -53,3 +53,40 @@ TEST(ItemEvictionClassTest, freqThreshold) {
     EXPECT_EQ(255, result100.first);
     EXPECT_EQ(510, result100.second);
 }
+
+// Test that the frequency threshold is exact regardless of how many values
+// have been added, and that copyFreqHistogram copies every value.
+TEST(ItemEvictionClassTest, copyFreqHistogram) {
+    ItemEviction itemEv;
+    for (int ii = 0; ii < 1000; ii++) {
+        itemEv.addFreqAndAgeToHistograms(ii % 10 == 0 ? 255 : ii % 4, ii);
+    }
+    // 90% of the values have a frequency of 0-3, the rest 255.
+    EXPECT_EQ(0, itemEv.getThresholds(20.0, 50.0).first);
+    EXPECT_EQ(1, itemEv.getThresholds(40.0, 50.0).first);
+    EXPECT_EQ(3, itemEv.getThresholds(90.0, 50.0).first);
+    EXPECT_EQ(255, itemEv.getThresholds(91.0, 50.0).first);
+
+    HdrUint8Histogram hist;
+    itemEv.copyFreqHistogram(hist);
+    EXPECT_EQ(1000, hist.getValueCount());
+    EXPECT_EQ(1, hist.getValueAtPercentile(40.0));
+    EXPECT_EQ(255, hist.getValueAtPercentile(91.0));
+
+    itemEv.reset();
+    EXPECT_EQ(0, itemEv.getFreqHistogramValueCount());
+    EXPECT_EQ(0, itemEv.getThresholds(50.0, 50.0).first);
+}
+
+// Test that once past the learning population the sampled ages still give
+// (approximately) the right age threshold.
+TEST(ItemEvictionClassTest, ageSampling) {
+    ItemEviction itemEv;
+    for (uint64_t ii = 0; ii < 100000; ii++) {
+        itemEv.addFreqAndAgeToHistograms(0, ii);
+    }
+    EXPECT_EQ(100000, itemEv.getFreqHistogramValueCount());
+    // The age histogram has 1 significant figure of precision
+    auto ageThreshold = itemEv.getThresholds(50.0, 50.0).second;
+    EXPECT_NEAR(50000, ageThreshold, 5000);
+}
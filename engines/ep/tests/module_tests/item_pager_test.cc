@@ -40,6 +40,7 @@
 #include <programs/engine_testapp/mock_server.h>
 #include <statistics/labelled_collector.h>
 #include <string_utilities.h>
+#include <utilities/test_manifest.h>
 #include <xattr/blob.h>
 #include <xattr/utils.h>
 
@@ -348,6 +349,74 @@ protected:
         return (numItems != 0) ? size_t((numResident * 100.0) / numItems) : 100;
     }
 
+    /// @return a paging visitor which tries to evict everything eligible
+    std::unique_ptr<MockPagingVisitor> makeEvictAllPagingVisitor() {
+        auto available = std::make_shared<std::atomic<bool>>();
+        auto& config = engine->getConfiguration();
+        return std::make_unique<MockPagingVisitor>(
+                *store,
+                engine->getEpStats(),
+                EvictionRatios{1.0 /* active&pending */, 1.0 /* replica */},
+                available,
+                ITEM_PAGER,
+                false,
+                VBucketFilter(),
+                config.getItemEvictionAgePercentage(),
+                config.getItemEvictionFreqCounterAgeThreshold());
+    }
+
+    /// @return true if the key is in the HashTable with its value resident
+    bool isResident(const DocKey& key) {
+        auto res = store->getVBucket(vbid)->ht.findOnlyCommitted(key);
+        return res.storedValue && res.storedValue->isResident();
+    }
+
+    /**
+     * Check that the eviction priority of their collection orders which
+     * (equally hot) items the paging visitor evicts first, in a vBucket of
+     * the given state: low, then normal, then high priority.
+     */
+    void testCollectionEvictionPriority(vbucket_state_t state) {
+        CollectionsManifest cm;
+        cm.add(CollectionEntry::fruit).add(CollectionEntry::vegetable);
+        cm.setEvictionSettings(CollectionEntry::fruit, 0, "low");
+        cm.setEvictionSettings(CollectionEntry::vegetable, 0, "high");
+        setCollections(cookie, cm);
+
+        const auto low = makeStoredDocKey("low", CollectionEntry::fruit);
+        const auto normal = makeStoredDocKey("normal");
+        const auto high = makeStoredDocKey("high", CollectionEntry::vegetable);
+        for (const auto& key : {low, normal, high}) {
+            auto item = make_item(vbid, key, std::string(512, 'x'));
+            ASSERT_EQ(cb::engine_errc::success, storeItem(item));
+        }
+        flushDirectlyIfPersistent(vbid);
+        if (state != vbucket_state_active) {
+            setVBucketStateAndRunPersistTask(vbid, state);
+        }
+
+        auto pv = makeEvictAllPagingVisitor();
+        auto vb = store->getVBucket(vbid);
+        pv->setCurrentBucket(vb);
+
+        // All of the items have the same frequency counter; a threshold of
+        // 0 only evicts those of the low priority collection
+        pv->setFreqCounterThreshold(0);
+        vb->ht.visit(*pv);
+        EXPECT_FALSE(isResident(low));
+        EXPECT_TRUE(isResident(normal));
+        EXPECT_TRUE(isResident(high));
+
+        pv->setFreqCounterThreshold(Item::initialFreqCount);
+        vb->ht.visit(*pv);
+        EXPECT_FALSE(isResident(normal));
+        EXPECT_TRUE(isResident(high));
+
+        pv->setFreqCounterThreshold(std::numeric_limits<uint8_t>::max());
+        vb->ht.visit(*pv);
+        EXPECT_FALSE(isResident(high));
+    }
+
     /// Has the item pager been scheduled to run?
     bool itemPagerScheduled = false;
 };
@@ -1346,6 +1415,73 @@ TEST_P(STItemPagerTest, MB43559_EvictionWithoutReplicasReachesLWM) {
 /**
  * Test fixture for Ephemeral-only item pager tests.
  */
+// Test that the paging visitor doesn't evict the items of a collection which
+// uses no more than its memory share, but does evict those of others.
+TEST_P(STItemPagerTest, CollectionWithinMemoryShareNotEvicted) {
+    if (ephemeral()) {
+        // Ephemeral deletes rather than ejects items; only check residency
+        // of ejected values.
+        GTEST_SKIP();
+    }
+
+    CollectionsManifest cm;
+    cm.add(CollectionEntry::fruit).add(CollectionEntry::vegetable);
+    cm.setEvictionSettings(CollectionEntry::fruit, 50, "normal");
+    setCollections(cookie, cm);
+
+    std::vector<StoredDocKey> shared;
+    std::vector<StoredDocKey> others;
+    for (int ii = 0; ii < 10; ++ii) {
+        shared.push_back(makeStoredDocKey("key-" + std::to_string(ii),
+                                          CollectionEntry::fruit));
+        others.push_back(makeStoredDocKey("key-" + std::to_string(ii),
+                                          CollectionEntry::vegetable));
+        others.push_back(makeStoredDocKey("key-" + std::to_string(ii)));
+    }
+    for (const auto* keys : {&shared, &others}) {
+        for (const auto& key : *keys) {
+            auto item = make_item(vbid, key, std::string(512, 'x'));
+            ASSERT_EQ(cb::engine_errc::success, storeItem(item));
+        }
+    }
+    flushDirectlyIfPersistent(vbid);
+
+    // The collection is far within 50% of the quota
+    auto& stats = engine->getEpStats();
+    ASSERT_LT(stats.getCollectionMemStats(CollectionEntry::fruit).memUsed,
+              stats.getMaxDataSize() / 2);
+
+    auto pv = makeEvictAllPagingVisitor();
+    auto vb = store->getVBucket(vbid);
+    pv->setCurrentBucket(vb);
+    pv->setFreqCounterThreshold(std::numeric_limits<uint8_t>::max());
+    vb->ht.visit(*pv);
+
+    for (const auto& key : shared) {
+        EXPECT_TRUE(isResident(key)) << key.to_string();
+    }
+    for (const auto& key : others) {
+        EXPECT_FALSE(isResident(key)) << key.to_string();
+    }
+}
+
+TEST_P(STItemPagerTest, CollectionEvictionPriority) {
+    if (ephemeral()) {
+        // Ephemeral deletes rather than ejects items; only check residency
+        // of ejected values.
+        GTEST_SKIP();
+    }
+    testCollectionEvictionPriority(vbucket_state_active);
+}
+
+TEST_P(STItemPagerTest, CollectionEvictionPriorityReplica) {
+    if (ephemeral()) {
+        // Ephemeral does not evict from replicas
+        GTEST_SKIP();
+    }
+    testCollectionEvictionPriority(vbucket_state_replica);
+}
+
 class STEphemeralItemPagerTest : public STItemPagerTest {
 };
 
@@ -262,6 +262,12 @@ enum class ClientOpcode : uint8_t {
      */
     CollectionsGetScopeID = 0xbc,
 
+    /**
+     * Command to fetch multiple documents (possibly from different
+     * vbuckets and collections) with a single request
+     */
+    GetMulti = 0xbd,
+
     /**
      * Commands for GO-XDCR
      */
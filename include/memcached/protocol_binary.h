@@ -2239,5 +2239,33 @@ public:
 protected:
     CollectionIDType collectionId{0};
 };
+
+// Each key in the value of a get_multi (opcode 0xbd) request is encoded as
+// this header followed by keylen bytes of key. Data stored in network byte
+// order
+class GetMultiKeySpec {
+public:
+    GetMultiKeySpec() = default;
+    GetMultiKeySpec(Vbid vbucket, uint16_t keylen)
+        : vbucket(vbucket.hton()), keylen(htons(keylen)) {
+    }
+
+    Vbid getVBucket() const {
+        return vbucket.ntoh();
+    }
+
+    uint16_t getKeylen() const {
+        return ntohs(keylen);
+    }
+
+    std::string_view getBuffer() const {
+        return {reinterpret_cast<const char*>(this), sizeof(*this)};
+    }
+
+protected:
+    Vbid vbucket{0};
+    uint16_t keylen{0};
+};
+static_assert(sizeof(GetMultiKeySpec) == 4, "Unexpected struct size");
 #pragma pack()
 } // namespace cb::mcbp::request
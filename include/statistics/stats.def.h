@@ -129,6 +129,10 @@ STAT(ep_diskqueue_items, , count, , )
 STAT(ep_commit_num, , count, , )
 STAT(ep_commit_time, , microseconds, , )
 STAT(ep_commit_time_total, , microseconds, , )
+STAT(ep_flusher_batch_size, , count, , )
+STAT(ep_flusher_pacing_delay, , microseconds, , )
+STAT(ep_flusher_batch_size_increases, , count, , )
+STAT(ep_flusher_batch_size_decreases, , count, , )
 STAT(ep_item_begin_failed, , count, , )
 STAT(ep_item_commit_failed, , count, , )
 STAT(ep_item_flush_expired, , count, , )
@@ -177,6 +181,7 @@ STAT(ep_tmp_oom_errors, , count, , )
 STAT(ep_mem_tracker_enabled, , none, , )
 STAT(ep_bg_fetched, , count, , )
 STAT(ep_bg_meta_fetched, , count, , )
+STAT(ep_bg_fetch_not_admitted, , count, , )
 STAT(ep_bg_remaining_items, , count, , )
 STAT(ep_bg_remaining_jobs, , count, , )
 STAT(ep_num_pager_runs, , count, , )
@@ -184,6 +189,7 @@ STAT(ep_num_expiry_pager_runs, , count, , )
 STAT(ep_num_freq_decayer_runs, , count, , )
 STAT(ep_items_expelled_from_checkpoints, , count, , )
 STAT(ep_items_rm_from_checkpoints, , count, , )
+STAT(ep_dcp_cursor_batches_shared, , count, , )
 STAT(ep_num_value_ejects, , count, , )
 STAT(ep_num_eject_failures, , count, , )
 STAT(ep_num_not_my_vbuckets, , count, , )
@@ -264,6 +270,7 @@ STAT(ep_io_total_write_bytes, , bytes, , )
 STAT(ep_io_compaction_read_bytes, , bytes, , )
 STAT(ep_io_compaction_write_bytes, , bytes, , )
 STAT(ep_io_bg_fetch_read_count, , count, , )
+STAT(ep_bg_fetch_coalesced, , count, , )
 STAT(ep_bg_fetch_avg_read_amplification, , ratio, , )
 
 // Magma stats
@@ -425,6 +432,16 @@ STAT(bytes_subdoc_lookup_total,
 STAT(bytes_subdoc_lookup_extracted, , bytes, subdoc_lookup_extracted, )
 STAT(bytes_subdoc_mutation_total, , bytes, subdoc_mutation_updated, )
 STAT(bytes_subdoc_mutation_inserted, , bytes, subdoc_mutation_inserted, )
+STAT(subdoc_lookup_cache_hits,
+     ,
+     count,
+     subdoc_lookup_cache_lookups,
+     LABEL(result, hit))
+STAT(subdoc_lookup_cache_misses,
+     ,
+     count,
+     subdoc_lookup_cache_lookups,
+     LABEL(result, miss))
 // aggregates over all buckets
 STAT(cmd_total_sets, , count, , )
 STAT(cmd_total_gets, , count, , )
@@ -448,6 +465,7 @@ STAT(cas_hits, , count, ops, LABEL(op, cas), LABEL(result, hit))
 STAT(cas_badval, , count, ops, LABEL(op, cas), LABEL(result, badval))
 STAT(bytes_read, , bytes, read, ) // type _bytes will be suffixed
 STAT(bytes_written, , bytes, written, )
+STAT(direct_sends, , count, , )
 STAT(rejected_conns, , count, , )
 STAT(threads, , count, , )
 STAT(conn_yields, , count, , )
@@ -584,6 +602,8 @@ STAT(manifest_force, "force", none, , )
 STAT(collection_name, "name", none, , )
 STAT(collection_scope_name, "scope_name", none, , )
 STAT(collection_maxTTL, "maxTTL", seconds, , )
+STAT(collection_memory_share, "memory_share", percent, , )
+STAT(collection_eviction_priority, "eviction_priority", none, , )
 
 STAT(scope_name, "name", none, , )
 STAT(scope_collection_count, "collections", count, , )
@@ -591,6 +611,7 @@ STAT(scope_collection_count, "collections", count, , )
 STAT(collection_mem_used, "collections_mem_used", bytes, , )
 STAT(collection_item_count, "items", count, , )
 STAT(collection_disk_size, "disk_size", bytes, , )
+STAT(collection_resident_ratio, "resident_ratio", percent, , )
 
 STAT(collection_ops_store, "ops_store", count, collection_ops, LABEL(op, store))
 STAT(collection_ops_delete,
@@ -86,7 +86,8 @@ public:
      * Replace the contents of the Blob with the given buffer.
      *
      * If the incoming buffer is snappy compressed, it must contain a
-     * compressed xattr value.
+     * compressed xattr value. Only the xattrs are inflated (into a buffer
+     * owned by the Blob); the body of the value is left compressed.
      *
      * @param buffer an existing buffer to use
      * @param compressed the buffer contains snappy compressed data
@@ -281,7 +282,7 @@ private:
 
     cb::char_buffer blob;
 
-    /// When the incoming data is compressed will auto-decompress into this
+    /// When the incoming data is compressed the xattrs are inflated into this
     cb::compression::Buffer decompressed;
 
     std::unique_ptr<char[]>& allocator;
@@ -16,7 +16,10 @@
  */
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace cb {
 /**
@@ -105,6 +108,32 @@ static std::string_view XTOC = {"$XTOC", 5};
  */
 size_t get_system_xattr_size(uint8_t datatype, std::string_view doc);
 
+/**
+ * Inflate the first bytes of a Snappy compressed buffer.
+ *
+ * Snappy only ever copies from data which is already inflated, so the start
+ * of a compressed document (e.g. its xattrs) can be inflated without
+ * inflating the rest of it.
+ *
+ * @param input the Snappy compressed data
+ * @param output where to store the inflated data (room for size bytes)
+ * @param size the number of bytes to inflate
+ * @return true if the bytes were inflated, false if the input isn't valid
+ *         Snappy data or inflates to less than size bytes
+ */
+bool inflate_prefix(std::string_view input, char* output, size_t size);
+
+/**
+ * Get the offset of the body into the provided Snappy compressed payload
+ * (i.e. the number of bytes the xattrs occupy once inflated), inflating
+ * only the length word.
+ *
+ * @param payload the compressed payload to check
+ * @return The number of bytes into the inflated payload where the body lives
+ * @throws std::invalid_argument if the payload can't be inflated
+ */
+uint32_t get_compressed_body_offset(std::string_view payload);
+
 /**
  * Get the size of the body chunk in the provided value, which may not contain
  * any xattr.
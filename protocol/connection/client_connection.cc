@@ -1028,6 +1028,60 @@ void MemcachedConnection::mget(
     } while (!done);
 }
 
+void MemcachedConnection::getMulti(
+        const std::vector<std::pair<const std::string, Vbid>>& id,
+        std::function<void(std::unique_ptr<Document>&)> documentCallback,
+        std::function<void(const std::string&, const cb::mcbp::Response&)>
+                errorCallback,
+        GetFrameInfoFunction getFrameInfo) {
+    std::string value;
+    for (const auto& doc : id) {
+        const cb::mcbp::request::GetMultiKeySpec spec(
+                doc.second, gsl::narrow<uint16_t>(doc.first.size()));
+        value.append(spec.getBuffer());
+        value.append(doc.first);
+    }
+
+    BinprotGenericCommand command{cb::mcbp::ClientOpcode::GetMulti};
+    command.setValue(std::move(value));
+    applyFrameInfos(command, getFrameInfo);
+    sendCommand(command);
+
+    // The server sends one response per key, and terminates the sequence
+    // with a response without a key
+    while (true) {
+        BinprotResponse rsp;
+        recvResponse(rsp);
+        if (rsp.getOp() != cb::mcbp::ClientOpcode::GetMulti) {
+            throw std::runtime_error(
+                    "MemcachedConnection::getMulti: Received unexpected "
+                    "opcode: " +
+                    ::to_string(rsp.getOp()));
+        }
+        if (rsp.getKey().empty()) {
+            if (!rsp.isSuccess()) {
+                throw ConnectionError("Failed getMulti", rsp.getStatus());
+            }
+            return;
+        }
+
+        BinprotGetResponse getResponse(std::move(rsp));
+        const auto key = getResponse.getKeyString();
+        if (getResponse.isSuccess()) {
+            auto doc = std::make_unique<Document>();
+            doc->info.flags = getResponse.getDocumentFlags();
+            doc->info.cas = getResponse.getCas();
+            doc->info.id = key;
+            doc->info.datatype = getResponse.getResponse().getDatatype();
+            doc->value = getResponse.getDataString();
+            documentCallback(doc);
+        } else if (errorCallback &&
+                   getResponse.getStatus() != cb::mcbp::Status::KeyEnoent) {
+            errorCallback(key, getResponse.getResponse());
+        }
+    }
+}
+
 Frame MemcachedConnection::encodeCmdGet(const std::string& id, Vbid vbucket) {
     BinprotGetCommand command;
     command.setKey(id);
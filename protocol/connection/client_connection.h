@@ -456,6 +456,27 @@ public:
                       errorCallback = {},
               GetFrameInfoFunction getFrameInfo = {});
 
+    /**
+     * Fetch multiple documents with a single GetMulti command
+     *
+     * Fire the documentCallback with the documents found in the server,
+     * and the errorCallback for the documents which failed (other than
+     * the ones which don't exist).
+     *
+     * @param id The key and the vbucket the document resides in
+     * @param documentCallback the callback with the document for an
+     *                         operation
+     * @param errorCallback the callback if the server returns an error
+     * @param getFrameInfo Optional FrameInfo to inject to the command
+     * @throws ConnectionError if the command failed
+     */
+    void getMulti(
+            const std::vector<std::pair<const std::string, Vbid>>& id,
+            std::function<void(std::unique_ptr<Document>&)> documentCallback,
+            std::function<void(const std::string&, const cb::mcbp::Response&)>
+                    errorCallback = {},
+            GetFrameInfoFunction getFrameInfo = {});
+
     /**
      * Fetch and lock a document from the server
      *
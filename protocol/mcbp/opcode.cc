@@ -160,6 +160,7 @@ bool is_valid_opcode(ClientOpcode opcode) {
     case ClientOpcode::CollectionsGetManifest:
     case ClientOpcode::CollectionsGetID:
     case ClientOpcode::CollectionsGetScopeID:
+    case ClientOpcode::GetMulti:
     case ClientOpcode::SetDriftCounterState_Unsupported:
     case ClientOpcode::GetAdjustedTime_Unsupported:
     case ClientOpcode::SubdocGet:
@@ -358,6 +359,7 @@ bool is_durability_supported(ClientOpcode opcode) {
     case ClientOpcode::CollectionsGetManifest:
     case ClientOpcode::CollectionsGetID:
     case ClientOpcode::CollectionsGetScopeID:
+    case ClientOpcode::GetMulti:
     case ClientOpcode::SetDriftCounterState_Unsupported:
     case ClientOpcode::GetAdjustedTime_Unsupported:
     case ClientOpcode::SubdocGet:
@@ -540,6 +542,7 @@ bool is_reorder_supported(ClientOpcode opcode) {
     case ClientOpcode::CollectionsGetManifest:
     case ClientOpcode::CollectionsGetID:
     case ClientOpcode::CollectionsGetScopeID:
+    case ClientOpcode::GetMulti:
     case ClientOpcode::SetDriftCounterState_Unsupported:
     case ClientOpcode::GetAdjustedTime_Unsupported:
     case ClientOpcode::Scrub:
@@ -723,6 +726,7 @@ bool is_collection_command(ClientOpcode opcode) {
     case ClientOpcode::CollectionsGetManifest:
     case ClientOpcode::CollectionsGetID:
     case ClientOpcode::CollectionsGetScopeID:
+    case ClientOpcode::GetMulti:
     case ClientOpcode::SetDriftCounterState_Unsupported:
     case ClientOpcode::GetAdjustedTime_Unsupported:
     case ClientOpcode::Scrub:
@@ -896,6 +900,7 @@ bool is_preserve_ttl_supported(ClientOpcode opcode) {
     case ClientOpcode::CollectionsGetManifest:
     case ClientOpcode::CollectionsGetID:
     case ClientOpcode::CollectionsGetScopeID:
+    case ClientOpcode::GetMulti:
     case ClientOpcode::SetDriftCounterState_Unsupported:
     case ClientOpcode::GetAdjustedTime_Unsupported:
     case ClientOpcode::SubdocGet:
@@ -1198,6 +1203,8 @@ std::string to_string(cb::mcbp::ClientOpcode opcode) {
         return "COLLECTIONS_GET_ID";
     case ClientOpcode::CollectionsGetScopeID:
         return "COLLECTIONS_GET_SCOPE_ID";
+    case ClientOpcode::GetMulti:
+        return "GET_MULTI";
     case ClientOpcode::SetDriftCounterState_Unsupported:
         return "SET_DRIFT_COUNTER_STATE";
     case ClientOpcode::GetAdjustedTime_Unsupported:
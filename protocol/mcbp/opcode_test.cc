@@ -163,6 +163,7 @@ const std::map<cb::mcbp::ClientOpcode, std::string> client_blueprint = {
          {ClientOpcode::CollectionsGetManifest, "COLLECTIONS_GET_MANIFEST"},
          {ClientOpcode::CollectionsGetID, "COLLECTIONS_GET_ID"},
          {ClientOpcode::CollectionsGetScopeID, "COLLECTIONS_GET_SCOPE_ID"},
+         {ClientOpcode::GetMulti, "GET_MULTI"},
          {ClientOpcode::SetDriftCounterState_Unsupported,
           "SET_DRIFT_COUNTER_STATE"},
          {ClientOpcode::GetAdjustedTime_Unsupported, "GET_ADJUSTED_TIME"},
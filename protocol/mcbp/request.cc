@@ -211,6 +211,7 @@ bool Request::isQuiet() const {
         case ClientOpcode::CollectionsGetManifest:
         case ClientOpcode::CollectionsGetID:
         case ClientOpcode::CollectionsGetScopeID:
+        case ClientOpcode::GetMulti:
         case ClientOpcode::SetDriftCounterState_Unsupported:
         case ClientOpcode::GetAdjustedTime_Unsupported:
         case ClientOpcode::SubdocGet:
@@ -21,6 +21,7 @@
 
 #include <benchmark/benchmark.h>
 #include <daemon/timing_histogram.h>
+#include <daemon/timings.h>
 #include <folly/portability/GTest.h>
 #include <nlohmann/json.hpp>
 #include <utilities/hdrhistogram.h>
@@ -203,6 +204,32 @@ void HistogramToJson(benchmark::State& state) {
     }
 }
 
+/**
+ * Cost of recording command timings (as every front-end thread does for
+ * each command) when many threads record into the same Timings.
+ */
+static void TimingsCollect(benchmark::State& state) {
+    static Timings timings;
+    int64_t ii = 0;
+    while (state.KeepRunning()) {
+        timings.collect(cb::mcbp::ClientOpcode::Get,
+                        std::chrono::microseconds(1 + (ii++ & 0xff)));
+    }
+}
+
+/// Cost of reading (merging) the timings of an opcode for mctimings
+static void TimingsGenerate(benchmark::State& state) {
+    Timings timings;
+    for (int64_t ii = 0; ii < state.range(0); ++ii) {
+        timings.collect(cb::mcbp::ClientOpcode::Get,
+                        std::chrono::microseconds(ii));
+    }
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(
+                timings.generate(cb::mcbp::ClientOpcode::Get));
+    }
+}
+
 BENCHMARK_TEMPLATE(HistogramConstructionDestructionHeap, TimingHistogram);
 BENCHMARK_TEMPLATE(HistogramConstructionDestructionHeap, HdrHistogramBench);
 BENCHMARK_TEMPLATE(HistogramConstructionDestructionHeap, HdrHistogramEmpty);
@@ -239,4 +266,7 @@ BENCHMARK_TEMPLATE(HistogramReset, HdrHistogramEmpty);
 BENCHMARK_TEMPLATE(HistogramAggregation, TimingHistogram)->Arg(100);
 BENCHMARK_TEMPLATE(HistogramAggregation, HdrHistogramBench)->Arg(100);
 
+BENCHMARK(TimingsCollect)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(TimingsGenerate)->Arg(10000);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,63 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/*
+ * Benchmarks comparing cb::json::Validator with JSON_checker.
+ */
+
+#include <JSON_checker.h>
+#include <benchmark/benchmark.h>
+#include <utilities/json_validator.h>
+
+#include <string>
+
+/// @return a JSON document of (about) the given size, resembling a
+///         typical application document
+static std::string makeDocument(size_t size) {
+    std::string document = "[";
+    for (int ii = 0; document.size() < size; ++ii) {
+        document += R"({"id":)" + std::to_string(ii) +
+                    R"(,"name":"Customer )" + std::to_string(ii) +
+                    R"(","email":"customer@example.com","active":true,)"
+                    R"("balance":1234.56,"tags":["gold","europe"]},)";
+    }
+    document.back() = ']';
+    return document;
+}
+
+static void BM_JsonValidator(benchmark::State& state) {
+    const auto document = makeDocument(state.range(0));
+    cb::json::Validator validator;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(validator.validate(document));
+    }
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+
+static void BM_JsonChecker(benchmark::State& state) {
+    const auto document = makeDocument(state.range(0));
+    JSON_checker::Validator validator;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(validator.validate(document));
+    }
+    state.SetBytesProcessed(state.iterations() * document.size());
+}
+
+BENCHMARK(BM_JsonValidator)->RangeMultiplier(32)->Range(100, 1024 * 1024);
+BENCHMARK(BM_JsonChecker)->RangeMultiplier(32)->Range(100, 1024 * 1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,139 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <JSON_checker.h>
+#include <folly/portability/GTest.h>
+#include <utilities/json_validator.h>
+
+#include <string>
+#include <vector>
+
+class JsonValidatorTest : public ::testing::Test {
+protected:
+    /// Check the validator agrees with JSON_checker about the document
+    void expectSameAsJsonChecker(const std::string& document) {
+        EXPECT_EQ(jsonChecker.validate(document), validator.validate(document))
+                << "document: " << document;
+    }
+
+    cb::json::Validator validator;
+    JSON_checker::Validator jsonChecker;
+};
+
+TEST_F(JsonValidatorTest, Valid) {
+    const std::vector<std::string> documents = {
+            "{}",
+            "[]",
+            "0",
+            "-0",
+            "12.5e-3",
+            "1E+10",
+            R"("string")",
+            "true",
+            "false",
+            "null",
+            " \t\r\n{} \t\r\n",
+            R"({"a":[1,2,{"b":null}],"c":{}})",
+            R"([[[[[[]]]]]])",
+            R"("\"\\\/\b\f\n\r\t\u00e9")",
+            "\"\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80\""};
+    for (const auto& document : documents) {
+        EXPECT_TRUE(validator.validate(document)) << document;
+        expectSameAsJsonChecker(document);
+    }
+}
+
+TEST_F(JsonValidatorTest, Invalid) {
+    const std::vector<std::string> documents = {"",
+                                                " ",
+                                                "{",
+                                                "[1,]",
+                                                R"({"a":1,})",
+                                                R"({"a"})",
+                                                "{a:1}",
+                                                "[1 2]",
+                                                "[1}",
+                                                "{} {}",
+                                                "01",
+                                                "1.",
+                                                ".5",
+                                                "-",
+                                                "1e",
+                                                "+1",
+                                                "tru",
+                                                "truee",
+                                                "nul",
+                                                "NaN",
+                                                R"("unterminated)",
+                                                R"("\x")",
+                                                R"("\u12g4")",
+                                                "\"\x01\"",
+                                                "\"\xc3\"",
+                                                "\"\xff\"",
+                                                "'single'"};
+    for (const auto& document : documents) {
+        EXPECT_FALSE(validator.validate(document)) << document;
+        expectSameAsJsonChecker(document);
+    }
+}
+
+// UTF-8 which is well-formed only by a lax decoder - overlong encodings,
+// surrogates and code points above U+10FFFF - is rejected (RFC 3629). This is
+// intentionally stricter than JSON_checker (so not expectSameAsJsonChecker):
+// such a value must not be given the JSON datatype, as clients decoding it
+// as JSON would reject it.
+TEST_F(JsonValidatorTest, StrictUtf8) {
+    EXPECT_FALSE(validator.validate("\"\xc0\xaf\""));
+    EXPECT_FALSE(validator.validate("\"\xe0\x80\xaf\""));
+    EXPECT_FALSE(validator.validate("\"\xed\xa0\x80\""));
+    EXPECT_FALSE(validator.validate("\"\xf4\x90\x80\x80\""));
+    EXPECT_TRUE(validator.validate("\"\xed\x9f\xbf\""));
+    EXPECT_TRUE(validator.validate("\"\xf4\x8f\xbf\xbf\""));
+}
+
+// Strings are validated a vector register at a time; check that whatever
+// the position of a special character within a register (and whatever is
+// left over at the end) it is handled.
+TEST_F(JsonValidatorTest, StringChunking) {
+    for (size_t length = 0; length < 100; ++length) {
+        for (size_t position = 0; position < length; ++position) {
+            for (const std::string special :
+                 {"\\\"", "\\u0041", "\xc3\xa9", "\x1f", "\"", "\xc3"}) {
+                std::string document(length, 'x');
+                document.replace(position, 1, special);
+                document = "[\"" + document + "\"]";
+                expectSameAsJsonChecker(document);
+            }
+        }
+    }
+}
+
+// Check a (valid and then truncated) larger document at every length
+TEST_F(JsonValidatorTest, Truncated) {
+    std::string document = "[";
+    for (int ii = 0; ii < 20; ++ii) {
+        document += R"({"key":"value )" + std::to_string(ii) +
+                    R"(","number":-)" + std::to_string(ii) + ".5e" +
+                    std::to_string(ii) + R"(,"flag":true,"none":null},)";
+    }
+    document += "[]]";
+    ASSERT_TRUE(validator.validate(document));
+
+    for (size_t length = 0; length < document.size(); ++length) {
+        expectSameAsJsonChecker(document.substr(0, length));
+    }
+}
@@ -2951,6 +2951,80 @@ TEST_P(GetRandomKeyValidatorTest, InvalidBodylen) {
     EXPECT_EQ(cb::mcbp::Status::Einval, validate());
 }
 
+class GetMultiValidatorTest : public ::testing::WithParamInterface<bool>,
+                              public ValidatorTest {
+public:
+    GetMultiValidatorTest()
+        : ValidatorTest(GetParam()), req(request.message.header.request) {
+    }
+
+protected:
+    /// Append the specification for the given key to the value
+    void addKey(std::string key, uint16_t keylen = 0) {
+        if (GetParam()) {
+            // Collections expects the (default) collection to be encoded
+            key.insert(key.begin(), '\0');
+        }
+        const cb::mcbp::request::GetMultiKeySpec spec(
+                Vbid(0), keylen ? keylen : gsl::narrow<uint16_t>(key.size()));
+        value.append(spec.getBuffer());
+        value.append(key);
+    }
+
+    cb::mcbp::Status validate() {
+        cb::mcbp::RequestBuilder builder({blob, sizeof(blob)}, true);
+        builder.setValue(value);
+        return ValidatorTest::validate(cb::mcbp::ClientOpcode::GetMulti,
+                                       static_cast<void*>(&request));
+    }
+
+    cb::mcbp::Request& req;
+    std::string value;
+};
+
+TEST_P(GetMultiValidatorTest, CorrectMessage) {
+    addKey("foo");
+    addKey("bar");
+    EXPECT_EQ(cb::mcbp::Status::Success, validate());
+}
+
+TEST_P(GetMultiValidatorTest, NoKeys) {
+    EXPECT_EQ(cb::mcbp::Status::Einval, validate());
+}
+
+TEST_P(GetMultiValidatorTest, TruncatedKeySpec) {
+    addKey("foo");
+    value.push_back('\0');
+    EXPECT_EQ(cb::mcbp::Status::Einval, validate());
+}
+
+TEST_P(GetMultiValidatorTest, ZeroKeylen) {
+    addKey("foo");
+    const cb::mcbp::request::GetMultiKeySpec spec(Vbid(0), 0);
+    value.append(spec.getBuffer());
+    EXPECT_EQ(cb::mcbp::Status::Einval, validate());
+}
+
+TEST_P(GetMultiValidatorTest, KeyExceedsValue) {
+    addKey("foo", 10);
+    EXPECT_EQ(cb::mcbp::Status::Einval, validate());
+}
+
+TEST_P(GetMultiValidatorTest, InvalidKey) {
+    addKey("foo");
+    req.setKeylen(2);
+    req.setBodylen(value.size() + 2);
+    EXPECT_EQ(cb::mcbp::Status::Einval,
+              ValidatorTest::validate(cb::mcbp::ClientOpcode::GetMulti,
+                                      static_cast<void*>(&request)));
+}
+
+TEST_P(GetMultiValidatorTest, InvalidDatatype) {
+    addKey("foo");
+    req.setDatatype(cb::mcbp::Datatype::JSON);
+    EXPECT_EQ(cb::mcbp::Status::Einval, validate());
+}
+
 class DelVBucketValidatorTest : public ::testing::WithParamInterface<bool>,
                                 public ValidatorTest {
 public:
@@ -3172,6 +3246,10 @@ INSTANTIATE_TEST_SUITE_P(CollectionsOnOff,
                          GetRandomKeyValidatorTest,
                          ::testing::Bool(),
                          ::testing::PrintToStringParamName());
+INSTANTIATE_TEST_SUITE_P(CollectionsOnOff,
+                         GetMultiValidatorTest,
+                         ::testing::Bool(),
+                         ::testing::PrintToStringParamName());
 INSTANTIATE_TEST_SUITE_P(CollectionsOnOff,
                          DelVBucketValidatorTest,
                          ::testing::Bool(),
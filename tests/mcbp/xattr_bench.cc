@@ -0,0 +1,97 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <memcached/protocol_binary.h>
+#include <platform/compress.h>
+#include <xattr/blob.h>
+#include <xattr/utils.h>
+
+#include <string>
+
+/**
+ * Benchmarks for accessing the system xattrs of a Snappy compressed
+ * document (as done for DCP, subdoc and deletions) for a range of body
+ * sizes; only the xattrs should need to be inflated.
+ */
+
+/// @return a compressed document with a few xattrs and a JSON body
+static std::string makeCompressedDocument(size_t bodySize) {
+    cb::xattr::Blob blob;
+    blob.set("_sync", R"({"cas":"0xdeadbeefcafefeed","rev":"1-abcdef"})");
+    blob.set("_txn", R"({"id":"3b8b5d4a","state":"committed"})");
+    blob.set("meta", R"({"content-type":"application/json"})");
+
+    std::string document{blob.finalize()};
+    document.append(R"({"body":[)");
+    while (document.size() < blob.size() + bodySize) {
+        document.append(std::to_string(document.size())).append(",");
+    }
+    document.append("0]}");
+
+    cb::compression::Buffer deflated;
+    cb::compression::deflate(
+            cb::compression::Algorithm::Snappy, document, deflated);
+    return std::string{std::string_view{deflated}};
+}
+
+static void BM_XattrBlobGet(benchmark::State& state) {
+    const auto document = makeCompressedDocument(state.range(0));
+    while (state.KeepRunning()) {
+        const cb::xattr::Blob blob(
+                {const_cast<char*>(document.data()), document.size()}, true);
+        benchmark::DoNotOptimize(blob.get("_txn"));
+    }
+}
+BENCHMARK(BM_XattrBlobGet)->RangeMultiplier(16)->Range(256, 1024 * 1024);
+
+static void BM_XattrGetSystemXattrSize(benchmark::State& state) {
+    const auto document = makeCompressedDocument(state.range(0));
+    const uint8_t datatype =
+            PROTOCOL_BINARY_DATATYPE_XATTR | PROTOCOL_BINARY_DATATYPE_SNAPPY;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(
+                cb::xattr::get_system_xattr_size(datatype, document));
+    }
+}
+BENCHMARK(BM_XattrGetSystemXattrSize)
+        ->RangeMultiplier(16)
+        ->Range(256, 1024 * 1024);
+
+static void BM_XattrGetBodySize(benchmark::State& state) {
+    const auto document = makeCompressedDocument(state.range(0));
+    const uint8_t datatype =
+            PROTOCOL_BINARY_DATATYPE_XATTR | PROTOCOL_BINARY_DATATYPE_SNAPPY;
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(cb::xattr::get_body_size(datatype, document));
+    }
+}
+BENCHMARK(BM_XattrGetBodySize)->RangeMultiplier(16)->Range(256, 1024 * 1024);
+
+static void BM_XattrPruneUserKeys(benchmark::State& state) {
+    const auto document = makeCompressedDocument(state.range(0));
+    while (state.KeepRunning()) {
+        const cb::xattr::Blob blob(
+                {const_cast<char*>(document.data()), document.size()}, true);
+        cb::xattr::Blob copy(blob);
+        copy.prune_user_keys();
+        benchmark::DoNotOptimize(copy.finalize());
+    }
+}
+BENCHMARK(BM_XattrPruneUserKeys)->RangeMultiplier(16)->Range(256, 1024 * 1024);
+
+BENCHMARK_MAIN();
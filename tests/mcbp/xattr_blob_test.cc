@@ -16,6 +16,7 @@
  */
 #include <folly/portability/GTest.h>
 
+#include <memcached/protocol_binary.h>
 #include <nlohmann/json.hpp>
 #include <xattr/blob.h>
 #include <xattr/utils.h>
@@ -230,3 +231,109 @@ TEST(XattrBlob, iterator_insert) {
         }
     }
 }
+
+/**
+ * Build a Snappy compressed document with a couple of xattrs followed by a
+ * body of the given size
+ */
+static std::string makeCompressedDocument(cb::xattr::Blob& blob,
+                                          size_t bodySize) {
+    blob.set("_sync", R"({"cas":"0xdeadbeefcafefeed"})");
+    blob.set("user", R"({"author":"bubba"})");
+
+    std::string document{blob.finalize()};
+    for (size_t ii = 0; ii < bodySize; ++ii) {
+        document.push_back(char('a' + (ii * ii) % 7));
+    }
+
+    cb::compression::Buffer deflated;
+    EXPECT_TRUE(cb::compression::deflate(
+            cb::compression::Algorithm::Snappy, document, deflated));
+    return std::string{std::string_view{deflated}};
+}
+
+TEST(XattrBlob, CompressedDocument) {
+    cb::xattr::Blob original;
+    const auto compressed = makeCompressedDocument(original, 100000);
+    const auto xattrs = original.finalize();
+
+    // Only the xattrs get inflated
+    cb::xattr::Blob blob({const_cast<char*>(compressed.data()),
+                          compressed.size()},
+                         true);
+    EXPECT_EQ(xattrs, blob.finalize());
+    EXPECT_EQ(std::string{"{\"cas\":\"0xdeadbeefcafefeed\"}"},
+              to_string(blob.get("_sync")));
+    EXPECT_EQ(std::string{"{\"author\":\"bubba\"}"},
+              to_string(blob.get("user")));
+
+    const uint8_t datatype =
+            PROTOCOL_BINARY_DATATYPE_XATTR | PROTOCOL_BINARY_DATATYPE_SNAPPY;
+    EXPECT_EQ(xattrs.size(), cb::xattr::get_compressed_body_offset(compressed));
+    EXPECT_EQ(100000, cb::xattr::get_body_size(datatype, compressed));
+    EXPECT_EQ(original.get_system_size(),
+              cb::xattr::get_system_xattr_size(datatype, compressed));
+
+    // The copy doesn't depend on the inflated data of the original
+    cb::xattr::Blob copy(blob);
+    blob.assign({}, false);
+    copy.prune_user_keys();
+    EXPECT_TRUE(cb::xattr::validate(copy.finalize()));
+    EXPECT_EQ(original.get_system_size(), copy.size());
+    EXPECT_EQ(std::string{"{\"cas\":\"0xdeadbeefcafefeed\"}"},
+              to_string(copy.get("_sync")));
+}
+
+TEST(XattrBlob, InflatePrefix) {
+    cb::xattr::Blob blob;
+    const auto compressed = makeCompressedDocument(blob, 100000);
+    cb::compression::Buffer inflated;
+    ASSERT_TRUE(cb::compression::inflate(
+            cb::compression::Algorithm::Snappy, compressed, inflated));
+    const std::string_view document{inflated};
+
+    for (const size_t size : {size_t(0),
+                              size_t(1),
+                              size_t(4),
+                              blob.size(),
+                              document.size() / 2,
+                              document.size()}) {
+        std::string prefix(size, '\0');
+        ASSERT_TRUE(cb::xattr::inflate_prefix(compressed, prefix.data(), size))
+                << size;
+        EXPECT_EQ(document.substr(0, size), prefix);
+    }
+
+    // Can't inflate more than the document, or a truncated document
+    std::string buffer(document.size() + 1, '\0');
+    EXPECT_FALSE(cb::xattr::inflate_prefix(
+            compressed, buffer.data(), document.size() + 1));
+    EXPECT_FALSE(cb::xattr::inflate_prefix(
+            std::string_view{compressed}.substr(0, compressed.size() / 2),
+            buffer.data(),
+            document.size()));
+    EXPECT_THROW(cb::xattr::get_compressed_body_offset("invalid"),
+                 std::invalid_argument);
+}
+
+TEST(XattrBlob, BodySizeOfCorruptCompressedDocument) {
+    cb::xattr::Blob blob;
+    const auto compressed = makeCompressedDocument(blob, 100000);
+    const uint8_t datatype =
+            PROTOCOL_BINARY_DATATYPE_XATTR | PROTOCOL_BINARY_DATATYPE_SNAPPY;
+
+    // The Snappy header (the inflated length) can't be decoded
+    const std::string badHeader(6, '\xff');
+    EXPECT_THROW(cb::xattr::get_body_size(PROTOCOL_BINARY_DATATYPE_SNAPPY,
+                                          badHeader),
+                 std::runtime_error);
+    EXPECT_THROW(cb::xattr::get_body_size(datatype, badHeader),
+                 std::runtime_error);
+
+    // The xattr length word can't be inflated
+    EXPECT_THROW(cb::xattr::get_body_size(
+                         datatype, std::string_view{compressed}.substr(0, 3)),
+                 std::runtime_error);
+    EXPECT_THROW(cb::xattr::get_body_size(datatype, "invalid"),
+                 std::runtime_error);
+}
@@ -21,8 +21,10 @@
 #include <mcbp/protocol/unsigned_leb128.h>
 #include <memcached/limits.h>
 #include <platform/compress.h>
+#include <protocol/mcbp/ewb_encode.h>
 #include <algorithm>
 #include <gsl/gsl>
+#include <map>
 
 class GetSetTest : public TestappXattrClientTest {
 protected:
@@ -605,6 +607,74 @@ TEST_P(GetSetTest, TestGetSuccess) {
     EXPECT_EQ(document.value, stored.value);
 }
 
+TEST_P(GetSetTest, TestGetMulti) {
+    MemcachedConnection& conn = getConnection();
+    document.info.datatype = cb::mcbp::Datatype::Raw;
+    std::vector<std::pair<const std::string, Vbid>> keys;
+    for (int ii = 0; ii < 5; ++ii) {
+        document.info.id = name + std::to_string(ii);
+        document.value = "value-" + std::to_string(ii);
+        conn.mutate(document, Vbid(0), MutationType::Set);
+        keys.emplace_back(document.info.id, Vbid(0));
+    }
+    keys.emplace_back(name + "-missing", Vbid(0));
+
+    std::map<std::string, std::string> found;
+    conn.getMulti(
+            keys,
+            [&found](std::unique_ptr<Document>& doc) {
+                EXPECT_NE(mcbp::cas::Wildcard, doc->info.cas);
+                found[doc->info.id] = doc->value;
+            },
+            [](const std::string& key, const cb::mcbp::Response& rsp) {
+                FAIL() << "Unexpected error for " << key << ": "
+                       << to_string(rsp.getStatus());
+            });
+
+    ASSERT_EQ(5, found.size());
+    for (int ii = 0; ii < 5; ++ii) {
+        EXPECT_EQ("value-" + std::to_string(ii),
+                  found[name + std::to_string(ii)]);
+    }
+}
+
+/**
+ * A key failing the command after another key blocked (as for a background
+ * fetch) must not complete the command before the engine notified the
+ * blocked get.
+ */
+TEST_P(GetSetTest, TestGetMultiErrorAfterBlock) {
+    MemcachedConnection& conn = getConnection();
+    document.info.datatype = cb::mcbp::Datatype::Raw;
+    std::vector<std::pair<const std::string, Vbid>> keys;
+    for (int ii = 0; ii < 2; ++ii) {
+        document.info.id = name + std::to_string(ii);
+        conn.mutate(document, Vbid(0), MutationType::Set);
+        keys.emplace_back(document.info.id, Vbid(0));
+    }
+
+    // Block the first get (notifying success later), and make the second
+    // one fail the command
+    conn.configureEwouldBlockEngine(
+            EWBEngineMode::Sequence,
+            /*unused*/ {},
+            /*unused*/ {},
+            ewb::encodeSequence({cb::engine_errc::would_block,
+                                 cb::engine_errc::success,
+                                 cb::engine_errc::disconnect}));
+    try {
+        conn.getMulti(keys, [](std::unique_ptr<Document>&) {}, {});
+        FAIL() << "Expected the connection to be disconnected";
+    } catch (const ConnectionError& e) {
+        FAIL() << "Expected the connection to be disconnected: " << e.what();
+    } catch (const std::exception&) {
+    }
+
+    // The server should still be up and running
+    auto& other = getConnection();
+    EXPECT_EQ(document.value, other.get(keys.front().first, Vbid(0)).value);
+}
+
 TEST_P(GetSetTest, TestAppend) {
     MemcachedConnection& conn = getConnection();
     document.info.datatype = cb::mcbp::Datatype::Raw;
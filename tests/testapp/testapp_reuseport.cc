@@ -0,0 +1,73 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#include "testapp_client_test.h"
+
+#include <memory>
+#include <vector>
+
+static const int NUM_THREADS = 4;
+
+/**
+ * Tests run with each front end thread having its own listening socket
+ * (the "reuseport_listeners" setting, which can't be changed dynamically)
+ */
+class ReuseportListenersTest : public TestappClientTest {
+public:
+    static void SetUpTestCase() {
+        memcached_cfg = generate_config();
+        memcached_cfg["threads"] = NUM_THREADS;
+        memcached_cfg["reuseport_listeners"] = true;
+        start_memcached_server();
+
+        if (HasFailure()) {
+            std::cerr << "Error in ReuseportListenersTest::SetUpTestCase, "
+                         "terminating process"
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        } else {
+            CreateTestBucket();
+        }
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(TransportProtocols,
+                         ReuseportListenersTest,
+                         ::testing::Values(TransportProtocols::McbpPlain,
+                                           TransportProtocols::McbpSsl),
+                         ::testing::PrintToStringParamName());
+
+/// Connect a number of clients (which the kernel distributes across the
+/// listening sockets of the front end threads) and run commands on each.
+TEST_P(ReuseportListenersTest, ConnectAndRunCommands) {
+    auto& conn = getConnection();
+    std::vector<std::unique_ptr<MemcachedConnection>> clients;
+    for (int ii = 0; ii < NUM_THREADS * 4; ++ii) {
+        clients.emplace_back(conn.clone());
+    }
+
+    Document doc;
+    doc.info.id = name;
+    doc.value = "value";
+    conn.mutate(doc, Vbid(0), MutationType::Set);
+
+    for (auto& client : clients) {
+        const auto rsp = client->execute(
+                BinprotGenericCommand{cb::mcbp::ClientOpcode::Noop});
+        EXPECT_TRUE(rsp.isSuccess()) << to_string(rsp.getStatus());
+        EXPECT_EQ(doc.value, client->get(name, Vbid(0)).value);
+    }
+}
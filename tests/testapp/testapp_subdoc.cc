@@ -1834,6 +1834,69 @@ TEST_P(SubdocTestappTest, SubdocLockedItem) {
 }
 
 
+// Test that repeated lookups in the same version of a document are answered
+// by the sub-document lookup cache, and that the cache is bypassed where it
+// can't be used.
+TEST_P(SubdocTestappTest, SubdocLookupCache) {
+    memcached_cfg["subdoc_lookup_cache_size"] = 16;
+    reconfigure();
+
+    // The (hits, misses) of the cache since the start of the test.
+    const auto getCacheStats = []() {
+        const auto stats = request_stats();
+        return std::make_pair(
+                extract_single_stat(stats, "subdoc_lookup_cache_hits"),
+                extract_single_stat(stats, "subdoc_lookup_cache_misses"));
+    };
+    const auto initial = getCacheStats();
+    const auto expectCacheStats = [&](uint64_t hits, uint64_t misses) {
+        const auto current = getCacheStats();
+        EXPECT_EQ(hits, current.first - initial.first);
+        EXPECT_EQ(misses, current.second - initial.second);
+    };
+
+    store_document("dict", R"({"a":1,"b":{"c":"two"}})");
+
+    // The first lookup of each path misses, and the next one hits (for a
+    // match and for a missing path alike).
+    EXPECT_SD_GET("dict", "b.c", "\"two\"");
+    expectCacheStats(0, 1);
+    EXPECT_SD_GET("dict", "b.c", "\"two\"");
+    expectCacheStats(1, 1);
+    EXPECT_SD_GET("dict", "a", "1");
+    EXPECT_SD_GET("dict", "a", "1");
+    expectCacheStats(2, 2);
+    for (int ii = 0; ii < 2; ++ii) {
+        EXPECT_SD_ERR(BinprotSubdocCommand(
+                              cb::mcbp::ClientOpcode::SubdocGet, "dict", "x"),
+                      cb::mcbp::Status::SubdocPathEnoent);
+    }
+    expectCacheStats(3, 3);
+
+    // Mutations don't use the cache, but change the CAS - so the next
+    // lookups miss and see the new version of the document.
+    EXPECT_SD_OK(BinprotSubdocCommand(
+            cb::mcbp::ClientOpcode::SubdocDictUpsert, "dict", "a", "3"));
+    expectCacheStats(3, 3);
+    EXPECT_SD_GET("dict", "a", "3");
+    expectCacheStats(3, 4);
+    EXPECT_SD_GET("dict", "a", "3");
+    expectCacheStats(4, 4);
+
+    // The CAS of a locked document is hidden, so lookups in it bypass the
+    // cache.
+    auto doc = getConnection().get_and_lock("dict", Vbid(0), 10);
+    EXPECT_SD_GET("dict", "a", "3");
+    EXPECT_SD_GET("dict", "b.c", "\"two\"");
+    expectCacheStats(4, 4);
+    getConnection().unlock("dict", Vbid(0), doc.info.cas);
+
+    delete_object("dict");
+
+    memcached_cfg["subdoc_lookup_cache_size"] = 0;
+    reconfigure();
+}
+
 enum class SubdocCmdType {
     Lookup,
     Mutation
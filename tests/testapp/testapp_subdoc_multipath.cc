@@ -314,6 +314,103 @@ TEST_P(SubdocTestappTest, SubdocMultiMutation_DictAddCounter) {
     delete_object("dict");
 }
 
+// Test multi-path mutation command - mutations of disjoint parts of the
+// document (applied with a single copy of the document) give the same result
+// as applying them one at a time.
+TEST_P(SubdocTestappTest, SubdocMultiMutation_DisjointPaths) {
+    store_document(
+            "dict",
+            R"({"a":1,"b":{"c":"x","d":[1,2]},"count":5,"e":true,"f":null})");
+
+    SubdocMultiMutationCmd mutation;
+    mutation.key = "dict";
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocReplace,
+                              SUBDOC_FLAG_NONE,
+                              "a",
+                              "10"});
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocDelete,
+                              SUBDOC_FLAG_NONE,
+                              "f",
+                              {}});
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocCounter,
+                              SUBDOC_FLAG_NONE,
+                              "count",
+                              "2"});
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocDictUpsert,
+                              SUBDOC_FLAG_NONE,
+                              "b.c",
+                              "\"y\""});
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocArrayPushLast,
+                              SUBDOC_FLAG_NONE,
+                              "b.d",
+                              "3"});
+    expect_subdoc_cmd(mutation,
+                      cb::mcbp::Status::Success,
+                      {{2, cb::mcbp::Status::Success, "7"}});
+
+    validate_json_document(
+            "dict", R"({"a":10,"b":{"c":"y","d":[1,2,3]},"count":7,"e":true})");
+
+    delete_object("dict");
+}
+
+// Test multi-path mutation command - mutations which depend on an earlier
+// mutation in the same command (and so must be applied one at a time).
+TEST_P(SubdocTestappTest, SubdocMultiMutation_DependentPaths) {
+    store_document("dict", R"({"a":1,"b":2,"c":{}})");
+
+    SubdocMultiMutationCmd mutation;
+    mutation.key = "dict";
+    // "a.y" only exists once "a" is a dictionary.
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocDictUpsert,
+                              SUBDOC_FLAG_NONE,
+                              "a",
+                              R"({"x":1})"});
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocDictAdd,
+                              SUBDOC_FLAG_NONE,
+                              "a.y",
+                              "2"});
+    // "b" can only be added back once it is deleted.
+    mutation.specs.push_back(
+            {cb::mcbp::ClientOpcode::SubdocDelete, SUBDOC_FLAG_NONE, "b", {}});
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocDictAdd,
+                              SUBDOC_FLAG_NONE,
+                              "b",
+                              "3"});
+    // Both keys are added at the same place in "c".
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocDictAdd,
+                              SUBDOC_FLAG_NONE,
+                              "c.p",
+                              "4"});
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocDictAdd,
+                              SUBDOC_FLAG_NONE,
+                              "c.q",
+                              "5"});
+    expect_subdoc_cmd(mutation, cb::mcbp::Status::Success, {});
+
+    validate_json_document("dict",
+                           R"({"a":{"x":1,"y":2},"c":{"p":4,"q":5},"b":3})");
+
+    // A failing spec is reported at its index, with the document unmodified.
+    mutation.specs.clear();
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocReplace,
+                              SUBDOC_FLAG_NONE,
+                              "b",
+                              "6"});
+    mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocReplace,
+                              SUBDOC_FLAG_NONE,
+                              "missing",
+                              "7"});
+    expect_subdoc_cmd(mutation,
+                      cb::mcbp::Status::SubdocMultiPathFailure,
+                      {{1, cb::mcbp::Status::SubdocPathEnoent}});
+
+    validate_json_document("dict",
+                           R"({"a":{"x":1,"y":2},"c":{"p":4,"q":5},"b":3})");
+
+    delete_object("dict");
+}
+
 // Test multi-path mutation command - 2x DictAdd with specific CAS.
 TEST_P(SubdocTestappTest, SubdocMultiMutation_DictAddCAS) {
     store_document("dict", "{\"int\":1}");
@@ -401,6 +401,63 @@ TEST_P(SubdocPerfTest, Dict_Add_Multipath) {
 }
 
 
+// Create an N-element dictionary, then benchmark replacing each of its values
+// using multi-path commands. The paths of each command are disjoint, so
+// each command is applied with a single copy of the document.
+TEST_P(SubdocPerfTest, Dict_Replace_Multipath) {
+    subdoc_create_dict("dict", iterations);
+
+    SubdocMultiMutationCmd mutation;
+    mutation.key = "dict";
+    for (size_t i = 0; i < iterations; i++) {
+        mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocReplace,
+                                  SUBDOC_FLAG_NONE,
+                                  std::to_string(i),
+                                  "\"new_value\""});
+
+        if (mutation.specs.size() == PROTOCOL_BINARY_SUBDOC_MULTI_MAX_PATHS) {
+            expect_subdoc_cmd(mutation, cb::mcbp::Status::Success, {});
+            mutation.specs.clear();
+        }
+    }
+
+    // If there are any remaining specs, send them.
+    if (!mutation.specs.empty()) {
+        expect_subdoc_cmd(mutation, cb::mcbp::Status::Success, {});
+    }
+
+    delete_object("dict");
+}
+
+// As Dict_Replace_Multipath, but with every spec of a command replacing the
+// same value - baseline for Dict_Replace_Multipath, as overlapping paths are
+// applied one at a time.
+TEST_P(SubdocPerfTest, Dict_ReplaceSame_Multipath) {
+    subdoc_create_dict("dict", iterations);
+
+    SubdocMultiMutationCmd mutation;
+    mutation.key = "dict";
+    for (size_t i = 0; i < iterations; i++) {
+        const auto key = i / PROTOCOL_BINARY_SUBDOC_MULTI_MAX_PATHS;
+        mutation.specs.push_back({cb::mcbp::ClientOpcode::SubdocReplace,
+                                  SUBDOC_FLAG_NONE,
+                                  std::to_string(key),
+                                  "\"new_value\""});
+
+        if (mutation.specs.size() == PROTOCOL_BINARY_SUBDOC_MULTI_MAX_PATHS) {
+            expect_subdoc_cmd(mutation, cb::mcbp::Status::Success, {});
+            mutation.specs.clear();
+        }
+    }
+
+    // If there are any remaining specs, send them.
+    if (!mutation.specs.empty()) {
+        expect_subdoc_cmd(mutation, cb::mcbp::Status::Success, {});
+    }
+
+    delete_object("dict");
+}
+
 /*****************************************************************************
  * 'Fulldoc' Performance Tests
  *
@@ -0,0 +1,364 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *     Copyright 2021 Couchbase, Inc
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "json_validator.h"
+
+#include <folly/lang/Bits.h>
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace cb::json {
+
+/// @return the first non-whitespace character at or after p
+static const char* skipWhitespace(const char* p, const char* end) {
+    while (p != end &&
+           (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+        ++p;
+    }
+    return p;
+}
+
+/// @return true if c may be copied verbatim into a string (it isn't a
+///         quote, backslash, control character or part of a multi-byte
+///         UTF-8 sequence)
+static bool isPlainStringChar(char c) {
+    const auto u = uint8_t(c);
+    return u >= 0x20 && u < 0x80 && c != '"' && c != '\\';
+}
+
+/**
+ * @return the first character at or after p (in a string) which is not a
+ *         plain string character
+ */
+static const char* skipPlainStringChars(const char* p, const char* end) {
+#if defined(__AVX2__)
+    const auto quote = _mm256_set1_epi8('"');
+    const auto backslash = _mm256_set1_epi8('\\');
+    const auto space = _mm256_set1_epi8(0x20);
+    while (end - p >= 32) {
+        const auto chunk =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        // A signed compare with space catches both control characters and
+        // bytes with the top bit set.
+        const auto special = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                                _mm256_cmpeq_epi8(chunk, backslash)),
+                _mm256_cmpgt_epi8(space, chunk));
+        const auto mask = uint32_t(_mm256_movemask_epi8(special));
+        if (mask != 0) {
+            return p + folly::findFirstSet(mask) - 1;
+        }
+        p += 32;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    const auto quote = _mm_set1_epi8('"');
+    const auto backslash = _mm_set1_epi8('\\');
+    const auto space = _mm_set1_epi8(0x20);
+    while (end - p >= 16) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // A signed compare with space catches both control characters and
+        // bytes with the top bit set.
+        const auto special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                             _mm_cmpeq_epi8(chunk, backslash)),
+                _mm_cmplt_epi8(chunk, space));
+        const auto mask = uint32_t(_mm_movemask_epi8(special));
+        if (mask != 0) {
+            return p + folly::findFirstSet(mask) - 1;
+        }
+        p += 16;
+    }
+#endif
+    while (p != end && isPlainStringChar(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+static bool isHexDigit(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') ||
+           (c >= 'A' && c <= 'F');
+}
+
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * Validate the (well-formed) UTF-8 sequence starting at p, whose first byte
+ * has the top bit set.
+ *
+ * @return the character after the sequence, or nullptr if not valid
+ */
+static const char* skipUtf8Sequence(const char* p, const char* end) {
+    const auto first = uint8_t(*p);
+    size_t length;
+    // The range of the second byte excludes overlong encodings, surrogates
+    // and code points above U+10FFFF (RFC 3629).
+    uint8_t low = 0x80;
+    uint8_t high = 0xbf;
+    if (first >= 0xc2 && first <= 0xdf) {
+        length = 2;
+    } else if (first >= 0xe0 && first <= 0xef) {
+        length = 3;
+        if (first == 0xe0) {
+            low = 0xa0;
+        } else if (first == 0xed) {
+            high = 0x9f;
+        }
+    } else if (first >= 0xf0 && first <= 0xf4) {
+        length = 4;
+        if (first == 0xf0) {
+            low = 0x90;
+        } else if (first == 0xf4) {
+            high = 0x8f;
+        }
+    } else {
+        return nullptr;
+    }
+
+    if (size_t(end - p) < length) {
+        return nullptr;
+    }
+    const auto second = uint8_t(p[1]);
+    if (second < low || second > high) {
+        return nullptr;
+    }
+    for (size_t ii = 2; ii < length; ++ii) {
+        if ((uint8_t(p[ii]) & 0xc0) != 0x80) {
+            return nullptr;
+        }
+    }
+    return p + length;
+}
+
+/**
+ * Validate the string starting at p (after the opening quote).
+ *
+ * @return the character after the closing quote, or nullptr if not valid
+ */
+static const char* skipString(const char* p, const char* end) {
+    while (true) {
+        p = skipPlainStringChars(p, end);
+        if (p == end) {
+            return nullptr;
+        }
+
+        switch (*p) {
+        case '"':
+            return p + 1;
+        case '\\':
+            if (++p == end) {
+                return nullptr;
+            }
+            switch (*p) {
+            case '"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+                ++p;
+                break;
+            case 'u':
+                if (end - p < 5 || !isHexDigit(p[1]) || !isHexDigit(p[2]) ||
+                    !isHexDigit(p[3]) || !isHexDigit(p[4])) {
+                    return nullptr;
+                }
+                p += 5;
+                break;
+            default:
+                return nullptr;
+            }
+            break;
+        default:
+            if (uint8_t(*p) < 0x20) {
+                // Control characters must be escaped
+                return nullptr;
+            }
+            p = skipUtf8Sequence(p, end);
+            if (p == nullptr) {
+                return nullptr;
+            }
+        }
+    }
+}
+
+/**
+ * Validate the number starting at p.
+ *
+ * @return the character after the number, or nullptr if not valid
+ */
+static const char* skipNumber(const char* p, const char* end) {
+    if (p != end && *p == '-') {
+        ++p;
+    }
+    if (p == end) {
+        return nullptr;
+    }
+    if (*p == '0') {
+        ++p;
+    } else if (*p >= '1' && *p <= '9') {
+        while (++p != end && isDigit(*p)) {
+        }
+    } else {
+        return nullptr;
+    }
+
+    if (p != end && *p == '.') {
+        if (++p == end || !isDigit(*p)) {
+            return nullptr;
+        }
+        while (++p != end && isDigit(*p)) {
+        }
+    }
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        if (++p != end && (*p == '+' || *p == '-')) {
+            ++p;
+        }
+        if (p == end || !isDigit(*p)) {
+            return nullptr;
+        }
+        while (++p != end && isDigit(*p)) {
+        }
+    }
+    return p;
+}
+
+/**
+ * Validate the literal starting at p.
+ *
+ * @return the character after the literal, or nullptr if it isn't the
+ *         expected literal
+ */
+static const char* skipLiteral(const char* p,
+                               const char* end,
+                               std::string_view literal) {
+    if (size_t(end - p) < literal.size() ||
+        std::memcmp(p, literal.data(), literal.size()) != 0) {
+        return nullptr;
+    }
+    return p + literal.size();
+}
+
+bool Validator::validate(std::string_view document) {
+    // What may come next at the current position
+    enum class Expect { Value, Key, AfterValue };
+
+    stack.clear();
+    const char* p = document.data();
+    const char* const end = p + document.size();
+    auto expect = Expect::Value;
+
+    while (true) {
+        p = skipWhitespace(p, end);
+        switch (expect) {
+        case Expect::Value:
+            if (p == end) {
+                return false;
+            }
+            switch (*p) {
+            case '{':
+                p = skipWhitespace(p + 1, end);
+                if (p != end && *p == '}') {
+                    ++p;
+                    expect = Expect::AfterValue;
+                } else {
+                    stack.push_back(Container::Object);
+                    expect = Expect::Key;
+                }
+                continue;
+            case '[':
+                p = skipWhitespace(p + 1, end);
+                if (p != end && *p == ']') {
+                    ++p;
+                    expect = Expect::AfterValue;
+                } else {
+                    stack.push_back(Container::Array);
+                }
+                continue;
+            case '"':
+                p = skipString(p + 1, end);
+                break;
+            case 't':
+                p = skipLiteral(p, end, "true");
+                break;
+            case 'f':
+                p = skipLiteral(p, end, "false");
+                break;
+            case 'n':
+                p = skipLiteral(p, end, "null");
+                break;
+            default:
+                p = skipNumber(p, end);
+            }
+            if (p == nullptr) {
+                return false;
+            }
+            expect = Expect::AfterValue;
+            continue;
+
+        case Expect::Key:
+            if (p == end || *p != '"') {
+                return false;
+            }
+            p = skipString(p + 1, end);
+            if (p == nullptr) {
+                return false;
+            }
+            p = skipWhitespace(p, end);
+            if (p == end || *p != ':') {
+                return false;
+            }
+            ++p;
+            expect = Expect::Value;
+            continue;
+
+        case Expect::AfterValue:
+            if (stack.empty()) {
+                // Only whitespace may follow the document
+                return p == end;
+            }
+            if (p == end) {
+                return false;
+            }
+            if (*p == ',') {
+                ++p;
+                expect = stack.back() == Container::Object ? Expect::Key
+                                                           : Expect::Value;
+                continue;
+            }
+            if (*p != (stack.back() == Container::Object ? '}' : ']')) {
+                return false;
+            }
+            ++p;
+            stack.pop_back();
+            continue;
+        }
+    }
+}
+
+} // namespace cb::json
@@ -183,6 +183,33 @@ CollectionsManifest& CollectionsManifest::rename(
             "anything");
 }
 
+CollectionsManifest& CollectionsManifest::setEvictionSettings(
+        const CollectionEntry::Entry& collectionEntry,
+        uint8_t memoryShare,
+        const std::string& evictionPriority,
+        const ScopeEntry::Entry& scopeEntry) {
+    updateUid();
+    std::stringstream sidString, cidString;
+    sidString << std::hex << uint32_t(scopeEntry.uid);
+    cidString << std::hex << uint32_t(collectionEntry.uid);
+    for (auto& scope : json["scopes"]) {
+        if (scope["name"] == scopeEntry.name &&
+            scope["uid"] == sidString.str()) {
+            for (auto& collection : scope["collections"]) {
+                if (collection["name"] == collectionEntry.name &&
+                    collection["uid"] == cidString.str()) {
+                    collection["memoryShare"] = memoryShare;
+                    collection["evictionPriority"] = evictionPriority;
+                    return *this;
+                }
+            }
+        }
+    }
+    throw std::invalid_argument(
+            "CollectionsManifest::setEvictionSettings did not find the "
+            "collection");
+}
+
 bool CollectionsManifest::exists(const CollectionEntry::Entry& collectionEntry,
                                  const ScopeEntry::Entry& scopeEntry) const {
     std::stringstream cid;
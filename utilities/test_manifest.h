@@ -184,6 +184,14 @@ public:
                                 const ScopeEntry::Entry& scopeEntry,
                                 const std::string& newName);
 
+    /// Set the eviction settings (memoryShare and evictionPriority) of the
+    /// collection in the given scope
+    CollectionsManifest& setEvictionSettings(
+            const CollectionEntry::Entry& collectionEntry,
+            uint8_t memoryShare,
+            const std::string& evictionPriority,
+            const ScopeEntry::Entry& scopeEntry = ScopeEntry::defaultS);
+
     /// @return true if collection exists
     bool exists(
             const CollectionEntry::Entry& collectionEntry,
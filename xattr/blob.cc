@@ -31,10 +31,8 @@ namespace cb::xattr {
 Blob::Blob(const Blob& other)
     : allocator(default_allocator),
       alloc_size(other.blob.size()) {
-    decompressed.resize(other.decompressed.size());
-    std::copy_n(other.decompressed.data(),
-                other.decompressed.size(),
-                decompressed.data());
+    // The copy lives in its own buffer, so there is no need to copy any
+    // inflated data the other blob may have
     allocator.reset(new char[alloc_size]);
     blob = { allocator.get(), alloc_size };
     std::copy(other.blob.begin(), other.blob.end(), blob.begin());
@@ -50,11 +48,17 @@ Blob::Blob(cb::char_buffer buffer,
 
 Blob& Blob::assign(std::string_view buffer, bool compressed) {
     if (compressed && !buffer.empty()) {
-        // inflate and attach blob to the compression::buffer
-        if (!cb::compression::inflate(
-                    cb::compression::Algorithm::Snappy,
-                    {static_cast<const char*>(buffer.data()), buffer.size()},
-                    decompressed)) {
+        // Only inflate the xattrs (and not the body which follows them)
+        // into the compression::buffer and attach the blob to it
+        uint32_t size = 0;
+        try {
+            size = cb::xattr::get_compressed_body_offset(buffer);
+        } catch (const std::invalid_argument&) {
+            // Reported (with some more details) below
+        }
+        decompressed.resize(size);
+        if (size == 0 ||
+            !cb::xattr::inflate_prefix(buffer, decompressed.data(), size)) {
             // inflate (de-compress) failed.  Try to grab the
             // uncompressedLength for debugging purposes - zero indicates
             // that it failed to return the uncompressedLength.
@@ -68,10 +72,6 @@ Blob& Blob::assign(std::string_view buffer, bool compressed) {
                     std::to_string(buffer.size()) + " uncompressedLength:" +
                     std::to_string(uncompressedLength));
         }
-
-        // Connect blob to the decompressed xattrs after resizing which in
-        // theory /could/ release the now un-required non xattr data
-        decompressed.resize(cb::xattr::get_body_offset(decompressed));
         blob = {decompressed.data(), decompressed.size()};
     } else if (!buffer.empty()) {
         // incoming data is not compressed, just get the size and attach
@@ -20,6 +20,9 @@
 #include <xattr/key_validator.h>
 #include <xattr/utils.h>
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
 #include <unordered_set>
 
 namespace cb::xattr {
@@ -144,6 +147,125 @@ std::string_view get_body(std::string_view payload) {
     return payload;
 }
 
+/**
+ * Read the inflated length (a varint) from the start of a Snappy stream.
+ * See https://github.com/google/snappy/blob/master/format_description.txt
+ *
+ * @param ptr the start of the stream; advanced past the length
+ * @param end the end of the stream
+ * @param length where to store the inflated length
+ * @return true if the length was read, false if the header is invalid
+ */
+static bool read_snappy_length(const uint8_t*& ptr,
+                               const uint8_t* end,
+                               uint64_t& length) {
+    length = 0;
+    for (int shift = 0;; shift += 7) {
+        if (ptr == end || shift > 28) {
+            return false;
+        }
+        const auto byte = *ptr++;
+        length |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+}
+
+bool inflate_prefix(std::string_view input, char* output, size_t size) {
+    const auto* ptr = reinterpret_cast<const uint8_t*>(input.data());
+    const auto* const end = ptr + input.size();
+
+    // The stream starts with the inflated length
+    uint64_t length;
+    if (!read_snappy_length(ptr, end, length) || length < size) {
+        return false;
+    }
+
+    // Followed by a sequence of literals and copies of earlier output
+    size_t produced = 0;
+    while (produced < size) {
+        if (ptr == end) {
+            return false;
+        }
+        const auto tag = *ptr++;
+        size_t len = (tag >> 2) + 1;
+        size_t offset;
+        switch (tag & 0x3) {
+        case 0: {
+            if (len > 60) {
+                // The length-1 is stored in the following 1-4 bytes
+                const size_t nbytes = len - 60;
+                if (size_t(end - ptr) < nbytes) {
+                    return false;
+                }
+                len = 0;
+                for (size_t ii = 0; ii < nbytes; ++ii) {
+                    len |= size_t(ptr[ii]) << (8 * ii);
+                }
+                ++len;
+                ptr += nbytes;
+            }
+            if (size_t(end - ptr) < len) {
+                return false;
+            }
+            const auto n = std::min(len, size - produced);
+            std::memcpy(output + produced, ptr, n);
+            produced += n;
+            ptr += len;
+            continue;
+        }
+        case 1:
+            if (ptr == end) {
+                return false;
+            }
+            len = ((tag >> 2) & 0x7) + 4;
+            offset = (size_t(tag >> 5) << 8) | *ptr++;
+            break;
+        case 2:
+            if (end - ptr < 2) {
+                return false;
+            }
+            offset = size_t(ptr[0]) | (size_t(ptr[1]) << 8);
+            ptr += 2;
+            break;
+        default:
+            if (end - ptr < 4) {
+                return false;
+            }
+            offset = size_t(ptr[0]) | (size_t(ptr[1]) << 8) |
+                     (size_t(ptr[2]) << 16) | (size_t(ptr[3]) << 24);
+            ptr += 4;
+            break;
+        }
+
+        if (offset == 0 || offset > produced) {
+            return false;
+        }
+        // The source and destination may overlap (offset < len repeats the
+        // last offset bytes) so copy a byte at a time
+        const auto n = std::min(len, size - produced);
+        for (size_t ii = 0; ii < n; ++ii, ++produced) {
+            output[produced] = output[produced - offset];
+        }
+    }
+
+    return true;
+}
+
+uint32_t get_compressed_body_offset(std::string_view payload) {
+    uint32_t len;
+    if (!inflate_prefix(payload, reinterpret_cast<char*>(&len), sizeof(len))) {
+        throw std::invalid_argument(
+                "get_compressed_body_offset: Failed to inflate data");
+    }
+    len = ntohl(len);
+    check_len(len,
+              cb::compression::get_uncompressed_length(
+                      cb::compression::Algorithm::Snappy, payload));
+    return len + sizeof(uint32_t);
+}
+
 size_t get_system_xattr_size(uint8_t datatype, std::string_view doc) {
     if (!::mcbp::datatype::is_xattr(datatype)) {
         return 0;
@@ -155,14 +277,26 @@ size_t get_system_xattr_size(uint8_t datatype, std::string_view doc) {
 }
 
 size_t get_body_size(uint8_t datatype, std::string_view value) {
-    cb::compression::Buffer uncompressed;
     if (::mcbp::datatype::is_snappy(datatype)) {
-        if (!cb::compression::inflate(
-                    cb::compression::Algorithm::Snappy, value, uncompressed)) {
-            throw std::invalid_argument(
-                    "get_body_size: Failed to inflate data");
+        // The size is known from the Snappy header and the xattr length
+        // word, so there is no need to inflate the body
+        const auto* ptr = reinterpret_cast<const uint8_t*>(value.data());
+        uint64_t size;
+        if (!read_snappy_length(ptr, ptr + value.size(), size)) {
+            throw std::runtime_error("get_body_size: Failed to inflate data");
+        }
+        if (size == 0 || !::mcbp::datatype::is_xattr(datatype)) {
+            return size;
+        }
+
+        uint32_t len;
+        if (!inflate_prefix(
+                    value, reinterpret_cast<char*>(&len), sizeof(len))) {
+            throw std::runtime_error("get_body_size: Failed to inflate data");
         }
-        value = uncompressed;
+        len = ntohl(len);
+        check_len(len, size - sizeof(uint32_t));
+        return size - len - sizeof(uint32_t);
     }
 
     if (value.size() == 0) {